@@ -80,7 +80,7 @@ namespace BB
 	inline void BBfree_f(Allocator a_Allocator, T* a_Ptr)
 	{
 		BB_ASSERT(a_Ptr != nullptr, "Trying to free a nullptr");
-		if constexpr (!std::is_trivially_destructible_v<T>)
+		if constexpr (!std::is_void_v<T> && !std::is_trivially_destructible_v<T>)
 		{
 			a_Ptr->~T();
 		}
@@ -3,6 +3,7 @@
 #include "BBMemory.h"
 #include "Hashmap.h"
 #include "BBString.h"
+#include "StringBuilder.h"
 
 //tutorial/guide used: https://kishoreganesh.com/post/writing-a-json-parser-in-cplusplus/
 namespace BB
@@ -66,6 +67,7 @@ namespace BB
 	{
 		struct Pair
 		{
+			//Points into the json text of the parser, the closing quote is replaced with a null terminator.
 			char* name;
 			JsonNode* node;
 			Pair* next = nullptr;
@@ -76,6 +78,13 @@ namespace BB
 		{};
 		OL_HashMap<char*, JsonNode*, String_KeyComp> map;
 		Pair* pairLL;
+
+		//Find a member without copying the name, returns nullptr if the object has no member called a_Name.
+		JsonNode* Find(const StringView a_Name) const
+		{
+			JsonNode** t_Node = map.find(a_Name.data(), a_Name.size());
+			return t_Node != nullptr ? *t_Node : nullptr;
+		}
 	};
 
 	struct JsonFile
@@ -85,15 +94,19 @@ namespace BB
 		uint32_t pos = 0;
 	};
 
+	//Appends the node and everything in it as json text.
 	void JsonNodeToString(const JsonNode* t_Node, String& a_String);
+	//Same as the String version, but appending never reallocates or copies the text that is already written. Use this for big trees.
+	void JsonNodeToString(const JsonNode* t_Node, StringBuilder& a_String);
 	struct Token;
 	class JsonParser
 	{
 	public:
 		//load from disk
 		JsonParser(const char* a_Path);
-		//load from memory
+		//load from memory, the memory is copied once so the parser can terminate strings in place.
 		JsonParser(const Buffer& a_Buffer);
+		JsonParser(const StringView a_Json);
 		~JsonParser();
 
 		void Parse();
@@ -110,6 +123,7 @@ namespace BB
 		
 		//jank
 		JsonNode* PraseSingleToken(const Token& a_Token);
+		void CopyJson(const char* a_Json, const size_t a_Size);
 		LinearAllocator_t m_Allocator;
 		JsonFile m_JsonFile;
 
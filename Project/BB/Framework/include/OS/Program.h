@@ -79,6 +79,8 @@ namespace BB
 	OSFileHandle LoadOSFile(const wchar* a_FileName);
 	//char replaced with string view later on.
 	void WriteToOSFile(const OSFileHandle a_file_handle, const void* a_data, const size_t a_size);
+	//Write the buffers to the file in order. Windows does one write per buffer, a POSIX backend can do it in a single writev.
+	void WriteToOSFile(const OSFileHandle a_FileHandle, const Buffer* a_Buffers, const size_t a_BufferCount);
 	//Reads a loaded file.
 	//Buffer.data will have a dynamic allocation from the given allocator.
 	Buffer ReadOSFile(Allocator a_SysAllocator, const OSFileHandle a_FileHandle);
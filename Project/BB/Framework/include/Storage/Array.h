@@ -10,12 +10,18 @@ namespace BB
 	{
 		constexpr const size_t multipleValue = 8;
 		constexpr const size_t standardSize = 8;
+		//Default growth factor, can be changed per array with set_growth_factor.
+		constexpr const float growthFactor = 2.f;
 	};
 
+	template<typename T>
+	class Slice;
+
 	template<typename T>
 	struct Array
 	{
 		static constexpr bool trivialDestructible_T = std::is_trivially_destructible_v<T>;
+		BB_TRIVIALLY_RELOCATABLE;
 
 		struct Iterator
 		{
@@ -44,13 +50,13 @@ namespace BB
 				return t_Tmp;
 			}
 
-			friend bool operator== (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_ptr == a_Rhs.m_ptr; };
-			friend bool operator!= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_ptr != a_Rhs.m_ptr; };
+			friend bool operator== (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Ptr == a_Rhs.m_Ptr; };
+			friend bool operator!= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Ptr != a_Rhs.m_Ptr; };
 
-			friend bool operator< (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_ptr < a_Rhs.m_ptr; };
-			friend bool operator> (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_ptr > a_Rhs.m_ptr; };
-			friend bool operator<= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_ptr <= a_Rhs.m_ptr; };
-			friend bool operator>= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_ptr >= a_Rhs.m_ptr; };
+			friend bool operator< (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Ptr < a_Rhs.m_Ptr; };
+			friend bool operator> (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Ptr > a_Rhs.m_Ptr; };
+			friend bool operator<= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Ptr <= a_Rhs.m_Ptr; };
+			friend bool operator>= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Ptr >= a_Rhs.m_Ptr; };
 
 
 		private:
@@ -69,6 +75,8 @@ namespace BB
 
 		void push_back(T& a_Element);
 		void push_back(const T* a_Elements, size_t a_Count);
+		//Add all elements of a_Elements to the back, a single memcpy for trivially copyable types.
+		void append(const Slice<const T> a_Elements);
 		void insert(size_t a_Position, const T& a_Element);
 		void insert(size_t a_Position, const T* a_Elements, size_t a_Count);
 		template <class... Args>
@@ -78,16 +86,31 @@ namespace BB
 
 		void reserve(size_t a_Size);
 		void resize(size_t a_Size);
+		/// <summary>
+		/// Resize without constructing the new elements, meant to be filled with a memcpy or a file read afterwards.
+		/// </summary>
+		void resize_uninitialized(size_t a_Size);
 
 		void pop();
+		//Remove the element at a_Index by moving the last element into it, does not keep the order.
+		void erase_swap(size_t a_Index);
 		void clear();
 
+		/// <summary>
+		/// How much the capacity is multiplied by when the array runs out of space, must be bigger then 1.
+		/// </summary>
+		void set_growth_factor(const float a_GrowthFactor)
+		{
+			BB_ASSERT(a_GrowthFactor > 1.f, "Array growth factor must be bigger then 1.");
+			m_GrowthFactor = a_GrowthFactor;
+		}
+
 		const size_t size() const { return m_Size; };
 		const size_t capacity() const { return m_Capacity; }
 		T* data() const { return m_Arr; };
 
 		Iterator begin() { return Iterator(m_Arr); }
-		Iterator end() { return Iterator(&m_Arr[m_Size + 1]); } //Get an out of bounds Iterator.
+		Iterator end() { return Iterator(&m_Arr[m_Size]); }
 			 
 	private:
 		void grow(size_t a_MinCapacity = 0);
@@ -99,6 +122,7 @@ namespace BB
 		T* m_Arr;
 		size_t m_Size = 0;
 		size_t m_Capacity;
+		float m_GrowthFactor = Array_Specs::growthFactor;
 	};
 
 	template<typename T>
@@ -121,6 +145,7 @@ namespace BB
 		m_Allocator = a_Array.m_Allocator;
 		m_Size = a_Array.m_Size;
 		m_Capacity = a_Array.m_Capacity;
+		m_GrowthFactor = a_Array.m_GrowthFactor;
 		m_Arr = reinterpret_cast<T*>(BBalloc(m_Allocator, m_Capacity * sizeof(T)));
 
 		Memory::Copy<T>(m_Arr, a_Array.m_Arr, m_Size);
@@ -132,6 +157,7 @@ namespace BB
 		m_Allocator = a_Array.m_Allocator;
 		m_Size = a_Array.m_Size;
 		m_Capacity = a_Array.m_Capacity;
+		m_GrowthFactor = a_Array.m_GrowthFactor;
 		m_Arr = a_Array.m_Arr;
 
 		a_Array.m_Size = 0;
@@ -154,7 +180,7 @@ namespace BB
 				}
 			}
 
-			BBfree(m_Allocator, m_Arr);
+			BBfree(m_Allocator, reinterpret_cast<void*>(m_Arr));
 		}
 	}
 
@@ -166,6 +192,7 @@ namespace BB
 		m_Allocator = a_Rhs.m_Allocator;
 		m_Size = a_Rhs.m_Size;
 		m_Capacity = a_Rhs.m_Capacity;
+		m_GrowthFactor = a_Rhs.m_GrowthFactor;
 		m_Arr = reinterpret_cast<T*>(BBalloc(m_Allocator, m_Capacity * sizeof(T)));
 
 		Memory::Copy<T>(m_Arr, a_Rhs.m_Arr, m_Size);
@@ -181,6 +208,7 @@ namespace BB
 		m_Allocator = a_Rhs.m_Allocator;
 		m_Size = a_Rhs.m_Size;
 		m_Capacity = a_Rhs.m_Capacity;
+		m_GrowthFactor = a_Rhs.m_GrowthFactor;
 		m_Arr = a_Rhs.m_Arr;
 
 		a_Rhs.m_Size = 0;
@@ -209,13 +237,28 @@ namespace BB
 	inline void Array<T>::push_back(const T* a_Elements, size_t a_Count)
 	{
 		if (m_Size + a_Count > m_Capacity)
-			grow(a_Count);
+			grow(m_Size + a_Count);
 
-		Memory::Copy<T>(m_Arr, a_Elements, a_Count);
+		Memory::Copy<T>(m_Arr + m_Size, a_Elements, a_Count);
 
 		m_Size += a_Count;
 	}
 
+	template<typename T>
+	inline void Array<T>::append(const Slice<const T> a_Elements)
+	{
+		const size_t t_Count = a_Elements.size();
+		if (m_Size + t_Count > m_Capacity)
+			grow(m_Size + t_Count);
+
+		if constexpr (std::is_trivially_copyable_v<T>)
+			memcpy(m_Arr + m_Size, a_Elements.data(), t_Count * sizeof(T));
+		else
+			Memory::Copy<T>(m_Arr + m_Size, a_Elements.data(), t_Count);
+
+		m_Size += t_Count;
+	}
+
 	template<typename T>
 	inline void BB::Array<T>::insert(size_t a_Position, const T& a_Element)
 	{
@@ -241,21 +284,8 @@ namespace BB
 		if (m_Size >= m_Capacity)
 			grow();
 
-		if constexpr (!trivialDestructible_T)
-		{
-			//Move all elements after a_Position 1 to the front.
-			for (size_t i = m_Size; i > a_Position; i--)
-			{
-				new (&m_Arr[i]) T(m_Arr[i - 1]);
-				m_Arr[i - 1].~T();
-			}
-		}
-		else
-		{
-			//Move all elements after a_Position 1 to the front.
-			//Using memmove for more safety.
-			memmove(&m_Arr[a_Position + 1], &m_Arr[a_Position], sizeof(T) * (m_Size - a_Position));
-		}
+		//Move all elements after a_Position 1 to the front.
+		Memory::sMove(&m_Arr[a_Position + 1], &m_Arr[a_Position], m_Size - a_Position);
 
 		new (&m_Arr[a_Position]) T(std::forward<Args>(a_Args)...);
 		m_Size++;
@@ -279,11 +309,37 @@ namespace BB
 	{
 		reserve(a_Size);
 
-		for (size_t i = m_Size; i < a_Size; i++)
+		if (a_Size > m_Size)
 		{
-			new (&m_Arr[i]) T();
+			//Value initialization of a trivial type is a zero fill.
+			if constexpr (std::is_trivially_default_constructible_v<T>)
+			{
+				memset(&m_Arr[m_Size], 0, (a_Size - m_Size) * sizeof(T));
+			}
+			else
+			{
+				for (size_t i = m_Size; i < a_Size; i++)
+				{
+					new (&m_Arr[i]) T();
+				}
+			}
 		}
+		else if constexpr (!trivialDestructible_T)
+		{
+			for (size_t i = a_Size; i < m_Size; i++)
+			{
+				m_Arr[i].~T();
+			}
+		}
+
+		m_Size = a_Size;
+	}
 
+	template<typename T>
+	inline void BB::Array<T>::resize_uninitialized(size_t a_Size)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Array::resize_uninitialized only works with trivially copyable types.");
+		reserve(a_Size);
 		m_Size = a_Size;
 	}
 
@@ -298,6 +354,20 @@ namespace BB
 		}
 	}
 
+	template<typename T>
+	inline void BB::Array<T>::erase_swap(size_t a_Index)
+	{
+		BB_ASSERT(a_Index < m_Size, "Dynamic_Array, erase_swap index is out of bounds!");
+		--m_Size;
+		if constexpr (!trivialDestructible_T)
+		{
+			m_Arr[a_Index].~T();
+		}
+		//Relocate the last element into the hole, the last slot is dead after this.
+		if (a_Index != m_Size)
+			Memory::Move(&m_Arr[a_Index], &m_Arr[m_Size], 1);
+	}
+
 	template<typename T>
 	inline void BB::Array<T>::clear()
 	{
@@ -314,7 +384,11 @@ namespace BB
 	template<typename T>
 	inline void Array<T>::grow(size_t a_MinCapacity)
 	{
-		size_t t_ModifiedCapacity = m_Capacity * 2;
+		size_t t_ModifiedCapacity = static_cast<size_t>(static_cast<float>(m_Capacity) * m_GrowthFactor);
+		//Small factors can round down to the current capacity.
+		if (t_ModifiedCapacity <= m_Capacity)
+			t_ModifiedCapacity = m_Capacity + 1;
+		t_ModifiedCapacity = Math::RoundUp(t_ModifiedCapacity, Array_Specs::multipleValue);
 
 		if (a_MinCapacity > t_ModifiedCapacity)
 			t_ModifiedCapacity = Math::RoundUp(a_MinCapacity, Array_Specs::multipleValue);
@@ -328,7 +402,7 @@ namespace BB
 		T* t_NewArr = reinterpret_cast<T*>(BBalloc(m_Allocator, a_NewCapacity * sizeof(T)));
 
 		Memory::Move(t_NewArr, m_Arr, m_Size);
-		BBfree(m_Allocator, m_Arr);
+		BBfree(m_Allocator, reinterpret_cast<void*>(m_Arr));
 
 		m_Arr = t_NewArr;
 		m_Capacity = a_NewCapacity;
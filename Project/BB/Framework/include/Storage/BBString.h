@@ -3,6 +3,7 @@
 #include "BBMemory.h"
 
 #include "Utils/Utils.h"
+#include "Storage/StringView.h"
 
 namespace BB
 {
@@ -12,14 +13,22 @@ namespace BB
 		constexpr const size_t standardSize = 8;
 	}
 
+	/// <summary>
+	/// Allocator backed string that is always null terminated.
+	/// Small strings are stored inside the string object itself and do not allocate,
+	/// that is 23 characters for String and 5 for WString with a 4 byte wchar_t.
+	/// </summary>
 	template<typename CharT>
 	class Basic_String
 	{
 	public:
+		BB_TRIVIALLY_RELOCATABLE;
+
 		Basic_String(Allocator a_Allocator);
 		Basic_String(Allocator a_Allocator, size_t a_Size);
 		Basic_String(Allocator a_Allocator, const CharT* a_String);
 		Basic_String(Allocator a_Allocator, const CharT* a_String, size_t a_Size);
+		Basic_String(Allocator a_Allocator, const Basic_StringView<CharT> a_String);
 		Basic_String(const Basic_String<CharT>& a_String);
 		Basic_String(Basic_String<CharT>&& a_String) noexcept;
 		~Basic_String();
@@ -32,12 +41,14 @@ namespace BB
 		void append(const Basic_String<CharT>& a_String, size_t a_SubPos, size_t a_SubLength);
 		void append(const CharT* a_String);
 		void append(const CharT* a_String, size_t a_Size);
+		void append(const Basic_StringView<CharT> a_String);
 		void insert(size_t a_Pos, const Basic_String<CharT>& a_String);
 		void insert(size_t a_Pos, const Basic_String<CharT>& a_String, size_t a_SubPos, size_t a_SubLength);
 		void insert(size_t a_Pos, const CharT* a_String);
 		void insert(size_t a_Pos, const CharT* a_String, size_t a_Size);
+		void insert(size_t a_Pos, const Basic_StringView<CharT> a_String);
 		void push_back(const CharT a_Char);
-		
+
 		void pop_back();
 
 		bool compare(const Basic_String<CharT>& a_String) const;
@@ -53,20 +64,51 @@ namespace BB
 		void reserve(const size_t a_Size);
 		void shrink_to_fit();
 
-		size_t size() const { return m_Size; }
-		size_t capacity() const { return m_Capacity; }
-		CharT* data() const { return m_String; }
-		const CharT* c_str() const { return m_String; }
+		size_t size() const { return IsLocal() ? LOCAL_CAPACITY - 1 - static_cast<size_t>(m_Local[LOCAL_CAPACITY - 1]) : m_Heap.size; }
+		//Includes the space for the null terminator.
+		size_t capacity() const { return IsLocal() ? LOCAL_CAPACITY : m_Heap.capacity & ~HEAP_FLAG; }
+		CharT* data() const { return IsLocal() ? const_cast<CharT*>(m_Local) : m_Heap.string; }
+		const CharT* c_str() const { return data(); }
+		//View of the whole string, invalidated when the string grows.
+		operator Basic_StringView<CharT>() const { return Basic_StringView<CharT>(data(), size()); }
+		//True if the string is stored inside the string object.
+		bool is_local() const { return IsLocal(); }
 
 	private:
+		struct HeapString
+		{
+			CharT* string;
+			size_t size;
+			//The top bit is always set, see HEAP_FLAG.
+			size_t capacity;
+		};
+
+		//Characters that fit in the string object, including the null terminator.
+		static constexpr size_t LOCAL_CAPACITY = sizeof(HeapString) / sizeof(CharT);
+		//On little endian the top bit of the heap capacity shares the last byte with the last local character.
+		//A local string keeps LOCAL_CAPACITY - 1 - size in that character, so the bit is never set for a local string.
+		//When a local string is full that character is 0 and is the null terminator.
+		static constexpr size_t HEAP_FLAG = static_cast<size_t>(1) << (sizeof(size_t) * 8 - 1);
+
+		bool IsLocal() const { return (m_Heap.capacity & HEAP_FLAG) == 0; }
+		//Sets the size and writes the null terminator.
+		void SetSize(const size_t a_Size);
+		void SetLocalEmpty();
+		//Takes the representation of a_String and leaves it empty with no memory.
+		void MoveFrom(Basic_String<CharT>& a_String);
+		void CopyFrom(const Basic_String<CharT>& a_String);
+		void Release();
+
 		void grow(size_t a_MinCapacity = 1);
 		void reallocate(size_t a_NewCapacity);
 
 		Allocator m_Allocator;
 
-		CharT* m_String;
-		size_t m_Size = 0;
-		size_t m_Capacity = 64;
+		union
+		{
+			HeapString m_Heap;
+			CharT m_Local[LOCAL_CAPACITY];
+		};
 	};
 
 	using String = Basic_String<char>;
@@ -75,7 +117,7 @@ namespace BB
 
 	template<typename CharT>
 	inline BB::Basic_String<CharT>::Basic_String(Allocator a_Allocator)
-		: Basic_String(a_Allocator, String_Specs::standardSize)
+		: Basic_String(a_Allocator, LOCAL_CAPACITY)
 	{}
 
 	template<typename CharT>
@@ -85,10 +127,9 @@ namespace BB
 		BB_STATIC_ASSERT(is_char, "String is not a char or wchar");
 
 		m_Allocator = a_Allocator;
-		m_Capacity = Math::RoundUp(a_Size, String_Specs::multipleValue);
-
-		m_String = reinterpret_cast<CharT*>(BBalloc(m_Allocator, m_Capacity * sizeof(CharT)));
-		Memory::Set(m_String, NULL, m_Capacity);
+		SetLocalEmpty();
+		if (a_Size > LOCAL_CAPACITY)
+			reallocate(Math::RoundUp(a_Size, String_Specs::multipleValue));
 	}
 
 	template<typename CharT>
@@ -103,61 +144,45 @@ namespace BB
 		BB_STATIC_ASSERT(is_char, "String is not a char or wchar");
 
 		m_Allocator = a_Allocator;
-		m_Capacity = Math::RoundUp(a_Size + 1, String_Specs::multipleValue);
-		m_Size = a_Size;
+		SetLocalEmpty();
+		if (a_Size + 1 > LOCAL_CAPACITY)
+			reallocate(Math::RoundUp(a_Size + 1, String_Specs::multipleValue));
 
-		m_String = reinterpret_cast<CharT*>(BBalloc(m_Allocator, m_Capacity * sizeof(CharT)));
-		Memory::Copy(m_String, a_String, a_Size);
-		Memory::Set(m_String + a_Size, NULL, m_Capacity - a_Size);
+		Memory::Copy(data(), a_String, a_Size);
+		SetSize(a_Size);
 	}
 
+	template<typename CharT>
+	inline BB::Basic_String<CharT>::Basic_String(Allocator a_Allocator, const Basic_StringView<CharT> a_String)
+		:	Basic_String(a_Allocator, a_String.data(), a_String.size())
+	{}
+
 	template<typename CharT>
 	inline BB::Basic_String<CharT>::Basic_String(const Basic_String<CharT>& a_String)
 	{
-		m_Allocator = a_String.m_Allocator;
-		m_Capacity = a_String.m_Capacity;
-		m_Size = a_String.m_Size;
-
-		m_String = reinterpret_cast<CharT*>(BBalloc(m_Allocator, m_Capacity * sizeof(CharT)));
-		Memory::Copy(m_String, a_String.m_String, m_Capacity);
+		CopyFrom(a_String);
 	}
 
 	template<typename CharT>
 	inline BB::Basic_String<CharT>::Basic_String(Basic_String<CharT>&& a_String) noexcept
 	{
-		m_Allocator = a_String.m_Allocator;
-		m_Capacity = a_String.m_Capacity;
-		m_Size = a_String.m_Size;
-		m_String = a_String.m_String;
-
-		a_String.m_Allocator.allocator = nullptr;
-		a_String.m_Allocator.func = nullptr;
-		a_String.m_Capacity = 0;
-		a_String.m_Size = 0;
-		a_String.m_String = nullptr;
+		MoveFrom(a_String);
 	}
 
 	template<typename CharT>
 	inline BB::Basic_String<CharT>::~Basic_String()
 	{
-		if (m_String != nullptr)
-		{
-			BBfree(m_Allocator, m_String);
-			m_String = nullptr;
-		}
+		Release();
 	}
 
 	template<typename CharT>
 	inline Basic_String<CharT>& BB::Basic_String<CharT>::operator=(const Basic_String<CharT>& a_Rhs)
 	{
-		this->~Basic_String();
+		if (this == &a_Rhs)
+			return *this;
 
-		m_Allocator = a_Rhs.m_Allocator;
-		m_Capacity = a_Rhs.m_Capacity;
-		m_Size = a_Rhs.m_Size;
-
-		m_String = reinterpret_cast<CharT*>(BBalloc(m_Allocator, m_Capacity * sizeof(CharT)));
-		Memory::Copy(m_String, a_Rhs.m_String, m_Capacity);
+		Release();
+		CopyFrom(a_Rhs);
 
 		return *this;
 	}
@@ -165,18 +190,11 @@ namespace BB
 	template<typename CharT>
 	inline Basic_String<CharT>& BB::Basic_String<CharT>::operator=(Basic_String<CharT>&& a_Rhs) noexcept
 	{
-		this->~Basic_String();
-
-		m_Allocator = a_Rhs.m_Allocator;
-		m_Capacity = a_Rhs.m_Capacity;
-		m_Size = a_Rhs.m_Size;
-		m_String = a_Rhs.m_String;
+		if (this == &a_Rhs)
+			return *this;
 
-		a_Rhs.m_Allocator.allocator = nullptr;
-		a_Rhs.m_Allocator.func = nullptr;
-		a_Rhs.m_Capacity = 0;
-		a_Rhs.m_Size = 0;
-		a_Rhs.m_String = nullptr;
+		Release();
+		MoveFrom(a_Rhs);
 
 		return *this;
 	}
@@ -184,7 +202,7 @@ namespace BB
 	template<typename CharT>
 	inline bool BB::Basic_String<CharT>::operator==(const Basic_String<CharT>& a_Rhs) const
 	{
-		if (Memory::Compare(m_String, a_Rhs.data(), m_Size) == 0)
+		if (Memory::Compare(data(), a_Rhs.data(), size()) == 0)
 			return true;
 		return false;
 	}
@@ -210,11 +228,18 @@ namespace BB
 	template<typename CharT>
 	inline void BB::Basic_String<CharT>::append(const CharT* a_String, size_t a_Size)
 	{
-		if (m_Size + 1 + a_Size >= m_Capacity)
-			grow(a_Size + 1);
+		const size_t t_Size = size();
+		if (t_Size + 1 + a_Size > capacity())
+			grow(t_Size + 1 + a_Size);
+
+		BB::Memory::Copy(data() + t_Size, a_String, a_Size);
+		SetSize(t_Size + a_Size);
+	}
 
-		BB::Memory::Copy(m_String + m_Size, a_String, a_Size);
-		m_Size += a_Size;
+	template<typename CharT>
+	inline void BB::Basic_String<CharT>::append(const Basic_StringView<CharT> a_String)
+	{
+		append(a_String.data(), a_String.size());
 	}
 
 	template<typename CharT>
@@ -238,36 +263,47 @@ namespace BB
 	template<typename CharT>
 	inline void BB::Basic_String<CharT>::insert(size_t a_Pos, const CharT* a_String, size_t a_Size)
 	{
-		BB_ASSERT(m_Size >= a_Pos, "String::Insert, trying to insert a string in a invalid position.");
+		const size_t t_Size = size();
+		BB_ASSERT(t_Size >= a_Pos, "String::Insert, trying to insert a string in a invalid position.");
 
-		if (m_Size + 1 + a_Size >= m_Capacity)
-			grow(a_Size + 1);
+		if (t_Size + 1 + a_Size > capacity())
+			grow(t_Size + 1 + a_Size);
 
-		Memory::sMove(m_String + (a_Pos + a_Size), m_String + a_Pos, m_Size - a_Pos);
+		CharT* t_String = data();
+		Memory::sMove(t_String + (a_Pos + a_Size), t_String + a_Pos, t_Size - a_Pos);
 
-		Memory::Copy(m_String + a_Pos, a_String, a_Size);
-		m_Size += a_Size;
+		Memory::Copy(t_String + a_Pos, a_String, a_Size);
+		SetSize(t_Size + a_Size);
+	}
+
+	template<typename CharT>
+	inline void BB::Basic_String<CharT>::insert(size_t a_Pos, const Basic_StringView<CharT> a_String)
+	{
+		insert(a_Pos, a_String.data(), a_String.size());
 	}
 
 	template<typename CharT>
 	inline void BB::Basic_String<CharT>::push_back(const CharT a_Char)
 	{
-		if (m_Size + 1 >= m_Capacity)
-			grow();
+		const size_t t_Size = size();
+		if (t_Size + 2 > capacity())
+			grow(t_Size + 2);
 
-		m_String[m_Size++] = a_Char;
+		data()[t_Size] = a_Char;
+		SetSize(t_Size + 1);
 	}
 
 	template<typename CharT>
 	inline void BB::Basic_String<CharT>::pop_back()
 	{
-		m_String[m_Size--] = NULL;
+		BB_ASSERT(size() != 0, "String::pop_back, the string is empty.");
+		SetSize(size() - 1);
 	}
 
 	template<typename CharT>
 	inline bool BB::Basic_String<CharT>::compare(const Basic_String<CharT>& a_String) const
 	{
-		if (Memory::Compare(m_String, a_String.data(), m_Size) == 0)
+		if (Memory::Compare(data(), a_String.data(), size()) == 0)
 			return true;
 		return false;
 	}
@@ -275,7 +311,7 @@ namespace BB
 	template<typename CharT>
 	inline bool BB::Basic_String<CharT>::compare(const Basic_String<CharT>& a_String, size_t a_Size) const
 	{
-		if (Memory::Compare(m_String, a_String.c_str(), a_Size) == 0)
+		if (Memory::Compare(data(), a_String.c_str(), a_Size) == 0)
 			return true;
 		return false;
 	}
@@ -283,7 +319,7 @@ namespace BB
 	template<typename CharT>
 	inline bool BB::Basic_String<CharT>::compare(size_t a_Pos, const Basic_String<CharT>& a_String, size_t a_Subpos, size_t a_Size) const
 	{
-		if (Memory::Compare(m_String + a_Pos, a_String.c_str() + a_Subpos, a_Size) == 0)
+		if (Memory::Compare(data() + a_Pos, a_String.c_str() + a_Subpos, a_Size) == 0)
 			return true;
 		return false;
 	}
@@ -297,7 +333,7 @@ namespace BB
 	template<typename CharT>
 	inline bool BB::Basic_String<CharT>::compare(const CharT* a_String, size_t a_Size) const
 	{
-		if (Memory::Compare(m_String, a_String, a_Size) == 0)
+		if (Memory::Compare(data(), a_String, a_Size) == 0)
 			return true;
 		return false;
 	}
@@ -311,7 +347,7 @@ namespace BB
 	template<typename CharT>
 	inline bool BB::Basic_String<CharT>::compare(size_t a_Pos, const CharT* a_String, size_t a_Size) const
 	{
-		if (Memory::Compare(m_String + a_Pos, a_String, a_Size) == 0)
+		if (Memory::Compare(data() + a_Pos, a_String, a_Size) == 0)
 			return true;
 		return false;
 	}
@@ -319,14 +355,15 @@ namespace BB
 	template<typename CharT>
 	inline void BB::Basic_String<CharT>::clear()
 	{
-		Memory::Set(m_String, NULL, m_Size);
-		m_Size = 0;
+		//A moved from string has no memory to write the terminator in.
+		if (data() != nullptr)
+			SetSize(0);
 	}
 
 	template<typename CharT>
 	inline void BB::Basic_String<CharT>::reserve(const size_t a_Size)
 	{
-		if (a_Size > m_Capacity)
+		if (a_Size > capacity())
 		{
 			size_t t_ModifiedCapacity = Math::RoundUp(a_Size + 1, String_Specs::multipleValue);
 
@@ -337,17 +374,96 @@ namespace BB
 	template<typename CharT>
 	inline void BB::Basic_String<CharT>::shrink_to_fit()
 	{
-		size_t t_ModifiedCapacity = Math::RoundUp(m_Size + 1, String_Specs::multipleValue);
-		if (t_ModifiedCapacity < m_Capacity)
+		if (IsLocal() || m_Heap.string == nullptr)
+			return;
+
+		const size_t t_Size = m_Heap.size;
+		if (t_Size + 1 <= LOCAL_CAPACITY)
+		{
+			//Fits in the object again, the +1 also copies the terminator.
+			CharT* t_OldString = m_Heap.string;
+			SetLocalEmpty();
+			Memory::Copy(m_Local, t_OldString, t_Size + 1);
+			SetSize(t_Size);
+			BBfree(m_Allocator, t_OldString);
+			return;
+		}
+
+		size_t t_ModifiedCapacity = Math::RoundUp(t_Size + 1, String_Specs::multipleValue);
+		if (t_ModifiedCapacity < capacity())
 		{
 			reallocate(t_ModifiedCapacity);
 		}
 	}
 
+	template<typename CharT>
+	inline void BB::Basic_String<CharT>::SetSize(const size_t a_Size)
+	{
+		if (IsLocal())
+		{
+			//When a_Size is LOCAL_CAPACITY - 1 both writes are the same null terminator.
+			m_Local[a_Size] = static_cast<CharT>(0);
+			m_Local[LOCAL_CAPACITY - 1] = static_cast<CharT>(LOCAL_CAPACITY - 1 - a_Size);
+		}
+		else
+		{
+			m_Heap.string[a_Size] = static_cast<CharT>(0);
+			m_Heap.size = a_Size;
+		}
+	}
+
+	template<typename CharT>
+	inline void BB::Basic_String<CharT>::SetLocalEmpty()
+	{
+		m_Heap.capacity = 0;
+		m_Local[0] = static_cast<CharT>(0);
+		m_Local[LOCAL_CAPACITY - 1] = static_cast<CharT>(LOCAL_CAPACITY - 1);
+	}
+
+	template<typename CharT>
+	inline void BB::Basic_String<CharT>::MoveFrom(Basic_String<CharT>& a_String)
+	{
+		m_Allocator = a_String.m_Allocator;
+		//Also copies a local string, it is never bigger than the heap representation.
+		m_Heap = a_String.m_Heap;
+
+		a_String.m_Allocator.allocator = nullptr;
+		a_String.m_Allocator.func = nullptr;
+		a_String.m_Heap.string = nullptr;
+		a_String.m_Heap.size = 0;
+		a_String.m_Heap.capacity = HEAP_FLAG;
+	}
+
+	template<typename CharT>
+	inline void BB::Basic_String<CharT>::CopyFrom(const Basic_String<CharT>& a_String)
+	{
+		m_Allocator = a_String.m_Allocator;
+		const size_t t_Size = a_String.size();
+
+		SetLocalEmpty();
+		if (t_Size + 1 > LOCAL_CAPACITY)
+			reallocate(Math::RoundUp(t_Size + 1, String_Specs::multipleValue));
+
+		//Only copy the characters in use, SetSize writes the terminator.
+		if (t_Size != 0)
+			Memory::Copy(data(), a_String.data(), t_Size);
+		SetSize(t_Size);
+	}
+
+	template<typename CharT>
+	inline void BB::Basic_String<CharT>::Release()
+	{
+		if (!IsLocal() && m_Heap.string != nullptr)
+		{
+			BBfree(m_Allocator, m_Heap.string);
+			m_Heap.string = nullptr;
+		}
+	}
+
 	template<typename CharT>
 	inline void BB::Basic_String<CharT>::grow(size_t a_MinCapacity)
 	{
-		size_t t_ModifiedCapacity = m_Capacity * 2;
+		size_t t_ModifiedCapacity = capacity() * 2;
 
 		if (a_MinCapacity > t_ModifiedCapacity)
 			t_ModifiedCapacity = Math::RoundUp(a_MinCapacity, String_Specs::multipleValue);
@@ -358,13 +474,24 @@ namespace BB
 	template<typename CharT>
 	inline void BB::Basic_String<CharT>::reallocate(size_t a_NewCapacity)
 	{
+		BB_ASSERT(a_NewCapacity > LOCAL_CAPACITY, "String::reallocate, a string this small should be stored locally.");
 		CharT* t_NewString = reinterpret_cast<CharT*>(BBalloc(m_Allocator, a_NewCapacity * sizeof(CharT)));
 
-		Memory::Copy(t_NewString, m_String, m_Size);
-		BBfree(m_Allocator, m_String);
+		CharT* t_OldString = data();
+		const size_t t_Size = size();
+		if (t_OldString != nullptr)
+		{
+			//Copy the terminator with it.
+			Memory::Copy(t_NewString, t_OldString, t_Size + 1);
+			if (!IsLocal())
+				BBfree(m_Allocator, t_OldString);
+		}
+		else
+			t_NewString[0] = static_cast<CharT>(0);
 
-		m_String = t_NewString;
-		m_Capacity = a_NewCapacity;
+		m_Heap.string = t_NewString;
+		m_Heap.size = t_Size;
+		m_Heap.capacity = a_NewCapacity | HEAP_FLAG;
 	}
 
 
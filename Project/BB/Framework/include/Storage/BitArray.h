@@ -0,0 +1,236 @@
+#pragma once
+#include "Utils/Logger.h"
+#include "BBMemory.h"
+
+#include "Utils/Utils.h"
+
+namespace BB
+{
+	namespace BitArray_Specs
+	{
+		constexpr const size_t bitsPerWord = 64;
+		constexpr const size_t wordShift = 6;
+		constexpr const size_t wordMask = bitsPerWord - 1;
+
+		constexpr size_t WordCount(const size_t a_BitCount)
+		{
+			return (a_BitCount + wordMask) >> wordShift;
+		}
+		//Mask of the bits in use of the last word, all bits when the bit count is a multiple of 64.
+		constexpr uint64_t LastWordMask(const size_t a_BitCount)
+		{
+			return (a_BitCount & wordMask) == 0 ? ~0ull : (1ull << (a_BitCount & wordMask)) - 1;
+		}
+	};
+
+	//Word level bit operations, AVX2 when the framework is compiled with it.
+	namespace BitOps
+	{
+		void And(uint64_t* __restrict a_Destination, const uint64_t* __restrict a_Source, const size_t a_WordCount);
+		void Or(uint64_t* __restrict a_Destination, const uint64_t* __restrict a_Source, const size_t a_WordCount);
+		void Xor(uint64_t* __restrict a_Destination, const uint64_t* __restrict a_Source, const size_t a_WordCount);
+		//a_Destination = a_Destination & ~a_Source
+		void AndNot(uint64_t* __restrict a_Destination, const uint64_t* __restrict a_Source, const size_t a_WordCount);
+		size_t PopCount(const uint64_t* a_Words, const size_t a_WordCount);
+		bool Any(const uint64_t* a_Words, const size_t a_WordCount);
+		//Index of the first 0 bit in [a_Begin, a_End), a_End if there is none.
+		size_t FindFirstUnset(const uint64_t* a_Words, const size_t a_Begin, const size_t a_End);
+		//Index of the last 1 bit in [a_Begin, a_End), a_End if there is none.
+		size_t FindLastSet(const uint64_t* a_Words, const size_t a_Begin, const size_t a_End);
+	}
+
+	/// <summary>
+	/// Goes over the indices of the set bits, one tzcnt per set bit and whole zero words are skipped.
+	/// for (size_t t_Index : t_Bits.set_bits())
+	/// </summary>
+	class SetBitRange
+	{
+	public:
+		struct Iterator
+		{
+			Iterator(const uint64_t* a_Words, const size_t a_WordCount, size_t a_WordIndex)
+				: m_Words(a_Words), m_WordCount(a_WordCount), m_WordIndex(a_WordIndex)
+			{
+				m_Word = m_WordIndex < m_WordCount ? m_Words[m_WordIndex] : 0;
+				SkipEmptyWords();
+			}
+
+			size_t operator*() const { return (m_WordIndex << BitArray_Specs::wordShift) + Math::CountTrailingZeros(m_Word); }
+
+			Iterator& operator++()
+			{
+				//Clear the lowest set bit.
+				m_Word &= m_Word - 1;
+				SkipEmptyWords();
+				return *this;
+			}
+
+			friend bool operator== (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_WordIndex == a_Rhs.m_WordIndex && a_Lhs.m_Word == a_Rhs.m_Word; };
+			friend bool operator!= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return !(a_Lhs == a_Rhs); };
+
+		private:
+			void SkipEmptyWords()
+			{
+				while (m_Word == 0 && m_WordIndex < m_WordCount)
+				{
+					if (++m_WordIndex < m_WordCount)
+						m_Word = m_Words[m_WordIndex];
+				}
+			}
+
+			const uint64_t* m_Words;
+			size_t m_WordCount;
+			size_t m_WordIndex;
+			uint64_t m_Word;
+		};
+
+		SetBitRange(const uint64_t* a_Words, const size_t a_WordCount) : m_Words(a_Words), m_WordCount(a_WordCount) {}
+
+		Iterator begin() const { return Iterator(m_Words, m_WordCount, 0); }
+		Iterator end() const { return Iterator(m_Words, m_WordCount, m_WordCount); }
+
+	private:
+		const uint64_t* m_Words;
+		size_t m_WordCount;
+	};
+
+	/// <summary>
+	/// Bitset with a compile time size, lives fully inside the object.
+	/// Bits outside of N are always 0.
+	/// </summary>
+	template<size_t N>
+	class FixedBitArray
+	{
+		static_assert(N > 0, "FixedBitArray needs at least 1 bit.");
+		static constexpr size_t wordCount = BitArray_Specs::WordCount(N);
+
+	public:
+		bool operator[](const size_t a_Index) const { return test(a_Index); }
+
+		bool test(const size_t a_Index) const
+		{
+			BB_ASSERT(a_Index < N, "FixedBitArray, bit index out of bounds.");
+			return (m_Words[a_Index >> BitArray_Specs::wordShift] >> (a_Index & BitArray_Specs::wordMask)) & 1;
+		}
+		void set(const size_t a_Index)
+		{
+			BB_ASSERT(a_Index < N, "FixedBitArray, bit index out of bounds.");
+			m_Words[a_Index >> BitArray_Specs::wordShift] |= 1ull << (a_Index & BitArray_Specs::wordMask);
+		}
+		void reset(const size_t a_Index)
+		{
+			BB_ASSERT(a_Index < N, "FixedBitArray, bit index out of bounds.");
+			m_Words[a_Index >> BitArray_Specs::wordShift] &= ~(1ull << (a_Index & BitArray_Specs::wordMask));
+		}
+		void flip(const size_t a_Index)
+		{
+			BB_ASSERT(a_Index < N, "FixedBitArray, bit index out of bounds.");
+			m_Words[a_Index >> BitArray_Specs::wordShift] ^= 1ull << (a_Index & BitArray_Specs::wordMask);
+		}
+
+		void set_all()
+		{
+			memset(m_Words, 0xFF, sizeof(m_Words));
+			m_Words[wordCount - 1] &= BitArray_Specs::LastWordMask(N);
+		}
+		void clear() { memset(m_Words, 0, sizeof(m_Words)); }
+
+		FixedBitArray<N>& operator&=(const FixedBitArray<N>& a_Rhs) { BitOps::And(m_Words, a_Rhs.m_Words, wordCount); return *this; }
+		FixedBitArray<N>& operator|=(const FixedBitArray<N>& a_Rhs) { BitOps::Or(m_Words, a_Rhs.m_Words, wordCount); return *this; }
+		FixedBitArray<N>& operator^=(const FixedBitArray<N>& a_Rhs) { BitOps::Xor(m_Words, a_Rhs.m_Words, wordCount); return *this; }
+		//Clears every bit that is set in a_Rhs.
+		FixedBitArray<N>& and_not(const FixedBitArray<N>& a_Rhs) { BitOps::AndNot(m_Words, a_Rhs.m_Words, wordCount); return *this; }
+
+		size_t count() const { return BitOps::PopCount(m_Words, wordCount); }
+		bool any() const { return BitOps::Any(m_Words, wordCount); }
+		bool none() const { return !any(); }
+
+		SetBitRange set_bits() const { return SetBitRange(m_Words, wordCount); }
+
+		constexpr size_t size() const { return N; }
+		constexpr size_t word_count() const { return wordCount; }
+		uint64_t* data() { return m_Words; }
+		const uint64_t* data() const { return m_Words; }
+
+	private:
+		uint64_t m_Words[wordCount]{};
+	};
+
+	/// <summary>
+	/// Growable bitset, bits outside of size() are always 0.
+	/// New bits from a resize or push_back start at 0, unless pushed as 1.
+	/// </summary>
+	class BitArray
+	{
+	public:
+		BB_TRIVIALLY_RELOCATABLE;
+
+		BitArray(Allocator a_Allocator);
+		BitArray(Allocator a_Allocator, const size_t a_BitCount);
+		BitArray(const BitArray& a_BitArray);
+		BitArray(BitArray&& a_BitArray) noexcept;
+		~BitArray();
+
+		BitArray& operator=(const BitArray& a_Rhs);
+		BitArray& operator=(BitArray&& a_Rhs) noexcept;
+
+		bool operator[](const size_t a_Index) const { return test(a_Index); }
+
+		bool test(const size_t a_Index) const
+		{
+			BB_ASSERT(a_Index < m_BitCount, "BitArray, bit index out of bounds.");
+			return (m_Words[a_Index >> BitArray_Specs::wordShift] >> (a_Index & BitArray_Specs::wordMask)) & 1;
+		}
+		void set(const size_t a_Index)
+		{
+			BB_ASSERT(a_Index < m_BitCount, "BitArray, bit index out of bounds.");
+			m_Words[a_Index >> BitArray_Specs::wordShift] |= 1ull << (a_Index & BitArray_Specs::wordMask);
+		}
+		void reset(const size_t a_Index)
+		{
+			BB_ASSERT(a_Index < m_BitCount, "BitArray, bit index out of bounds.");
+			m_Words[a_Index >> BitArray_Specs::wordShift] &= ~(1ull << (a_Index & BitArray_Specs::wordMask));
+		}
+		void flip(const size_t a_Index)
+		{
+			BB_ASSERT(a_Index < m_BitCount, "BitArray, bit index out of bounds.");
+			m_Words[a_Index >> BitArray_Specs::wordShift] ^= 1ull << (a_Index & BitArray_Specs::wordMask);
+		}
+
+		void push_back(const bool a_Value);
+		void resize(const size_t a_BitCount);
+		void reserve(const size_t a_BitCount);
+
+		void set_all();
+		//Sets every bit to 0, keeps the size.
+		void clear();
+
+		//The bulk operations need two BitArrays of the same size.
+		BitArray& operator&=(const BitArray& a_Rhs);
+		BitArray& operator|=(const BitArray& a_Rhs);
+		BitArray& operator^=(const BitArray& a_Rhs);
+		//Clears every bit that is set in a_Rhs.
+		BitArray& and_not(const BitArray& a_Rhs);
+
+		size_t count() const { return BitOps::PopCount(m_Words, word_count()); }
+		bool any() const { return BitOps::Any(m_Words, word_count()); }
+		bool none() const { return !any(); }
+
+		SetBitRange set_bits() const { return SetBitRange(m_Words, word_count()); }
+
+		size_t size() const { return m_BitCount; }
+		size_t capacity() const { return m_WordCapacity * BitArray_Specs::bitsPerWord; }
+		size_t word_count() const { return BitArray_Specs::WordCount(m_BitCount); }
+		uint64_t* data() const { return m_Words; }
+
+	private:
+		//This function also changes the m_WordCapacity value.
+		void reallocate(const size_t a_NewWordCapacity);
+
+		Allocator m_Allocator;
+
+		uint64_t* m_Words = nullptr;
+		size_t m_BitCount = 0;
+		size_t m_WordCapacity = 0;
+	};
+}
@@ -0,0 +1,303 @@
+#pragma once
+#include "Utils/Logger.h"
+#include "BBMemory.h"
+
+#include "Utils/Utils.h"
+#include "Utils/Slice.h"
+
+namespace BB
+{
+	namespace BucketArray_Specs
+	{
+		constexpr const size_t standardBucketSize = 64;
+		constexpr const size_t standardBucketListSize = 8;
+	};
+
+	/// <summary>
+	/// Array made out of fixed size buckets, elements never move after being added.
+	/// Pointers to elements stay valid until the element is popped or the BucketArray is cleared.
+	/// Growing only allocates a new bucket, the elements that are already in are not touched.
+	/// </summary>
+	template<typename T, size_t BucketSize = BucketArray_Specs::standardBucketSize>
+	class BucketArray
+	{
+		static_assert(BucketSize != 0 && (BucketSize & (BucketSize - 1)) == 0, "BucketArray bucket size must be a power of 2.");
+		static constexpr bool trivialDestructible_T = std::is_trivially_destructible_v<T>;
+		static constexpr size_t bucketMask = BucketSize - 1;
+		static constexpr size_t BucketShift()
+		{
+			size_t t_Shift = 0;
+			while ((static_cast<size_t>(1) << t_Shift) != BucketSize)
+				++t_Shift;
+			return t_Shift;
+		}
+		static constexpr size_t bucketShift = BucketShift();
+
+	public:
+		BB_TRIVIALLY_RELOCATABLE;
+
+		struct Iterator
+		{
+			using value_type = T;
+			using pointer = T*;
+			using reference = T&;
+
+			Iterator(T* const* a_Buckets, size_t a_Index) : m_Buckets(a_Buckets), m_Index(a_Index) {}
+
+			reference operator*() const { return m_Buckets[m_Index >> bucketShift][m_Index & bucketMask]; }
+			pointer operator->() { return &m_Buckets[m_Index >> bucketShift][m_Index & bucketMask]; }
+
+			Iterator& operator++()
+			{
+				m_Index++;
+				return *this;
+			}
+
+			Iterator operator++(int)
+			{
+				Iterator t_Tmp = *this;
+				++(*this);
+				return t_Tmp;
+			}
+
+			friend bool operator== (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Index == a_Rhs.m_Index; };
+			friend bool operator!= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Index != a_Rhs.m_Index; };
+
+		private:
+			T* const* m_Buckets;
+			size_t m_Index;
+		};
+
+		BucketArray(Allocator a_Allocator);
+		BucketArray(Allocator a_Allocator, size_t a_Size);
+		BucketArray(const BucketArray<T, BucketSize>& a_Array);
+		BucketArray(BucketArray<T, BucketSize>&& a_Array) noexcept;
+		~BucketArray();
+
+		BucketArray<T, BucketSize>& operator=(const BucketArray<T, BucketSize>& a_Rhs);
+		BucketArray<T, BucketSize>& operator=(BucketArray<T, BucketSize>&& a_Rhs) noexcept;
+		T& operator[](const size_t a_Index) const;
+
+		T& push_back(const T& a_Element);
+		template <class... Args>
+		T& emplace_back(Args&&... a_Args);
+
+		//Allocates buckets until a_Size elements fit, never moves elements.
+		void reserve(size_t a_Size);
+
+		void pop();
+		//Destructs all elements but keeps the buckets for reuse.
+		void clear();
+
+		const size_t size() const { return m_Size; }
+		const size_t capacity() const { return m_BucketCount * BucketSize; }
+		const size_t bucket_count() const { return m_BucketCount; }
+		/// <summary>
+		/// Get the elements in use of a bucket, iterating bucket by bucket keeps the inner loop a plain pointer walk.
+		/// </summary>
+		Slice<T> bucket(const size_t a_BucketIndex) const;
+
+		Iterator begin() const { return Iterator(m_Buckets, 0); }
+		Iterator end() const { return Iterator(m_Buckets, m_Size); }
+
+	private:
+		void AddBucket();
+		void CopyFrom(const BucketArray<T, BucketSize>& a_Array);
+		void MoveFrom(BucketArray<T, BucketSize>& a_Array);
+		//Destroys the elements and frees all buckets, back to an empty BucketArray.
+		void Release();
+
+		Allocator m_Allocator;
+
+		T** m_Buckets = nullptr;
+		size_t m_BucketCount = 0;
+		size_t m_BucketListCapacity = 0;
+		size_t m_Size = 0;
+	};
+
+	template<typename T, size_t BucketSize>
+	inline BB::BucketArray<T, BucketSize>::BucketArray(Allocator a_Allocator)
+		: m_Allocator(a_Allocator)
+	{}
+
+	template<typename T, size_t BucketSize>
+	inline BB::BucketArray<T, BucketSize>::BucketArray(Allocator a_Allocator, size_t a_Size)
+		: m_Allocator(a_Allocator)
+	{
+		reserve(a_Size);
+	}
+
+	template<typename T, size_t BucketSize>
+	inline BB::BucketArray<T, BucketSize>::BucketArray(const BucketArray<T, BucketSize>& a_Array)
+		: m_Allocator(a_Array.m_Allocator)
+	{
+		CopyFrom(a_Array);
+	}
+
+	template<typename T, size_t BucketSize>
+	inline BB::BucketArray<T, BucketSize>::BucketArray(BucketArray<T, BucketSize>&& a_Array) noexcept
+		: m_Allocator(a_Array.m_Allocator)
+	{
+		MoveFrom(a_Array);
+	}
+
+	template<typename T, size_t BucketSize>
+	inline BB::BucketArray<T, BucketSize>::~BucketArray()
+	{
+		Release();
+	}
+
+	template<typename T, size_t BucketSize>
+	inline BucketArray<T, BucketSize>& BB::BucketArray<T, BucketSize>::operator=(const BucketArray<T, BucketSize>& a_Rhs)
+	{
+		Release();
+
+		m_Allocator = a_Rhs.m_Allocator;
+		CopyFrom(a_Rhs);
+
+		return *this;
+	}
+
+	template<typename T, size_t BucketSize>
+	inline BucketArray<T, BucketSize>& BB::BucketArray<T, BucketSize>::operator=(BucketArray<T, BucketSize>&& a_Rhs) noexcept
+	{
+		Release();
+
+		m_Allocator = a_Rhs.m_Allocator;
+		MoveFrom(a_Rhs);
+
+		return *this;
+	}
+
+	template<typename T, size_t BucketSize>
+	inline T& BB::BucketArray<T, BucketSize>::operator[](const size_t a_Index) const
+	{
+		BB_ASSERT(a_Index < m_Size, "BucketArray, trying to get an element using the [] operator but that element is not there.");
+		return m_Buckets[a_Index >> bucketShift][a_Index & bucketMask];
+	}
+
+	template<typename T, size_t BucketSize>
+	inline T& BB::BucketArray<T, BucketSize>::push_back(const T& a_Element)
+	{
+		return emplace_back(a_Element);
+	}
+
+	template<typename T, size_t BucketSize>
+	template<class ...Args>
+	inline T& BB::BucketArray<T, BucketSize>::emplace_back(Args&&... a_Args)
+	{
+		if (m_Size == capacity())
+			AddBucket();
+
+		T* t_Element = new (&m_Buckets[m_Size >> bucketShift][m_Size & bucketMask]) T(std::forward<Args>(a_Args)...);
+		m_Size++;
+		return *t_Element;
+	}
+
+	template<typename T, size_t BucketSize>
+	inline void BB::BucketArray<T, BucketSize>::reserve(size_t a_Size)
+	{
+		while (capacity() < a_Size)
+			AddBucket();
+	}
+
+	template<typename T, size_t BucketSize>
+	inline void BB::BucketArray<T, BucketSize>::pop()
+	{
+		BB_ASSERT(m_Size != 0, "BucketArray, Popping while m_Size is 0!");
+		--m_Size;
+		if constexpr (!trivialDestructible_T)
+		{
+			m_Buckets[m_Size >> bucketShift][m_Size & bucketMask].~T();
+		}
+	}
+
+	template<typename T, size_t BucketSize>
+	inline void BB::BucketArray<T, BucketSize>::clear()
+	{
+		if constexpr (!trivialDestructible_T)
+		{
+			for (size_t i = 0; i < m_Size; i++)
+			{
+				m_Buckets[i >> bucketShift][i & bucketMask].~T();
+			}
+		}
+		m_Size = 0;
+	}
+
+	template<typename T, size_t BucketSize>
+	inline Slice<T> BB::BucketArray<T, BucketSize>::bucket(const size_t a_BucketIndex) const
+	{
+		BB_ASSERT(a_BucketIndex < m_BucketCount, "BucketArray, bucket index is out of bounds.");
+		const size_t t_Start = a_BucketIndex * BucketSize;
+		if (t_Start >= m_Size)
+			return Slice<T>(m_Buckets[a_BucketIndex], static_cast<size_t>(0));
+
+		const size_t t_Count = m_Size - t_Start < BucketSize ? m_Size - t_Start : BucketSize;
+		return Slice<T>(m_Buckets[a_BucketIndex], t_Count);
+	}
+
+	template<typename T, size_t BucketSize>
+	inline void BB::BucketArray<T, BucketSize>::AddBucket()
+	{
+		//Only the list of bucket pointers moves, the buckets themselves stay where they are.
+		if (m_BucketCount == m_BucketListCapacity)
+		{
+			const size_t t_NewListCapacity = m_BucketListCapacity == 0 ? BucketArray_Specs::standardBucketListSize : m_BucketListCapacity * 2;
+			T** t_NewBuckets = reinterpret_cast<T**>(BBalloc(m_Allocator, t_NewListCapacity * sizeof(T*)));
+			if (m_Buckets != nullptr)
+			{
+				memcpy(t_NewBuckets, m_Buckets, m_BucketCount * sizeof(T*));
+				BBfree(m_Allocator, m_Buckets);
+			}
+			m_Buckets = t_NewBuckets;
+			m_BucketListCapacity = t_NewListCapacity;
+		}
+
+		m_Buckets[m_BucketCount++] = reinterpret_cast<T*>(BBalloc(m_Allocator, BucketSize * sizeof(T)));
+	}
+
+	template<typename T, size_t BucketSize>
+	inline void BB::BucketArray<T, BucketSize>::CopyFrom(const BucketArray<T, BucketSize>& a_Array)
+	{
+		reserve(a_Array.m_Size);
+		for (size_t i = 0; i < a_Array.m_BucketCount; i++)
+		{
+			const Slice<T> t_Bucket = a_Array.bucket(i);
+			Memory::Copy<T>(m_Buckets[i], t_Bucket.data(), t_Bucket.size());
+		}
+		m_Size = a_Array.m_Size;
+	}
+
+	template<typename T, size_t BucketSize>
+	inline void BB::BucketArray<T, BucketSize>::MoveFrom(BucketArray<T, BucketSize>& a_Array)
+	{
+		m_Buckets = a_Array.m_Buckets;
+		m_BucketCount = a_Array.m_BucketCount;
+		m_BucketListCapacity = a_Array.m_BucketListCapacity;
+		m_Size = a_Array.m_Size;
+
+		a_Array.m_Buckets = nullptr;
+		a_Array.m_BucketCount = 0;
+		a_Array.m_BucketListCapacity = 0;
+		a_Array.m_Size = 0;
+	}
+
+	template<typename T, size_t BucketSize>
+	inline void BB::BucketArray<T, BucketSize>::Release()
+	{
+		if (m_Buckets == nullptr)
+			return;
+
+		clear();
+		for (size_t i = 0; i < m_BucketCount; i++)
+		{
+			BBfree(m_Allocator, reinterpret_cast<void*>(m_Buckets[i]));
+		}
+		BBfree(m_Allocator, m_Buckets);
+
+		m_Buckets = nullptr;
+		m_BucketCount = 0;
+		m_BucketListCapacity = 0;
+	}
+}
@@ -0,0 +1,314 @@
+#pragma once
+#include "Utils/Logger.h"
+#include "BBMemory.h"
+#include "Allocators/BackingAllocator.h"
+
+#include <atomic>
+#include <thread>
+
+namespace BB
+{
+	/// <summary>
+	/// Lock-free stack of free element indices (a Treiber stack) shared by the concurrent pools.
+	/// The head stores index + 1 in the low 32 bits and a tag in the high 32 bits. The tag changes on every
+	/// push and pop, so a thread that read an old head cannot swap it back in (the ABA problem).
+	/// The links live in a separate atomic array, reading the link of an element that another thread just took is not a data race.
+	/// </summary>
+	class ConcurrentFreeList
+	{
+	public:
+		static constexpr uint32_t EMPTY = 0;
+
+		void Init(std::atomic<uint32_t>* a_Next) { m_Next = a_Next; m_Head.store(0, std::memory_order_relaxed); }
+
+		bool Pop(uint32_t& a_Index)
+		{
+			uint64_t t_Head = m_Head.load(std::memory_order_acquire);
+			while (true)
+			{
+				const uint32_t t_Top = static_cast<uint32_t>(t_Head);
+				if (t_Top == EMPTY)
+					return false;
+
+				const uint64_t t_NewHead = NextTag(t_Head) | m_Next[t_Top - 1].load(std::memory_order_relaxed);
+				if (m_Head.compare_exchange_weak(t_Head, t_NewHead, std::memory_order_acquire, std::memory_order_acquire))
+				{
+					a_Index = t_Top - 1;
+					return true;
+				}
+			}
+		}
+
+		//Push the chain a_First -> ... -> a_Last, the chain is already linked through the next array.
+		void PushChain(const uint32_t a_First, const uint32_t a_Last)
+		{
+			uint64_t t_Head = m_Head.load(std::memory_order_relaxed);
+			do
+			{
+				m_Next[a_Last].store(static_cast<uint32_t>(t_Head), std::memory_order_relaxed);
+			} while (!m_Head.compare_exchange_weak(t_Head, NextTag(t_Head) | (a_First + 1), std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		void Push(const uint32_t a_Index) { PushChain(a_Index, a_Index); }
+
+		//Links a_Begin till a_End as one chain, not thread safe on those elements.
+		void LinkRange(const uint32_t a_Begin, const uint32_t a_End)
+		{
+			for (uint32_t i = a_Begin; i < a_End - 1; i++)
+				m_Next[i].store(i + 2, std::memory_order_relaxed);
+			m_Next[a_End - 1].store(EMPTY, std::memory_order_relaxed);
+		}
+
+		bool Empty() const { return static_cast<uint32_t>(m_Head.load(std::memory_order_acquire)) == EMPTY; }
+
+	private:
+		static uint64_t NextTag(const uint64_t a_Head) { return ((a_Head >> 32) + 1) << 32; }
+
+		alignas(64) std::atomic<uint64_t> m_Head{ 0 };
+		std::atomic<uint32_t>* m_Next = nullptr;
+	};
+
+	/// <summary>
+	/// Pool where Get and Free are lock-free and can be called from any thread, an object can be taken in one job and returned in another.
+	/// NON_RAII and does not support non-POD types, works like Pool.
+	/// Uses 4 extra bytes per element for the free list links, T has no minimum size.
+	/// The links are placed behind the objects, padded up to the alignment of the atomics.
+	/// </summary>
+	template<typename T>
+	class ConcurrentPool
+	{
+	public:
+		ConcurrentPool() {};
+#ifdef _DEBUG
+		~ConcurrentPool();
+#endif //_DEBUG
+
+		//Shared between threads, copying or moving it while in use is never safe.
+		ConcurrentPool(const ConcurrentPool&) = delete;
+		ConcurrentPool(ConcurrentPool&&) = delete;
+		ConcurrentPool& operator =(const ConcurrentPool&) = delete;
+		ConcurrentPool& operator =(ConcurrentPool&&) = delete;
+
+		void CreatePool(Allocator a_Allocator, const size_t a_Size);
+		void DestroyPool(Allocator a_Allocator);
+
+		/// <summary>
+		/// Get an object from the pool, returns nullptr if the pool is empty. Thread safe.
+		/// </summary>
+		T* Get();
+		/// <summary>
+		/// Return an object to the pool. Thread safe.
+		/// </summary>
+		void Free(T* a_Ptr);
+
+		T* data() const { return m_Start; }
+
+	private:
+		T* m_Start = nullptr;
+		size_t m_Capacity = 0;
+		ConcurrentFreeList m_FreeList;
+	};
+
+#ifdef _DEBUG
+	template<typename T>
+	inline ConcurrentPool<T>::~ConcurrentPool()
+	{
+		BB_ASSERT(m_Start == nullptr, "Memory pool was not destroyed before it went out of scope!");
+	}
+#endif //_DEBUG
+
+	template<typename T>
+	inline void ConcurrentPool<T>::CreatePool(Allocator a_Allocator, const size_t a_Size)
+	{
+		BB_ASSERT(m_Start == nullptr, "Trying to create a pool while one already exists!");
+		BB_ASSERT(a_Size != 0 && a_Size < UINT32_MAX, "ConcurrentPool size must be between 0 and UINT32_MAX.");
+
+		//Pad the objects so the links are aligned, T can have an odd size.
+		const size_t t_ObjectBytes = Math::RoundUp(a_Size * sizeof(T), alignof(std::atomic<uint32_t>));
+		m_Start = reinterpret_cast<T*>(BBalloc(a_Allocator, t_ObjectBytes + a_Size * sizeof(std::atomic<uint32_t>)));
+		m_Capacity = a_Size;
+		std::atomic<uint32_t>* t_Next = reinterpret_cast<std::atomic<uint32_t>*>(Pointer::Add(m_Start, t_ObjectBytes));
+		for (size_t i = 0; i < a_Size; i++)
+			new (&t_Next[i]) std::atomic<uint32_t>(0);
+
+		m_FreeList.Init(t_Next);
+		m_FreeList.LinkRange(0, static_cast<uint32_t>(a_Size));
+		m_FreeList.PushChain(0, static_cast<uint32_t>(a_Size - 1));
+	}
+
+	template<typename T>
+	inline void ConcurrentPool<T>::DestroyPool(Allocator a_Allocator)
+	{
+		BBfree(a_Allocator, reinterpret_cast<void*>(m_Start));
+		m_Start = nullptr;
+		m_Capacity = 0;
+	}
+
+	template<typename T>
+	inline T* ConcurrentPool<T>::Get()
+	{
+		uint32_t t_Index;
+		if (!m_FreeList.Pop(t_Index))
+		{
+			BB_WARNING(false, "Trying to get an pool object while there are none left!", WarningType::HIGH);
+			return nullptr;
+		}
+		return m_Start + t_Index;
+	}
+
+	template<typename T>
+	inline void ConcurrentPool<T>::Free(T* a_Ptr)
+	{
+		BB_ASSERT((a_Ptr >= m_Start && a_Ptr < m_Start + m_Capacity), "Trying to free an pool object that is not part of this pool!");
+		m_FreeList.Push(static_cast<uint32_t>(a_Ptr - m_Start));
+	}
+
+	/// <summary>
+	/// GrowPool where Get and Free are lock-free and can be called from any thread.
+	/// Getting from an empty pool commits more virtual memory, only one thread grows at a time while the others wait for it.
+	/// NON_RAII and does not support non-POD types, works like GrowPool.
+	/// </summary>
+	template<typename T>
+	class ConcurrentGrowPool
+	{
+	public:
+		ConcurrentGrowPool() {};
+#ifdef _DEBUG
+		~ConcurrentGrowPool();
+#endif //_DEBUG
+
+		//Shared between threads, copying or moving it while in use is never safe.
+		ConcurrentGrowPool(const ConcurrentGrowPool&) = delete;
+		ConcurrentGrowPool(ConcurrentGrowPool&&) = delete;
+		ConcurrentGrowPool& operator =(const ConcurrentGrowPool&) = delete;
+		ConcurrentGrowPool& operator =(ConcurrentGrowPool&&) = delete;
+
+		/// <summary>
+		/// Create a pool that can hold members equal to a_Size.
+		/// Will likely over allocate more due to how virtual memory paging works.
+		/// </summary>
+		void CreatePool(const size_t a_Size);
+		void DestroyPool();
+
+		/// <summary>
+		/// Get an object from the pool, grows the pool if it is empty. Thread safe.
+		/// </summary>
+		T* Get();
+		/// <summary>
+		/// Return an object to the pool. Thread safe.
+		/// </summary>
+		void Free(T* a_Ptr);
+
+	private:
+		//Commit more memory and push the new elements on the free list, a_ObjectBytes is the size of the newly committed memory.
+		void AddElements(const size_t a_ObjectBytes);
+		void Grow();
+
+		T* m_Start = nullptr;
+		std::atomic<uint32_t>* m_Next = nullptr;
+		size_t m_ObjectBytes = 0;
+		size_t m_NextBytes = 0;
+		std::atomic<size_t> m_Capacity{ 0 };
+		std::atomic<bool> m_Growing{ false };
+		ConcurrentFreeList m_FreeList;
+	};
+
+#ifdef _DEBUG
+	template<typename T>
+	inline ConcurrentGrowPool<T>::~ConcurrentGrowPool()
+	{
+		BB_ASSERT(m_Start == nullptr, "Memory pool was not destroyed before it went out of scope!");
+	}
+#endif //_DEBUG
+
+	template<typename T>
+	inline void ConcurrentGrowPool<T>::CreatePool(const size_t a_Size)
+	{
+		BB_ASSERT(m_Start == nullptr, "Trying to create a pool while one already exists!");
+
+		size_t t_AllocSize = a_Size * sizeof(T);
+		m_Start = reinterpret_cast<T*>(mallocVirtual(nullptr, t_AllocSize));
+		size_t t_NextSize = (t_AllocSize / sizeof(T)) * sizeof(std::atomic<uint32_t>);
+		m_Next = reinterpret_cast<std::atomic<uint32_t>*>(mallocVirtual(nullptr, t_NextSize));
+		m_NextBytes = t_NextSize;
+
+		m_FreeList.Init(m_Next);
+		AddElements(t_AllocSize);
+	}
+
+	template<typename T>
+	inline void ConcurrentGrowPool<T>::DestroyPool()
+	{
+		freeVirtual(m_Next);
+		freeVirtual(m_Start);
+		m_Start = nullptr;
+		m_Next = nullptr;
+		m_ObjectBytes = 0;
+		m_NextBytes = 0;
+		m_Capacity.store(0, std::memory_order_relaxed);
+	}
+
+	template<class T>
+	inline T* ConcurrentGrowPool<T>::Get()
+	{
+		uint32_t t_Index;
+		while (!m_FreeList.Pop(t_Index))
+			Grow();
+
+		return m_Start + t_Index;
+	}
+
+	template<typename T>
+	inline void ConcurrentGrowPool<T>::Free(T* a_Ptr)
+	{
+		BB_ASSERT((a_Ptr >= m_Start && a_Ptr < m_Start + m_Capacity.load(std::memory_order_acquire)), "Trying to free an pool object that is not part of this pool!");
+		m_FreeList.Push(static_cast<uint32_t>(a_Ptr - m_Start));
+	}
+
+	template<typename T>
+	inline void ConcurrentGrowPool<T>::AddElements(const size_t a_ObjectBytes)
+	{
+		//Elements can span the end of the old commit range, count from the total committed bytes.
+		const size_t t_OldCapacity = m_Capacity.load(std::memory_order_relaxed);
+		m_ObjectBytes += a_ObjectBytes;
+		const size_t t_NewCapacity = m_ObjectBytes / sizeof(T);
+		BB_ASSERT(t_NewCapacity < UINT32_MAX, "ConcurrentGrowPool, too many elements.");
+		if (t_NewCapacity == t_OldCapacity)
+			return;
+
+		while (m_NextBytes < t_NewCapacity * sizeof(std::atomic<uint32_t>))
+		{
+			size_t t_NextSize = t_NewCapacity * sizeof(std::atomic<uint32_t>) - m_NextBytes;
+			mallocVirtual(m_Next, t_NextSize);
+			m_NextBytes += t_NextSize;
+		}
+		for (size_t i = t_OldCapacity; i < t_NewCapacity; i++)
+			new (&m_Next[i]) std::atomic<uint32_t>(0);
+
+		m_FreeList.LinkRange(static_cast<uint32_t>(t_OldCapacity), static_cast<uint32_t>(t_NewCapacity));
+		m_Capacity.store(t_NewCapacity, std::memory_order_release);
+		m_FreeList.PushChain(static_cast<uint32_t>(t_OldCapacity), static_cast<uint32_t>(t_NewCapacity - 1));
+	}
+
+	template<typename T>
+	inline void ConcurrentGrowPool<T>::Grow()
+	{
+		if (m_Growing.exchange(true, std::memory_order_acquire))
+		{
+			//Another thread is growing, wait for it and try the free list again.
+			while (m_Growing.load(std::memory_order_acquire))
+				std::this_thread::yield();
+			return;
+		}
+
+		//Objects might have been freed while we waited for the flag.
+		if (m_FreeList.Empty())
+		{
+			BB_WARNING(false, "Growing the growpool, if this happens often try to reserve more.", WarningType::OPTIMALIZATION);
+			size_t t_AllocSize = 0;
+			mallocVirtual(m_Start, t_AllocSize);
+			AddElements(t_AllocSize);
+		}
+		m_Growing.store(false, std::memory_order_release);
+	}
+}
@@ -0,0 +1,287 @@
+#pragma once
+#include "Utils/Logger.h"
+#include "BBMemory.h"
+
+#include "Utils/Utils.h"
+#include "Storage/Slotmap.h"
+#include <atomic>
+
+namespace BB
+{
+	/// <summary>
+	/// Slotmap where emplace and erase are safe to call from many threads at the same time.
+	/// Handles come from a lock-free stack of free ids. Inserted objects are built in a staging area behind the dense objects,
+	/// erases are recorded and applied later. Both are merged into the dense array by sync(), which is the only
+	/// place where ids return to the free list, so a handle never gets reused while its object can still be reached.
+	/// The capacity does not grow while threads are working, reserve enough before the parallel phase.
+	/// </summary>
+	template <typename T>
+	class ConcurrentSlotmap
+	{
+		static constexpr bool trivialDestructible_T = std::is_trivially_destructible_v<T>;
+
+	public:
+		ConcurrentSlotmap(Allocator a_Allocator);
+		ConcurrentSlotmap(Allocator a_Allocator, const uint32_t a_Size);
+		~ConcurrentSlotmap();
+
+		//Shared between threads, copying or moving it while in use is never safe.
+		ConcurrentSlotmap(const ConcurrentSlotmap<T>&) = delete;
+		ConcurrentSlotmap(ConcurrentSlotmap<T>&&) = delete;
+		ConcurrentSlotmap<T>& operator=(const ConcurrentSlotmap<T>&) = delete;
+		ConcurrentSlotmap<T>& operator=(ConcurrentSlotmap<T>&&) = delete;
+
+		/// <summary>
+		/// Thread safe. The handle is valid right away, the object can be found after the next sync().
+		/// </summary>
+		SlotmapHandle insert(const T& a_Obj);
+		//Thread safe, see insert.
+		template <class... Args>
+		SlotmapHandle emplace(Args&&... a_Args);
+		/// <summary>
+		/// Thread safe. The object is destroyed and the handle becomes invalid at the next sync().
+		/// </summary>
+		void erase(const SlotmapHandle a_Handle);
+
+		/// <summary>
+		/// Not thread safe, call it when no thread is inserting or erasing.
+		/// Moves the staged objects into the dense array, then applies the erases.
+		/// </summary>
+		void sync();
+
+		//The functions below are not thread safe with insert, erase or sync.
+		T& operator[](const SlotmapHandle a_Handle) const { return find(a_Handle); }
+		T& find(const SlotmapHandle a_Handle) const;
+		bool contains(const SlotmapHandle a_Handle) const;
+
+		void reserve(const uint32_t a_Capacity);
+		void clear();
+
+		T* begin() const { return m_ObjArr; }
+		T* end() const { return m_ObjArr + m_Size; }
+
+		uint32_t size() const { return m_Size; }
+		uint32_t capacity() const { return m_Capacity; }
+		T* data() const { return m_ObjArr; }
+
+	private:
+		void CheckGen(const SlotmapHandle a_Handle) const;
+		//Removes the object of a_Handle by moving the last dense object into its place.
+		void EraseDense(const SlotmapHandle a_Handle);
+		//This function also changes the m_Capacity value.
+		void reallocate(const uint32_t a_NewCapacity);
+
+		Allocator m_Allocator;
+
+		//All arrays are m_Capacity long and share one allocation.
+		SlotmapHandle* m_IdArr = nullptr;
+		T* m_ObjArr = nullptr;
+		uint32_t* m_EraseArr = nullptr;
+		//Stack of free ids, the top is m_FreeCount - 1.
+		uint32_t* m_FreeIds = nullptr;
+		SlotmapHandle* m_PendingErases = nullptr;
+
+		uint32_t m_Capacity = 0;
+		uint32_t m_Size = 0;
+
+		//Only decrements between syncs, so popping an id needs no ABA protection.
+		alignas(64) std::atomic<uint32_t> m_FreeCount{ 0 };
+		alignas(64) std::atomic<uint32_t> m_StagedCount{ 0 };
+		alignas(64) std::atomic<uint32_t> m_PendingEraseCount{ 0 };
+	};
+
+	template<typename T>
+	inline BB::ConcurrentSlotmap<T>::ConcurrentSlotmap(Allocator a_Allocator)
+		: ConcurrentSlotmap(a_Allocator, Slotmap_Specs::standardSize)
+	{}
+
+	template<typename T>
+	inline BB::ConcurrentSlotmap<T>::ConcurrentSlotmap(Allocator a_Allocator, const uint32_t a_Size)
+		: m_Allocator(a_Allocator)
+	{
+		BB_ASSERT(a_Size != 0, "ConcurrentSlotmap size is specified to be 0");
+		reallocate(a_Size);
+	}
+
+	template<typename T>
+	inline BB::ConcurrentSlotmap<T>::~ConcurrentSlotmap()
+	{
+		clear();
+		BBfree(m_Allocator, m_IdArr);
+	}
+
+	template<typename T>
+	inline SlotmapHandle BB::ConcurrentSlotmap<T>::insert(const T& a_Obj)
+	{
+		return emplace(a_Obj);
+	}
+
+	template<typename T>
+	template<class ...Args>
+	inline SlotmapHandle BB::ConcurrentSlotmap<T>::emplace(Args&&... a_Args)
+	{
+		uint32_t t_FreeCount = m_FreeCount.load(std::memory_order_relaxed);
+		do
+		{
+			if (t_FreeCount == 0)
+			{
+				BB_ASSERT(false, "ConcurrentSlotmap, out of ids. Reserve more before inserting from multiple threads.");
+				return SlotmapHandle();
+			}
+		} while (!m_FreeCount.compare_exchange_weak(t_FreeCount, t_FreeCount - 1, std::memory_order_acquire, std::memory_order_relaxed));
+
+		//Every staged object owns an id, so the staging area can never pass m_Capacity.
+		const uint32_t t_DenseIndex = m_Size + m_StagedCount.fetch_add(1, std::memory_order_relaxed);
+
+		SlotmapHandle t_ID;
+		t_ID.index = m_FreeIds[t_FreeCount - 1];
+		t_ID.generation = m_IdArr[t_ID.index].generation;
+		m_IdArr[t_ID.index].index = t_DenseIndex;
+
+		new (&m_ObjArr[t_DenseIndex]) T(std::forward<Args>(a_Args)...);
+		m_EraseArr[t_DenseIndex] = t_ID.index;
+
+		return t_ID;
+	}
+
+	template<typename T>
+	inline void BB::ConcurrentSlotmap<T>::erase(const SlotmapHandle a_Handle)
+	{
+		CheckGen(a_Handle);
+		const uint32_t t_Pending = m_PendingEraseCount.fetch_add(1, std::memory_order_relaxed);
+		BB_ASSERT(t_Pending < m_Capacity, "ConcurrentSlotmap, more erases than objects. Likely means a handle was erased twice.");
+		m_PendingErases[t_Pending] = a_Handle;
+	}
+
+	template<typename T>
+	inline void BB::ConcurrentSlotmap<T>::sync()
+	{
+		m_Size += m_StagedCount.load(std::memory_order_acquire);
+		m_StagedCount.store(0, std::memory_order_relaxed);
+
+		const uint32_t t_PendingCount = m_PendingEraseCount.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < t_PendingCount; i++)
+			EraseDense(m_PendingErases[i]);
+		m_PendingEraseCount.store(0, std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	inline T& BB::ConcurrentSlotmap<T>::find(const SlotmapHandle a_Handle) const
+	{
+		CheckGen(a_Handle);
+		BB_ASSERT(m_IdArr[a_Handle.index].index < m_Size, "ConcurrentSlotmap, object is still staged, call sync first.");
+		return m_ObjArr[m_IdArr[a_Handle.index].index];
+	}
+
+	template<typename T>
+	inline bool BB::ConcurrentSlotmap<T>::contains(const SlotmapHandle a_Handle) const
+	{
+		return a_Handle.index < m_Capacity &&
+			m_IdArr[a_Handle.index].generation == a_Handle.generation &&
+			m_IdArr[a_Handle.index].index < m_Size;
+	}
+
+	template<typename T>
+	inline void BB::ConcurrentSlotmap<T>::reserve(const uint32_t a_Capacity)
+	{
+		BB_ASSERT(m_StagedCount.load(std::memory_order_relaxed) == 0 && m_PendingEraseCount.load(std::memory_order_relaxed) == 0,
+			"ConcurrentSlotmap, reserve called with unsynced inserts or erases.");
+		if (a_Capacity > m_Capacity)
+			reallocate(a_Capacity);
+	}
+
+	template<typename T>
+	inline void BB::ConcurrentSlotmap<T>::clear()
+	{
+		sync();
+		if constexpr (!trivialDestructible_T)
+		{
+			for (uint32_t i = 0; i < m_Size; i++)
+			{
+				m_ObjArr[i].~T();
+			}
+		}
+
+		//Every live handle becomes invalid and the id goes back on the free stack.
+		uint32_t t_FreeCount = m_FreeCount.load(std::memory_order_relaxed);
+		for (uint32_t i = 0; i < m_Size; i++)
+		{
+			++m_IdArr[m_EraseArr[i]].generation;
+			m_FreeIds[t_FreeCount++] = m_EraseArr[i];
+		}
+		m_FreeCount.store(t_FreeCount, std::memory_order_release);
+		m_Size = 0;
+	}
+
+	template<typename T>
+	inline void BB::ConcurrentSlotmap<T>::CheckGen(const SlotmapHandle a_Handle) const
+	{
+		BB_ASSERT(m_IdArr[a_Handle.index].generation == a_Handle.generation,
+			"ConcurrentSlotmap, Handle is from the wrong generation! Likely means this handle was already used to delete an element.");
+	}
+
+	template<typename T>
+	inline void BB::ConcurrentSlotmap<T>::EraseDense(const SlotmapHandle a_Handle)
+	{
+		CheckGen(a_Handle);
+		const uint32_t t_Index = m_IdArr[a_Handle.index].index;
+		const uint32_t t_Last = --m_Size;
+
+		if constexpr (!trivialDestructible_T)
+		{
+			m_ObjArr[t_Index].~T();
+		}
+		if (t_Index != t_Last)
+		{
+			Memory::Move(&m_ObjArr[t_Index], &m_ObjArr[t_Last], 1);
+			m_EraseArr[t_Index] = m_EraseArr[t_Last];
+			m_IdArr[m_EraseArr[t_Index]].index = t_Index;
+		}
+
+		//Increment the gen so the old handle fails the check, then free the id.
+		++m_IdArr[a_Handle.index].generation;
+		const uint32_t t_FreeCount = m_FreeCount.load(std::memory_order_relaxed);
+		m_FreeIds[t_FreeCount] = a_Handle.index;
+		m_FreeCount.store(t_FreeCount + 1, std::memory_order_release);
+	}
+
+	template<typename T>
+	inline void BB::ConcurrentSlotmap<T>::reallocate(const uint32_t a_NewCapacity)
+	{
+		BB_ASSERT(a_NewCapacity < UINT32_MAX, "ConcurrentSlotmap's too big! ConcurrentSlotmaps cannot be bigger then UINT32_MAX");
+
+		const size_t t_ElementSize = sizeof(SlotmapHandle) * 2 + sizeof(T) + sizeof(uint32_t) * 2;
+		SlotmapHandle* t_NewIdArr = reinterpret_cast<SlotmapHandle*>(BBalloc(m_Allocator, t_ElementSize * a_NewCapacity));
+		SlotmapHandle* t_NewPendingErases = reinterpret_cast<SlotmapHandle*>(Pointer::Add(t_NewIdArr, sizeof(SlotmapHandle) * a_NewCapacity));
+		T* t_NewObjArr = reinterpret_cast<T*>(Pointer::Add(t_NewPendingErases, sizeof(SlotmapHandle) * a_NewCapacity));
+		uint32_t* t_NewEraseArr = reinterpret_cast<uint32_t*>(Pointer::Add(t_NewObjArr, sizeof(T) * a_NewCapacity));
+		uint32_t* t_NewFreeIds = reinterpret_cast<uint32_t*>(Pointer::Add(t_NewEraseArr, sizeof(uint32_t) * a_NewCapacity));
+
+		uint32_t t_FreeCount = m_FreeCount.load(std::memory_order_relaxed);
+		if (m_IdArr != nullptr)
+		{
+			Memory::Copy(t_NewIdArr, m_IdArr, m_Capacity);
+			Memory::Move(t_NewObjArr, m_ObjArr, m_Size);
+			Memory::Copy(t_NewEraseArr, m_EraseArr, m_Size);
+			//The new ids go under the old free ids, the old ones get handed out first.
+			Memory::Copy(t_NewFreeIds + (a_NewCapacity - m_Capacity), m_FreeIds, t_FreeCount);
+			BBfree(m_Allocator, m_IdArr);
+		}
+
+		for (uint32_t i = m_Capacity; i < a_NewCapacity; i++)
+		{
+			t_NewIdArr[i].index = 0;
+			t_NewIdArr[i].generation = 1;
+			t_NewFreeIds[a_NewCapacity - 1 - i] = i;
+		}
+		t_FreeCount += a_NewCapacity - m_Capacity;
+
+		m_IdArr = t_NewIdArr;
+		m_PendingErases = t_NewPendingErases;
+		m_ObjArr = t_NewObjArr;
+		m_EraseArr = t_NewEraseArr;
+		m_FreeIds = t_NewFreeIds;
+		m_Capacity = a_NewCapacity;
+		m_FreeCount.store(t_FreeCount, std::memory_order_release);
+	}
+}
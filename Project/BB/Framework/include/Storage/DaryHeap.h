@@ -0,0 +1,454 @@
+#pragma once
+#include "Utils/Logger.h"
+#include "BBMemory.h"
+
+#include "Utils/Utils.h"
+#include "Utils/Slice.h"
+#include "Storage/Array.h"
+
+namespace BB
+{
+	namespace DaryHeap_Specs
+	{
+		//4 children per node, the children of a node share a cache line for small T and the tree is half as deep as a binary heap.
+		constexpr const size_t standardArity = 4;
+		constexpr const uint32_t INVALID_POSITION = UINT32_MAX;
+	};
+
+	using HeapHandle = uint32_t;
+
+	/// <summary>
+	/// Priority queue as a d-ary heap in a BB::Array, top() is the smallest element according to Compare.
+	/// Use a Compare that returns a > b for a max heap.
+	/// </summary>
+	template<typename T, size_t Arity = DaryHeap_Specs::standardArity, typename Compare = Standard_KeyLess<T>>
+	class DaryHeap
+	{
+		static_assert(Arity >= 2, "DaryHeap needs at least 2 children per node.");
+
+	public:
+		BB_TRIVIALLY_RELOCATABLE;
+
+		DaryHeap(Allocator a_Allocator) : m_Heap(a_Allocator) {}
+		DaryHeap(Allocator a_Allocator, const size_t a_Size) : m_Heap(a_Allocator, a_Size) {}
+
+		void push(const T& a_Element);
+		template <class... Args>
+		void emplace(Args&&... a_Args);
+
+		const T& top() const;
+		void pop();
+		/// <summary>
+		/// Pop up to a_Count elements in order into a_Out, returns the amount of elements popped.
+		/// </summary>
+		size_t pop_many(T* a_Out, const size_t a_Count);
+
+		/// <summary>
+		/// Replace the content of the heap with a_Elements in O(n), faster than pushing the elements one by one.
+		/// </summary>
+		void heapify(const Slice<const T> a_Elements);
+
+		void reserve(const size_t a_Size) { m_Heap.reserve(a_Size); }
+		void clear() { m_Heap.clear(); }
+
+		const size_t size() const { return m_Heap.size(); }
+		const bool empty() const { return m_Heap.size() == 0; }
+
+	private:
+		void SiftUp(size_t a_Position);
+		void SiftDown(size_t a_Position);
+
+		Array<T> m_Heap;
+	};
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::DaryHeap<T, Arity, Compare>::push(const T& a_Element)
+	{
+		emplace(a_Element);
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	template<class ...Args>
+	inline void BB::DaryHeap<T, Arity, Compare>::emplace(Args&&... a_Args)
+	{
+		m_Heap.emplace_back(std::forward<Args>(a_Args)...);
+		SiftUp(m_Heap.size() - 1);
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline const T& BB::DaryHeap<T, Arity, Compare>::top() const
+	{
+		BB_ASSERT(m_Heap.size() != 0, "DaryHeap, getting the top of an empty heap.");
+		return m_Heap[0];
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::DaryHeap<T, Arity, Compare>::pop()
+	{
+		BB_ASSERT(m_Heap.size() != 0, "DaryHeap, popping an empty heap.");
+		const size_t t_Last = m_Heap.size() - 1;
+		if (t_Last != 0)
+			m_Heap[0] = std::move(m_Heap[t_Last]);
+		m_Heap.pop();
+
+		if (m_Heap.size() > 1)
+			SiftDown(0);
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline size_t BB::DaryHeap<T, Arity, Compare>::pop_many(T* a_Out, const size_t a_Count)
+	{
+		size_t t_Popped = 0;
+		for (; t_Popped < a_Count && m_Heap.size() != 0; t_Popped++)
+		{
+			a_Out[t_Popped] = std::move(m_Heap[0]);
+			pop();
+		}
+		return t_Popped;
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::DaryHeap<T, Arity, Compare>::heapify(const Slice<const T> a_Elements)
+	{
+		m_Heap.clear();
+		m_Heap.append(a_Elements);
+		if (m_Heap.size() < 2)
+			return;
+
+		//Bottom up, every parent from the last one to the root sinks into place.
+		for (size_t i = (m_Heap.size() - 2) / Arity + 1; i > 0; i--)
+		{
+			SiftDown(i - 1);
+		}
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::DaryHeap<T, Arity, Compare>::SiftUp(size_t a_Position)
+	{
+		//Move parents down into the hole instead of swapping, the element is only written once.
+		T t_Element = std::move(m_Heap[a_Position]);
+		while (a_Position != 0)
+		{
+			const size_t t_Parent = (a_Position - 1) / Arity;
+			if (!Compare()(t_Element, m_Heap[t_Parent]))
+				break;
+			m_Heap[a_Position] = std::move(m_Heap[t_Parent]);
+			a_Position = t_Parent;
+		}
+		m_Heap[a_Position] = std::move(t_Element);
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::DaryHeap<T, Arity, Compare>::SiftDown(size_t a_Position)
+	{
+		const size_t t_Size = m_Heap.size();
+		T t_Element = std::move(m_Heap[a_Position]);
+		while (true)
+		{
+			const size_t t_FirstChild = a_Position * Arity + 1;
+			if (t_FirstChild >= t_Size)
+				break;
+
+			//The children are next to each other, find the smallest.
+			const size_t t_EndChild = t_FirstChild + Arity < t_Size ? t_FirstChild + Arity : t_Size;
+			size_t t_Best = t_FirstChild;
+			for (size_t t_Child = t_FirstChild + 1; t_Child < t_EndChild; t_Child++)
+			{
+				if (Compare()(m_Heap[t_Child], m_Heap[t_Best]))
+					t_Best = t_Child;
+			}
+
+			if (!Compare()(m_Heap[t_Best], t_Element))
+				break;
+			m_Heap[a_Position] = std::move(m_Heap[t_Best]);
+			a_Position = t_Best;
+		}
+		m_Heap[a_Position] = std::move(t_Element);
+	}
+
+	/// <summary>
+	/// DaryHeap that gives every element a handle, the handle can be used to change the priority or erase the element.
+	/// An index map from handle to heap position is kept up to date on every move, handles are reused after a pop or erase.
+	/// </summary>
+	template<typename T, size_t Arity = DaryHeap_Specs::standardArity, typename Compare = Standard_KeyLess<T>>
+	class IndexedDaryHeap
+	{
+		static_assert(Arity >= 2, "IndexedDaryHeap needs at least 2 children per node.");
+
+	public:
+		BB_TRIVIALLY_RELOCATABLE;
+
+		IndexedDaryHeap(Allocator a_Allocator)
+			: m_Heap(a_Allocator), m_HeapHandles(a_Allocator), m_Positions(a_Allocator), m_FreeHandles(a_Allocator) {}
+		IndexedDaryHeap(Allocator a_Allocator, const size_t a_Size)
+			: m_Heap(a_Allocator, a_Size), m_HeapHandles(a_Allocator, a_Size), m_Positions(a_Allocator, a_Size), m_FreeHandles(a_Allocator) {}
+
+		HeapHandle push(const T& a_Element);
+		template <class... Args>
+		HeapHandle emplace(Args&&... a_Args);
+
+		const T& top() const;
+		HeapHandle top_handle() const;
+		void pop();
+		/// <summary>
+		/// Pop up to a_Count elements in order into a_Out, returns the amount of elements popped.
+		/// </summary>
+		size_t pop_many(T* a_Out, const size_t a_Count);
+
+		/// <summary>
+		/// Replace the content of the heap with a_Elements in O(n), the element at index i gets handle i.
+		/// </summary>
+		void heapify(const Slice<const T> a_Elements);
+
+		const T& get(const HeapHandle a_Handle) const;
+		bool contains(const HeapHandle a_Handle) const;
+		/// <summary>
+		/// Give an element a smaller or equal priority value, the element only moves towards the top.
+		/// </summary>
+		void decrease_key(const HeapHandle a_Handle, const T& a_Element);
+		//Change the priority value in any direction.
+		void update(const HeapHandle a_Handle, const T& a_Element);
+		void erase(const HeapHandle a_Handle);
+
+		void clear();
+
+		const size_t size() const { return m_Heap.size(); }
+		const bool empty() const { return m_Heap.size() == 0; }
+
+	private:
+		HeapHandle AllocateHandle();
+		//Removes the element at a_Position and frees its handle.
+		void RemoveAt(const size_t a_Position);
+		//Puts the element that now lives at a_Position on the right spot, up or down.
+		void Restore(const size_t a_Position);
+		void SiftUp(size_t a_Position);
+		void SiftDown(size_t a_Position);
+
+		//m_Heap[i] belongs to m_HeapHandles[i], m_Positions[handle] is the heap position of a handle.
+		Array<T> m_Heap;
+		Array<HeapHandle> m_HeapHandles;
+		Array<uint32_t> m_Positions;
+		Array<HeapHandle> m_FreeHandles;
+	};
+
+	template<typename T, size_t Arity, typename Compare>
+	inline HeapHandle BB::IndexedDaryHeap<T, Arity, Compare>::push(const T& a_Element)
+	{
+		return emplace(a_Element);
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	template<class ...Args>
+	inline HeapHandle BB::IndexedDaryHeap<T, Arity, Compare>::emplace(Args&&... a_Args)
+	{
+		const HeapHandle t_Handle = AllocateHandle();
+		const size_t t_Position = m_Heap.size();
+		m_Heap.emplace_back(std::forward<Args>(a_Args)...);
+		m_HeapHandles.emplace_back(t_Handle);
+		m_Positions[t_Handle] = static_cast<uint32_t>(t_Position);
+
+		SiftUp(t_Position);
+		return t_Handle;
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline const T& BB::IndexedDaryHeap<T, Arity, Compare>::top() const
+	{
+		BB_ASSERT(m_Heap.size() != 0, "IndexedDaryHeap, getting the top of an empty heap.");
+		return m_Heap[0];
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline HeapHandle BB::IndexedDaryHeap<T, Arity, Compare>::top_handle() const
+	{
+		BB_ASSERT(m_Heap.size() != 0, "IndexedDaryHeap, getting the top of an empty heap.");
+		return m_HeapHandles[0];
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::IndexedDaryHeap<T, Arity, Compare>::pop()
+	{
+		BB_ASSERT(m_Heap.size() != 0, "IndexedDaryHeap, popping an empty heap.");
+		RemoveAt(0);
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline size_t BB::IndexedDaryHeap<T, Arity, Compare>::pop_many(T* a_Out, const size_t a_Count)
+	{
+		size_t t_Popped = 0;
+		for (; t_Popped < a_Count && m_Heap.size() != 0; t_Popped++)
+		{
+			a_Out[t_Popped] = std::move(m_Heap[0]);
+			RemoveAt(0);
+		}
+		return t_Popped;
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::IndexedDaryHeap<T, Arity, Compare>::heapify(const Slice<const T> a_Elements)
+	{
+		clear();
+		m_Heap.append(a_Elements);
+		m_HeapHandles.resize(a_Elements.size());
+		m_Positions.resize(a_Elements.size());
+		for (size_t i = 0; i < a_Elements.size(); i++)
+		{
+			m_HeapHandles[i] = static_cast<HeapHandle>(i);
+			m_Positions[i] = static_cast<uint32_t>(i);
+		}
+		if (m_Heap.size() < 2)
+			return;
+
+		//Bottom up, every parent from the last one to the root sinks into place.
+		for (size_t i = (m_Heap.size() - 2) / Arity + 1; i > 0; i--)
+		{
+			SiftDown(i - 1);
+		}
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline const T& BB::IndexedDaryHeap<T, Arity, Compare>::get(const HeapHandle a_Handle) const
+	{
+		BB_ASSERT(contains(a_Handle), "IndexedDaryHeap, handle is not in the heap.");
+		return m_Heap[m_Positions[a_Handle]];
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline bool BB::IndexedDaryHeap<T, Arity, Compare>::contains(const HeapHandle a_Handle) const
+	{
+		return a_Handle < m_Positions.size() && m_Positions[a_Handle] != DaryHeap_Specs::INVALID_POSITION;
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::IndexedDaryHeap<T, Arity, Compare>::decrease_key(const HeapHandle a_Handle, const T& a_Element)
+	{
+		BB_ASSERT(contains(a_Handle), "IndexedDaryHeap, handle is not in the heap.");
+		const size_t t_Position = m_Positions[a_Handle];
+		BB_ASSERT(!Compare()(m_Heap[t_Position], a_Element), "IndexedDaryHeap, decrease_key with a bigger value, use update instead.");
+		m_Heap[t_Position] = a_Element;
+		SiftUp(t_Position);
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::IndexedDaryHeap<T, Arity, Compare>::update(const HeapHandle a_Handle, const T& a_Element)
+	{
+		BB_ASSERT(contains(a_Handle), "IndexedDaryHeap, handle is not in the heap.");
+		const size_t t_Position = m_Positions[a_Handle];
+		m_Heap[t_Position] = a_Element;
+		Restore(t_Position);
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::IndexedDaryHeap<T, Arity, Compare>::erase(const HeapHandle a_Handle)
+	{
+		BB_ASSERT(contains(a_Handle), "IndexedDaryHeap, handle is not in the heap.");
+		RemoveAt(m_Positions[a_Handle]);
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::IndexedDaryHeap<T, Arity, Compare>::clear()
+	{
+		m_Heap.clear();
+		m_HeapHandles.clear();
+		m_Positions.clear();
+		m_FreeHandles.clear();
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline HeapHandle BB::IndexedDaryHeap<T, Arity, Compare>::AllocateHandle()
+	{
+		if (m_FreeHandles.size() != 0)
+		{
+			const HeapHandle t_Handle = m_FreeHandles[m_FreeHandles.size() - 1];
+			m_FreeHandles.pop();
+			return t_Handle;
+		}
+
+		BB_ASSERT(m_Positions.size() < DaryHeap_Specs::INVALID_POSITION, "IndexedDaryHeap, ran out of handles.");
+		m_Positions.emplace_back(DaryHeap_Specs::INVALID_POSITION);
+		return static_cast<HeapHandle>(m_Positions.size() - 1);
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::IndexedDaryHeap<T, Arity, Compare>::RemoveAt(const size_t a_Position)
+	{
+		const HeapHandle t_Handle = m_HeapHandles[a_Position];
+		m_Positions[t_Handle] = DaryHeap_Specs::INVALID_POSITION;
+		m_FreeHandles.emplace_back(t_Handle);
+
+		//The last element fills the hole and then finds its spot.
+		const size_t t_Last = m_Heap.size() - 1;
+		if (a_Position != t_Last)
+		{
+			m_Heap[a_Position] = std::move(m_Heap[t_Last]);
+			m_HeapHandles[a_Position] = m_HeapHandles[t_Last];
+			m_Positions[m_HeapHandles[a_Position]] = static_cast<uint32_t>(a_Position);
+		}
+		m_Heap.pop();
+		m_HeapHandles.pop();
+
+		if (a_Position < m_Heap.size())
+			Restore(a_Position);
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::IndexedDaryHeap<T, Arity, Compare>::Restore(const size_t a_Position)
+	{
+		if (a_Position != 0 && Compare()(m_Heap[a_Position], m_Heap[(a_Position - 1) / Arity]))
+			SiftUp(a_Position);
+		else
+			SiftDown(a_Position);
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::IndexedDaryHeap<T, Arity, Compare>::SiftUp(size_t a_Position)
+	{
+		T t_Element = std::move(m_Heap[a_Position]);
+		const HeapHandle t_Handle = m_HeapHandles[a_Position];
+		while (a_Position != 0)
+		{
+			const size_t t_Parent = (a_Position - 1) / Arity;
+			if (!Compare()(t_Element, m_Heap[t_Parent]))
+				break;
+			m_Heap[a_Position] = std::move(m_Heap[t_Parent]);
+			m_HeapHandles[a_Position] = m_HeapHandles[t_Parent];
+			m_Positions[m_HeapHandles[a_Position]] = static_cast<uint32_t>(a_Position);
+			a_Position = t_Parent;
+		}
+		m_Heap[a_Position] = std::move(t_Element);
+		m_HeapHandles[a_Position] = t_Handle;
+		m_Positions[t_Handle] = static_cast<uint32_t>(a_Position);
+	}
+
+	template<typename T, size_t Arity, typename Compare>
+	inline void BB::IndexedDaryHeap<T, Arity, Compare>::SiftDown(size_t a_Position)
+	{
+		const size_t t_Size = m_Heap.size();
+		T t_Element = std::move(m_Heap[a_Position]);
+		const HeapHandle t_Handle = m_HeapHandles[a_Position];
+		while (true)
+		{
+			const size_t t_FirstChild = a_Position * Arity + 1;
+			if (t_FirstChild >= t_Size)
+				break;
+
+			const size_t t_EndChild = t_FirstChild + Arity < t_Size ? t_FirstChild + Arity : t_Size;
+			size_t t_Best = t_FirstChild;
+			for (size_t t_Child = t_FirstChild + 1; t_Child < t_EndChild; t_Child++)
+			{
+				if (Compare()(m_Heap[t_Child], m_Heap[t_Best]))
+					t_Best = t_Child;
+			}
+
+			if (!Compare()(m_Heap[t_Best], t_Element))
+				break;
+			m_Heap[a_Position] = std::move(m_Heap[t_Best]);
+			m_HeapHandles[a_Position] = m_HeapHandles[t_Best];
+			m_Positions[m_HeapHandles[a_Position]] = static_cast<uint32_t>(a_Position);
+			a_Position = t_Best;
+		}
+		m_Heap[a_Position] = std::move(t_Element);
+		m_HeapHandles[a_Position] = t_Handle;
+		m_Positions[t_Handle] = static_cast<uint32_t>(a_Position);
+	}
+}
@@ -0,0 +1,555 @@
+#pragma once
+#include "Utils/Logger.h"
+#include "BBMemory.h"
+
+#include "Utils/Utils.h"
+#include "Utils/Slice.h"
+#include <algorithm>
+
+namespace BB
+{
+	namespace FlatMap_Specs
+	{
+		constexpr const size_t standardSize = 16;
+		constexpr const size_t cacheLineSize = 64;
+	};
+
+	/// <summary>
+	/// Map that keeps its keys sorted in one array and the values in a second array with the same order.
+	/// Lookups are a branchless binary search over the keys only, iteration and range queries go in key order.
+	/// With set_eytzinger(true) a copy of the keys in breadth first (Eytzinger) order is kept for the lookups,
+	/// the top levels of the search then share cache lines and the next levels are prefetched while searching.
+	/// Insert and erase move the elements after them, use build to add many elements with a single sort.
+	/// </summary>
+	template<typename Key, typename Value, typename KeyLess = Standard_KeyLess<Key>>
+	class FlatMap
+	{
+		static constexpr bool trivialDestructible_Key = std::is_trivially_destructible_v<Key>;
+		static constexpr bool trivialDestructible_Value = std::is_trivially_destructible_v<Value>;
+		//The descendants of a node some levels down sit next to each other in the eytzinger layout,
+		//the search prefetches the level where they fill a single cache line.
+		static constexpr size_t PrefetchNodes()
+		{
+			size_t t_Nodes = 1;
+			while (t_Nodes * 2 * sizeof(Key) <= FlatMap_Specs::cacheLineSize)
+				t_Nodes *= 2;
+			return t_Nodes;
+		}
+		static constexpr size_t prefetchNodes = PrefetchNodes();
+
+	public:
+		BB_TRIVIALLY_RELOCATABLE;
+
+		struct Pair
+		{
+			const Key* key;
+			Value* value;
+		};
+
+		//Goes over the elements in key order, invalidated by an insert, erase or build.
+		struct Iterator
+		{
+			Iterator(const FlatMap* a_Map, const size_t a_Index) : m_Map(a_Map), m_Index(a_Index) {}
+
+			Pair operator*() const { return Pair{ &m_Map->m_Keys[m_Index], &m_Map->m_Values[m_Index] }; }
+
+			Iterator& operator++()
+			{
+				m_Index++;
+				return *this;
+			}
+
+			Iterator operator++(int)
+			{
+				Iterator t_Tmp = *this;
+				++(*this);
+				return t_Tmp;
+			}
+
+			friend bool operator== (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Index == a_Rhs.m_Index; };
+			friend bool operator!= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Index != a_Rhs.m_Index; };
+
+		private:
+			const FlatMap* m_Map;
+			size_t m_Index;
+		};
+
+		//The elements of a range query, keys[i] belongs to values[i].
+		struct Range
+		{
+			Slice<const Key> keys;
+			Slice<Value> values;
+		};
+
+		FlatMap(Allocator a_Allocator);
+		FlatMap(Allocator a_Allocator, const size_t a_Size);
+		FlatMap(const FlatMap<Key, Value, KeyLess>& a_Map);
+		FlatMap(FlatMap<Key, Value, KeyLess>&& a_Map) noexcept;
+		~FlatMap();
+
+		FlatMap<Key, Value, KeyLess>& operator=(const FlatMap<Key, Value, KeyLess>& a_Rhs);
+		FlatMap<Key, Value, KeyLess>& operator=(FlatMap<Key, Value, KeyLess>&& a_Rhs) noexcept;
+
+		//Overwrites the value if the key is already in the map.
+		void insert(const Key& a_Key, const Value& a_Value);
+		//Overwrites the value if the key is already in the map.
+		template <class... Args>
+		Value& emplace(const Key& a_Key, Args&&... a_ValueArgs);
+		/// <summary>
+		/// Add a_Count elements with a single sort at the end instead of moving elements for every insert.
+		/// When a key is given more than once, or is already in the map, the last given value is kept.
+		/// </summary>
+		void build(const Key* a_Keys, const Value* a_Values, const size_t a_Count);
+
+		Value* find(const Key& a_Key) const;
+		void erase(const Key& a_Key);
+		void clear();
+		void reserve(const size_t a_Size);
+
+		/// <summary>
+		/// Index in key order of the first key that is not smaller than a_Key, size() if there is none.
+		/// </summary>
+		size_t lower_bound(const Key& a_Key) const;
+		//All elements with a_Min <= key < a_Max.
+		Range range(const Key& a_Min, const Key& a_Max) const;
+
+		/// <summary>
+		/// Keep a breadth first copy of the keys for the lookups. Costs a copy of the keys and a rebuild on every change,
+		/// worth it for bigger maps that are searched a lot more than they change.
+		/// </summary>
+		void set_eytzinger(const bool a_Eytzinger);
+
+		const Key& key(const size_t a_Index) const { BB_ASSERT(a_Index < m_Size, "FlatMap, index out of bounds."); return m_Keys[a_Index]; }
+		Value& value(const size_t a_Index) const { BB_ASSERT(a_Index < m_Size, "FlatMap, index out of bounds."); return m_Values[a_Index]; }
+		Slice<const Key> keys() const { return Slice<const Key>(m_Keys, m_Size); }
+		Slice<Value> values() const { return Slice<Value>(m_Values, m_Size); }
+
+		size_t size() const { return m_Size; }
+		size_t capacity() const { return m_Capacity; }
+
+		Iterator begin() const { return Iterator(this, 0); }
+		Iterator end() const { return Iterator(this, m_Size); }
+
+	private:
+		//Sorts an index list by the keys it points to.
+		struct IndexLess
+		{
+			const Key* keys;
+			bool operator()(const size_t a_A, const size_t a_B) const { return KeyLess()(keys[a_A], keys[a_B]); }
+		};
+
+		//This function also changes the m_Capacity value.
+		void reallocate(const size_t a_NewCapacity);
+		//Sorts m_Keys and m_Values and removes duplicate keys, the later element of a duplicate is kept.
+		void SortAndMerge();
+		size_t SortedLowerBound(const Key& a_Key) const;
+		size_t EytzingerLowerBound(const Key& a_Key) const;
+		void BuildSearchIndex();
+		//Fills the eytzinger tree in order, returns the next sorted index.
+		size_t FillEytzinger(size_t a_SortedIndex, const size_t a_Node);
+		void FreeSearchIndex();
+		void CopyFrom(const FlatMap<Key, Value, KeyLess>& a_Map);
+		void MoveFrom(FlatMap<Key, Value, KeyLess>& a_Map);
+		//Destroys the elements and frees all memory, back to an empty FlatMap.
+		void Release();
+
+		Allocator m_Allocator;
+
+		Key* m_Keys = nullptr;
+		Value* m_Values = nullptr;
+		size_t m_Size = 0;
+		size_t m_Capacity = 0;
+
+		//Eytzinger search index, node 0 is unused and the children of node i are 2i and 2i + 1.
+		bool m_Eytzinger = false;
+		Key* m_SearchKeys = nullptr;
+		//Sorted index of every node, node 0 holds m_Size for a key bigger than all keys.
+		uint32_t* m_SearchIndices = nullptr;
+	};
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline BB::FlatMap<Key, Value, KeyLess>::FlatMap(Allocator a_Allocator)
+		: FlatMap(a_Allocator, FlatMap_Specs::standardSize)
+	{}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline BB::FlatMap<Key, Value, KeyLess>::FlatMap(Allocator a_Allocator, const size_t a_Size)
+		: m_Allocator(a_Allocator)
+	{
+		reallocate(a_Size);
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline BB::FlatMap<Key, Value, KeyLess>::FlatMap(const FlatMap<Key, Value, KeyLess>& a_Map)
+		: m_Allocator(a_Map.m_Allocator)
+	{
+		CopyFrom(a_Map);
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline BB::FlatMap<Key, Value, KeyLess>::FlatMap(FlatMap<Key, Value, KeyLess>&& a_Map) noexcept
+		: m_Allocator(a_Map.m_Allocator)
+	{
+		MoveFrom(a_Map);
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline BB::FlatMap<Key, Value, KeyLess>::~FlatMap()
+	{
+		Release();
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline FlatMap<Key, Value, KeyLess>& BB::FlatMap<Key, Value, KeyLess>::operator=(const FlatMap<Key, Value, KeyLess>& a_Rhs)
+	{
+		Release();
+
+		m_Allocator = a_Rhs.m_Allocator;
+		CopyFrom(a_Rhs);
+
+		return *this;
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline FlatMap<Key, Value, KeyLess>& BB::FlatMap<Key, Value, KeyLess>::operator=(FlatMap<Key, Value, KeyLess>&& a_Rhs) noexcept
+	{
+		Release();
+
+		m_Allocator = a_Rhs.m_Allocator;
+		MoveFrom(a_Rhs);
+
+		return *this;
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline void BB::FlatMap<Key, Value, KeyLess>::insert(const Key& a_Key, const Value& a_Value)
+	{
+		emplace(a_Key, a_Value);
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	template<class ...Args>
+	inline Value& BB::FlatMap<Key, Value, KeyLess>::emplace(const Key& a_Key, Args&&... a_ValueArgs)
+	{
+		const size_t t_Index = lower_bound(a_Key);
+		if (t_Index < m_Size && !KeyLess()(a_Key, m_Keys[t_Index]))
+		{
+			if constexpr (!trivialDestructible_Value)
+			{
+				m_Values[t_Index].~Value();
+			}
+			return *new (&m_Values[t_Index]) Value(std::forward<Args>(a_ValueArgs)...);
+		}
+
+		if (m_Size == m_Capacity)
+			reallocate(m_Capacity == 0 ? FlatMap_Specs::standardSize : m_Capacity * 2);
+
+		//Make a hole at t_Index to keep the keys sorted.
+		Memory::sMove(m_Keys + t_Index + 1, m_Keys + t_Index, m_Size - t_Index);
+		Memory::sMove(m_Values + t_Index + 1, m_Values + t_Index, m_Size - t_Index);
+		new (&m_Keys[t_Index]) Key(a_Key);
+		Value* t_Value = new (&m_Values[t_Index]) Value(std::forward<Args>(a_ValueArgs)...);
+		++m_Size;
+
+		if (m_Eytzinger)
+			BuildSearchIndex();
+		return *t_Value;
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline void BB::FlatMap<Key, Value, KeyLess>::build(const Key* a_Keys, const Value* a_Values, const size_t a_Count)
+	{
+		reserve(m_Size + a_Count);
+		Memory::Copy<Key>(m_Keys + m_Size, a_Keys, a_Count);
+		Memory::Copy<Value>(m_Values + m_Size, a_Values, a_Count);
+		m_Size += a_Count;
+
+		SortAndMerge();
+		if (m_Eytzinger)
+			BuildSearchIndex();
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline Value* BB::FlatMap<Key, Value, KeyLess>::find(const Key& a_Key) const
+	{
+		const size_t t_Index = lower_bound(a_Key);
+		if (t_Index < m_Size && !KeyLess()(a_Key, m_Keys[t_Index]))
+			return &m_Values[t_Index];
+		return nullptr;
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline void BB::FlatMap<Key, Value, KeyLess>::erase(const Key& a_Key)
+	{
+		const size_t t_Index = lower_bound(a_Key);
+		if (t_Index == m_Size || KeyLess()(a_Key, m_Keys[t_Index]))
+			return;
+
+		if constexpr (!trivialDestructible_Key)
+		{
+			m_Keys[t_Index].~Key();
+		}
+		if constexpr (!trivialDestructible_Value)
+		{
+			m_Values[t_Index].~Value();
+		}
+		Memory::sMove(m_Keys + t_Index, m_Keys + t_Index + 1, m_Size - t_Index - 1);
+		Memory::sMove(m_Values + t_Index, m_Values + t_Index + 1, m_Size - t_Index - 1);
+		--m_Size;
+
+		if (m_Eytzinger)
+			BuildSearchIndex();
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline void BB::FlatMap<Key, Value, KeyLess>::clear()
+	{
+		for (size_t i = 0; i < m_Size; i++)
+		{
+			if constexpr (!trivialDestructible_Key)
+			{
+				m_Keys[i].~Key();
+			}
+			if constexpr (!trivialDestructible_Value)
+			{
+				m_Values[i].~Value();
+			}
+		}
+		m_Size = 0;
+
+		if (m_Eytzinger)
+			BuildSearchIndex();
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline void BB::FlatMap<Key, Value, KeyLess>::reserve(const size_t a_Size)
+	{
+		if (a_Size > m_Capacity)
+			reallocate(a_Size);
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline size_t BB::FlatMap<Key, Value, KeyLess>::lower_bound(const Key& a_Key) const
+	{
+		if (m_Eytzinger)
+			return EytzingerLowerBound(a_Key);
+		return SortedLowerBound(a_Key);
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline typename FlatMap<Key, Value, KeyLess>::Range BB::FlatMap<Key, Value, KeyLess>::range(const Key& a_Min, const Key& a_Max) const
+	{
+		const size_t t_Begin = lower_bound(a_Min);
+		size_t t_End = lower_bound(a_Max);
+		if (t_End < t_Begin)
+			t_End = t_Begin;
+
+		Range t_Range;
+		t_Range.keys = Slice<const Key>(m_Keys + t_Begin, t_End - t_Begin);
+		t_Range.values = Slice<Value>(m_Values + t_Begin, t_End - t_Begin);
+		return t_Range;
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline void BB::FlatMap<Key, Value, KeyLess>::set_eytzinger(const bool a_Eytzinger)
+	{
+		m_Eytzinger = a_Eytzinger;
+		if (m_Eytzinger)
+			BuildSearchIndex();
+		else
+			FreeSearchIndex();
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline void BB::FlatMap<Key, Value, KeyLess>::reallocate(const size_t a_NewCapacity)
+	{
+		Key* t_NewKeys = reinterpret_cast<Key*>(BBalloc(m_Allocator, a_NewCapacity * sizeof(Key)));
+		Value* t_NewValues = reinterpret_cast<Value*>(BBalloc(m_Allocator, a_NewCapacity * sizeof(Value)));
+		if (m_Keys != nullptr)
+		{
+			Memory::Move(t_NewKeys, m_Keys, m_Size);
+			Memory::Move(t_NewValues, m_Values, m_Size);
+			BBfree(m_Allocator, reinterpret_cast<void*>(m_Keys));
+			BBfree(m_Allocator, reinterpret_cast<void*>(m_Values));
+		}
+
+		m_Keys = t_NewKeys;
+		m_Values = t_NewValues;
+		m_Capacity = a_NewCapacity;
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline void BB::FlatMap<Key, Value, KeyLess>::SortAndMerge()
+	{
+		if (m_Size < 2)
+			return;
+
+		//Sort indices instead of the elements so keys and values move only once.
+		//stable_sort keeps duplicates in the order they were added.
+		size_t* t_Order = reinterpret_cast<size_t*>(BBalloc(m_Allocator, m_Size * sizeof(size_t)));
+		for (size_t i = 0; i < m_Size; i++)
+			t_Order[i] = i;
+		std::stable_sort(t_Order, t_Order + m_Size, IndexLess{ m_Keys });
+
+		Key* t_NewKeys = reinterpret_cast<Key*>(BBalloc(m_Allocator, m_Capacity * sizeof(Key)));
+		Value* t_NewValues = reinterpret_cast<Value*>(BBalloc(m_Allocator, m_Capacity * sizeof(Value)));
+		size_t t_NewSize = 0;
+		for (size_t i = 0; i < m_Size; i++)
+		{
+			const size_t t_Index = t_Order[i];
+			//Only the last of equal keys survives.
+			const bool t_Duplicate = i + 1 < m_Size && !KeyLess()(m_Keys[t_Index], m_Keys[t_Order[i + 1]]);
+			if (t_Duplicate)
+			{
+				if constexpr (!trivialDestructible_Key)
+				{
+					m_Keys[t_Index].~Key();
+				}
+				if constexpr (!trivialDestructible_Value)
+				{
+					m_Values[t_Index].~Value();
+				}
+				continue;
+			}
+			Memory::Move(t_NewKeys + t_NewSize, m_Keys + t_Index, 1);
+			Memory::Move(t_NewValues + t_NewSize, m_Values + t_Index, 1);
+			++t_NewSize;
+		}
+
+		BBfree(m_Allocator, reinterpret_cast<void*>(t_Order));
+		BBfree(m_Allocator, reinterpret_cast<void*>(m_Keys));
+		BBfree(m_Allocator, reinterpret_cast<void*>(m_Values));
+		m_Keys = t_NewKeys;
+		m_Values = t_NewValues;
+		m_Size = t_NewSize;
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline size_t BB::FlatMap<Key, Value, KeyLess>::SortedLowerBound(const Key& a_Key) const
+	{
+		if (m_Size == 0)
+			return 0;
+
+		//Branchless, the select compiles to a conditional move so there is no misprediction per level.
+		const Key* t_Base = m_Keys;
+		size_t t_Count = m_Size;
+		while (t_Count > 1)
+		{
+			const size_t t_Half = t_Count / 2;
+			t_Base = KeyLess()(t_Base[t_Half], a_Key) ? t_Base + t_Half : t_Base;
+			t_Count -= t_Half;
+		}
+		return static_cast<size_t>(t_Base - m_Keys) + KeyLess()(*t_Base, a_Key);
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline size_t BB::FlatMap<Key, Value, KeyLess>::EytzingerLowerBound(const Key& a_Key) const
+	{
+		size_t t_Node = 1;
+		while (t_Node <= m_Size)
+		{
+			Memory::Prefetch(m_SearchKeys + t_Node * prefetchNodes);
+			t_Node = 2 * t_Node + KeyLess()(m_SearchKeys[t_Node], a_Key);
+		}
+		//The path ends with a run of right turns after the last left turn, the node of that left turn is the answer.
+		//No left turn means every key is smaller, t_Node becomes 0.
+		t_Node >>= Math::CountTrailingZeros(~t_Node) + 1;
+		return m_SearchIndices[t_Node];
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline void BB::FlatMap<Key, Value, KeyLess>::BuildSearchIndex()
+	{
+		BB_ASSERT(m_Size < UINT32_MAX, "FlatMap, too many elements for the eytzinger search index.");
+		FreeSearchIndex();
+
+		m_SearchKeys = reinterpret_cast<Key*>(BBalloc(m_Allocator, (m_Size + 1) * sizeof(Key)));
+		m_SearchIndices = reinterpret_cast<uint32_t*>(BBalloc(m_Allocator, (m_Size + 1) * sizeof(uint32_t)));
+		m_SearchIndices[0] = static_cast<uint32_t>(m_Size);
+		FillEytzinger(0, 1);
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline size_t BB::FlatMap<Key, Value, KeyLess>::FillEytzinger(size_t a_SortedIndex, const size_t a_Node)
+	{
+		if (a_Node > m_Size)
+			return a_SortedIndex;
+
+		//In order walk, left subtree, this node, right subtree.
+		a_SortedIndex = FillEytzinger(a_SortedIndex, 2 * a_Node);
+		new (&m_SearchKeys[a_Node]) Key(m_Keys[a_SortedIndex]);
+		m_SearchIndices[a_Node] = static_cast<uint32_t>(a_SortedIndex);
+		return FillEytzinger(a_SortedIndex + 1, 2 * a_Node + 1);
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline void BB::FlatMap<Key, Value, KeyLess>::FreeSearchIndex()
+	{
+		if (m_SearchKeys == nullptr)
+			return;
+
+		if constexpr (!trivialDestructible_Key)
+		{
+			//The search index was built for the size it had, rebuilding always happens after a size change.
+			for (size_t i = 1; i <= m_SearchIndices[0]; i++)
+			{
+				m_SearchKeys[i].~Key();
+			}
+		}
+		BBfree(m_Allocator, reinterpret_cast<void*>(m_SearchKeys));
+		BBfree(m_Allocator, m_SearchIndices);
+		m_SearchKeys = nullptr;
+		m_SearchIndices = nullptr;
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline void BB::FlatMap<Key, Value, KeyLess>::CopyFrom(const FlatMap<Key, Value, KeyLess>& a_Map)
+	{
+		reallocate(a_Map.m_Capacity);
+		Memory::Copy<Key>(m_Keys, a_Map.m_Keys, a_Map.m_Size);
+		Memory::Copy<Value>(m_Values, a_Map.m_Values, a_Map.m_Size);
+		m_Size = a_Map.m_Size;
+
+		m_Eytzinger = a_Map.m_Eytzinger;
+		if (m_Eytzinger)
+			BuildSearchIndex();
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline void BB::FlatMap<Key, Value, KeyLess>::MoveFrom(FlatMap<Key, Value, KeyLess>& a_Map)
+	{
+		m_Keys = a_Map.m_Keys;
+		m_Values = a_Map.m_Values;
+		m_Size = a_Map.m_Size;
+		m_Capacity = a_Map.m_Capacity;
+		m_Eytzinger = a_Map.m_Eytzinger;
+		m_SearchKeys = a_Map.m_SearchKeys;
+		m_SearchIndices = a_Map.m_SearchIndices;
+
+		a_Map.m_Keys = nullptr;
+		a_Map.m_Values = nullptr;
+		a_Map.m_Size = 0;
+		a_Map.m_Capacity = 0;
+		a_Map.m_Eytzinger = false;
+		a_Map.m_SearchKeys = nullptr;
+		a_Map.m_SearchIndices = nullptr;
+	}
+
+	template<typename Key, typename Value, typename KeyLess>
+	inline void BB::FlatMap<Key, Value, KeyLess>::Release()
+	{
+		//Turned off first so that clear does not build a new search index.
+		m_Eytzinger = false;
+		FreeSearchIndex();
+		if (m_Keys == nullptr)
+			return;
+
+		clear();
+		BBfree(m_Allocator, reinterpret_cast<void*>(m_Keys));
+		BBfree(m_Allocator, reinterpret_cast<void*>(m_Values));
+
+		m_Keys = nullptr;
+		m_Values = nullptr;
+		m_Capacity = 0;
+	}
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include "Utils/Logger.h"
 #include "Allocators/BackingAllocator.h"
+#include "Storage/Pool.h"
 
 namespace BB
 {
@@ -11,6 +12,9 @@ namespace BB
 	/// Create the pool by using CreatePool and DestroyPool. 
 	/// A special container that is not responsible for it's own deallocation. 
 	/// It uses virtual alloc in the background.
+	/// Slots that were never used are handed out by bumping a pointer, only freed slots go in the free list.
+	/// Pages are only touched when their slots are handed out.
+	/// An occupancy bitmap tracks the live objects, iterate over them in address order with a range for loop.
 	/// </summary>
 	template<typename T>
 	class GrowPool
@@ -39,19 +43,55 @@ namespace BB
 		/// </summary>
 		T* Get();
 		/// <summary>
+		/// Get a_Count objects from the pool and write them to a_Out, grows the pool if needed.
+		/// </summary>
+		void GetMany(T** a_Out, const size_t a_Count);
+		/// <summary>
 		/// Return an object to the pool.
 		/// </summary>
 		void Free(T* a_Ptr);
+		/// <summary>
+		/// Return a_Count objects to the pool with a single update of the free list.
+		/// </summary>
+		void FreeMany(T* const* a_Ptrs, const size_t a_Count);
+
+		/// <summary>
+		/// Move live objects from the back of the pool into free slots at the front, at most a_MaxRelocations of them.
+		/// Every move is written to a_Relocations so pointers to the moved objects can be updated, returns the amount of moves.
+		/// </summary>
+		size_t Compact(PoolRelocation<T>* a_Relocations, const size_t a_MaxRelocations);
+
+		bool IsLive(const T* a_Ptr) const { return a_Ptr >= data() && a_Ptr < m_Bump && PoolOccupancy::Test(m_Occupancy, a_Ptr - data()); }
+
+		//Iterates over the live objects in address order.
+		PoolIterator<T> begin() const { return PoolIterator<T>(data(), SetBitRange::Iterator(m_Occupancy, UsedWords(), 0)); }
+		PoolIterator<T> end() const { return PoolIterator<T>(data(), SetBitRange::Iterator(m_Occupancy, UsedWords(), UsedWords())); }
+
+		T* data() const { return reinterpret_cast<T*>(m_Start); }
 
 	private:
+		size_t UsedWords() const { return BitArray_Specs::WordCount(static_cast<size_t>(m_Bump - data())); }
+
 #ifdef _DEBUG
 		//Debug we can check it's current size.
 		size_t m_Size = 0;
 		size_t m_Capacity = 0;
 #endif // _DEBUG
 
+		//Commits more virtual memory behind the pool.
+		void Grow();
+		//Commits enough of the occupancy bitmap for every committed slot.
+		void CommitOccupancy();
+
 		void* m_Start = nullptr;
+		//Head of the free list of returned objects.
 		T** m_Pool = nullptr;
+		//The first slot that was never handed out and the end of the committed memory.
+		T* m_Bump = nullptr;
+		void* m_CommitEnd = nullptr;
+		//1 bit per slot, set when the object is live. Has its own virtual memory range.
+		uint64_t* m_Occupancy = nullptr;
+		size_t m_OccupancyBytes = 0;
 	};
 
 #ifdef _DEBUG
@@ -70,70 +110,82 @@ namespace BB
 
 		size_t t_AllocSize = a_Size * sizeof(T);
 		m_Start = mallocVirtual(m_Start, t_AllocSize);
-		m_Pool = reinterpret_cast<T**>(m_Start);
-		const size_t t_SpaceForElements = t_AllocSize / sizeof(T);
+		//No free list yet, every slot comes from the bump pointer the first time.
+		m_Pool = nullptr;
+		m_Bump = reinterpret_cast<T*>(m_Start);
+		m_CommitEnd = Pointer::Add(m_Start, t_AllocSize);
+		CommitOccupancy();
 
 #ifdef _DEBUG
 		m_Size = 0;
-		m_Capacity = t_SpaceForElements;
+		m_Capacity = t_AllocSize / sizeof(T);
 #endif //_DEBUG
-
-		T** t_Pool = m_Pool;
-
-		for (size_t i = 0; i < t_SpaceForElements - 1; i++)
-		{
-			*t_Pool = (reinterpret_cast<T*>(t_Pool)) + 1;
-			t_Pool = reinterpret_cast<T**>(*t_Pool);
-		}
-		*t_Pool = nullptr;
 	}
 
 	template<typename T>
 	inline void GrowPool<T>::DestroyPool()
 	{
+		freeVirtual(m_Occupancy);
 		freeVirtual(m_Start);
 #ifdef _DEBUG
 		//Set everything to 0 in debug to indicate it was destroyed.
 		memset(this, 0, sizeof(BB::GrowPool<T>));
 #endif //_DEBUG
 		m_Start = nullptr;
+		m_Occupancy = nullptr;
+		m_OccupancyBytes = 0;
 	}
 
 	template<class T>
 	inline T* GrowPool<T>::Get()
 	{
-		if (*m_Pool == nullptr)
+		T* t_Ptr;
+		if (m_Pool != nullptr)
 		{
-			BB_WARNING(false, "Growing the growpool, if this happens often try to reserve more.", WarningType::OPTIMALIZATION);
-			//get more memory!
-			size_t t_AllocSize = 0;
-			mallocVirtual(m_Start, t_AllocSize);
-			const size_t t_SpaceForElements = t_AllocSize / sizeof(T);
+			//Take the freelist
+			t_Ptr = reinterpret_cast<T*>(m_Pool);
+			//Set the new head of the freelist.
+			m_Pool = reinterpret_cast<T**>(*m_Pool);
+			PoolOccupancy::Set(m_Occupancy, t_Ptr - data());
+		}
+		else
+		{
+			while (Pointer::Add(m_Bump, sizeof(T)) > m_CommitEnd)
+				Grow();
+			PoolOccupancy::MarkBumped(m_Occupancy, m_Bump - data());
+			t_Ptr = m_Bump++;
+		}
 
 #ifdef _DEBUG
-			m_Capacity += t_SpaceForElements;
+		++m_Size;
 #endif //_DEBUG
 
-			T** t_Pool = m_Pool;
+		return t_Ptr;
+	}
 
-			for (size_t i = 0; i < t_SpaceForElements - 1; i++)
-			{
-				*t_Pool = (reinterpret_cast<T*>(t_Pool)) + 1;
-				t_Pool = reinterpret_cast<T**>(*t_Pool);
-			}
-			*t_Pool = nullptr;
+	template<typename T>
+	inline void GrowPool<T>::GetMany(T** a_Out, const size_t a_Count)
+	{
+		size_t t_Got = 0;
+		for (; t_Got < a_Count && m_Pool != nullptr; t_Got++)
+		{
+			a_Out[t_Got] = reinterpret_cast<T*>(m_Pool);
+			m_Pool = reinterpret_cast<T**>(*m_Pool);
+			PoolOccupancy::Set(m_Occupancy, a_Out[t_Got] - data());
 		}
 
-		//Take the freelist
-		T* t_Ptr = reinterpret_cast<T*>(m_Pool);
-		//Set the new head of the freelist.
-		m_Pool = reinterpret_cast<T**>(*m_Pool);
+		//The rest is one contiguous range from the bump pointer.
+		while (Pointer::Add(m_Bump, (a_Count - t_Got) * sizeof(T)) > m_CommitEnd)
+			Grow();
+		for (; t_Got < a_Count; t_Got++)
+		{
+			PoolOccupancy::MarkBumped(m_Occupancy, m_Bump - data());
+			a_Out[t_Got] = m_Bump++;
+		}
 
 #ifdef _DEBUG
-		++m_Size;
+		m_Size += a_Count;
 #endif //_DEBUG
-
-		return t_Ptr;
 	}
 
 	template<typename T>
@@ -143,10 +195,79 @@ namespace BB
 		BB_ASSERT((a_Ptr >= m_Start && a_Ptr < Pointer::Add(m_Start, m_Capacity * sizeof(T))), "Trying to free an pool object that is not part of this pool!");
 		--m_Size;
 #endif // _DEBUG
+		BB_ASSERT(IsLive(a_Ptr), "Trying to free an pool object that is not live, likely a double free.");
+		PoolOccupancy::Reset(m_Occupancy, a_Ptr - data());
 
 		//Set the previous free list to the new head.
 		(*reinterpret_cast<T**>(a_Ptr)) = reinterpret_cast<T*>(m_Pool);
 		//Set the new head.
 		m_Pool = reinterpret_cast<T**>(a_Ptr);
 	}
+
+	template<typename T>
+	inline void GrowPool<T>::FreeMany(T* const* a_Ptrs, const size_t a_Count)
+	{
+		if (a_Count == 0)
+			return;
+
+		//Link the objects to each other and put the chain in front of the free list.
+		for (size_t i = 0; i < a_Count; i++)
+		{
+#ifdef _DEBUG
+			BB_ASSERT((a_Ptrs[i] >= m_Start && a_Ptrs[i] < Pointer::Add(m_Start, m_Capacity * sizeof(T))), "Trying to free an pool object that is not part of this pool!");
+#endif // _DEBUG
+			BB_ASSERT(IsLive(a_Ptrs[i]), "Trying to free an pool object that is not live, likely a double free.");
+			PoolOccupancy::Reset(m_Occupancy, a_Ptrs[i] - data());
+			(*reinterpret_cast<T**>(a_Ptrs[i])) = i + 1 < a_Count ? a_Ptrs[i + 1] : reinterpret_cast<T*>(m_Pool);
+		}
+		m_Pool = reinterpret_cast<T**>(a_Ptrs[0]);
+
+#ifdef _DEBUG
+		m_Size -= a_Count;
+#endif // _DEBUG
+	}
+
+	template<typename T>
+	inline void GrowPool<T>::Grow()
+	{
+		BB_WARNING(false, "Growing the growpool, if this happens often try to reserve more.", WarningType::OPTIMALIZATION);
+		//get more memory!
+		size_t t_AllocSize = 0;
+		mallocVirtual(m_Start, t_AllocSize);
+		m_CommitEnd = Pointer::Add(m_CommitEnd, t_AllocSize);
+		CommitOccupancy();
+
+#ifdef _DEBUG
+		m_Capacity = (reinterpret_cast<uintptr_t>(m_CommitEnd) - reinterpret_cast<uintptr_t>(m_Start)) / sizeof(T);
+#endif //_DEBUG
+	}
+
+	template<typename T>
+	inline void GrowPool<T>::CommitOccupancy()
+	{
+		const size_t t_Slots = (reinterpret_cast<uintptr_t>(m_CommitEnd) - reinterpret_cast<uintptr_t>(m_Start)) / sizeof(T);
+		const size_t t_NeededBytes = BitArray_Specs::WordCount(t_Slots) * sizeof(uint64_t);
+		if (m_Occupancy == nullptr)
+		{
+			m_OccupancyBytes = t_NeededBytes;
+			m_Occupancy = reinterpret_cast<uint64_t*>(mallocVirtual(nullptr, m_OccupancyBytes));
+		}
+		while (m_OccupancyBytes < t_NeededBytes)
+		{
+			size_t t_CommitSize = t_NeededBytes - m_OccupancyBytes;
+			mallocVirtual(m_Occupancy, t_CommitSize);
+			m_OccupancyBytes += t_CommitSize;
+		}
+	}
+
+	template<typename T>
+	inline size_t GrowPool<T>::Compact(PoolRelocation<T>* a_Relocations, const size_t a_MaxRelocations)
+	{
+		size_t t_UsedSlots = static_cast<size_t>(m_Bump - data());
+		const size_t t_Moved = PoolOccupancy::Compact(data(), m_Occupancy, t_UsedSlots, a_Relocations, a_MaxRelocations);
+		m_Bump = data() + t_UsedSlots;
+		//The old free list has slots that are now live or above the bump pointer.
+		m_Pool = PoolOccupancy::BuildFreeList(data(), m_Occupancy, t_UsedSlots);
+		return t_Moved;
+	}
 }
\ No newline at end of file
@@ -12,10 +12,18 @@ namespace BB
 
 		constexpr const float UM_LoadFactor = 1.f;
 		constexpr const size_t UM_EMPTYNODE = 0xAABBCCDD;
+		//How many buckets of the old table get moved per operation during an incremental resize.
+		constexpr const size_t UM_IncrementalMigrateCount = 16;
 
 		constexpr const float OL_LoadFactor = 1.3f;
 		constexpr const size_t OL_TOMBSTONE = 0xDEADBEEFDEADBEEF;
 		constexpr const size_t OL_EMPTY = 0xAABBCCDD;
+		//How many buckets of the old table get moved per operation during an incremental resize.
+		constexpr const size_t OL_IncrementalMigrateCount = 32;
+		constexpr const size_t OL_INVALID_INDEX = SIZE_MAX;
+
+		//How many keys find_many hashes and prefetches before it starts comparing.
+		constexpr const size_t findManyBatchSize = 8;
 	};
 
 	//Calculate the load factor.
@@ -26,41 +34,77 @@ namespace BB
 
 	struct String_KeyComp
 	{
+		//OL_HashMap stores the length of every key so that a compare can exit early.
+		static constexpr bool storeKeyLength = true;
+		static size_t KeyLength(const char* a_Key) { return strlen(a_Key); }
+
 		bool operator()(const char* a_A, const char* a_B) const
 		{
 			return strcmp(a_A, a_B) == 0;
 		}
+		//Compare with a string that is not null terminated.
+		bool operator()(const char* a_A, const char* a_B, const size_t a_BLength) const
+		{
+			return strncmp(a_A, a_B, a_BLength) == 0 && a_A[a_BLength] == '\0';
+		}
+		//Both lengths are known so different lengths never reach the memcmp.
+		bool operator()(const char* a_A, const size_t a_ALength, const char* a_B, const size_t a_BLength) const
+		{
+			return a_ALength == a_BLength && memcmp(a_A, a_B, a_ALength) == 0;
+		}
 	};
 
 	template<typename Key>
 	struct Standard_KeyComp
 	{
+		static constexpr bool storeKeyLength = false;
+
 		inline bool operator()(const Key a_A, const Key a_B) const
 		{
 			return a_A == a_B;
 		}
 	};
 
+	//Default hasher of the hashmaps, the (string, length) overload is used by the string lookups.
+	template<typename Key>
+	struct Standard_Hasher
+	{
+		inline Hash operator()(const Key& a_Key) const
+		{
+			return Hash::MakeHash(a_Key);
+		}
+		inline Hash operator()(const char* a_String, const size_t a_Length) const
+		{
+			return Hash::MakeHash(a_String, a_Length);
+		}
+	};
+
 #pragma region Unordered_Map
 	//Unordered Map, uses linked list for collision.
-	template<typename Key, typename Value, typename KeyComp = Standard_KeyComp<Key>>
+	template<typename Key, typename Value, typename KeyComp = Standard_KeyComp<Key>, typename Hasher = Standard_Hasher<Key>>
 	class UM_HashMap
 	{
 		struct HashEntry
 		{
 			static constexpr bool trivalDestructableKey = std::is_trivially_destructible_v<Key>;
-			static constexpr bool trivalDestructableValue = std::is_trivially_destructible_v<Value>;
+			HashEntry() {}
+			//Copy and move are only used on entries that hold a key.
+			HashEntry(const HashEntry& a_Entry)
+				: next_Entry(a_Entry.next_Entry), hash(a_Entry.hash), key(a_Entry.key), value(a_Entry.value)
+			{}
+			HashEntry(HashEntry&& a_Entry) noexcept
+				: next_Entry(a_Entry.next_Entry), hash(a_Entry.hash), key(std::move(a_Entry.key)), value(std::move(a_Entry.value))
+			{}
 			~HashEntry()
 			{
-				state = Hashmap_Specs::UM_EMPTYNODE;
-				//Call the destructor if it has one for the value.
-				if constexpr (!trivalDestructableValue)
-					value.~Value();
-				//Call the destructor if it has one for the key.
+				//The value is a normal member and gets destroyed after this, the key lives in the union so it needs a manual call.
 				if constexpr (!trivalDestructableKey)
 					key.~Key();
+				state = Hashmap_Specs::UM_EMPTYNODE;
 			}
 			HashEntry* next_Entry = nullptr;
+			//The full hash of the key, saves rehashing the key on a resize.
+			Hash hash;
 			union
 			{
 				size_t state = Hashmap_Specs::UM_EMPTYNODE;
@@ -70,6 +114,79 @@ namespace BB
 		};
 
 	public:
+		BB_TRIVIALLY_RELOCATABLE;
+
+		struct Pair
+		{
+			const Key* key;
+			Value* value;
+		};
+
+		//Goes over every bucket and its chain, invalidated by an insert or erase.
+		struct Iterator
+		{
+			Iterator(const UM_HashMap* a_Map, const size_t a_Bucket) : m_Map(a_Map), m_Bucket(a_Bucket)
+			{
+				SkipEmptyBuckets();
+			}
+
+			Pair& operator*() { return m_Pair; }
+			Pair* operator->() { return &m_Pair; }
+
+			Iterator& operator++()
+			{
+				m_Entry = m_Entry->next_Entry;
+				if (m_Entry == nullptr)
+				{
+					++m_Bucket;
+					SkipEmptyBuckets();
+				}
+				else
+				{
+					m_Pair.key = &m_Entry->key;
+					m_Pair.value = &m_Entry->value;
+				}
+				return *this;
+			}
+
+			Iterator operator++(int)
+			{
+				Iterator t_Tmp = *this;
+				++(*this);
+				return t_Tmp;
+			}
+
+			friend bool operator== (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Bucket == a_Rhs.m_Bucket && a_Lhs.m_Entry == a_Rhs.m_Entry; };
+			friend bool operator!= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return !(a_Lhs == a_Rhs); };
+
+		private:
+			//The buckets of an unfinished incremental resize come after the buckets of the current table.
+			void SkipEmptyBuckets()
+			{
+				const size_t t_BucketCount = m_Map->m_Capacity + m_Map->m_OldCapacity;
+				for (; m_Bucket < t_BucketCount; m_Bucket++)
+				{
+					HashEntry* t_Entry = m_Bucket < m_Map->m_Capacity ?
+						&m_Map->m_Entries[m_Bucket] :
+						&m_Map->m_OldEntries[m_Bucket - m_Map->m_Capacity];
+
+					if (t_Entry->state != Hashmap_Specs::UM_EMPTYNODE)
+					{
+						m_Entry = t_Entry;
+						m_Pair.key = &m_Entry->key;
+						m_Pair.value = &m_Entry->value;
+						return;
+					}
+				}
+				m_Entry = nullptr;
+			}
+
+			const UM_HashMap* m_Map;
+			size_t m_Bucket;
+			HashEntry* m_Entry = nullptr;
+			Pair m_Pair{};
+		};
+
 		UM_HashMap(Allocator a_Allocator)
 			: UM_HashMap(a_Allocator, Hashmap_Specs::Standard_Hashmap_Size)
 		{}
@@ -86,12 +203,13 @@ namespace BB
 				new (&m_Entries[i]) HashEntry();
 			}
 		}
-		UM_HashMap(const UM_HashMap<Key, Value>& a_Map)
+		UM_HashMap(const UM_HashMap& a_Map)
 		{
 			m_Allocator = a_Map.m_Allocator;
 			m_Size = a_Map.m_Size;
 			m_Capacity = a_Map.m_Capacity;
 			m_LoadCapacity = a_Map.m_LoadCapacity;
+			m_IncrementalResize = a_Map.m_IncrementalResize;
 
 			m_Entries = reinterpret_cast<HashEntry*>(BBalloc(m_Allocator, m_Capacity * sizeof(HashEntry)));
 
@@ -115,19 +233,29 @@ namespace BB
 					new (&m_Entries[i]) HashEntry();
 				}
 			}
+
+			//Entries that the incremental resize did not move yet are put in the new table directly.
+			CopyUnmigratedEntries(a_Map);
 		}
-		UM_HashMap(UM_HashMap<Key, Value>&& a_Map) noexcept
+		UM_HashMap(UM_HashMap&& a_Map) noexcept
 		{
 			m_Allocator = a_Map.m_Allocator;
 			m_Size = a_Map.m_Size;
 			m_Capacity = a_Map.m_Capacity;
 			m_LoadCapacity = a_Map.m_LoadCapacity;
 			m_Entries = a_Map.m_Entries;
+			m_OldEntries = a_Map.m_OldEntries;
+			m_OldCapacity = a_Map.m_OldCapacity;
+			m_MigrateIndex = a_Map.m_MigrateIndex;
+			m_IncrementalResize = a_Map.m_IncrementalResize;
 
 			a_Map.m_Size = 0;
 			a_Map.m_Capacity = 0;
 			a_Map.m_LoadCapacity = 0;
 			a_Map.m_Entries = nullptr;
+			a_Map.m_OldEntries = nullptr;
+			a_Map.m_OldCapacity = 0;
+			a_Map.m_MigrateIndex = 0;
 			a_Map.m_Allocator.allocator = nullptr;
 			a_Map.m_Allocator.func = nullptr;
 		}
@@ -137,11 +265,13 @@ namespace BB
 			{
 				clear();
 
-				BBfree(m_Allocator, m_Entries);
+				//The entries are destroyed by hand, a typed BBfree would run the destructor of the first entry again.
+				BBfree(m_Allocator, reinterpret_cast<void*>(m_Entries));
+				m_Entries = nullptr;
 			}
 		}
 
-		UM_HashMap<Key, Value>& operator=(const UM_HashMap<Key, Value>& a_Rhs)
+		UM_HashMap& operator=(const UM_HashMap& a_Rhs)
 		{
 			this->~UM_HashMap();
 
@@ -149,6 +279,7 @@ namespace BB
 			m_Size = a_Rhs.m_Size;
 			m_Capacity = a_Rhs.m_Capacity;
 			m_LoadCapacity = a_Rhs.m_LoadCapacity;
+			m_IncrementalResize = a_Rhs.m_IncrementalResize;
 
 			m_Entries = reinterpret_cast<HashEntry*>(BBalloc(m_Allocator, m_Capacity * sizeof(HashEntry)));
 
@@ -173,9 +304,12 @@ namespace BB
 				}
 			}
 
+			//Entries that the incremental resize did not move yet are put in the new table directly.
+			CopyUnmigratedEntries(a_Rhs);
+
 			return *this;
 		}
-		UM_HashMap<Key, Value>& operator=(UM_HashMap<Key, Value>&& a_Rhs) noexcept
+		UM_HashMap& operator=(UM_HashMap&& a_Rhs) noexcept
 		{
 			this->~UM_HashMap();
 
@@ -184,11 +318,18 @@ namespace BB
 			m_Capacity = a_Rhs.m_Capacity;
 			m_LoadCapacity = a_Rhs.m_LoadCapacity;
 			m_Entries = a_Rhs.m_Entries;
+			m_OldEntries = a_Rhs.m_OldEntries;
+			m_OldCapacity = a_Rhs.m_OldCapacity;
+			m_MigrateIndex = a_Rhs.m_MigrateIndex;
+			m_IncrementalResize = a_Rhs.m_IncrementalResize;
 
 			a_Rhs.m_Size = 0;
 			a_Rhs.m_Capacity = 0;
 			a_Rhs.m_LoadCapacity = 0;
 			a_Rhs.m_Entries = nullptr;
+			a_Rhs.m_OldEntries = nullptr;
+			a_Rhs.m_OldCapacity = 0;
+			a_Rhs.m_MigrateIndex = 0;
 			a_Rhs.m_Allocator.allocator = nullptr;
 			a_Rhs.m_Allocator.func = nullptr;
 
@@ -202,14 +343,276 @@ namespace BB
 		template <class... Args>
 		void emplace(const Key& a_Key, Args&&... a_ValueArgs)
 		{
+			emplace_hashed(a_Key, Hasher()(a_Key), std::forward<Args>(a_ValueArgs)...);
+		}
+		/// <summary>
+		/// Emplace with a hash that was already calculated, a_Hash must be Hasher()(a_Key).
+		/// </summary>
+		template <class... Args>
+		void emplace_hashed(const Key& a_Key, const Hash a_Hash, Args&&... a_ValueArgs)
+		{
+			if (m_OldEntries != nullptr)
+				MigrateBuckets(Hashmap_Specs::UM_IncrementalMigrateCount);
+
 			if (m_Size > m_LoadCapacity)
 				grow();
 
-			const Hash t_Hash = Hash::MakeHash(a_Key) % m_Capacity;
+			m_Size++;
+			InsertEntry(a_Hash, a_Key, std::forward<Args>(a_ValueArgs)...);
+		}
+		Value* find(const Key& a_Key) const
+		{
+			return find_hashed(a_Key, Hasher()(a_Key));
+		}
+		/// <summary>
+		/// Find with a hash that was already calculated, a_Hash must be Hasher()(a_Key).
+		/// </summary>
+		Value* find_hashed(const Key& a_Key, const Hash a_Hash) const
+		{
+			HashEntry* t_Entry = FindEntry(m_Entries, m_Capacity, a_Hash, a_Key);
+
+			//Not moved to the new table yet, so it can still be in the old one.
+			if (t_Entry == nullptr && m_OldEntries != nullptr)
+				t_Entry = FindEntry(m_OldEntries, m_OldCapacity, a_Hash, a_Key);
+
+			if (t_Entry == nullptr)
+				return nullptr;
+
+			return &t_Entry->value;
+		}
+		/// <summary>
+		/// Find a string key using a string that does not need to be null terminated.
+		/// Only works for maps that use String_KeyComp.
+		/// </summary>
+		Value* find(const char* a_String, const size_t a_Length) const
+		{
+			return find_hashed(a_String, a_Length, Hasher()(a_String, a_Length));
+		}
+		Value* find_hashed(const char* a_String, const size_t a_Length, const Hash a_Hash) const
+		{
+			HashEntry* t_Entry = FindEntry(m_Entries, m_Capacity, a_Hash, a_String, a_Length);
+
+			//Not moved to the new table yet, so it can still be in the old one.
+			if (t_Entry == nullptr && m_OldEntries != nullptr)
+				t_Entry = FindEntry(m_OldEntries, m_OldCapacity, a_Hash, a_String, a_Length);
+
+			if (t_Entry == nullptr)
+				return nullptr;
+
+			return &t_Entry->value;
+		}
+		void erase(const Key& a_Key)
+		{
+			if (m_OldEntries != nullptr)
+				MigrateBuckets(Hashmap_Specs::UM_IncrementalMigrateCount);
+
+			const Hash t_Hash = Hasher()(a_Key);
+			if (EraseEntry(m_Entries, m_Capacity, t_Hash, a_Key) ||
+				(m_OldEntries != nullptr && EraseEntry(m_OldEntries, m_OldCapacity, t_Hash, a_Key)))
+			{
+				--m_Size;
+			}
+		}
+		void clear()
+		{
+			ClearEntries(m_Entries, m_Capacity);
+
+			//An incremental resize was still going on, throw away the old table.
+			if (m_OldEntries != nullptr)
+			{
+				ClearEntries(m_OldEntries, m_OldCapacity);
+				BBfree(m_Allocator, reinterpret_cast<void*>(m_OldEntries));
+				m_OldEntries = nullptr;
+				m_OldCapacity = 0;
+				m_MigrateIndex = 0;
+			}
+
+			m_Size = 0;
+		}
+
+		void reserve(const size_t a_Size)
+		{
+			if (a_Size > m_LoadCapacity)
+			{
+				size_t t_ModifiedCapacity = Math::RoundUp(a_Size, Hashmap_Specs::multipleValue);
+
+				reallocate(t_ModifiedCapacity);
+			}
+		}
+
+		/// <summary>
+		/// When enabled a resize keeps the old table around and moves a couple of buckets per insert or erase
+		/// instead of rehashing the entire table in one go. Disabling it finishes a resize that is still going on.
+		/// </summary>
+		void set_incremental_resize(const bool a_Incremental)
+		{
+			m_IncrementalResize = a_Incremental;
+			if (!m_IncrementalResize && m_OldEntries != nullptr)
+				MigrateBuckets(m_OldCapacity);
+		}
+
+		/// <summary>
+		/// Insert a_Count unique keys that are not yet in the map. The table is sized once
+		/// and the inserts skip the growth checks.
+		/// </summary>
+		void build(const Key* a_Keys, const Value* a_Values, const size_t a_Count)
+		{
+			reserve(m_Size + a_Count);
+			//Nothing should be left in the old table while building.
+			if (m_OldEntries != nullptr)
+				MigrateBuckets(m_OldCapacity);
+
+			for (size_t i = 0; i < a_Count; i++)
+			{
+				InsertEntry(Hasher()(a_Keys[i]), a_Keys[i], a_Values[i]);
+			}
+			m_Size += a_Count;
+		}
+
+		/// <summary>
+		/// Find a_Count keys, a_Results[i] gets the value of a_Keys[i] or nullptr.
+		/// The buckets of a batch of keys are prefetched before any key is compared.
+		/// </summary>
+		void find_many(const Key* a_Keys, const size_t a_Count, Value** a_Results) const
+		{
+			Hash t_Hashes[Hashmap_Specs::findManyBatchSize];
+			for (size_t t_Batch = 0; t_Batch < a_Count; t_Batch += Hashmap_Specs::findManyBatchSize)
+			{
+				size_t t_BatchSize = a_Count - t_Batch;
+				if (t_BatchSize > Hashmap_Specs::findManyBatchSize)
+					t_BatchSize = Hashmap_Specs::findManyBatchSize;
+
+				for (size_t i = 0; i < t_BatchSize; i++)
+				{
+					t_Hashes[i] = Hasher()(a_Keys[t_Batch + i]);
+					Memory::Prefetch(&m_Entries[t_Hashes[i] % m_Capacity]);
+				}
+				for (size_t i = 0; i < t_BatchSize; i++)
+				{
+					a_Results[t_Batch + i] = find_hashed(a_Keys[t_Batch + i], t_Hashes[i]);
+				}
+			}
+		}
+
+		size_t size() const { return m_Size; }
+		//Returns true if an incremental resize has not finished moving all the old buckets yet.
+		bool is_resizing() const { return m_OldEntries != nullptr; }
+
+		Iterator begin() { return Iterator(this, 0); }
+		Iterator end() { return Iterator(this, m_Capacity + m_OldCapacity); }
 
-			HashEntry* t_Entry = &m_Entries[t_Hash.hash];
+	private:
+		void grow(size_t a_MinCapacity = 1)
+		{
+			BB_WARNING(m_IncrementalResize, "Resizing an UM_HashMap, this might be a bit slow. Possibly reserve more.", WarningType::OPTIMALIZATION);
+
+			size_t t_ModifiedCapacity = m_Capacity * 2;
+
+			if (a_MinCapacity > t_ModifiedCapacity)
+				t_ModifiedCapacity = Math::RoundUp(a_MinCapacity, Hashmap_Specs::multipleValue);
+
+			reallocate(t_ModifiedCapacity, m_IncrementalResize);
+		}
+
+		//When a_Incremental is true the old table is kept and moved over bit by bit with MigrateBuckets.
+		void reallocate(const size_t a_NewLoadCapacity, const bool a_Incremental = false)
+		{
+			//Only one resize can be going on at a time.
+			if (m_OldEntries != nullptr)
+				MigrateBuckets(m_OldCapacity);
+
+			const size_t t_NewCapacity = LFCalculation(a_NewLoadCapacity, Hashmap_Specs::UM_LoadFactor);
+
+			//Allocate the new buffer.
+			HashEntry* t_NewEntries = reinterpret_cast<HashEntry*>(BBalloc(m_Allocator, t_NewCapacity * sizeof(HashEntry)));
+
+			for (size_t i = 0; i < t_NewCapacity; i++)
+			{
+				new (&t_NewEntries[i]) HashEntry();
+			}
+
+			m_OldEntries = m_Entries;
+			m_OldCapacity = m_Capacity;
+			m_MigrateIndex = 0;
+
+			m_Capacity = t_NewCapacity;
+			m_LoadCapacity = a_NewLoadCapacity;
+			m_Entries = t_NewEntries;
+
+			if (!a_Incremental)
+				MigrateBuckets(m_OldCapacity);
+		}
+
+		//Move up to a_BucketCount buckets from the old table into the new one, frees the old table when done.
+		void MigrateBuckets(const size_t a_BucketCount)
+		{
+			size_t t_End = m_MigrateIndex + a_BucketCount;
+			if (t_End > m_OldCapacity)
+				t_End = m_OldCapacity;
+
+			for (; m_MigrateIndex < t_End; m_MigrateIndex++)
+			{
+				HashEntry* t_OldEntry = &m_OldEntries[m_MigrateIndex];
+				if (t_OldEntry->state == Hashmap_Specs::UM_EMPTYNODE)
+					continue;
+
+				HashEntry* t_Node = t_OldEntry->next_Entry;
+
+				//The bucket entry lives inside the old table so it needs to be copied over.
+				HashEntry* t_NewEntry = &m_Entries[t_OldEntry->hash % m_Capacity];
+				if (t_NewEntry->state == Hashmap_Specs::UM_EMPTYNODE)
+				{
+					new (t_NewEntry) HashEntry(std::move(*t_OldEntry));
+					t_NewEntry->next_Entry = nullptr;
+				}
+				else
+				{
+					HashEntry* t_NewNode = BBnew(m_Allocator, HashEntry)(std::move(*t_OldEntry));
+					t_NewNode->next_Entry = t_NewEntry->next_Entry;
+					t_NewEntry->next_Entry = t_NewNode;
+				}
+				t_OldEntry->~HashEntry();
+				t_OldEntry->next_Entry = nullptr;
+				t_OldEntry->state = Hashmap_Specs::UM_EMPTYNODE;
+
+				//Collision nodes are already seperate allocations, just link them into the new table.
+				while (t_Node != nullptr)
+				{
+					HashEntry* t_NextNode = t_Node->next_Entry;
+					t_NewEntry = &m_Entries[t_Node->hash % m_Capacity];
+					if (t_NewEntry->state == Hashmap_Specs::UM_EMPTYNODE)
+					{
+						new (t_NewEntry) HashEntry(std::move(*t_Node));
+						t_NewEntry->next_Entry = nullptr;
+						t_Node->~HashEntry();
+						BBfree(m_Allocator, reinterpret_cast<void*>(t_Node));
+					}
+					else
+					{
+						t_Node->next_Entry = t_NewEntry->next_Entry;
+						t_NewEntry->next_Entry = t_Node;
+					}
+					t_Node = t_NextNode;
+				}
+			}
+
+			if (m_MigrateIndex == m_OldCapacity)
+			{
+				BBfree(m_Allocator, reinterpret_cast<void*>(m_OldEntries));
+				m_OldEntries = nullptr;
+				m_OldCapacity = 0;
+				m_MigrateIndex = 0;
+			}
+		}
+
+		//Does not check for growth or change the size.
+		template <class... Args>
+		void InsertEntry(const Hash a_Hash, const Key& a_Key, Args&&... a_ValueArgs)
+		{
+			HashEntry* t_Entry = &m_Entries[a_Hash % m_Capacity];
 			if (t_Entry->state == Hashmap_Specs::UM_EMPTYNODE)
 			{
+				t_Entry->hash = a_Hash;
 				t_Entry->key = a_Key;
 				new (&t_Entry->value) Value(std::forward<Args>(a_ValueArgs)...);
 				t_Entry->next_Entry = nullptr;
@@ -222,6 +625,7 @@ namespace BB
 				if (t_Entry->next_Entry == nullptr)
 				{
 					HashEntry* t_NewEntry = BBnew(m_Allocator, HashEntry);
+					t_NewEntry->hash = a_Hash;
 					t_NewEntry->key = a_Key;
 					new (&t_NewEntry->value) Value(std::forward<Args>(a_ValueArgs)...);
 					t_NewEntry->next_Entry = nullptr;
@@ -231,153 +635,126 @@ namespace BB
 				t_Entry = t_Entry->next_Entry;
 			}
 		}
-		Value* find(const Key& a_Key) const
+
+		HashEntry* FindEntry(HashEntry* a_Entries, const size_t a_Capacity, const Hash a_Hash, const Key& a_Key) const
 		{
-			const Hash t_Hash = Hash::MakeHash(a_Key) % m_Capacity;
+			HashEntry* t_Entry = &a_Entries[a_Hash % a_Capacity];
 
-			HashEntry* t_Entry = &m_Entries[t_Hash];
+			if (t_Entry->state == Hashmap_Specs::UM_EMPTYNODE)
+				return nullptr;
+
+			while (t_Entry)
+			{
+				if (t_Entry->hash == a_Hash && Match(t_Entry, a_Key))
+				{
+					return t_Entry;
+				}
+				t_Entry = t_Entry->next_Entry;
+			}
+			return nullptr;
+		}
+
+		HashEntry* FindEntry(HashEntry* a_Entries, const size_t a_Capacity, const Hash a_Hash, const char* a_String, const size_t a_Length) const
+		{
+			HashEntry* t_Entry = &a_Entries[a_Hash % a_Capacity];
 
 			if (t_Entry->state == Hashmap_Specs::UM_EMPTYNODE)
 				return nullptr;
 
 			while (t_Entry)
 			{
-				if (Match(t_Entry, a_Key))
+				if (t_Entry->hash == a_Hash && KeyComp()(t_Entry->key, a_String, a_Length))
 				{
-					return &t_Entry->value;
+					return t_Entry;
 				}
 				t_Entry = t_Entry->next_Entry;
 			}
 			return nullptr;
 		}
-		void erase(const Key& a_Key)
+
+		//Returns false if the key was not inside a_Entries.
+		bool EraseEntry(HashEntry* a_Entries, const size_t a_Capacity, const Hash a_Hash, const Key& a_Key)
 		{
-			const Hash t_Hash = Hash::MakeHash(a_Key) % m_Capacity;;
+			HashEntry* t_Entry = &a_Entries[a_Hash % a_Capacity];
+			if (t_Entry->state == Hashmap_Specs::UM_EMPTYNODE)
+				return false;
 
-			HashEntry* t_Entry = &m_Entries[t_Hash];
-			if (Match(t_Entry, a_Key))
+			if (t_Entry->hash == a_Hash && Match(t_Entry, a_Key))
 			{
+				HashEntry* t_NextEntry = t_Entry->next_Entry;
 				t_Entry->~HashEntry();
+				t_Entry->next_Entry = nullptr;
+				t_Entry->state = Hashmap_Specs::UM_EMPTYNODE;
 
-				if (t_Entry->next_Entry != nullptr)
+				//Pull the first collision node into the bucket.
+				if (t_NextEntry != nullptr)
 				{
-					HashEntry* t_NextEntry = t_Entry->next_Entry;
-					*t_Entry = *t_Entry->next_Entry;
-					BBfree(m_Allocator, t_NextEntry);
-					return;
+					new (t_Entry) HashEntry(std::move(*t_NextEntry));
+					t_NextEntry->~HashEntry();
+					BBfree(m_Allocator, reinterpret_cast<void*>(t_NextEntry));
 				}
-
-				t_Entry->state = Hashmap_Specs::UM_EMPTYNODE;
-				return;
+				return true;
 			}
 
-			HashEntry* t_PreviousEntry = nullptr;
+			HashEntry* t_PreviousEntry = t_Entry;
+			t_Entry = t_Entry->next_Entry;
 
 			while (t_Entry)
 			{
-				if (Match(t_Entry, a_Key))
+				if (t_Entry->hash == a_Hash && Match(t_Entry, a_Key))
 				{
-					t_PreviousEntry = t_Entry->next_Entry;
-					BBfree(m_Allocator, t_Entry);
-					return;
+					t_PreviousEntry->next_Entry = t_Entry->next_Entry;
+					t_Entry->~HashEntry();
+					BBfree(m_Allocator, reinterpret_cast<void*>(t_Entry));
+					return true;
 				}
 				t_PreviousEntry = t_Entry;
 				t_Entry = t_Entry->next_Entry;
 			}
+			return false;
 		}
-		void clear()
+
+		void ClearEntries(HashEntry* a_Entries, const size_t a_Capacity)
 		{
 			//go through all the entries and individually delete the extra values from the linked list.
 			//They need to be deleted seperatly since the memory is somewhere else.
-			for (size_t i = 0; i < m_Capacity; i++)
+			for (size_t i = 0; i < a_Capacity; i++)
 			{
-				if (m_Entries[i].state != Hashmap_Specs::UM_EMPTYNODE)
+				if (a_Entries[i].state != Hashmap_Specs::UM_EMPTYNODE)
 				{
-					HashEntry* t_NextEntry = m_Entries[i].next_Entry;
+					HashEntry* t_NextEntry = a_Entries[i].next_Entry;
 					while (t_NextEntry != nullptr)
 					{
 						HashEntry* t_DeleteEntry = t_NextEntry;
 						t_NextEntry = t_NextEntry->next_Entry;
-						t_DeleteEntry->~HashEntry();
 
-						BBfree(m_Allocator, t_DeleteEntry);
+						t_DeleteEntry->~HashEntry();
+						BBfree(m_Allocator, reinterpret_cast<void*>(t_DeleteEntry));
 					}
-					m_Entries[i].state = Hashmap_Specs::UM_EMPTYNODE;
+					a_Entries[i].~HashEntry();
+					a_Entries[i].next_Entry = nullptr;
+					a_Entries[i].state = Hashmap_Specs::UM_EMPTYNODE;
 				}
 			}
-			for (size_t i = 0; i < m_Capacity; i++)
-				if (m_Entries[i].state == Hashmap_Specs::UM_EMPTYNODE)
-					m_Entries[i].~HashEntry();
-
-			m_Size = 0;
-		}
-
-		void reserve(const size_t a_Size)
-		{
-			if (a_Size > m_Capacity)
-			{
-				size_t t_ModifiedCapacity = Math::RoundUp(a_Size, Hashmap_Specs::multipleValue);
-
-				reallocate(t_ModifiedCapacity);
-			}
 		}
 
-		size_t size() const { return m_Size; }
-
-	private:
-		void grow(size_t a_MinCapacity = 1)
+		void CopyUnmigratedEntries(const UM_HashMap& a_Map)
 		{
-			BB_WARNING(false, "Resizing an OL_HashMap, this might be a bit slow. Possibly reserve more.", WarningType::OPTIMALIZATION);
-
-			size_t t_ModifiedCapacity = m_Capacity * 2;
-
-			if (a_MinCapacity > t_ModifiedCapacity)
-				t_ModifiedCapacity = Math::RoundUp(a_MinCapacity, Hashmap_Specs::multipleValue);
-
-			reallocate(t_ModifiedCapacity);
-		}
-
-		void reallocate(const size_t a_NewLoadCapacity)
-		{
-			const size_t t_NewCapacity = LFCalculation(a_NewLoadCapacity, Hashmap_Specs::UM_LoadFactor);
-
-			//Allocate the new buffer.
-			HashEntry* t_NewEntries = reinterpret_cast<HashEntry*>(BBalloc(m_Allocator, t_NewCapacity * sizeof(HashEntry)));
+			if (a_Map.m_OldEntries == nullptr)
+				return;
 
-			for (size_t i = 0; i < t_NewCapacity; i++)
+			for (size_t i = a_Map.m_MigrateIndex; i < a_Map.m_OldCapacity; i++)
 			{
-				new (&t_NewEntries[i]) HashEntry();
-			}
+				const HashEntry* t_Entry = &a_Map.m_OldEntries[i];
+				if (t_Entry->state == Hashmap_Specs::UM_EMPTYNODE)
+					continue;
 
-			for (size_t i = 0; i < m_Capacity; i++)
-			{
-				if (m_Entries[i].state != Hashmap_Specs::UM_EMPTYNODE)
+				while (t_Entry != nullptr)
 				{
-					const Hash t_Hash = Hash::MakeHash(m_Entries[i].key) % t_NewCapacity;
-
-					HashEntry* t_Entry = &t_NewEntries[t_Hash.hash];
-					if (t_Entry->state == Hashmap_Specs::UM_EMPTYNODE)
-					{
-						*t_Entry = m_Entries[i];
-					}
-					//Collision accurred, no problem we just create a linked list and make a new element.
-					//Bad for cache memory though.
-					while (t_Entry)
-					{
-						if (t_Entry->next_Entry == nullptr)
-						{
-							HashEntry* t_NewEntry = BBnew(m_Allocator, HashEntry)(m_Entries[i]);
-						}
-						t_Entry = t_Entry->next_Entry;
-					}
+					InsertEntry(t_Entry->hash, t_Entry->key, t_Entry->value);
+					t_Entry = t_Entry->next_Entry;
 				}
 			}
-
-			this->~UM_HashMap();
-
-			m_Capacity = t_NewCapacity;
-			m_LoadCapacity = a_NewLoadCapacity;
-			m_Entries = t_NewEntries;
 		}
 
 		size_t m_Capacity;
@@ -386,6 +763,12 @@ namespace BB
 
 		HashEntry* m_Entries;
 
+		//Only used while an incremental resize is moving buckets.
+		HashEntry* m_OldEntries = nullptr;
+		size_t m_OldCapacity = 0;
+		size_t m_MigrateIndex = 0;
+		bool m_IncrementalResize = false;
+
 		Allocator m_Allocator;
 
 	private:
@@ -400,13 +783,77 @@ namespace BB
 
 #pragma region Open Addressing Linear Probing (OL)
 	//Open addressing with Linear probing.
-	template<typename Key, typename Value, typename KeyComp = Standard_KeyComp<Key>>
+	template<typename Key, typename Value, typename KeyComp = Standard_KeyComp<Key>, typename Hasher = Standard_Hasher<Key>>
 	class OL_HashMap
 	{
 		static constexpr bool trivalDestructableValue = std::is_trivially_destructible_v<Value>;
 		static constexpr bool trivalDestructableKey = std::is_trivially_destructible_v<Key>;
+		//String keys keep their length next to them so a compare can skip the strcmp.
+		static constexpr bool storeKeyLength = KeyComp::storeKeyLength;
 
 	public:
+		BB_TRIVIALLY_RELOCATABLE;
+
+		struct Pair
+		{
+			const Key* key;
+			Value* value;
+		};
+
+		//Goes over the occupied slots, invalidated by an insert or erase.
+		struct Iterator
+		{
+			Iterator(const OL_HashMap* a_Map, const size_t a_Index) : m_Map(a_Map), m_Index(a_Index)
+			{
+				SkipEmptySlots();
+			}
+
+			Pair& operator*() { return m_Pair; }
+			Pair* operator->() { return &m_Pair; }
+
+			Iterator& operator++()
+			{
+				++m_Index;
+				SkipEmptySlots();
+				return *this;
+			}
+
+			Iterator operator++(int)
+			{
+				Iterator t_Tmp = *this;
+				++(*this);
+				return t_Tmp;
+			}
+
+			friend bool operator== (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Index == a_Rhs.m_Index; };
+			friend bool operator!= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Index != a_Rhs.m_Index; };
+
+		private:
+			//The slots of an unfinished incremental resize come after the slots of the current table.
+			//Moved slots in the old table are tombstones so they get skipped.
+			void SkipEmptySlots()
+			{
+				const size_t t_SlotCount = m_Map->m_Capacity + m_Map->m_OldCapacity;
+				for (; m_Index < t_SlotCount; m_Index++)
+				{
+					const bool t_Old = m_Index >= m_Map->m_Capacity;
+					const size_t t_Slot = t_Old ? m_Index - m_Map->m_Capacity : m_Index;
+					const Hash* t_Hashes = t_Old ? m_Map->m_OldHashes : m_Map->m_Hashes;
+
+					if (t_Hashes[t_Slot] != Hashmap_Specs::OL_EMPTY && t_Hashes[t_Slot] != Hashmap_Specs::OL_TOMBSTONE)
+					{
+						m_Pair.key = t_Old ? &m_Map->m_OldKeys[t_Slot] : &m_Map->m_Keys[t_Slot];
+						m_Pair.value = t_Old ? &m_Map->m_OldValues[t_Slot] : &m_Map->m_Values[t_Slot];
+						return;
+					}
+				}
+			}
+
+			const OL_HashMap* m_Map;
+			size_t m_Index;
+			Pair m_Pair{};
+		};
+
 		OL_HashMap(Allocator a_Allocator)
 			: OL_HashMap(a_Allocator, Hashmap_Specs::Standard_Hashmap_Size)
 		{}
@@ -417,45 +864,22 @@ namespace BB
 			m_Size = 0;
 			m_LoadCapacity = a_Size;
 
-			const size_t t_MemorySize = (sizeof(Hash) + sizeof(Key) + sizeof(Value)) * m_Capacity;
-
-			void* t_Buffer = BBalloc(m_Allocator, t_MemorySize);
-			m_Hashes = reinterpret_cast<Hash*>(t_Buffer);
-			m_Keys = reinterpret_cast<Key*>(Pointer::Add(t_Buffer, sizeof(Hash) * m_Capacity));
-			m_Values = reinterpret_cast<Value*>(Pointer::Add(t_Buffer, (sizeof(Hash) + sizeof(Key)) * m_Capacity));
-			for (size_t i = 0; i < m_Capacity; i++)
-			{
-				m_Hashes[i] = Hashmap_Specs::OL_EMPTY;
-			}
+			AllocateTable(m_Capacity, m_Hashes, m_Keys, m_Values, m_KeyLengths);
 		}
-		OL_HashMap(const OL_HashMap<Key, Value>& a_Map)
+		OL_HashMap(const OL_HashMap& a_Map)
 		{
 			m_Capacity = a_Map.m_Capacity;
 			m_Size = 0;
 			m_LoadCapacity = a_Map.m_LoadCapacity;
+			m_IncrementalResize = a_Map.m_IncrementalResize;
 
 			m_Allocator = a_Map.m_Allocator;
 
-			const size_t t_MemorySize = (sizeof(Hash) + sizeof(Key) + sizeof(Value)) * m_Capacity;
-
-			void* t_Buffer = BBalloc(m_Allocator, t_MemorySize);
-			m_Hashes = reinterpret_cast<Hash*>(t_Buffer);
-			m_Keys = reinterpret_cast<Key*>(Pointer::Add(t_Buffer, sizeof(Hash) * m_Capacity));
-			m_Values = reinterpret_cast<Value*>(Pointer::Add(t_Buffer, (sizeof(Hash) + sizeof(Key)) * m_Capacity));
-			for (size_t i = 0; i < m_Capacity; i++)
-			{
-				m_Hashes[i] = Hashmap_Specs::OL_EMPTY;
-			}
+			AllocateTable(m_Capacity, m_Hashes, m_Keys, m_Values, m_KeyLengths);
 
-			for (size_t i = 0; i < m_Capacity; i++)
-			{
-				if (a_Map.m_Hashes[i] != Hashmap_Specs::OL_EMPTY && a_Map.m_Hashes[i] != Hashmap_Specs::OL_TOMBSTONE)
-				{
-					insert(a_Map.m_Keys[i], a_Map.m_Values[i]);
-				}
-			}
+			CopyEntries(a_Map);
 		}
-		OL_HashMap(OL_HashMap<Key, Value>&& a_Map) noexcept
+		OL_HashMap(OL_HashMap&& a_Map) noexcept
 		{
 			m_Capacity = a_Map.m_Capacity;
 			m_Size = a_Map.m_Size;
@@ -464,6 +888,15 @@ namespace BB
 			m_Hashes = a_Map.m_Hashes;
 			m_Keys = a_Map.m_Keys;
 			m_Values = a_Map.m_Values;
+			m_KeyLengths = a_Map.m_KeyLengths;
+
+			m_OldHashes = a_Map.m_OldHashes;
+			m_OldKeys = a_Map.m_OldKeys;
+			m_OldValues = a_Map.m_OldValues;
+			m_OldKeyLengths = a_Map.m_OldKeyLengths;
+			m_OldCapacity = a_Map.m_OldCapacity;
+			m_MigrateIndex = a_Map.m_MigrateIndex;
+			m_IncrementalResize = a_Map.m_IncrementalResize;
 
 			m_Allocator = a_Map.m_Allocator;
 
@@ -473,6 +906,14 @@ namespace BB
 			a_Map.m_Hashes = nullptr;
 			a_Map.m_Keys = nullptr;
 			a_Map.m_Values = nullptr;
+			a_Map.m_KeyLengths = nullptr;
+
+			a_Map.m_OldHashes = nullptr;
+			a_Map.m_OldKeys = nullptr;
+			a_Map.m_OldValues = nullptr;
+			a_Map.m_OldKeyLengths = nullptr;
+			a_Map.m_OldCapacity = 0;
+			a_Map.m_MigrateIndex = 0;
 
 			a_Map.m_Allocator.allocator = nullptr;
 			a_Map.m_Allocator.func = nullptr;
@@ -481,53 +922,36 @@ namespace BB
 		{
 			if (m_Hashes != nullptr)
 			{
-				//Call the destructor if it has one for the value.
-				if constexpr (!trivalDestructableValue)
-					for (size_t i = 0; i < m_Capacity; i++)
-						if (m_Hashes[i] != 0)
-							m_Values[i].~Value();
-				//Call the destructor if it has one for the key.
-				if constexpr (!trivalDestructableKey)
-					for (size_t i = 0; i < m_Capacity; i++)
-						if (m_Hashes[i] != 0)
-							m_Keys[i].~Key();
-
+				DestroyEntries(m_Hashes, m_Keys, m_Values, m_Capacity);
 				BBfree(m_Allocator, m_Hashes);
+				m_Hashes = nullptr;
+			}
+			if (m_OldHashes != nullptr)
+			{
+				DestroyEntries(m_OldHashes, m_OldKeys, m_OldValues, m_OldCapacity);
+				BBfree(m_Allocator, m_OldHashes);
+				m_OldHashes = nullptr;
 			}
 		}
 
-		OL_HashMap<Key, Value>& operator=(const OL_HashMap<Key, Value>& a_Rhs)
+		OL_HashMap& operator=(const OL_HashMap& a_Rhs)
 		{
 			this->~OL_HashMap();
 
 			m_Capacity = a_Rhs.m_Capacity;
 			m_Size = 0;
 			m_LoadCapacity = a_Rhs.m_LoadCapacity;
+			m_IncrementalResize = a_Rhs.m_IncrementalResize;
 
 			m_Allocator = a_Rhs.m_Allocator;
 
-			const size_t t_MemorySize = (sizeof(Hash) + sizeof(Key) + sizeof(Value)) * m_Capacity;
+			AllocateTable(m_Capacity, m_Hashes, m_Keys, m_Values, m_KeyLengths);
 
-			void* t_Buffer = BBalloc(m_Allocator, t_MemorySize);
-			m_Hashes = reinterpret_cast<Hash*>(t_Buffer);
-			m_Keys = reinterpret_cast<Key*>(Pointer::Add(t_Buffer, sizeof(Hash) * m_Capacity));
-			m_Values = reinterpret_cast<Value*>(Pointer::Add(t_Buffer, (sizeof(Hash) + sizeof(Key)) * m_Capacity));
-			for (size_t i = 0; i < m_Capacity; i++)
-			{
-				m_Hashes[i] = Hashmap_Specs::OL_EMPTY;
-			}
-
-			for (size_t i = 0; i < m_Capacity; i++)
-			{
-				if (a_Rhs.m_Hashes[i] != Hashmap_Specs::OL_EMPTY && a_Rhs.m_Hashes[i] != Hashmap_Specs::OL_TOMBSTONE)
-				{
-					insert(a_Rhs.m_Keys[i], a_Rhs.m_Values[i]);
-				}
-			}
+			CopyEntries(a_Rhs);
 
 			return *this;
 		}
-		OL_HashMap<Key, Value>& operator=(OL_HashMap<Key, Value>&& a_Rhs) noexcept
+		OL_HashMap& operator=(OL_HashMap&& a_Rhs) noexcept
 		{
 			this->~OL_HashMap();
 
@@ -540,6 +964,15 @@ namespace BB
 			m_Hashes = a_Rhs.m_Hashes;
 			m_Keys = a_Rhs.m_Keys;
 			m_Values = a_Rhs.m_Values;
+			m_KeyLengths = a_Rhs.m_KeyLengths;
+
+			m_OldHashes = a_Rhs.m_OldHashes;
+			m_OldKeys = a_Rhs.m_OldKeys;
+			m_OldValues = a_Rhs.m_OldValues;
+			m_OldKeyLengths = a_Rhs.m_OldKeyLengths;
+			m_OldCapacity = a_Rhs.m_OldCapacity;
+			m_MigrateIndex = a_Rhs.m_MigrateIndex;
+			m_IncrementalResize = a_Rhs.m_IncrementalResize;
 
 			a_Rhs.m_Capacity = 0;
 			a_Rhs.m_Size = 0;
@@ -551,6 +984,14 @@ namespace BB
 			a_Rhs.m_Hashes = nullptr;
 			a_Rhs.m_Keys = nullptr;
 			a_Rhs.m_Values = nullptr;
+			a_Rhs.m_KeyLengths = nullptr;
+
+			a_Rhs.m_OldHashes = nullptr;
+			a_Rhs.m_OldKeys = nullptr;
+			a_Rhs.m_OldValues = nullptr;
+			a_Rhs.m_OldKeyLengths = nullptr;
+			a_Rhs.m_OldCapacity = 0;
+			a_Rhs.m_MigrateIndex = 0;
 
 			return *this;
 		}
@@ -562,65 +1003,90 @@ namespace BB
 		template <class... Args>
 		void emplace(const Key& a_Key, Args&&... a_ValueArgs)
 		{
+			emplace_hashed(a_Key, Hasher()(a_Key), std::forward<Args>(a_ValueArgs)...);
+		}
+		/// <summary>
+		/// Emplace with a hash that was already calculated, a_Hash must be Hasher()(a_Key).
+		/// </summary>
+		template <class... Args>
+		void emplace_hashed(const Key& a_Key, const Hash a_Hash, Args&&... a_ValueArgs)
+		{
+			if (m_OldHashes != nullptr)
+				MigrateBuckets(Hashmap_Specs::OL_IncrementalMigrateCount);
+
 			if (m_Size > m_LoadCapacity)
 				grow();
 
 			m_Size++;
-			const Hash t_Hash = Hash::MakeHash(a_Key) % m_Capacity;
-
-
-			for (size_t i = t_Hash; i < m_Capacity; i++)
-			{
-				if (m_Hashes[i] == Hashmap_Specs::OL_EMPTY || m_Hashes[i] == Hashmap_Specs::OL_TOMBSTONE)
-				{
-					m_Hashes[i] = t_Hash;
-					m_Keys[i] = a_Key;
-					new (&m_Values[i]) Value(std::forward<Args>(a_ValueArgs)...);
-					return;
-				}
-			}
-
-			//Loop again but then from the start and stop at the hash. 
-			for (size_t i = 0; i < t_Hash; i++)
+			const Hash t_Hash = StoredHash(a_Hash);
+			const size_t t_Index = InsertSlot(t_Hash);
+			new (&m_Keys[t_Index]) Key(a_Key);
+			new (&m_Values[t_Index]) Value(std::forward<Args>(a_ValueArgs)...);
+			if constexpr (storeKeyLength)
+				m_KeyLengths[t_Index] = static_cast<uint32_t>(KeyComp::KeyLength(a_Key));
+		}
+		Value* find(const Key& a_Key) const
+		{
+			if constexpr (storeKeyLength)
 			{
-				if (m_Hashes[i] == Hashmap_Specs::OL_EMPTY || m_Hashes[i] == Hashmap_Specs::OL_TOMBSTONE)
-				{
-					m_Hashes[i] = t_Hash;
-					m_Keys[i] = a_Key;
-					new (&m_Values[i]) Value(std::forward<Args>(a_ValueArgs)...);
-					return;
-				}
+				//The hash and the compares share the one length calculation.
+				const size_t t_Length = KeyComp::KeyLength(a_Key);
+				return find_hashed(a_Key, t_Length, Hasher()(a_Key, t_Length));
 			}
+			else
+				return find_hashed(a_Key, Hasher()(a_Key));
 		}
-		Value* find(const Key& a_Key) const
+		/// <summary>
+		/// Find with a hash that was already calculated, a_Hash must be Hasher()(a_Key).
+		/// </summary>
+		Value* find_hashed(const Key& a_Key, const Hash a_Hash) const
 		{
-			const Hash t_Hash = Hash::MakeHash(a_Key) % m_Capacity;
-
-			for (size_t i = t_Hash; i < m_Capacity; i++)
+			if constexpr (storeKeyLength)
 			{
-				if (m_Hashes[i] != Hashmap_Specs::OL_TOMBSTONE && KeyComp()(m_Keys[i], a_Key))
-				{
-					return &m_Values[i];
-				}
-				//If you hit an empty return a nullptr.
-				if (m_Hashes[i] == Hashmap_Specs::OL_EMPTY)
-				{
-					return nullptr;
-				}
+				//Calculate the length once so every compare can use it.
+				return find_hashed(a_Key, KeyComp::KeyLength(a_Key), a_Hash);
 			}
-
-			//Loop again but then from the start and stop at the hash. 
-			for (size_t i = 0; i < t_Hash; i++)
+			else
 			{
-				if (m_Hashes[i] != Hashmap_Specs::OL_TOMBSTONE && KeyComp()(m_Keys[i], a_Key))
-				{
-					return &m_Values[i];
-				}
-				//If you hit an empty return a nullptr.
-				if (m_Hashes[i] == Hashmap_Specs::OL_EMPTY)
+				const Hash t_Hash = StoredHash(a_Hash);
+				size_t t_Index = FindSlot(m_Hashes, m_Keys, m_Capacity, t_Hash, a_Key);
+				if (t_Index != Hashmap_Specs::OL_INVALID_INDEX)
+					return &m_Values[t_Index];
+
+				//Not moved to the new table yet, so it can still be in the old one.
+				if (m_OldHashes != nullptr)
 				{
-					return nullptr;
+					t_Index = FindSlot(m_OldHashes, m_OldKeys, m_OldCapacity, t_Hash, a_Key);
+					if (t_Index != Hashmap_Specs::OL_INVALID_INDEX)
+						return &m_OldValues[t_Index];
 				}
+
+				//Key does not exist.
+				return nullptr;
+			}
+		}
+		/// <summary>
+		/// Find a string key using a string that does not need to be null terminated.
+		/// Only works for maps that use String_KeyComp.
+		/// </summary>
+		Value* find(const char* a_String, const size_t a_Length) const
+		{
+			return find_hashed(a_String, a_Length, Hasher()(a_String, a_Length));
+		}
+		Value* find_hashed(const char* a_String, const size_t a_Length, const Hash a_Hash) const
+		{
+			static_assert(storeKeyLength, "OL_HashMap string lookup requires a KeyComp that stores key lengths.");
+			const Hash t_Hash = StoredHash(a_Hash);
+			size_t t_Index = FindSlot(m_Hashes, m_Keys, m_KeyLengths, m_Capacity, t_Hash, a_String, a_Length);
+			if (t_Index != Hashmap_Specs::OL_INVALID_INDEX)
+				return &m_Values[t_Index];
+
+			//Not moved to the new table yet, so it can still be in the old one.
+			if (m_OldHashes != nullptr)
+			{
+				t_Index = FindSlot(m_OldHashes, m_OldKeys, m_OldKeyLengths, m_OldCapacity, t_Hash, a_String, a_Length);
+				if (t_Index != Hashmap_Specs::OL_INVALID_INDEX)
+					return &m_OldValues[t_Index];
 			}
 
 			//Key does not exist.
@@ -628,41 +1094,23 @@ namespace BB
 		}
 		void erase(const Key& a_Key)
 		{
-			const Hash t_Hash = Hash::MakeHash(a_Key) % m_Capacity;
+			if (m_OldHashes != nullptr)
+				MigrateBuckets(Hashmap_Specs::OL_IncrementalMigrateCount);
 
-			for (size_t i = t_Hash; i < m_Capacity; i++)
+			const Hash t_Hash = StoredHash(Hasher()(a_Key));
+			size_t t_Index = FindSlot(m_Hashes, m_Keys, m_Capacity, t_Hash, a_Key);
+			if (t_Index != Hashmap_Specs::OL_INVALID_INDEX)
 			{
-				if (KeyComp()(m_Keys[i], a_Key))
-				{
-					m_Hashes[i] = Hashmap_Specs::OL_TOMBSTONE;
-					//Call the destructor if it has one for the value.
-					if constexpr (!trivalDestructableValue)
-						m_Values[i].~Value();
-					//Call the destructor if it has one for the key.
-					if constexpr (!trivalDestructableKey)
-						m_Keys[i].~Key();
-					m_Keys[i] = 0;
-
-					m_Size--;
-					return;
-				}
+				EraseSlot(m_Hashes, m_Keys, m_Values, t_Index);
+				return;
 			}
 
-			//Loop again but then from the start and stop at the hash. 
-			for (size_t i = 0; i < t_Hash; i++)
+			if (m_OldHashes != nullptr)
 			{
-				if (KeyComp()(m_Keys[i], a_Key))
+				t_Index = FindSlot(m_OldHashes, m_OldKeys, m_OldCapacity, t_Hash, a_Key);
+				if (t_Index != Hashmap_Specs::OL_INVALID_INDEX)
 				{
-					m_Hashes[i] = Hashmap_Specs::OL_TOMBSTONE;
-					//Call the destructor if it has one for the value.
-					if constexpr (!trivalDestructableValue)
-						m_Values[i].~Value();
-					//Call the destructor if it has one for the key.
-					if constexpr (!trivalDestructableKey)
-						m_Keys[i].~Key();
-					m_Keys[i] = 0;
-
-					m_Size--;
+					EraseSlot(m_OldHashes, m_OldKeys, m_OldValues, t_Index);
 					return;
 				}
 			}
@@ -670,24 +1118,30 @@ namespace BB
 		}
 		void clear()
 		{
+			DestroyEntries(m_Hashes, m_Keys, m_Values, m_Capacity);
 			for (size_t i = 0; i < m_Capacity; i++)
 			{
-				if (m_Hashes[i] != Hashmap_Specs::OL_EMPTY)
-				{
-					m_Hashes[i] = Hashmap_Specs::OL_EMPTY;
-					if constexpr (!trivalDestructableValue)
-						m_Values[i].~Value();
-					if constexpr (!trivalDestructableKey)
-						m_Keys[i].~Key();
-					m_Keys[i] = 0;
-				}
+				m_Hashes[i] = Hashmap_Specs::OL_EMPTY;
+			}
+
+			//An incremental resize was still going on, throw away the old table.
+			if (m_OldHashes != nullptr)
+			{
+				DestroyEntries(m_OldHashes, m_OldKeys, m_OldValues, m_OldCapacity);
+				BBfree(m_Allocator, m_OldHashes);
+				m_OldHashes = nullptr;
+				m_OldKeys = nullptr;
+				m_OldValues = nullptr;
+				m_OldKeyLengths = nullptr;
+				m_OldCapacity = 0;
+				m_MigrateIndex = 0;
 			}
 			m_Size = 0;
 		}
 
 		void reserve(const size_t a_Size)
 		{
-			if (a_Size > m_Capacity)
+			if (a_Size > m_LoadCapacity)
 			{
 				size_t t_ModifiedCapacity = Math::RoundUp(a_Size, Hashmap_Specs::multipleValue);
 
@@ -695,63 +1149,283 @@ namespace BB
 			}
 		}
 
+		/// <summary>
+		/// When enabled a resize keeps the old table around and moves a couple of buckets per insert or erase
+		/// instead of rehashing the entire table in one go. Disabling it finishes a resize that is still going on.
+		/// </summary>
+		void set_incremental_resize(const bool a_Incremental)
+		{
+			m_IncrementalResize = a_Incremental;
+			if (!m_IncrementalResize && m_OldHashes != nullptr)
+				MigrateBuckets(m_OldCapacity);
+		}
+
+		/// <summary>
+		/// Insert a_Count unique keys that are not yet in the map. The table is sized once
+		/// and the inserts skip the growth checks.
+		/// </summary>
+		void build(const Key* a_Keys, const Value* a_Values, const size_t a_Count)
+		{
+			reserve(m_Size + a_Count);
+			//Nothing should be left in the old table while building.
+			if (m_OldHashes != nullptr)
+				MigrateBuckets(m_OldCapacity);
+
+			for (size_t i = 0; i < a_Count; i++)
+			{
+				const size_t t_Index = InsertSlot(StoredHash(Hasher()(a_Keys[i])));
+				new (&m_Keys[t_Index]) Key(a_Keys[i]);
+				new (&m_Values[t_Index]) Value(a_Values[i]);
+				if constexpr (storeKeyLength)
+					m_KeyLengths[t_Index] = static_cast<uint32_t>(KeyComp::KeyLength(a_Keys[i]));
+			}
+			m_Size += a_Count;
+		}
+
+		/// <summary>
+		/// Find a_Count keys, a_Results[i] gets the value of a_Keys[i] or nullptr.
+		/// The home slots of a batch of keys are prefetched before any key is compared.
+		/// </summary>
+		void find_many(const Key* a_Keys, const size_t a_Count, Value** a_Results) const
+		{
+			Hash t_Hashes[Hashmap_Specs::findManyBatchSize];
+			for (size_t t_Batch = 0; t_Batch < a_Count; t_Batch += Hashmap_Specs::findManyBatchSize)
+			{
+				size_t t_BatchSize = a_Count - t_Batch;
+				if (t_BatchSize > Hashmap_Specs::findManyBatchSize)
+					t_BatchSize = Hashmap_Specs::findManyBatchSize;
+
+				for (size_t i = 0; i < t_BatchSize; i++)
+				{
+					t_Hashes[i] = Hasher()(a_Keys[t_Batch + i]);
+					const size_t t_Index = StoredHash(t_Hashes[i]) % m_Capacity;
+					Memory::Prefetch(&m_Hashes[t_Index]);
+					Memory::Prefetch(&m_Keys[t_Index]);
+				}
+				for (size_t i = 0; i < t_BatchSize; i++)
+				{
+					a_Results[t_Batch + i] = find_hashed(a_Keys[t_Batch + i], t_Hashes[i]);
+				}
+			}
+		}
+
 		size_t size() const { return m_Size; }
+		//Returns true if an incremental resize has not finished moving all the old buckets yet.
+		bool is_resizing() const { return m_OldHashes != nullptr; }
+
+		Iterator begin() { return Iterator(this, 0); }
+		Iterator end() { return Iterator(this, m_Capacity + m_OldCapacity); }
 	private:
 		void grow(size_t a_MinCapacity = 1)
 		{
-			BB_WARNING(false, "Resizing an OL_HashMap, this might be a bit slow. Possibly reserve more.", WarningType::OPTIMALIZATION);
+			BB_WARNING(m_IncrementalResize, "Resizing an OL_HashMap, this might be a bit slow. Possibly reserve more.", WarningType::OPTIMALIZATION);
 
 			size_t t_ModifiedCapacity = m_Capacity * 2;
 
 			if (a_MinCapacity > t_ModifiedCapacity)
 				t_ModifiedCapacity = Math::RoundUp(a_MinCapacity, Hashmap_Specs::multipleValue);
 
-			reallocate(t_ModifiedCapacity);
+			reallocate(t_ModifiedCapacity, m_IncrementalResize);
 		}
-		void reallocate(const size_t a_NewLoadCapacity)
+		//When a_Incremental is true the old table is kept and moved over bit by bit with MigrateBuckets.
+		void reallocate(const size_t a_NewLoadCapacity, const bool a_Incremental = false)
 		{
+			//Only one resize can be going on at a time.
+			if (m_OldHashes != nullptr)
+				MigrateBuckets(m_OldCapacity);
+
 			const size_t t_NewCapacity = LFCalculation(a_NewLoadCapacity, Hashmap_Specs::OL_LoadFactor);
 
-			//Allocate the new buffer.
-			const size_t t_MemorySize = (sizeof(Hash) + sizeof(Key) + sizeof(Value)) * t_NewCapacity;
-			void* t_Buffer = BBalloc(m_Allocator, t_MemorySize);
+			m_OldHashes = m_Hashes;
+			m_OldKeys = m_Keys;
+			m_OldValues = m_Values;
+			m_OldKeyLengths = m_KeyLengths;
+			m_OldCapacity = m_Capacity;
+			m_MigrateIndex = 0;
 
-			Hash* t_NewHashes = reinterpret_cast<Hash*>(t_Buffer);
-			Key* t_NewKeys = reinterpret_cast<Key*>(Pointer::Add(t_Buffer, sizeof(Hash) * t_NewCapacity));
-			Value* t_NewValues = reinterpret_cast<Value*>(Pointer::Add(t_Buffer, (sizeof(Hash) + sizeof(Key)) * t_NewCapacity));
-			for (size_t i = 0; i < t_NewCapacity; i++)
+			AllocateTable(t_NewCapacity, m_Hashes, m_Keys, m_Values, m_KeyLengths);
+
+			m_Capacity = t_NewCapacity;
+			m_LoadCapacity = a_NewLoadCapacity;
+
+			if (!a_Incremental)
+				MigrateBuckets(m_OldCapacity);
+		}
+
+		//One allocation holding hashes | keys | values | key lengths, all hashes are set to empty.
+		void AllocateTable(const size_t a_Capacity, Hash*& a_Hashes, Key*& a_Keys, Value*& a_Values, uint32_t*& a_KeyLengths)
+		{
+			size_t t_MemorySize = (sizeof(Hash) + sizeof(Key) + sizeof(Value)) * a_Capacity;
+			if constexpr (storeKeyLength)
+				t_MemorySize += sizeof(uint32_t) * a_Capacity;
+
+			void* t_Buffer = BBalloc(m_Allocator, t_MemorySize);
+			a_Hashes = reinterpret_cast<Hash*>(t_Buffer);
+			a_Keys = reinterpret_cast<Key*>(Pointer::Add(t_Buffer, sizeof(Hash) * a_Capacity));
+			a_Values = reinterpret_cast<Value*>(Pointer::Add(t_Buffer, (sizeof(Hash) + sizeof(Key)) * a_Capacity));
+			if constexpr (storeKeyLength)
+				a_KeyLengths = reinterpret_cast<uint32_t*>(Pointer::Add(t_Buffer, (sizeof(Hash) + sizeof(Key) + sizeof(Value)) * a_Capacity));
+			else
+				a_KeyLengths = nullptr;
+
+			for (size_t i = 0; i < a_Capacity; i++)
 			{
-				t_NewHashes[i] = Hashmap_Specs::OL_EMPTY;
+				a_Hashes[i] = Hashmap_Specs::OL_EMPTY;
 			}
+		}
 
-			for (size_t i = 0; i < m_Capacity; i++)
+		//Move up to a_BucketCount buckets from the old table into the new one, frees the old table when done.
+		void MigrateBuckets(const size_t a_BucketCount)
+		{
+			size_t t_End = m_MigrateIndex + a_BucketCount;
+			if (t_End > m_OldCapacity)
+				t_End = m_OldCapacity;
+
+			for (; m_MigrateIndex < t_End; m_MigrateIndex++)
 			{
-				if (m_Hashes[i] == i)
+				const size_t i = m_MigrateIndex;
+				if (m_OldHashes[i] != Hashmap_Specs::OL_EMPTY && m_OldHashes[i] != Hashmap_Specs::OL_TOMBSTONE)
 				{
-					Key t_Key = m_Keys[i];
-					Hash t_Hash = Hash::MakeHash(t_Key) % t_NewCapacity;
+					//The full hash is stored, so no need to hash the key again.
+					const size_t t_Index = InsertSlot(m_OldHashes[i]);
+					new (&m_Keys[t_Index]) Key(std::move(m_OldKeys[i]));
+					new (&m_Values[t_Index]) Value(std::move(m_OldValues[i]));
+					if constexpr (storeKeyLength)
+						m_KeyLengths[t_Index] = m_OldKeyLengths[i];
 
-					while (t_NewHashes[t_Hash] != Hashmap_Specs::OL_EMPTY)
-					{
-						t_Hash++;
-						if (t_Hash > t_NewCapacity)
-							t_Hash = 0;
-					}
-					t_NewHashes[t_Hash] = t_Hash;
-					t_NewKeys[t_Hash] = t_Key;
-					t_NewValues[t_Hash] = m_Values[i];
+					if constexpr (!trivalDestructableValue)
+						m_OldValues[i].~Value();
+					if constexpr (!trivalDestructableKey)
+						m_OldKeys[i].~Key();
 				}
+				//A tombstone and not empty, otherwise lookups in the old table stop at moved buckets.
+				m_OldHashes[i] = Hashmap_Specs::OL_TOMBSTONE;
 			}
 
-			//Remove all the elements and free the memory.
-			this->~OL_HashMap();
+			if (m_MigrateIndex == m_OldCapacity)
+			{
+				BBfree(m_Allocator, m_OldHashes);
+				m_OldHashes = nullptr;
+				m_OldKeys = nullptr;
+				m_OldValues = nullptr;
+				m_OldKeyLengths = nullptr;
+				m_OldCapacity = 0;
+				m_MigrateIndex = 0;
+			}
+		}
 
-			m_Hashes = t_NewHashes;
-			m_Keys = t_NewKeys;
-			m_Values = t_NewValues;
+		//The hash values that mark empty and tombstone slots can never be stored for a key.
+		static Hash StoredHash(const Hash a_Hash)
+		{
+			if (a_Hash == Hashmap_Specs::OL_EMPTY || a_Hash == Hashmap_Specs::OL_TOMBSTONE)
+				return a_Hash + 1;
+			return a_Hash;
+		}
 
-			m_Capacity = t_NewCapacity;
-			m_LoadCapacity = a_NewLoadCapacity;
+		//Claims a free slot in the current table for a_Hash, does not check for growth.
+		size_t InsertSlot(const Hash a_Hash)
+		{
+			size_t t_Index = a_Hash % m_Capacity;
+			while (m_Hashes[t_Index] != Hashmap_Specs::OL_EMPTY && m_Hashes[t_Index] != Hashmap_Specs::OL_TOMBSTONE)
+			{
+				if (++t_Index == m_Capacity)
+					t_Index = 0;
+			}
+			m_Hashes[t_Index] = a_Hash;
+			return t_Index;
+		}
+
+		//Returns Hashmap_Specs::OL_INVALID_INDEX if the key is not inside the given table.
+		static size_t FindSlot(const Hash* a_Hashes, const Key* a_Keys, const size_t a_Capacity, const Hash a_Hash, const Key& a_Key)
+		{
+			size_t t_Index = a_Hash % a_Capacity;
+			for (size_t i = 0; i < a_Capacity; i++)
+			{
+				//If you hit an empty the key is not here.
+				if (a_Hashes[t_Index] == Hashmap_Specs::OL_EMPTY)
+					return Hashmap_Specs::OL_INVALID_INDEX;
+
+				//Only compare keys when the full hash matches.
+				if (a_Hashes[t_Index] == a_Hash && KeyComp()(a_Keys[t_Index], a_Key))
+					return t_Index;
+
+				if (++t_Index == a_Capacity)
+					t_Index = 0;
+			}
+
+			return Hashmap_Specs::OL_INVALID_INDEX;
+		}
+
+		//Same as above but for maps that store the key lengths, a_String does not need to be null terminated.
+		static size_t FindSlot(const Hash* a_Hashes, const Key* a_Keys, const uint32_t* a_KeyLengths, const size_t a_Capacity, const Hash a_Hash, const char* a_String, const size_t a_Length)
+		{
+			size_t t_Index = a_Hash % a_Capacity;
+			for (size_t i = 0; i < a_Capacity; i++)
+			{
+				//If you hit an empty the key is not here.
+				if (a_Hashes[t_Index] == Hashmap_Specs::OL_EMPTY)
+					return Hashmap_Specs::OL_INVALID_INDEX;
+
+				if (a_Hashes[t_Index] == a_Hash && KeyComp()(a_Keys[t_Index], a_KeyLengths[t_Index], a_String, a_Length))
+					return t_Index;
+
+				if (++t_Index == a_Capacity)
+					t_Index = 0;
+			}
+
+			return Hashmap_Specs::OL_INVALID_INDEX;
+		}
+
+		void EraseSlot(Hash* a_Hashes, Key* a_Keys, Value* a_Values, const size_t a_Index)
+		{
+			a_Hashes[a_Index] = Hashmap_Specs::OL_TOMBSTONE;
+			//Call the destructor if it has one for the value.
+			if constexpr (!trivalDestructableValue)
+				a_Values[a_Index].~Value();
+			//Call the destructor if it has one for the key.
+			if constexpr (!trivalDestructableKey)
+				a_Keys[a_Index].~Key();
+
+			m_Size--;
+		}
+
+		static void DestroyEntries(const Hash* a_Hashes, Key* a_Keys, Value* a_Values, const size_t a_Capacity)
+		{
+			for (size_t i = 0; i < a_Capacity; i++)
+			{
+				if (a_Hashes[i] != Hashmap_Specs::OL_EMPTY && a_Hashes[i] != Hashmap_Specs::OL_TOMBSTONE)
+				{
+					//Call the destructor if it has one for the value.
+					if constexpr (!trivalDestructableValue)
+						a_Values[i].~Value();
+					//Call the destructor if it has one for the key.
+					if constexpr (!trivalDestructableKey)
+						a_Keys[i].~Key();
+				}
+			}
+		}
+
+		//Inserts all the elements of a_Map, including those still waiting in an incremental resize.
+		void CopyEntries(const OL_HashMap& a_Map)
+		{
+			for (size_t i = 0; i < a_Map.m_Capacity; i++)
+			{
+				if (a_Map.m_Hashes[i] != Hashmap_Specs::OL_EMPTY && a_Map.m_Hashes[i] != Hashmap_Specs::OL_TOMBSTONE)
+				{
+					emplace_hashed(a_Map.m_Keys[i], a_Map.m_Hashes[i], a_Map.m_Values[i]);
+				}
+			}
+
+			if (a_Map.m_OldHashes != nullptr)
+			{
+				for (size_t i = a_Map.m_MigrateIndex; i < a_Map.m_OldCapacity; i++)
+				{
+					if (a_Map.m_OldHashes[i] != Hashmap_Specs::OL_EMPTY && a_Map.m_OldHashes[i] != Hashmap_Specs::OL_TOMBSTONE)
+					{
+						emplace_hashed(a_Map.m_OldKeys[i], a_Map.m_OldHashes[i], a_Map.m_OldValues[i]);
+					}
+				}
+			}
 		}
 
 	private:
@@ -759,13 +1433,24 @@ namespace BB
 		size_t m_Size;
 		size_t m_LoadCapacity;
 
-		//All the elements.
+		//All the elements, m_Hashes holds the full hash of the key.
 		Hash* m_Hashes;
 		Key* m_Keys;
 		Value* m_Values;
+		//Only allocated when KeyComp::storeKeyLength is true.
+		uint32_t* m_KeyLengths = nullptr;
+
+		//Only used while an incremental resize is moving buckets.
+		Hash* m_OldHashes = nullptr;
+		Key* m_OldKeys = nullptr;
+		Value* m_OldValues = nullptr;
+		uint32_t* m_OldKeyLengths = nullptr;
+		size_t m_OldCapacity = 0;
+		size_t m_MigrateIndex = 0;
+		bool m_IncrementalResize = false;
 
 		Allocator m_Allocator;
 	};
 }
 
-#pragma endregion
\ No newline at end of file
+#pragma endregion
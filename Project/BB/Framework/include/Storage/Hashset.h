@@ -0,0 +1,397 @@
+#pragma once
+#include "Hashmap.h"
+
+namespace BB
+{
+#pragma region Open Addressing Linear Probing (OL)
+	//Key only version of the OL_HashMap, open addressing with linear probing.
+	template<typename Key, typename KeyComp = Standard_KeyComp<Key>, typename Hasher = Standard_Hasher<Key>>
+	class OL_HashSet
+	{
+		static constexpr bool trivalDestructableKey = std::is_trivially_destructible_v<Key>;
+
+	public:
+		BB_TRIVIALLY_RELOCATABLE;
+
+		//Goes over the occupied slots, invalidated by an insert or erase.
+		struct Iterator
+		{
+			Iterator(const OL_HashSet* a_Set, const size_t a_Index) : m_Set(a_Set), m_Index(a_Index)
+			{
+				SkipEmptySlots();
+			}
+
+			const Key& operator*() const { return m_Set->m_Keys[m_Index]; }
+			const Key* operator->() const { return &m_Set->m_Keys[m_Index]; }
+
+			Iterator& operator++()
+			{
+				++m_Index;
+				SkipEmptySlots();
+				return *this;
+			}
+
+			Iterator operator++(int)
+			{
+				Iterator t_Tmp = *this;
+				++(*this);
+				return t_Tmp;
+			}
+
+			friend bool operator== (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Index == a_Rhs.m_Index; };
+			friend bool operator!= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Index != a_Rhs.m_Index; };
+
+		private:
+			void SkipEmptySlots()
+			{
+				while (m_Index < m_Set->m_Capacity &&
+					(m_Set->m_Hashes[m_Index] == Hashmap_Specs::OL_EMPTY || m_Set->m_Hashes[m_Index] == Hashmap_Specs::OL_TOMBSTONE))
+				{
+					++m_Index;
+				}
+			}
+
+			const OL_HashSet* m_Set;
+			size_t m_Index;
+		};
+
+		OL_HashSet(Allocator a_Allocator)
+			: OL_HashSet(a_Allocator, Hashmap_Specs::Standard_Hashmap_Size)
+		{}
+		OL_HashSet(Allocator a_Allocator, const size_t a_Size)
+			: m_Allocator(a_Allocator)
+		{
+			m_Capacity = LFCalculation(a_Size, Hashmap_Specs::OL_LoadFactor);
+			m_Size = 0;
+			m_LoadCapacity = a_Size;
+
+			AllocateTable(m_Capacity, m_Hashes, m_Keys);
+		}
+		OL_HashSet(const OL_HashSet& a_Set)
+		{
+			m_Capacity = a_Set.m_Capacity;
+			m_Size = a_Set.m_Size;
+			m_LoadCapacity = a_Set.m_LoadCapacity;
+
+			m_Allocator = a_Set.m_Allocator;
+
+			AllocateTable(m_Capacity, m_Hashes, m_Keys);
+			CopyEntries(a_Set);
+		}
+		OL_HashSet(OL_HashSet&& a_Set) noexcept
+		{
+			m_Capacity = a_Set.m_Capacity;
+			m_Size = a_Set.m_Size;
+			m_LoadCapacity = a_Set.m_LoadCapacity;
+
+			m_Hashes = a_Set.m_Hashes;
+			m_Keys = a_Set.m_Keys;
+
+			m_Allocator = a_Set.m_Allocator;
+
+			a_Set.m_Capacity = 0;
+			a_Set.m_Size = 0;
+			a_Set.m_LoadCapacity = 0;
+			a_Set.m_Hashes = nullptr;
+			a_Set.m_Keys = nullptr;
+
+			a_Set.m_Allocator.allocator = nullptr;
+			a_Set.m_Allocator.func = nullptr;
+		}
+		~OL_HashSet()
+		{
+			if (m_Hashes != nullptr)
+			{
+				DestroyEntries();
+				BBfree(m_Allocator, m_Hashes);
+				m_Hashes = nullptr;
+			}
+		}
+
+		OL_HashSet& operator=(const OL_HashSet& a_Rhs)
+		{
+			this->~OL_HashSet();
+
+			m_Capacity = a_Rhs.m_Capacity;
+			m_Size = a_Rhs.m_Size;
+			m_LoadCapacity = a_Rhs.m_LoadCapacity;
+
+			m_Allocator = a_Rhs.m_Allocator;
+
+			AllocateTable(m_Capacity, m_Hashes, m_Keys);
+			CopyEntries(a_Rhs);
+
+			return *this;
+		}
+		OL_HashSet& operator=(OL_HashSet&& a_Rhs) noexcept
+		{
+			this->~OL_HashSet();
+
+			m_Capacity = a_Rhs.m_Capacity;
+			m_Size = a_Rhs.m_Size;
+			m_LoadCapacity = a_Rhs.m_LoadCapacity;
+
+			m_Allocator = a_Rhs.m_Allocator;
+
+			m_Hashes = a_Rhs.m_Hashes;
+			m_Keys = a_Rhs.m_Keys;
+
+			a_Rhs.m_Capacity = 0;
+			a_Rhs.m_Size = 0;
+			a_Rhs.m_LoadCapacity = 0;
+
+			a_Rhs.m_Allocator.allocator = nullptr;
+			a_Rhs.m_Allocator.func = nullptr;
+
+			a_Rhs.m_Hashes = nullptr;
+			a_Rhs.m_Keys = nullptr;
+
+			return *this;
+		}
+
+		//Returns false if the key was already inside the set.
+		bool insert(const Key& a_Key)
+		{
+			return insert_hashed(a_Key, Hasher()(a_Key));
+		}
+		/// <summary>
+		/// Insert with a hash that was already calculated, a_Hash must be Hasher()(a_Key).
+		/// </summary>
+		bool insert_hashed(const Key& a_Key, const Hash a_Hash)
+		{
+			const Hash t_Hash = StoredHash(a_Hash);
+			if (FindSlot(t_Hash, a_Key) != Hashmap_Specs::OL_INVALID_INDEX)
+				return false;
+
+			if (m_Size > m_LoadCapacity)
+				grow();
+
+			m_Size++;
+			new (&m_Keys[InsertSlot(t_Hash)]) Key(a_Key);
+			return true;
+		}
+		bool contains(const Key& a_Key) const
+		{
+			return contains_hashed(a_Key, Hasher()(a_Key));
+		}
+		/// <summary>
+		/// Contains with a hash that was already calculated, a_Hash must be Hasher()(a_Key).
+		/// </summary>
+		bool contains_hashed(const Key& a_Key, const Hash a_Hash) const
+		{
+			return FindSlot(StoredHash(a_Hash), a_Key) != Hashmap_Specs::OL_INVALID_INDEX;
+		}
+		//Returns false if the key was not inside the set.
+		bool erase(const Key& a_Key)
+		{
+			const size_t t_Index = FindSlot(StoredHash(Hasher()(a_Key)), a_Key);
+			if (t_Index == Hashmap_Specs::OL_INVALID_INDEX)
+				return false;
+
+			m_Hashes[t_Index] = Hashmap_Specs::OL_TOMBSTONE;
+			//Call the destructor if it has one for the key.
+			if constexpr (!trivalDestructableKey)
+				m_Keys[t_Index].~Key();
+
+			m_Size--;
+			return true;
+		}
+		void clear()
+		{
+			DestroyEntries();
+			for (size_t i = 0; i < m_Capacity; i++)
+			{
+				m_Hashes[i] = Hashmap_Specs::OL_EMPTY;
+			}
+			m_Size = 0;
+		}
+
+		/// <summary>
+		/// Insert a_Count unique keys that are not yet in the set. The table is sized once
+		/// and the inserts skip the growth and duplicate checks.
+		/// </summary>
+		void build(const Key* a_Keys, const size_t a_Count)
+		{
+			reserve(m_Size + a_Count);
+
+			for (size_t i = 0; i < a_Count; i++)
+			{
+				new (&m_Keys[InsertSlot(StoredHash(Hasher()(a_Keys[i])))]) Key(a_Keys[i]);
+			}
+			m_Size += a_Count;
+		}
+
+		/// <summary>
+		/// Check a_Count keys, a_Results[i] is true when a_Keys[i] is inside the set.
+		/// The home slots of a batch of keys are prefetched before any key is compared.
+		/// </summary>
+		void contains_many(const Key* a_Keys, const size_t a_Count, bool* a_Results) const
+		{
+			Hash t_Hashes[Hashmap_Specs::findManyBatchSize];
+			for (size_t t_Batch = 0; t_Batch < a_Count; t_Batch += Hashmap_Specs::findManyBatchSize)
+			{
+				size_t t_BatchSize = a_Count - t_Batch;
+				if (t_BatchSize > Hashmap_Specs::findManyBatchSize)
+					t_BatchSize = Hashmap_Specs::findManyBatchSize;
+
+				for (size_t i = 0; i < t_BatchSize; i++)
+				{
+					t_Hashes[i] = StoredHash(Hasher()(a_Keys[t_Batch + i]));
+					const size_t t_Index = t_Hashes[i] % m_Capacity;
+					Memory::Prefetch(&m_Hashes[t_Index]);
+					Memory::Prefetch(&m_Keys[t_Index]);
+				}
+				for (size_t i = 0; i < t_BatchSize; i++)
+				{
+					a_Results[t_Batch + i] = FindSlot(t_Hashes[i], a_Keys[t_Batch + i]) != Hashmap_Specs::OL_INVALID_INDEX;
+				}
+			}
+		}
+
+		void reserve(const size_t a_Size)
+		{
+			if (a_Size > m_LoadCapacity)
+			{
+				size_t t_ModifiedCapacity = Math::RoundUp(a_Size, Hashmap_Specs::multipleValue);
+
+				reallocate(t_ModifiedCapacity);
+			}
+		}
+
+		size_t size() const { return m_Size; }
+
+		Iterator begin() const { return Iterator(this, 0); }
+		Iterator end() const { return Iterator(this, m_Capacity); }
+
+	private:
+		void grow(size_t a_MinCapacity = 1)
+		{
+			BB_WARNING(false, "Resizing an OL_HashSet, this might be a bit slow. Possibly reserve more.", WarningType::OPTIMALIZATION);
+
+			size_t t_ModifiedCapacity = m_Capacity * 2;
+
+			if (a_MinCapacity > t_ModifiedCapacity)
+				t_ModifiedCapacity = Math::RoundUp(a_MinCapacity, Hashmap_Specs::multipleValue);
+
+			reallocate(t_ModifiedCapacity);
+		}
+
+		void reallocate(const size_t a_NewLoadCapacity)
+		{
+			const size_t t_NewCapacity = LFCalculation(a_NewLoadCapacity, Hashmap_Specs::OL_LoadFactor);
+
+			Hash* t_OldHashes = m_Hashes;
+			Key* t_OldKeys = m_Keys;
+			const size_t t_OldCapacity = m_Capacity;
+
+			AllocateTable(t_NewCapacity, m_Hashes, m_Keys);
+			m_Capacity = t_NewCapacity;
+			m_LoadCapacity = a_NewLoadCapacity;
+
+			//The full hash is stored, so no need to hash the keys again.
+			for (size_t i = 0; i < t_OldCapacity; i++)
+			{
+				if (t_OldHashes[i] != Hashmap_Specs::OL_EMPTY && t_OldHashes[i] != Hashmap_Specs::OL_TOMBSTONE)
+				{
+					new (&m_Keys[InsertSlot(t_OldHashes[i])]) Key(std::move(t_OldKeys[i]));
+					if constexpr (!trivalDestructableKey)
+						t_OldKeys[i].~Key();
+				}
+			}
+
+			BBfree(m_Allocator, t_OldHashes);
+		}
+
+		//One allocation holding hashes | keys, all hashes are set to empty.
+		void AllocateTable(const size_t a_Capacity, Hash*& a_Hashes, Key*& a_Keys)
+		{
+			void* t_Buffer = BBalloc(m_Allocator, (sizeof(Hash) + sizeof(Key)) * a_Capacity);
+			a_Hashes = reinterpret_cast<Hash*>(t_Buffer);
+			a_Keys = reinterpret_cast<Key*>(Pointer::Add(t_Buffer, sizeof(Hash) * a_Capacity));
+
+			for (size_t i = 0; i < a_Capacity; i++)
+			{
+				a_Hashes[i] = Hashmap_Specs::OL_EMPTY;
+			}
+		}
+
+		//The hash values that mark empty and tombstone slots can never be stored for a key.
+		static Hash StoredHash(const Hash a_Hash)
+		{
+			if (a_Hash == Hashmap_Specs::OL_EMPTY || a_Hash == Hashmap_Specs::OL_TOMBSTONE)
+				return a_Hash + 1;
+			return a_Hash;
+		}
+
+		//Claims a free slot for a_Hash, does not check for growth.
+		size_t InsertSlot(const Hash a_Hash)
+		{
+			size_t t_Index = a_Hash % m_Capacity;
+			while (m_Hashes[t_Index] != Hashmap_Specs::OL_EMPTY && m_Hashes[t_Index] != Hashmap_Specs::OL_TOMBSTONE)
+			{
+				if (++t_Index == m_Capacity)
+					t_Index = 0;
+			}
+			m_Hashes[t_Index] = a_Hash;
+			return t_Index;
+		}
+
+		//Returns Hashmap_Specs::OL_INVALID_INDEX if the key is not inside the set.
+		size_t FindSlot(const Hash a_Hash, const Key& a_Key) const
+		{
+			size_t t_Index = a_Hash % m_Capacity;
+			for (size_t i = 0; i < m_Capacity; i++)
+			{
+				//If you hit an empty the key is not here.
+				if (m_Hashes[t_Index] == Hashmap_Specs::OL_EMPTY)
+					return Hashmap_Specs::OL_INVALID_INDEX;
+
+				//Only compare keys when the full hash matches.
+				if (m_Hashes[t_Index] == a_Hash && KeyComp()(m_Keys[t_Index], a_Key))
+					return t_Index;
+
+				if (++t_Index == m_Capacity)
+					t_Index = 0;
+			}
+
+			return Hashmap_Specs::OL_INVALID_INDEX;
+		}
+
+		void DestroyEntries()
+		{
+			if constexpr (!trivalDestructableKey)
+			{
+				for (size_t i = 0; i < m_Capacity; i++)
+				{
+					if (m_Hashes[i] != Hashmap_Specs::OL_EMPTY && m_Hashes[i] != Hashmap_Specs::OL_TOMBSTONE)
+						m_Keys[i].~Key();
+				}
+			}
+		}
+
+		//Both sets have the same capacity so every slot can be copied directly.
+		void CopyEntries(const OL_HashSet& a_Set)
+		{
+			for (size_t i = 0; i < m_Capacity; i++)
+			{
+				m_Hashes[i] = a_Set.m_Hashes[i];
+				if (a_Set.m_Hashes[i] != Hashmap_Specs::OL_EMPTY && a_Set.m_Hashes[i] != Hashmap_Specs::OL_TOMBSTONE)
+				{
+					new (&m_Keys[i]) Key(a_Set.m_Keys[i]);
+				}
+			}
+		}
+
+	private:
+		size_t m_Capacity;
+		size_t m_Size;
+		size_t m_LoadCapacity;
+
+		//All the elements, m_Hashes holds the full hash of the key.
+		Hash* m_Hashes;
+		Key* m_Keys;
+
+		Allocator m_Allocator;
+	};
+#pragma endregion
+}
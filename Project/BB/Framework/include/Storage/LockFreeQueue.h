@@ -0,0 +1,395 @@
+#pragma once
+#include "Utils/Logger.h"
+#include "BBMemory.h"
+
+#include "Utils/Utils.h"
+#include <atomic>
+
+namespace BB
+{
+	namespace LockFreeQueue_Specs
+	{
+		//Indices written by different threads live on different cache lines to avoid false sharing.
+		constexpr const size_t cacheLineSize = 64;
+	};
+
+	/// <summary>
+	/// Bounded wait-free queue for exactly 1 producer thread and 1 consumer thread.
+	/// The capacity is rounded up to a power of 2 and never grows, a full queue makes try_push return false.
+	/// Each side keeps a cached copy of the other side's index so the shared index is only read when the cache says full or empty.
+	/// </summary>
+	template<typename T>
+	class SPSCQueue
+	{
+		static constexpr bool trivialDestructible_T = std::is_trivially_destructible_v<T>;
+
+	public:
+		SPSCQueue(Allocator a_Allocator, const size_t a_Capacity);
+		~SPSCQueue();
+
+		//Shared between threads, copying or moving it while in use is never safe.
+		SPSCQueue(const SPSCQueue<T>&) = delete;
+		SPSCQueue(SPSCQueue<T>&&) = delete;
+		SPSCQueue<T>& operator=(const SPSCQueue<T>&) = delete;
+		SPSCQueue<T>& operator=(SPSCQueue<T>&&) = delete;
+
+		//Producer only.
+		bool try_push(const T& a_Element);
+		//Producer only.
+		template <class... Args>
+		bool try_emplace(Args&&... a_Args);
+		/// <summary>
+		/// Producer only. Push up to a_Count elements with a single index update.
+		/// Returns the amount of elements pushed.
+		/// </summary>
+		size_t push_many(const T* a_Elements, const size_t a_Count);
+
+		//Consumer only.
+		bool try_pop(T& a_Out);
+		/// <summary>
+		/// Consumer only. Pop up to a_Count elements with a single index update.
+		/// Returns the amount of elements popped.
+		/// </summary>
+		size_t pop_many(T* a_Out, const size_t a_Count);
+
+		//Only exact when neither side is working on the queue.
+		const size_t size_approx() const { return m_Tail.load(std::memory_order_acquire) - m_Head.load(std::memory_order_acquire); }
+		const size_t capacity() const { return m_Mask + 1; }
+
+	private:
+		//Reserves space for up to a_Count elements, returns how many fit.
+		size_t ProducerSpace(const size_t a_Tail, const size_t a_Count);
+		//Returns how many of up to a_Count elements are ready.
+		size_t ConsumerAvailable(const size_t a_Head, const size_t a_Count);
+
+		Allocator m_Allocator;
+		T* m_Arr;
+		size_t m_Mask;
+
+		//The indices only grow, the mask finds the slot. Unsigned overflow keeps tail - head correct.
+		alignas(LockFreeQueue_Specs::cacheLineSize) std::atomic<size_t> m_Head{ 0 };
+		size_t m_CachedTail = 0; //Consumer's copy of m_Tail.
+
+		alignas(LockFreeQueue_Specs::cacheLineSize) std::atomic<size_t> m_Tail{ 0 };
+		size_t m_CachedHead = 0; //Producer's copy of m_Head.
+	};
+
+	template<typename T>
+	inline BB::SPSCQueue<T>::SPSCQueue(Allocator a_Allocator, const size_t a_Capacity)
+		: m_Allocator(a_Allocator)
+	{
+		BB_ASSERT(a_Capacity != 0, "SPSCQueue, capacity of 0 is not allowed.");
+		const size_t t_Capacity = Math::RoundUpPowerOfTwo(a_Capacity);
+		m_Arr = reinterpret_cast<T*>(BBalloc(m_Allocator, t_Capacity * sizeof(T)));
+		m_Mask = t_Capacity - 1;
+	}
+
+	template<typename T>
+	inline BB::SPSCQueue<T>::~SPSCQueue()
+	{
+		if constexpr (!trivialDestructible_T)
+		{
+			const size_t t_Tail = m_Tail.load(std::memory_order_relaxed);
+			for (size_t i = m_Head.load(std::memory_order_relaxed); i != t_Tail; i++)
+			{
+				m_Arr[i & m_Mask].~T();
+			}
+		}
+		BBfree(m_Allocator, reinterpret_cast<void*>(m_Arr));
+	}
+
+	template<typename T>
+	inline bool BB::SPSCQueue<T>::try_push(const T& a_Element)
+	{
+		return try_emplace(a_Element);
+	}
+
+	template<typename T>
+	template<class ...Args>
+	inline bool BB::SPSCQueue<T>::try_emplace(Args&&... a_Args)
+	{
+		const size_t t_Tail = m_Tail.load(std::memory_order_relaxed);
+		if (ProducerSpace(t_Tail, 1) == 0)
+			return false;
+
+		new (&m_Arr[t_Tail & m_Mask]) T(std::forward<Args>(a_Args)...);
+		m_Tail.store(t_Tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	inline size_t BB::SPSCQueue<T>::push_many(const T* a_Elements, const size_t a_Count)
+	{
+		const size_t t_Tail = m_Tail.load(std::memory_order_relaxed);
+		const size_t t_Count = ProducerSpace(t_Tail, a_Count);
+		for (size_t i = 0; i < t_Count; i++)
+		{
+			new (&m_Arr[(t_Tail + i) & m_Mask]) T(a_Elements[i]);
+		}
+		m_Tail.store(t_Tail + t_Count, std::memory_order_release);
+		return t_Count;
+	}
+
+	template<typename T>
+	inline bool BB::SPSCQueue<T>::try_pop(T& a_Out)
+	{
+		const size_t t_Head = m_Head.load(std::memory_order_relaxed);
+		if (ConsumerAvailable(t_Head, 1) == 0)
+			return false;
+
+		T& t_Element = m_Arr[t_Head & m_Mask];
+		a_Out = std::move(t_Element);
+		if constexpr (!trivialDestructible_T)
+		{
+			t_Element.~T();
+		}
+		m_Head.store(t_Head + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	inline size_t BB::SPSCQueue<T>::pop_many(T* a_Out, const size_t a_Count)
+	{
+		const size_t t_Head = m_Head.load(std::memory_order_relaxed);
+		const size_t t_Count = ConsumerAvailable(t_Head, a_Count);
+		for (size_t i = 0; i < t_Count; i++)
+		{
+			T& t_Element = m_Arr[(t_Head + i) & m_Mask];
+			a_Out[i] = std::move(t_Element);
+			if constexpr (!trivialDestructible_T)
+			{
+				t_Element.~T();
+			}
+		}
+		m_Head.store(t_Head + t_Count, std::memory_order_release);
+		return t_Count;
+	}
+
+	template<typename T>
+	inline size_t BB::SPSCQueue<T>::ProducerSpace(const size_t a_Tail, const size_t a_Count)
+	{
+		size_t t_Free = capacity() - (a_Tail - m_CachedHead);
+		if (t_Free < a_Count)
+		{
+			//Only touch the consumer's cache line when the cached value is not enough.
+			m_CachedHead = m_Head.load(std::memory_order_acquire);
+			t_Free = capacity() - (a_Tail - m_CachedHead);
+		}
+		return t_Free < a_Count ? t_Free : a_Count;
+	}
+
+	template<typename T>
+	inline size_t BB::SPSCQueue<T>::ConsumerAvailable(const size_t a_Head, const size_t a_Count)
+	{
+		size_t t_Available = m_CachedTail - a_Head;
+		if (t_Available < a_Count)
+		{
+			//Only touch the producer's cache line when the cached value is not enough.
+			m_CachedTail = m_Tail.load(std::memory_order_acquire);
+			t_Available = m_CachedTail - a_Head;
+		}
+		return t_Available < a_Count ? t_Available : a_Count;
+	}
+
+	/// <summary>
+	/// Bounded lock-free queue for any amount of producer and consumer threads, based on Dmitry Vyukov's bounded MPMC queue.
+	/// Every cell has a sequence number that tells if it is ready to be written or read for the current lap around the buffer,
+	/// so producers and consumers only contend on their own index with a single compare exchange.
+	/// The capacity is rounded up to a power of 2 and never grows.
+	/// </summary>
+	template<typename T>
+	class MPMCQueue
+	{
+		static constexpr bool trivialDestructible_T = std::is_trivially_destructible_v<T>;
+
+		struct Cell
+		{
+			std::atomic<size_t> sequence;
+			alignas(T) unsigned char storage[sizeof(T)];
+
+			T* Element() { return reinterpret_cast<T*>(storage); }
+		};
+
+	public:
+		MPMCQueue(Allocator a_Allocator, const size_t a_Capacity);
+		~MPMCQueue();
+
+		//Shared between threads, copying or moving it while in use is never safe.
+		MPMCQueue(const MPMCQueue<T>&) = delete;
+		MPMCQueue(MPMCQueue<T>&&) = delete;
+		MPMCQueue<T>& operator=(const MPMCQueue<T>&) = delete;
+		MPMCQueue<T>& operator=(MPMCQueue<T>&&) = delete;
+
+		bool try_push(const T& a_Element);
+		template <class... Args>
+		bool try_emplace(Args&&... a_Args);
+		/// <summary>
+		/// Push up to a_Count elements, the elements claim consecutive slots with a single compare exchange.
+		/// Returns the amount of elements pushed.
+		/// </summary>
+		size_t push_many(const T* a_Elements, const size_t a_Count);
+
+		bool try_pop(T& a_Out);
+		/// <summary>
+		/// Pop up to a_Count elements, the elements claim consecutive slots with a single compare exchange.
+		/// Returns the amount of elements popped.
+		/// </summary>
+		size_t pop_many(T* a_Out, const size_t a_Count);
+
+		//Only exact when no thread is working on the queue.
+		const size_t size_approx() const { return m_EnqueuePos.load(std::memory_order_acquire) - m_DequeuePos.load(std::memory_order_acquire); }
+		const size_t capacity() const { return m_Mask + 1; }
+
+	private:
+		/// <summary>
+		/// Claims up to a_Count consecutive cells whose sequence is a_Pos + a_SequenceOffset.
+		/// Writes the first claimed position to a_Pos and returns the amount claimed, 0 when the queue is full or empty.
+		/// </summary>
+		size_t Claim(std::atomic<size_t>& a_Index, size_t& a_Pos, const size_t a_SequenceOffset, const size_t a_Count);
+
+		Allocator m_Allocator;
+		Cell* m_Cells;
+		size_t m_Mask;
+
+		alignas(LockFreeQueue_Specs::cacheLineSize) std::atomic<size_t> m_EnqueuePos{ 0 };
+		alignas(LockFreeQueue_Specs::cacheLineSize) std::atomic<size_t> m_DequeuePos{ 0 };
+	};
+
+	template<typename T>
+	inline BB::MPMCQueue<T>::MPMCQueue(Allocator a_Allocator, const size_t a_Capacity)
+		: m_Allocator(a_Allocator)
+	{
+		BB_ASSERT(a_Capacity > 1, "MPMCQueue, needs a capacity of at least 2.");
+		const size_t t_Capacity = Math::RoundUpPowerOfTwo(a_Capacity);
+		m_Cells = reinterpret_cast<Cell*>(BBalloc(m_Allocator, t_Capacity * sizeof(Cell)));
+		m_Mask = t_Capacity - 1;
+		//A cell is ready to be written for position i when its sequence is i.
+		for (size_t i = 0; i < t_Capacity; i++)
+		{
+			new (&m_Cells[i].sequence) std::atomic<size_t>(i);
+		}
+	}
+
+	template<typename T>
+	inline BB::MPMCQueue<T>::~MPMCQueue()
+	{
+		if constexpr (!trivialDestructible_T)
+		{
+			const size_t t_End = m_EnqueuePos.load(std::memory_order_relaxed);
+			for (size_t i = m_DequeuePos.load(std::memory_order_relaxed); i != t_End; i++)
+			{
+				m_Cells[i & m_Mask].Element()->~T();
+			}
+		}
+		BBfree(m_Allocator, reinterpret_cast<void*>(m_Cells));
+	}
+
+	template<typename T>
+	inline bool BB::MPMCQueue<T>::try_push(const T& a_Element)
+	{
+		return try_emplace(a_Element);
+	}
+
+	template<typename T>
+	template<class ...Args>
+	inline bool BB::MPMCQueue<T>::try_emplace(Args&&... a_Args)
+	{
+		size_t t_Pos;
+		if (Claim(m_EnqueuePos, t_Pos, 0, 1) == 0)
+			return false;
+
+		Cell& t_Cell = m_Cells[t_Pos & m_Mask];
+		new (t_Cell.Element()) T(std::forward<Args>(a_Args)...);
+		//Ready to be read for this lap.
+		t_Cell.sequence.store(t_Pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	inline size_t BB::MPMCQueue<T>::push_many(const T* a_Elements, const size_t a_Count)
+	{
+		size_t t_Pos;
+		const size_t t_Count = Claim(m_EnqueuePos, t_Pos, 0, a_Count);
+		for (size_t i = 0; i < t_Count; i++)
+		{
+			Cell& t_Cell = m_Cells[(t_Pos + i) & m_Mask];
+			new (t_Cell.Element()) T(a_Elements[i]);
+			t_Cell.sequence.store(t_Pos + i + 1, std::memory_order_release);
+		}
+		return t_Count;
+	}
+
+	template<typename T>
+	inline bool BB::MPMCQueue<T>::try_pop(T& a_Out)
+	{
+		size_t t_Pos;
+		if (Claim(m_DequeuePos, t_Pos, 1, 1) == 0)
+			return false;
+
+		Cell& t_Cell = m_Cells[t_Pos & m_Mask];
+		a_Out = std::move(*t_Cell.Element());
+		if constexpr (!trivialDestructible_T)
+		{
+			t_Cell.Element()->~T();
+		}
+		//Ready to be written for the next lap.
+		t_Cell.sequence.store(t_Pos + m_Mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	inline size_t BB::MPMCQueue<T>::pop_many(T* a_Out, const size_t a_Count)
+	{
+		size_t t_Pos;
+		const size_t t_Count = Claim(m_DequeuePos, t_Pos, 1, a_Count);
+		for (size_t i = 0; i < t_Count; i++)
+		{
+			Cell& t_Cell = m_Cells[(t_Pos + i) & m_Mask];
+			a_Out[i] = std::move(*t_Cell.Element());
+			if constexpr (!trivialDestructible_T)
+			{
+				t_Cell.Element()->~T();
+			}
+			t_Cell.sequence.store(t_Pos + i + m_Mask + 1, std::memory_order_release);
+		}
+		return t_Count;
+	}
+
+	template<typename T>
+	inline size_t BB::MPMCQueue<T>::Claim(std::atomic<size_t>& a_Index, size_t& a_Pos, const size_t a_SequenceOffset, const size_t a_Count)
+	{
+		size_t t_Pos = a_Index.load(std::memory_order_relaxed);
+		while (true)
+		{
+			//Count the consecutive cells that are ready for this side. A cell seen as ready cannot change
+			//until its position is claimed, which moves a_Index and makes the compare exchange below fail.
+			size_t t_Ready = 0;
+			while (t_Ready < a_Count)
+			{
+				const size_t t_Sequence = m_Cells[(t_Pos + t_Ready) & m_Mask].sequence.load(std::memory_order_acquire);
+				if (t_Sequence != t_Pos + t_Ready + a_SequenceOffset)
+					break;
+				++t_Ready;
+			}
+
+			if (t_Ready == 0)
+			{
+				const size_t t_Sequence = m_Cells[t_Pos & m_Mask].sequence.load(std::memory_order_acquire);
+				//Signed difference, behind means the cell is still in use by the previous lap so the queue is full or empty.
+				const intptr_t t_Difference = static_cast<intptr_t>(t_Sequence) - static_cast<intptr_t>(t_Pos + a_SequenceOffset);
+				if (t_Difference < 0)
+					return 0;
+				//Another thread already claimed this position, try again from the new index.
+				t_Pos = a_Index.load(std::memory_order_relaxed);
+				continue;
+			}
+
+			if (a_Index.compare_exchange_weak(t_Pos, t_Pos + t_Ready, std::memory_order_relaxed))
+			{
+				a_Pos = t_Pos;
+				return t_Ready;
+			}
+			//t_Pos now holds the current index, try again.
+		}
+	}
+}
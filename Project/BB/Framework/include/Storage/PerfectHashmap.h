@@ -0,0 +1,250 @@
+#pragma once
+#include "Utils/Hash.h"
+#include "Utils/Logger.h"
+
+#include <type_traits>
+
+namespace BB
+{
+	namespace PerfectHash_Specs
+	{
+		constexpr const uint64_t seedMultiplier = 0x9E3779B97F4A7C15ull;
+		constexpr const uint64_t slotMultiplier = 0xD6E8FEB86659FD93ull;
+		//Give up on a bucket after this many seeds, only happens with keys that have the same hash.
+		constexpr const uint32_t maxSeedTries = 1u << 20;
+
+		constexpr size_t RoundUpPowerOfTwo(const size_t a_Value)
+		{
+			size_t t_Result = 2;
+			while (t_Result < a_Value)
+				t_Result <<= 1;
+			return t_Result;
+		}
+
+		constexpr size_t Log2(size_t a_Value)
+		{
+			size_t t_Result = 0;
+			while (a_Value >>= 1)
+				++t_Result;
+			return t_Result;
+		}
+	}
+
+	//How a key type is hashed and compared, the constexpr hash must give the same result as the runtime hash.
+	template<typename Key, typename Enable = void>
+	struct PerfectHash_KeyTraits;
+
+	template<typename Key>
+	struct PerfectHash_KeyTraits<Key, std::enable_if_t<std::is_integral_v<Key>>>
+	{
+		static constexpr Key EmptyKey() { return Key(); }
+		static constexpr uint64_t HashConstexpr(const Key a_Key) { return Hash::MakeHashConstexpr(static_cast<uint64_t>(a_Key)); }
+		static uint64_t HashRuntime(const Key a_Key) { return Hash::MakeHash(static_cast<size_t>(a_Key)); }
+		static constexpr bool Equal(const Key a_A, const Key a_B) { return a_A == a_B; }
+	};
+
+	template<>
+	struct PerfectHash_KeyTraits<const char*>
+	{
+		static constexpr const char* EmptyKey() { return ""; }
+		static constexpr size_t Length(const char* a_Key)
+		{
+			size_t t_Length = 0;
+			while (a_Key[t_Length] != '\0')
+				++t_Length;
+			return t_Length;
+		}
+		static constexpr uint64_t HashConstexpr(const char* a_Key) { return Hash::MakeHashConstexpr(a_Key, Length(a_Key)); }
+		static uint64_t HashRuntime(const char* a_Key) { return Hash::MakeHash(a_Key); }
+		static constexpr bool Equal(const char* a_A, const char* a_B)
+		{
+			while (*a_A != '\0' && *a_A == *a_B)
+			{
+				++a_A;
+				++a_B;
+			}
+			return *a_A == *a_B;
+		}
+	};
+
+	template<typename Key, typename Value>
+	struct PerfectHashEntry
+	{
+		Key key;
+		Value value;
+	};
+
+	/// <summary>
+	/// Read only hashmap for a key set that is known at compile time, build it as a constexpr variable.
+	/// Every key has its own slot so a lookup is a single probe and a single key compare.
+	/// Uses hash and displace: keys are split in buckets and every bucket gets a seed that places its keys in free slots.
+	/// Keys are integers or const char* string literals.
+	/// </summary>
+	template<typename Key, typename Value, size_t N>
+	class PerfectHashMap
+	{
+		static_assert(N > 0, "PerfectHashMap needs at least one key.");
+		using KeyTraits = PerfectHash_KeyTraits<Key>;
+		static constexpr bool stringKey = std::is_same_v<Key, const char*>;
+
+		//Keep the load factor under 0.8 so the seed search stays quick.
+		static constexpr size_t TableSize = PerfectHash_Specs::RoundUpPowerOfTwo(N + N / 4);
+		static constexpr size_t BucketCount = PerfectHash_Specs::RoundUpPowerOfTwo(N / 2);
+		static constexpr size_t SlotShift = 64 - PerfectHash_Specs::Log2(TableSize);
+
+	public:
+		//A duplicate key or a bucket without a seed stops the compile of a constexpr build, in every configuration.
+		constexpr PerfectHashMap(const PerfectHashEntry<Key, Value>(&a_Entries)[N])
+		{
+			if (!UniqueKeys(a_Entries))
+				BuildFailed("PerfectHashMap has a duplicate key.");
+
+			uint64_t t_Hashes[N]{};
+			for (size_t i = 0; i < N; i++)
+				t_Hashes[i] = KeyTraits::HashConstexpr(a_Entries[i].key);
+
+			//Sort the keys by bucket.
+			size_t t_BucketStart[BucketCount + 1]{};
+			for (size_t i = 0; i < N; i++)
+				++t_BucketStart[Bucket(t_Hashes[i]) + 1];
+			size_t t_MaxBucketSize = 0;
+			for (size_t i = 0; i < BucketCount; i++)
+			{
+				if (t_BucketStart[i + 1] > t_MaxBucketSize)
+					t_MaxBucketSize = t_BucketStart[i + 1];
+				t_BucketStart[i + 1] += t_BucketStart[i];
+			}
+
+			size_t t_BucketFill[BucketCount]{};
+			size_t t_Order[N]{};
+			for (size_t i = 0; i < N; i++)
+			{
+				const size_t t_Bucket = Bucket(t_Hashes[i]);
+				t_Order[t_BucketStart[t_Bucket] + t_BucketFill[t_Bucket]++] = i;
+			}
+
+			//Place the biggest buckets first while the table is still mostly empty.
+			for (size_t t_Size = t_MaxBucketSize; t_Size > 0; t_Size--)
+			{
+				for (size_t t_Bucket = 0; t_Bucket < BucketCount; t_Bucket++)
+				{
+					if (t_BucketFill[t_Bucket] != t_Size)
+						continue;
+
+					const size_t t_Start = t_BucketStart[t_Bucket];
+					uint32_t t_Seed = 0;
+					for (; t_Seed < PerfectHash_Specs::maxSeedTries; t_Seed++)
+					{
+						size_t t_Placed = 0;
+						for (; t_Placed < t_Size; t_Placed++)
+						{
+							const size_t t_Slot = Slot(t_Hashes[t_Order[t_Start + t_Placed]], t_Seed);
+							if (m_Occupied[t_Slot])
+								break;
+							m_Occupied[t_Slot] = true;
+						}
+
+						if (t_Placed == t_Size)
+							break;
+
+						//Undo the keys of this bucket that got a slot with this seed.
+						for (size_t i = 0; i < t_Placed; i++)
+							m_Occupied[Slot(t_Hashes[t_Order[t_Start + i]], t_Seed)] = false;
+					}
+					if (t_Seed == PerfectHash_Specs::maxSeedTries)
+						BuildFailed("PerfectHashMap could not find a seed for a bucket.");
+					m_Seeds[t_Bucket] = t_Seed;
+				}
+			}
+
+			for (size_t i = 0; i < TableSize; i++)
+				m_Keys[i] = KeyTraits::EmptyKey();
+
+			for (size_t i = 0; i < N; i++)
+			{
+				const size_t t_Slot = Slot(t_Hashes[i], m_Seeds[Bucket(t_Hashes[i])]);
+				m_Hashes[t_Slot] = t_Hashes[i];
+				m_Keys[t_Slot] = a_Entries[i].key;
+				m_Values[t_Slot] = a_Entries[i].value;
+				if constexpr (stringKey)
+					m_KeyLengths[t_Slot] = static_cast<uint32_t>(KeyTraits::Length(a_Entries[i].key));
+			}
+		}
+
+		const Value* find(const Key& a_Key) const
+		{
+			return find_hashed(a_Key, KeyTraits::HashRuntime(a_Key));
+		}
+		/// <summary>
+		/// Find with a hash that was already calculated, a_Hash must be the Hash::MakeHash of the key.
+		/// Pass a Hash::MakeHashConstexpr to do the lookup at compile time.
+		/// </summary>
+		constexpr const Value* find_hashed(const Key& a_Key, const uint64_t a_Hash) const
+		{
+			const size_t t_Slot = Slot(a_Hash, m_Seeds[Bucket(a_Hash)]);
+			if (m_Occupied[t_Slot] && m_Hashes[t_Slot] == a_Hash && KeyTraits::Equal(m_Keys[t_Slot], a_Key))
+				return &m_Values[t_Slot];
+			return nullptr;
+		}
+		/// <summary>
+		/// Find a string key using a string that does not need to be null terminated.
+		/// </summary>
+		const Value* find(const char* a_String, const size_t a_Length) const
+		{
+			static_assert(stringKey, "PerfectHashMap string lookup only works with const char* keys.");
+			const uint64_t t_Hash = Hash::MakeHash(a_String, a_Length);
+			const size_t t_Slot = Slot(t_Hash, m_Seeds[Bucket(t_Hash)]);
+			if (m_Occupied[t_Slot] && m_Hashes[t_Slot] == t_Hash &&
+				m_KeyLengths[t_Slot] == a_Length && memcmp(m_Keys[t_Slot], a_String, a_Length) == 0)
+				return &m_Values[t_Slot];
+			return nullptr;
+		}
+
+		constexpr size_t size() const { return N; }
+
+		//Returns false if a key is in a_Entries more than once, the constructor refuses those.
+		static constexpr bool UniqueKeys(const PerfectHashEntry<Key, Value>(&a_Entries)[N])
+		{
+			for (size_t i = 0; i < N; i++)
+				for (size_t j = 0; j < i; j++)
+					if (KeyTraits::Equal(a_Entries[i].key, a_Entries[j].key))
+						return false;
+			return true;
+		}
+
+	private:
+		//Not constexpr on purpose, reaching it during constant evaluation is a compile error.
+		//A runtime build asserts in debug.
+		static void BuildFailed(const char* a_Message)
+		{
+			BB_ASSERT(false, a_Message);
+		}
+
+		static constexpr size_t Bucket(const uint64_t a_Hash)
+		{
+			return static_cast<size_t>(a_Hash & (BucketCount - 1));
+		}
+		static constexpr size_t Slot(const uint64_t a_Hash, const uint32_t a_Seed)
+		{
+			return static_cast<size_t>(((a_Hash ^ (a_Seed * PerfectHash_Specs::seedMultiplier)) * PerfectHash_Specs::slotMultiplier) >> SlotShift);
+		}
+
+		uint32_t m_Seeds[BucketCount]{};
+		bool m_Occupied[TableSize]{};
+		uint64_t m_Hashes[TableSize]{};
+		Key m_Keys[TableSize]{};
+		Value m_Values[TableSize]{};
+		//Only used by string keys so a compare can check the length first.
+		uint32_t m_KeyLengths[stringKey ? TableSize : 1]{};
+	};
+
+	/// <summary>
+	/// Create a PerfectHashMap without writing down the key count.
+	/// constexpr auto t_Map = MakePerfectHashMap<const char*, int>({ { "width", 0 }, { "height", 1 } });
+	/// </summary>
+	template<typename Key, typename Value, size_t N>
+	constexpr PerfectHashMap<Key, Value, N> MakePerfectHashMap(const PerfectHashEntry<Key, Value>(&a_Entries)[N])
+	{
+		return PerfectHashMap<Key, Value, N>(a_Entries);
+	}
+}
@@ -2,22 +2,136 @@
 #include "Utils/Logger.h"
 #include "BBMemory.h"
 
+#include "Storage/BitArray.h"
+
 namespace BB
 {
+	//An object that Compact moved, pointers to from must be changed to to.
+	template<typename T>
+	struct PoolRelocation
+	{
+		T* from;
+		T* to;
+	};
+
+	/// <summary>
+	/// Goes over the live objects of a pool in address order by walking the set bits of the occupancy bitmap.
+	/// </summary>
+	template<typename T>
+	struct PoolIterator
+	{
+		PoolIterator(T* a_Objects, const SetBitRange::Iterator a_Bit) : m_Objects(a_Objects), m_Bit(a_Bit) {}
+
+		T& operator*() const { return m_Objects[*m_Bit]; }
+		T* operator->() const { return &m_Objects[*m_Bit]; }
+
+		PoolIterator& operator++()
+		{
+			++m_Bit;
+			return *this;
+		}
+
+		friend bool operator== (const PoolIterator& a_Lhs, const PoolIterator& a_Rhs) { return a_Lhs.m_Bit == a_Rhs.m_Bit; };
+		friend bool operator!= (const PoolIterator& a_Lhs, const PoolIterator& a_Rhs) { return a_Lhs.m_Bit != a_Rhs.m_Bit; };
+
+	private:
+		T* m_Objects;
+		SetBitRange::Iterator m_Bit;
+	};
+
+	//Occupancy bitmap functions shared by Pool and GrowPool, one bit per slot and only slots below the bump pointer are valid.
+	namespace PoolOccupancy
+	{
+		//A bumped slot that starts a new word clears that word first, the bitmap is never touched ahead of the slots.
+		inline void MarkBumped(uint64_t* a_Occupancy, const size_t a_Index)
+		{
+			if ((a_Index & BitArray_Specs::wordMask) == 0)
+				a_Occupancy[a_Index >> BitArray_Specs::wordShift] = 0;
+			a_Occupancy[a_Index >> BitArray_Specs::wordShift] |= 1ull << (a_Index & BitArray_Specs::wordMask);
+		}
+
+		inline void Set(uint64_t* a_Occupancy, const size_t a_Index)
+		{
+			a_Occupancy[a_Index >> BitArray_Specs::wordShift] |= 1ull << (a_Index & BitArray_Specs::wordMask);
+		}
+
+		inline void Reset(uint64_t* a_Occupancy, const size_t a_Index)
+		{
+			a_Occupancy[a_Index >> BitArray_Specs::wordShift] &= ~(1ull << (a_Index & BitArray_Specs::wordMask));
+		}
+
+		inline bool Test(const uint64_t* a_Occupancy, const size_t a_Index)
+		{
+			return (a_Occupancy[a_Index >> BitArray_Specs::wordShift] >> (a_Index & BitArray_Specs::wordMask)) & 1;
+		}
+
+		/// <summary>
+		/// Move up to a_MaxRelocations live objects from the back into the lowest free slots.
+		/// a_UsedSlots shrinks to just after the last live object. Returns the amount of relocations written.
+		/// </summary>
+		template<typename T>
+		size_t Compact(T* a_Objects, uint64_t* a_Occupancy, size_t& a_UsedSlots, PoolRelocation<T>* a_Relocations, const size_t a_MaxRelocations)
+		{
+			size_t t_Moved = 0;
+			size_t t_Hole = BitOps::FindFirstUnset(a_Occupancy, 0, a_UsedSlots);
+			size_t t_Live = BitOps::FindLastSet(a_Occupancy, 0, a_UsedSlots);
+			while (t_Moved < a_MaxRelocations && t_Live != a_UsedSlots && t_Hole < t_Live)
+			{
+				Memory::Move(&a_Objects[t_Hole], &a_Objects[t_Live], 1);
+				Set(a_Occupancy, t_Hole);
+				Reset(a_Occupancy, t_Live);
+				a_Relocations[t_Moved].from = &a_Objects[t_Live];
+				a_Relocations[t_Moved].to = &a_Objects[t_Hole];
+				++t_Moved;
+
+				t_Hole = BitOps::FindFirstUnset(a_Occupancy, t_Hole + 1, a_UsedSlots);
+				const size_t t_NextLive = BitOps::FindLastSet(a_Occupancy, 0, t_Live);
+				t_Live = t_NextLive == t_Live ? a_UsedSlots : t_NextLive;
+			}
+
+			//The free slots at the end go back to the bump range.
+			const size_t t_Last = BitOps::FindLastSet(a_Occupancy, 0, a_UsedSlots);
+			a_UsedSlots = t_Last == a_UsedSlots ? 0 : t_Last + 1;
+			return t_Moved;
+		}
+
+		//Links the free slots below a_UsedSlots in address order, returns the new head of the free list.
+		template<typename T>
+		T** BuildFreeList(T* a_Objects, const uint64_t* a_Occupancy, const size_t a_UsedSlots)
+		{
+			T** t_Head = nullptr;
+			T** t_Tail = nullptr;
+			for (size_t i = BitOps::FindFirstUnset(a_Occupancy, 0, a_UsedSlots); i < a_UsedSlots; i = BitOps::FindFirstUnset(a_Occupancy, i + 1, a_UsedSlots))
+			{
+				T** t_Slot = reinterpret_cast<T**>(&a_Objects[i]);
+				if (t_Tail == nullptr)
+					t_Head = t_Slot;
+				else
+					*t_Tail = reinterpret_cast<T*>(t_Slot);
+				t_Tail = t_Slot;
+			}
+			if (t_Tail != nullptr)
+				*t_Tail = nullptr;
+			return t_Head;
+		}
+	}
+
 	/// <summary>
 	/// NON_RAII and does not support non-POD types. 
 	/// You must call the destructor and constructor yourself.
 	/// Create the pool by using CreatePool and DestroyPool. 
 	/// A special container that is not responsible for it's own deallocation. 
 	/// It has enough memory to hold element T equal to the size given. 
+	/// Slots that were never used are handed out by bumping a pointer, only freed slots go in the free list.
+	/// Creating the pool does not touch the memory of the slots.
+	/// An occupancy bitmap tracks the live objects, iterate over them in address order with a range for loop.
 	/// </summary>
 	template<typename T>
 	class Pool
 	{
 	public:
-#ifdef _DEBUG
-		//Must have a constructor because of the debug destructor
 		Pool() {};
+#ifdef _DEBUG
 		~Pool();
 #endif _DEBUG
 
@@ -37,13 +151,36 @@ namespace BB
 		/// </summary>
 		T* Get();
 		/// <summary>
+		/// Get up to a_Count objects from the pool, returns the amount of objects written to a_Out.
+		/// </summary>
+		size_t GetMany(T** a_Out, const size_t a_Count);
+		/// <summary>
 		/// Return an object to the pool.
 		/// </summary>
 		void Free(T* a_Ptr);
+		/// <summary>
+		/// Return a_Count objects to the pool with a single update of the free list.
+		/// </summary>
+		void FreeMany(T* const* a_Ptrs, const size_t a_Count);
+
+		/// <summary>
+		/// Move live objects from the back of the pool into free slots at the front, at most a_MaxRelocations of them.
+		/// Every move is written to a_Relocations so pointers to the moved objects can be updated, returns the amount of moves.
+		/// Can be called every frame with a small budget.
+		/// </summary>
+		size_t Compact(PoolRelocation<T>* a_Relocations, const size_t a_MaxRelocations);
+
+		bool IsLive(const T* a_Ptr) const { return a_Ptr >= data() && a_Ptr < m_Bump && PoolOccupancy::Test(m_Occupancy, a_Ptr - data()); }
+
+		//Iterates over the live objects in address order.
+		PoolIterator<T> begin() const { return PoolIterator<T>(data(), SetBitRange::Iterator(m_Occupancy, UsedWords(), 0)); }
+		PoolIterator<T> end() const { return PoolIterator<T>(data(), SetBitRange::Iterator(m_Occupancy, UsedWords(), UsedWords())); }
 
 		T* data() const { return reinterpret_cast<T*>(m_Start); }
 
 	private:
+		size_t UsedWords() const { return BitArray_Specs::WordCount(static_cast<size_t>(m_Bump - data())); }
+
 #ifdef _DEBUG
 		//Debug we can check it's current size.
 		size_t m_Size;
@@ -53,7 +190,13 @@ namespace BB
 #endif // _DEBUG
 
 		void* m_Start = nullptr;
-		T** m_Pool;
+		//Head of the free list of returned objects.
+		T** m_Pool = nullptr;
+		//The first slot that was never handed out and the end of the pool.
+		T* m_Bump = nullptr;
+		T* m_End = nullptr;
+		//1 bit per slot, set when the object is live.
+		uint64_t* m_Occupancy = nullptr;
 	};
 
 #ifdef _DEBUG
@@ -69,8 +212,14 @@ namespace BB
 	{
 		m_Start = a_Pool.m_Start;
 		m_Pool = a_Pool.m_Pool;
-		m_Start = nullptr;
-		m_Pool = nullptr;
+		m_Bump = a_Pool.m_Bump;
+		m_End = a_Pool.m_End;
+		m_Occupancy = a_Pool.m_Occupancy;
+		a_Pool.m_Start = nullptr;
+		a_Pool.m_Pool = nullptr;
+		a_Pool.m_Bump = nullptr;
+		a_Pool.m_End = nullptr;
+		a_Pool.m_Occupancy = nullptr;
 
 #ifdef _DEBUG
 		m_Size = a_Pool.m_Size;
@@ -88,8 +237,14 @@ namespace BB
 	{
 		m_Start = a_Rhs.m_Start;
 		m_Pool = a_Rhs.m_Pool;
+		m_Bump = a_Rhs.m_Bump;
+		m_End = a_Rhs.m_End;
+		m_Occupancy = a_Rhs.m_Occupancy;
 		a_Rhs.m_Start = nullptr;
 		a_Rhs.m_Pool = nullptr;
+		a_Rhs.m_Bump = nullptr;
+		a_Rhs.m_End = nullptr;
+		a_Rhs.m_Occupancy = nullptr;
 
 #ifdef _DEBUG
 		m_Size = a_Rhs.m_Size;
@@ -116,17 +271,14 @@ namespace BB
 		m_Allocator = a_Allocator;
 #endif //_DEBUG
 
-		m_Start = BBalloc(a_Allocator, a_Size * sizeof(T));
-		m_Pool = reinterpret_cast<T**>(m_Start);
-
-		T** t_Pool = m_Pool;
-
-		for (size_t i = 0; i < a_Size - 1; i++)
-		{
-			*t_Pool = (reinterpret_cast<T*>(t_Pool)) + 1;
-			t_Pool = reinterpret_cast<T**>(*t_Pool);
-		}
-		*t_Pool = nullptr;
+		//The occupancy bitmap lives behind the objects in the same allocation.
+		const size_t t_ObjectBytes = Math::RoundUp(a_Size * sizeof(T), sizeof(uint64_t));
+		m_Start = BBalloc(a_Allocator, t_ObjectBytes + BitArray_Specs::WordCount(a_Size) * sizeof(uint64_t));
+		m_Occupancy = reinterpret_cast<uint64_t*>(Pointer::Add(m_Start, t_ObjectBytes));
+		//No free list yet, every slot comes from the bump pointer the first time.
+		m_Pool = nullptr;
+		m_Bump = reinterpret_cast<T*>(m_Start);
+		m_End = m_Bump + a_Size;
 	}
 
 	template<typename T>
@@ -146,17 +298,26 @@ namespace BB
 	template<class T>
 	inline T* Pool<T>::Get()
 	{
-		if (m_Pool == nullptr)
+		T* t_Ptr;
+		if (m_Pool != nullptr)
+		{
+			//Take the freelist
+			t_Ptr = reinterpret_cast<T*>(m_Pool);
+			//Set the new head of the freelist.
+			m_Pool = reinterpret_cast<T**>(*m_Pool);
+			PoolOccupancy::Set(m_Occupancy, t_Ptr - data());
+		}
+		else if (m_Bump != m_End)
+		{
+			PoolOccupancy::MarkBumped(m_Occupancy, m_Bump - data());
+			t_Ptr = m_Bump++;
+		}
+		else
 		{
 			BB_WARNING(false, "Trying to get an pool object while there are none left!", WarningType::HIGH);
 			return nullptr;
 		}
 
-		//Take the freelist
-		T* t_Ptr = reinterpret_cast<T*>(m_Pool);
-		//Set the new head of the freelist.
-		m_Pool = reinterpret_cast<T**>(*m_Pool);
-
 #ifdef _DEBUG
 		++m_Size;
 #endif //_DEBUG
@@ -164,6 +325,30 @@ namespace BB
 		return t_Ptr;
 	}
 
+	template<typename T>
+	inline size_t Pool<T>::GetMany(T** a_Out, const size_t a_Count)
+	{
+		size_t t_Got = 0;
+		for (; t_Got < a_Count && m_Pool != nullptr; t_Got++)
+		{
+			a_Out[t_Got] = reinterpret_cast<T*>(m_Pool);
+			m_Pool = reinterpret_cast<T**>(*m_Pool);
+			PoolOccupancy::Set(m_Occupancy, a_Out[t_Got] - data());
+		}
+		for (; t_Got < a_Count && m_Bump != m_End; t_Got++)
+		{
+			PoolOccupancy::MarkBumped(m_Occupancy, m_Bump - data());
+			a_Out[t_Got] = m_Bump++;
+		}
+
+		BB_WARNING(t_Got == a_Count, "Trying to get more pool objects than there are left!", WarningType::HIGH);
+#ifdef _DEBUG
+		m_Size += t_Got;
+#endif //_DEBUG
+
+		return t_Got;
+	}
+
 	template<typename T>
 	inline void BB::Pool<T>::Free(T* a_Ptr)
 	{
@@ -171,10 +356,46 @@ namespace BB
 		BB_ASSERT((a_Ptr >= m_Start && a_Ptr < Pointer::Add(m_Start,  m_Capacity * sizeof(T))), "Trying to free an pool object that is not part of this pool!");
 		--m_Size;
 #endif // _DEBUG
+		BB_ASSERT(IsLive(a_Ptr), "Trying to free an pool object that is not live, likely a double free.");
+		PoolOccupancy::Reset(m_Occupancy, a_Ptr - data());
 
 		//Set the previous free list to the new head.
 		(*reinterpret_cast<T**>(a_Ptr)) = reinterpret_cast<T*>(m_Pool);
 		//Set the new head.
 		m_Pool = reinterpret_cast<T**>(a_Ptr);
 	}
+
+	template<typename T>
+	inline void BB::Pool<T>::FreeMany(T* const* a_Ptrs, const size_t a_Count)
+	{
+		if (a_Count == 0)
+			return;
+
+		//Link the objects to each other and put the chain in front of the free list.
+		for (size_t i = 0; i < a_Count; i++)
+		{
+#ifdef _DEBUG
+			BB_ASSERT((a_Ptrs[i] >= m_Start && a_Ptrs[i] < Pointer::Add(m_Start, m_Capacity * sizeof(T))), "Trying to free an pool object that is not part of this pool!");
+#endif // _DEBUG
+			BB_ASSERT(IsLive(a_Ptrs[i]), "Trying to free an pool object that is not live, likely a double free.");
+			PoolOccupancy::Reset(m_Occupancy, a_Ptrs[i] - data());
+			(*reinterpret_cast<T**>(a_Ptrs[i])) = i + 1 < a_Count ? a_Ptrs[i + 1] : reinterpret_cast<T*>(m_Pool);
+		}
+		m_Pool = reinterpret_cast<T**>(a_Ptrs[0]);
+
+#ifdef _DEBUG
+		m_Size -= a_Count;
+#endif // _DEBUG
+	}
+
+	template<typename T>
+	inline size_t BB::Pool<T>::Compact(PoolRelocation<T>* a_Relocations, const size_t a_MaxRelocations)
+	{
+		size_t t_UsedSlots = static_cast<size_t>(m_Bump - data());
+		const size_t t_Moved = PoolOccupancy::Compact(data(), m_Occupancy, t_UsedSlots, a_Relocations, a_MaxRelocations);
+		m_Bump = data() + t_UsedSlots;
+		//The old free list has slots that are now live or above the bump pointer.
+		m_Pool = PoolOccupancy::BuildFreeList(data(), m_Occupancy, t_UsedSlots);
+		return t_Moved;
+	}
 }
\ No newline at end of file
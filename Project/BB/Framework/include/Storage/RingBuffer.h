@@ -0,0 +1,399 @@
+#pragma once
+#include "Utils/Logger.h"
+#include "BBMemory.h"
+
+#include "Utils/Utils.h"
+#include "Utils/Slice.h"
+
+namespace BB
+{
+	namespace RingBuffer_Specs
+	{
+		constexpr const size_t standardSize = 16;
+	};
+
+	/// <summary>
+	/// Double ended queue in a single power of 2 sized buffer, indices wrap with a mask instead of a branch or modulo.
+	/// Elements can be pushed and popped at both ends. When a_CanGrow is false a full RingBuffer will not allocate,
+	/// push functions assert and try_push_back returns false instead.
+	/// </summary>
+	template<typename T>
+	class RingBuffer
+	{
+		static constexpr bool trivialDestructible_T = std::is_trivially_destructible_v<T>;
+
+	public:
+		BB_TRIVIALLY_RELOCATABLE;
+
+		//a_Capacity is rounded up to a power of 2.
+		RingBuffer(Allocator a_Allocator, const size_t a_Capacity = RingBuffer_Specs::standardSize, const bool a_CanGrow = true);
+		RingBuffer(const RingBuffer<T>& a_RingBuffer);
+		RingBuffer(RingBuffer<T>&& a_RingBuffer) noexcept;
+		~RingBuffer();
+
+		RingBuffer<T>& operator=(const RingBuffer<T>& a_Rhs);
+		RingBuffer<T>& operator=(RingBuffer<T>&& a_Rhs) noexcept;
+		//Index 0 is the front.
+		T& operator[](const size_t a_Index) const;
+
+		T& front() const;
+		T& back() const;
+
+		void push_back(const T& a_Element);
+		void push_front(const T& a_Element);
+		template <class... Args>
+		T& emplace_back(Args&&... a_Args);
+		template <class... Args>
+		T& emplace_front(Args&&... a_Args);
+		//Returns false when the RingBuffer is full and is not allowed to grow.
+		bool try_push_back(const T& a_Element);
+
+		void pop_front();
+		void pop_back();
+		//Destructs a_Count elements from the front.
+		void pop_front(const size_t a_Count);
+
+		/// <summary>
+		/// Push a_Count elements to the back, at most 2 copies of contiguous memory.
+		/// </summary>
+		void push_back(const T* a_Elements, const size_t a_Count);
+		/// <summary>
+		/// Copy up to a_Count elements from the front into a_Destination and pop them.
+		/// Returns the amount of elements copied.
+		/// </summary>
+		size_t pop_front(T* a_Destination, const size_t a_Count);
+
+		/// <summary>
+		/// The elements from the front until the end of the buffer or the back, whichever comes first.
+		/// pop_front(read_span().size()) and then read_span() again gives the rest of the elements.
+		/// </summary>
+		Slice<T> read_span() const;
+		/// <summary>
+		/// Unused slots after the back until the end of the buffer or the front, whichever comes first.
+		/// Write into it and call commit_write with the amount of elements written. Only for trivially copyable types.
+		/// </summary>
+		Slice<T> write_span() const;
+		void commit_write(const size_t a_Count);
+
+		void reserve(const size_t a_Capacity);
+		void clear();
+
+		const size_t size() const { return m_Size; }
+		const size_t capacity() const { return m_Capacity; }
+		const bool empty() const { return m_Size == 0; }
+		const bool full() const { return m_Size == m_Capacity; }
+
+	private:
+		//Returns the buffer slot that the element at a_Index lives in.
+		size_t Slot(const size_t a_Index) const { return (m_Head + a_Index) & (m_Capacity - 1); }
+		//Makes sure there is space for 1 more element, grows or asserts.
+		void MakeSpace();
+		//This function also changes the m_Capacity value.
+		void reallocate(const size_t a_NewCapacity);
+		void CopyFrom(const RingBuffer<T>& a_RingBuffer);
+		void MoveFrom(RingBuffer<T>& a_RingBuffer);
+		//Destroys the elements and frees the buffer, back to an empty RingBuffer.
+		void Release();
+
+		Allocator m_Allocator;
+
+		T* m_Arr = nullptr;
+		size_t m_Head = 0;
+		size_t m_Size = 0;
+		size_t m_Capacity = 0;
+		bool m_CanGrow;
+	};
+
+	template<typename T>
+	inline BB::RingBuffer<T>::RingBuffer(Allocator a_Allocator, const size_t a_Capacity, const bool a_CanGrow)
+		: m_Allocator(a_Allocator), m_CanGrow(a_CanGrow)
+	{
+		BB_ASSERT(a_Capacity != 0, "RingBuffer, capacity of 0 is not allowed.");
+		reallocate(Math::RoundUpPowerOfTwo(a_Capacity));
+	}
+
+	template<typename T>
+	inline BB::RingBuffer<T>::RingBuffer(const RingBuffer<T>& a_RingBuffer)
+		: m_Allocator(a_RingBuffer.m_Allocator), m_CanGrow(a_RingBuffer.m_CanGrow)
+	{
+		CopyFrom(a_RingBuffer);
+	}
+
+	template<typename T>
+	inline BB::RingBuffer<T>::RingBuffer(RingBuffer<T>&& a_RingBuffer) noexcept
+		: m_Allocator(a_RingBuffer.m_Allocator), m_CanGrow(a_RingBuffer.m_CanGrow)
+	{
+		MoveFrom(a_RingBuffer);
+	}
+
+	template<typename T>
+	inline BB::RingBuffer<T>::~RingBuffer()
+	{
+		Release();
+	}
+
+	template<typename T>
+	inline RingBuffer<T>& BB::RingBuffer<T>::operator=(const RingBuffer<T>& a_Rhs)
+	{
+		Release();
+
+		m_Allocator = a_Rhs.m_Allocator;
+		m_CanGrow = a_Rhs.m_CanGrow;
+		CopyFrom(a_Rhs);
+
+		return *this;
+	}
+
+	template<typename T>
+	inline RingBuffer<T>& BB::RingBuffer<T>::operator=(RingBuffer<T>&& a_Rhs) noexcept
+	{
+		Release();
+
+		m_Allocator = a_Rhs.m_Allocator;
+		m_CanGrow = a_Rhs.m_CanGrow;
+		MoveFrom(a_Rhs);
+
+		return *this;
+	}
+
+	template<typename T>
+	inline T& BB::RingBuffer<T>::operator[](const size_t a_Index) const
+	{
+		BB_ASSERT(a_Index < m_Size, "RingBuffer, trying to get an element using the [] operator but that element is not there.");
+		return m_Arr[Slot(a_Index)];
+	}
+
+	template<typename T>
+	inline T& BB::RingBuffer<T>::front() const
+	{
+		BB_ASSERT(m_Size != 0, "RingBuffer, getting the front while m_Size is 0!");
+		return m_Arr[m_Head];
+	}
+
+	template<typename T>
+	inline T& BB::RingBuffer<T>::back() const
+	{
+		BB_ASSERT(m_Size != 0, "RingBuffer, getting the back while m_Size is 0!");
+		return m_Arr[Slot(m_Size - 1)];
+	}
+
+	template<typename T>
+	inline void BB::RingBuffer<T>::push_back(const T& a_Element)
+	{
+		emplace_back(a_Element);
+	}
+
+	template<typename T>
+	inline void BB::RingBuffer<T>::push_front(const T& a_Element)
+	{
+		emplace_front(a_Element);
+	}
+
+	template<typename T>
+	template<class ...Args>
+	inline T& BB::RingBuffer<T>::emplace_back(Args&&... a_Args)
+	{
+		MakeSpace();
+
+		T* t_Element = new (&m_Arr[Slot(m_Size)]) T(std::forward<Args>(a_Args)...);
+		m_Size++;
+		return *t_Element;
+	}
+
+	template<typename T>
+	template<class ...Args>
+	inline T& BB::RingBuffer<T>::emplace_front(Args&&... a_Args)
+	{
+		MakeSpace();
+
+		//Unsigned wrap around is fine, the mask brings it back in range.
+		m_Head = (m_Head - 1) & (m_Capacity - 1);
+		T* t_Element = new (&m_Arr[m_Head]) T(std::forward<Args>(a_Args)...);
+		m_Size++;
+		return *t_Element;
+	}
+
+	template<typename T>
+	inline bool BB::RingBuffer<T>::try_push_back(const T& a_Element)
+	{
+		if (full() && !m_CanGrow)
+			return false;
+
+		emplace_back(a_Element);
+		return true;
+	}
+
+	template<typename T>
+	inline void BB::RingBuffer<T>::pop_front()
+	{
+		BB_ASSERT(m_Size != 0, "RingBuffer, Popping while m_Size is 0!");
+		if constexpr (!trivialDestructible_T)
+		{
+			m_Arr[m_Head].~T();
+		}
+		m_Head = (m_Head + 1) & (m_Capacity - 1);
+		--m_Size;
+	}
+
+	template<typename T>
+	inline void BB::RingBuffer<T>::pop_back()
+	{
+		BB_ASSERT(m_Size != 0, "RingBuffer, Popping while m_Size is 0!");
+		--m_Size;
+		if constexpr (!trivialDestructible_T)
+		{
+			m_Arr[Slot(m_Size)].~T();
+		}
+	}
+
+	template<typename T>
+	inline void BB::RingBuffer<T>::pop_front(const size_t a_Count)
+	{
+		BB_ASSERT(a_Count <= m_Size, "RingBuffer, Popping more elements than there are in the RingBuffer!");
+		if constexpr (!trivialDestructible_T)
+		{
+			for (size_t i = 0; i < a_Count; i++)
+			{
+				m_Arr[Slot(i)].~T();
+			}
+		}
+		m_Head = Slot(a_Count);
+		m_Size -= a_Count;
+	}
+
+	template<typename T>
+	inline void BB::RingBuffer<T>::push_back(const T* a_Elements, const size_t a_Count)
+	{
+		if (m_Size + a_Count > m_Capacity)
+		{
+			BB_ASSERT(m_CanGrow, "RingBuffer, pushing more elements than fit in a RingBuffer that cannot grow.");
+			reallocate(Math::RoundUpPowerOfTwo(m_Size + a_Count));
+		}
+
+		//The free space is at most 2 contiguous parts, from the back to the end of the buffer and from the start.
+		const size_t t_Tail = Slot(m_Size);
+		const size_t t_FirstCount = m_Capacity - t_Tail < a_Count ? m_Capacity - t_Tail : a_Count;
+		Memory::Copy<T>(m_Arr + t_Tail, a_Elements, t_FirstCount);
+		Memory::Copy<T>(m_Arr, a_Elements + t_FirstCount, a_Count - t_FirstCount);
+		m_Size += a_Count;
+	}
+
+	template<typename T>
+	inline size_t BB::RingBuffer<T>::pop_front(T* a_Destination, const size_t a_Count)
+	{
+		const size_t t_Count = a_Count < m_Size ? a_Count : m_Size;
+		const size_t t_FirstCount = m_Capacity - m_Head < t_Count ? m_Capacity - m_Head : t_Count;
+		Memory::Move<T>(a_Destination, m_Arr + m_Head, t_FirstCount);
+		Memory::Move<T>(a_Destination + t_FirstCount, m_Arr, t_Count - t_FirstCount);
+
+		//Memory::Move already ended the lifetime of the elements.
+		m_Head = Slot(t_Count);
+		m_Size -= t_Count;
+		return t_Count;
+	}
+
+	template<typename T>
+	inline Slice<T> BB::RingBuffer<T>::read_span() const
+	{
+		const size_t t_Count = m_Capacity - m_Head < m_Size ? m_Capacity - m_Head : m_Size;
+		return Slice<T>(m_Arr + m_Head, t_Count);
+	}
+
+	template<typename T>
+	inline Slice<T> BB::RingBuffer<T>::write_span() const
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "RingBuffer, write_span is only allowed for trivially copyable types.");
+		const size_t t_Tail = Slot(m_Size);
+		const size_t t_Free = m_Capacity - m_Size;
+		const size_t t_Count = m_Capacity - t_Tail < t_Free ? m_Capacity - t_Tail : t_Free;
+		return Slice<T>(m_Arr + t_Tail, t_Count);
+	}
+
+	template<typename T>
+	inline void BB::RingBuffer<T>::commit_write(const size_t a_Count)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "RingBuffer, commit_write is only allowed for trivially copyable types.");
+		BB_ASSERT(m_Size + a_Count <= m_Capacity, "RingBuffer, committing more elements than there is space for.");
+		m_Size += a_Count;
+	}
+
+	template<typename T>
+	inline void BB::RingBuffer<T>::reserve(const size_t a_Capacity)
+	{
+		if (a_Capacity > m_Capacity)
+			reallocate(Math::RoundUpPowerOfTwo(a_Capacity));
+	}
+
+	template<typename T>
+	inline void BB::RingBuffer<T>::clear()
+	{
+		pop_front(m_Size);
+		m_Head = 0;
+	}
+
+	template<typename T>
+	inline void BB::RingBuffer<T>::MakeSpace()
+	{
+		if (m_Size == m_Capacity)
+		{
+			BB_ASSERT(m_CanGrow, "RingBuffer, pushing into a full RingBuffer that cannot grow.");
+			//A moved from RingBuffer has no buffer left.
+			reallocate(m_Capacity == 0 ? RingBuffer_Specs::standardSize : m_Capacity * 2);
+		}
+	}
+
+	template<typename T>
+	inline void BB::RingBuffer<T>::reallocate(const size_t a_NewCapacity)
+	{
+		T* t_NewArr = reinterpret_cast<T*>(BBalloc(m_Allocator, a_NewCapacity * sizeof(T)));
+		if (m_Arr != nullptr)
+		{
+			//Unwrap the elements so the front is at slot 0 again.
+			const size_t t_FirstCount = m_Capacity - m_Head < m_Size ? m_Capacity - m_Head : m_Size;
+			Memory::Move<T>(t_NewArr, m_Arr + m_Head, t_FirstCount);
+			Memory::Move<T>(t_NewArr + t_FirstCount, m_Arr, m_Size - t_FirstCount);
+			BBfree(m_Allocator, reinterpret_cast<void*>(m_Arr));
+		}
+
+		m_Arr = t_NewArr;
+		m_Head = 0;
+		m_Capacity = a_NewCapacity;
+	}
+
+	template<typename T>
+	inline void BB::RingBuffer<T>::CopyFrom(const RingBuffer<T>& a_RingBuffer)
+	{
+		reallocate(a_RingBuffer.m_Capacity);
+		const size_t t_FirstCount = a_RingBuffer.read_span().size();
+		Memory::Copy<T>(m_Arr, a_RingBuffer.m_Arr + a_RingBuffer.m_Head, t_FirstCount);
+		Memory::Copy<T>(m_Arr + t_FirstCount, a_RingBuffer.m_Arr, a_RingBuffer.m_Size - t_FirstCount);
+		m_Size = a_RingBuffer.m_Size;
+	}
+
+	template<typename T>
+	inline void BB::RingBuffer<T>::MoveFrom(RingBuffer<T>& a_RingBuffer)
+	{
+		m_Arr = a_RingBuffer.m_Arr;
+		m_Head = a_RingBuffer.m_Head;
+		m_Size = a_RingBuffer.m_Size;
+		m_Capacity = a_RingBuffer.m_Capacity;
+
+		a_RingBuffer.m_Arr = nullptr;
+		a_RingBuffer.m_Head = 0;
+		a_RingBuffer.m_Size = 0;
+		a_RingBuffer.m_Capacity = 0;
+	}
+
+	template<typename T>
+	inline void BB::RingBuffer<T>::Release()
+	{
+		if (m_Arr == nullptr)
+			return;
+
+		clear();
+		BBfree(m_Allocator, reinterpret_cast<void*>(m_Arr));
+
+		m_Arr = nullptr;
+		m_Capacity = 0;
+	}
+}
@@ -342,7 +342,8 @@ namespace BB
 		uint32_t* t_NewEraseArr = reinterpret_cast<uint32_t*>(Pointer::Add(t_NewObjArr, sizeof(T) * a_NewCapacity));
 
 		BB::Memory::Copy(t_NewIdArr, m_IdArr, m_Capacity);
-		BB::Memory::Copy(t_NewObjArr, m_ObjArr, m_Size);
+		//Relocate the objects, the old buffer only needs to be freed after this.
+		BB::Memory::Move(t_NewObjArr, m_ObjArr, m_Size);
 		BB::Memory::Copy(t_NewEraseArr, m_EraseArr, m_Size);
 
 		for (uint32_t i = m_Capacity; i < a_NewCapacity - 1; ++i)
@@ -351,9 +352,10 @@ namespace BB
 			t_NewIdArr[i].generation = 1;
 		}
 
-		m_IdArr[a_NewCapacity - 1].generation = 1;
-		
-		this->~Slotmap();
+		t_NewIdArr[a_NewCapacity - 1].generation = 1;
+
+		if (m_IdArr != nullptr)
+			BBfree(m_Allocator, m_IdArr);
 
 		m_Capacity = a_NewCapacity;
 		m_IdArr = t_NewIdArr;
@@ -0,0 +1,338 @@
+#pragma once
+#include "Utils/Logger.h"
+#include "BBMemory.h"
+
+#include "Utils/Utils.h"
+#include "Storage/Array.h"
+
+namespace BB
+{
+	/// <summary>
+	/// Array with inline storage for N elements, the allocator is only used once the array grows past N.
+	/// Has the same API as BB::Array.
+	/// </summary>
+	template<typename T, size_t N>
+	struct SmallArray
+	{
+		static_assert(N > 0, "SmallArray needs at least 1 inline element, use BB::Array instead.");
+		static constexpr bool trivialDestructible_T = std::is_trivially_destructible_v<T>;
+
+		struct Iterator
+		{
+			using value_type = T;
+			using pointer = T*;
+			using reference = T&;
+
+			Iterator(pointer a_Ptr) : m_Ptr(a_Ptr) {}
+
+			reference operator*() const { return *m_Ptr; }
+			pointer operator->() { return m_Ptr; }
+
+			Iterator& operator++()
+			{
+				m_Ptr++;
+				return *this;
+			}
+
+			Iterator operator++(int)
+			{
+				Iterator t_Tmp = *this;
+				++(*this);
+				return t_Tmp;
+			}
+
+			friend bool operator== (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Ptr == a_Rhs.m_Ptr; };
+			friend bool operator!= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Ptr != a_Rhs.m_Ptr; };
+
+			friend bool operator< (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Ptr < a_Rhs.m_Ptr; };
+			friend bool operator> (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Ptr > a_Rhs.m_Ptr; };
+			friend bool operator<= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Ptr <= a_Rhs.m_Ptr; };
+			friend bool operator>= (const Iterator& a_Lhs, const Iterator& a_Rhs) { return a_Lhs.m_Ptr >= a_Rhs.m_Ptr; };
+
+		private:
+			pointer m_Ptr;
+		};
+
+		SmallArray(Allocator a_Allocator);
+		SmallArray(Allocator a_Allocator, size_t a_Size);
+		SmallArray(const SmallArray<T, N>& a_Array);
+		SmallArray(SmallArray<T, N>&& a_Array) noexcept;
+		~SmallArray();
+
+		SmallArray<T, N>& operator=(const SmallArray<T, N>& a_Rhs);
+		SmallArray<T, N>& operator=(SmallArray<T, N>&& a_Rhs) noexcept;
+		T& operator[](const size_t a_Index) const;
+
+		void push_back(T& a_Element);
+		void push_back(const T* a_Elements, size_t a_Count);
+		void insert(size_t a_Position, const T& a_Element);
+		template <class... Args>
+		void emplace_back(Args&&... a_Args);
+		template <class... Args>
+		void emplace(size_t a_Position, Args&&... a_Args);
+
+		void reserve(size_t a_Size);
+		void resize(size_t a_Size);
+
+		void pop();
+		void clear();
+
+		const size_t size() const { return m_Size; };
+		const size_t capacity() const { return m_Capacity; }
+		T* data() const { return m_Arr; };
+		//Returns true while the elements are still inside the inline storage.
+		bool is_inline() const { return m_Arr == InlineData(); }
+
+		Iterator begin() { return Iterator(m_Arr); }
+		Iterator end() { return Iterator(&m_Arr[m_Size]); }
+
+	private:
+		void grow(size_t a_MinCapacity = 0);
+		//This function also changes the m_Capacity value.
+		void reallocate(size_t a_NewCapacity);
+		//Take over the elements of a_Array, steals the heap buffer if it has one.
+		void MoveFrom(SmallArray<T, N>& a_Array);
+		void DestroyElements();
+		//Destroys the elements and frees the heap buffer, back to an empty inline array.
+		void Release();
+
+		T* InlineData() const { return reinterpret_cast<T*>(const_cast<unsigned char*>(m_InlineStorage)); }
+
+		Allocator m_Allocator;
+
+		T* m_Arr;
+		size_t m_Size = 0;
+		size_t m_Capacity;
+
+		alignas(T) unsigned char m_InlineStorage[sizeof(T) * N];
+	};
+
+	template<typename T, size_t N>
+	inline BB::SmallArray<T, N>::SmallArray(Allocator a_Allocator)
+		: m_Allocator(a_Allocator)
+	{
+		m_Arr = InlineData();
+		m_Capacity = N;
+	}
+
+	template<typename T, size_t N>
+	inline BB::SmallArray<T, N>::SmallArray(Allocator a_Allocator, size_t a_Size)
+		: SmallArray(a_Allocator)
+	{
+		reserve(a_Size);
+	}
+
+	template<typename T, size_t N>
+	inline BB::SmallArray<T, N>::SmallArray(const SmallArray<T, N>& a_Array)
+		: SmallArray(a_Array.m_Allocator)
+	{
+		reserve(a_Array.m_Size);
+		Memory::Copy<T>(m_Arr, a_Array.m_Arr, a_Array.m_Size);
+		m_Size = a_Array.m_Size;
+	}
+
+	template<typename T, size_t N>
+	inline BB::SmallArray<T, N>::SmallArray(SmallArray<T, N>&& a_Array) noexcept
+		: SmallArray(a_Array.m_Allocator)
+	{
+		MoveFrom(a_Array);
+	}
+
+	template<typename T, size_t N>
+	inline SmallArray<T, N>::~SmallArray()
+	{
+		DestroyElements();
+		if (!is_inline())
+			BBfree(m_Allocator, reinterpret_cast<void*>(m_Arr));
+	}
+
+	template<typename T, size_t N>
+	inline SmallArray<T, N>& BB::SmallArray<T, N>::operator=(const SmallArray<T, N>& a_Rhs)
+	{
+		Release();
+
+		m_Allocator = a_Rhs.m_Allocator;
+		reserve(a_Rhs.m_Size);
+		Memory::Copy<T>(m_Arr, a_Rhs.m_Arr, a_Rhs.m_Size);
+		m_Size = a_Rhs.m_Size;
+
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	inline SmallArray<T, N>& BB::SmallArray<T, N>::operator=(SmallArray<T, N>&& a_Rhs) noexcept
+	{
+		Release();
+
+		m_Allocator = a_Rhs.m_Allocator;
+		MoveFrom(a_Rhs);
+
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	inline T& SmallArray<T, N>::operator[](const size_t a_Index) const
+	{
+		BB_ASSERT(a_Index < m_Size, "SmallArray, trying to get an element using the [] operator but that element is not there.");
+		return m_Arr[a_Index];
+	}
+
+	template<typename T, size_t N>
+	inline void SmallArray<T, N>::push_back(T& a_Element)
+	{
+		emplace_back(a_Element);
+	}
+
+	template<typename T, size_t N>
+	inline void SmallArray<T, N>::push_back(const T* a_Elements, size_t a_Count)
+	{
+		if (m_Size + a_Count > m_Capacity)
+			grow(m_Size + a_Count);
+
+		Memory::Copy<T>(m_Arr + m_Size, a_Elements, a_Count);
+
+		m_Size += a_Count;
+	}
+
+	template<typename T, size_t N>
+	inline void BB::SmallArray<T, N>::insert(size_t a_Position, const T& a_Element)
+	{
+		emplace(a_Position, a_Element);
+	}
+
+	template<typename T, size_t N>
+	template<class ...Args>
+	inline void BB::SmallArray<T, N>::emplace_back(Args&&... a_Args)
+	{
+		if (m_Size >= m_Capacity)
+			grow();
+
+		new (&m_Arr[m_Size]) T(std::forward<Args>(a_Args)...);
+		m_Size++;
+	}
+
+	template<typename T, size_t N>
+	template<class ...Args>
+	inline void BB::SmallArray<T, N>::emplace(size_t a_Position, Args&&... a_Args)
+	{
+		BB_ASSERT(m_Size >= a_Position, "trying to insert in a position that is bigger then the current SmallArray size!");
+		if (m_Size >= m_Capacity)
+			grow();
+
+		//Move all elements after a_Position 1 to the front.
+		Memory::sMove(&m_Arr[a_Position + 1], &m_Arr[a_Position], m_Size - a_Position);
+
+		new (&m_Arr[a_Position]) T(std::forward<Args>(a_Args)...);
+		m_Size++;
+	}
+
+	template<typename T, size_t N>
+	inline void SmallArray<T, N>::reserve(size_t a_Size)
+	{
+		if (a_Size > m_Capacity)
+		{
+			size_t t_ModifiedCapacity = Math::RoundUp(a_Size, Array_Specs::multipleValue);
+
+			reallocate(t_ModifiedCapacity);
+		}
+	}
+
+	template<typename T, size_t N>
+	inline void BB::SmallArray<T, N>::resize(size_t a_Size)
+	{
+		reserve(a_Size);
+
+		for (size_t i = m_Size; i < a_Size; i++)
+		{
+			new (&m_Arr[i]) T();
+		}
+
+		m_Size = a_Size;
+	}
+
+	template<typename T, size_t N>
+	inline void BB::SmallArray<T, N>::pop()
+	{
+		BB_ASSERT(m_Size != 0, "SmallArray, Popping while m_Size is 0!");
+		--m_Size;
+		if constexpr (!trivialDestructible_T)
+		{
+			m_Arr[m_Size].~T();
+		}
+	}
+
+	template<typename T, size_t N>
+	inline void BB::SmallArray<T, N>::clear()
+	{
+		DestroyElements();
+		m_Size = 0;
+	}
+
+	template<typename T, size_t N>
+	inline void SmallArray<T, N>::grow(size_t a_MinCapacity)
+	{
+		size_t t_ModifiedCapacity = m_Capacity * 2;
+
+		if (a_MinCapacity > t_ModifiedCapacity)
+			t_ModifiedCapacity = Math::RoundUp(a_MinCapacity, Array_Specs::multipleValue);
+
+		reallocate(t_ModifiedCapacity);
+	}
+
+	template<typename T, size_t N>
+	inline void SmallArray<T, N>::reallocate(size_t a_NewCapacity)
+	{
+		T* t_NewArr = reinterpret_cast<T*>(BBalloc(m_Allocator, a_NewCapacity * sizeof(T)));
+
+		Memory::Move(t_NewArr, m_Arr, m_Size);
+		//The inline storage is part of this object, only free heap memory.
+		if (!is_inline())
+			BBfree(m_Allocator, reinterpret_cast<void*>(m_Arr));
+
+		m_Arr = t_NewArr;
+		m_Capacity = a_NewCapacity;
+	}
+
+	template<typename T, size_t N>
+	inline void SmallArray<T, N>::MoveFrom(SmallArray<T, N>& a_Array)
+	{
+		if (a_Array.is_inline())
+		{
+			Memory::Move(m_Arr, a_Array.m_Arr, a_Array.m_Size);
+		}
+		else
+		{
+			m_Arr = a_Array.m_Arr;
+			m_Capacity = a_Array.m_Capacity;
+		}
+		m_Size = a_Array.m_Size;
+
+		a_Array.m_Arr = a_Array.InlineData();
+		a_Array.m_Size = 0;
+		a_Array.m_Capacity = N;
+	}
+
+	template<typename T, size_t N>
+	inline void SmallArray<T, N>::DestroyElements()
+	{
+		if constexpr (!trivialDestructible_T)
+		{
+			for (size_t i = 0; i < m_Size; i++)
+			{
+				m_Arr[i].~T();
+			}
+		}
+	}
+
+	template<typename T, size_t N>
+	inline void SmallArray<T, N>::Release()
+	{
+		DestroyElements();
+		if (!is_inline())
+			BBfree(m_Allocator, reinterpret_cast<void*>(m_Arr));
+
+		m_Arr = InlineData();
+		m_Size = 0;
+		m_Capacity = N;
+	}
+}
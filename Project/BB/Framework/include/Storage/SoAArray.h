@@ -0,0 +1,662 @@
+#pragma once
+#include "Utils/Logger.h"
+#include "BBMemory.h"
+
+#include "Utils/Utils.h"
+#include "Utils/Slice.h"
+#include "Storage/Slotmap.h"
+
+#include <tuple>
+#include <utility>
+
+namespace BB
+{
+	namespace SoA_Specs
+	{
+		constexpr const size_t multipleValue = 8;
+		constexpr const size_t standardSize = 8;
+		//Every field array starts on a cache line, also enough for the widest SIMD loads.
+		constexpr const size_t fieldAlignment = 64;
+	};
+
+	//Index of the field type F in Ts, used to get a field by type. F has to be in Ts exactly once.
+	template<typename F, typename... Ts>
+	constexpr size_t SoAFieldIndex()
+	{
+		constexpr size_t t_Count = (static_cast<size_t>(std::is_same_v<F, Ts>) + ... + 0);
+		static_assert(t_Count == 1, "SoA field type has to be in the field list exactly once, use the field index instead.");
+		constexpr bool t_Matches[] = { std::is_same_v<F, Ts>... };
+		size_t t_Index = 0;
+		while (!t_Matches[t_Index])
+			++t_Index;
+		return t_Index;
+	}
+
+	/// <summary>
+	/// Structure of arrays, every field type in Ts is stored in its own aligned array.
+	/// Elements are pushed and erased as a whole, loops that only touch one field iterate over field<I>().
+	/// All field arrays live in one allocation.
+	/// </summary>
+	template<typename... Ts>
+	class SoAArray
+	{
+		static_assert(sizeof...(Ts) > 0, "SoAArray needs at least one field.");
+		static constexpr size_t fieldCount = sizeof...(Ts);
+		using FieldIndices = std::index_sequence_for<Ts...>;
+
+	public:
+		BB_TRIVIALLY_RELOCATABLE;
+
+		template<size_t I>
+		using Field = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+		SoAArray(Allocator a_Allocator);
+		SoAArray(Allocator a_Allocator, size_t a_Size);
+		SoAArray(const SoAArray<Ts...>& a_Array);
+		SoAArray(SoAArray<Ts...>&& a_Array) noexcept;
+		~SoAArray();
+
+		SoAArray<Ts...>& operator=(const SoAArray<Ts...>& a_Rhs);
+		SoAArray<Ts...>& operator=(SoAArray<Ts...>&& a_Rhs) noexcept;
+
+		void push_back(const Ts&... a_Values);
+		//Construct every field from its own argument, needs one argument per field.
+		template <class... Args>
+		void emplace_back(Args&&... a_Args);
+
+		void reserve(size_t a_Size);
+		//Default constructs the new elements.
+		void resize(size_t a_Size);
+
+		void pop();
+		//Remove the element at a_Index by moving the last element into it, does not keep the order.
+		void erase_swap(size_t a_Index);
+		void clear();
+
+		template<size_t I>
+		Field<I>& get(const size_t a_Index) const
+		{
+			BB_ASSERT(a_Index < m_Size, "SoAArray, trying to get an element that is not there.");
+			return data<I>()[a_Index];
+		}
+		/// <summary>
+		/// All elements of a single field as a dense Slice, the pointer is aligned to SoA_Specs::fieldAlignment.
+		/// </summary>
+		template<size_t I>
+		Slice<Field<I>> field() const { return Slice<Field<I>>(data<I>(), m_Size); }
+		template<size_t I>
+		Field<I>* data() const { return reinterpret_cast<Field<I>*>(m_Fields[I]); }
+
+		//Same as above but by field type, only for types that are in Ts once.
+		template<typename F>
+		F& get(const size_t a_Index) const { return get<SoAFieldIndex<F, Ts...>()>(a_Index); }
+		template<typename F>
+		Slice<F> field() const { return field<SoAFieldIndex<F, Ts...>()>(); }
+		template<typename F>
+		F* data() const { return data<SoAFieldIndex<F, Ts...>()>(); }
+
+		const size_t size() const { return m_Size; }
+		const size_t capacity() const { return m_Capacity; }
+
+	private:
+		static size_t FieldBytes(const size_t a_FieldSize, const size_t a_Capacity)
+		{
+			return Math::RoundUp(a_FieldSize * a_Capacity, SoA_Specs::fieldAlignment);
+		}
+		//Allocates one buffer for all fields and points a_Fields into it.
+		void* AllocateFields(const size_t a_Capacity, void* (&a_Fields)[fieldCount]);
+
+		template<size_t... Is>
+		void CopyFields(std::index_sequence<Is...>, const SoAArray<Ts...>& a_Array);
+		template<size_t... Is>
+		void MoveFields(std::index_sequence<Is...>, void* (&a_NewFields)[fieldCount]);
+		template<size_t... Is, class... Args>
+		void ConstructFields(std::index_sequence<Is...>, const size_t a_Index, Args&&... a_Args);
+		template<size_t... Is>
+		void DefaultConstructFields(std::index_sequence<Is...>, const size_t a_Index);
+		template<size_t... Is>
+		void DestroyFields(std::index_sequence<Is...>, const size_t a_Index);
+		template<size_t... Is>
+		void MoveElement(std::index_sequence<Is...>, const size_t a_Destination, const size_t a_Source);
+		template<size_t I>
+		void DestroyField(const size_t a_Index);
+
+		void grow(size_t a_MinCapacity = 0);
+		//This function also changes the m_Capacity value.
+		void reallocate(size_t a_NewCapacity);
+		//Destroys the elements and frees the buffer, back to an empty SoAArray.
+		void Release();
+
+		Allocator m_Allocator;
+
+		void* m_Buffer = nullptr;
+		void* m_Fields[fieldCount]{};
+		size_t m_Size = 0;
+		size_t m_Capacity = 0;
+	};
+
+	template<typename... Ts>
+	inline BB::SoAArray<Ts...>::SoAArray(Allocator a_Allocator)
+		: SoAArray(a_Allocator, SoA_Specs::standardSize)
+	{}
+
+	template<typename... Ts>
+	inline BB::SoAArray<Ts...>::SoAArray(Allocator a_Allocator, size_t a_Size)
+		: m_Allocator(a_Allocator)
+	{
+		BB_ASSERT(a_Size != 0, "SoAArray size is specified to be 0");
+		m_Capacity = Math::RoundUp(a_Size, SoA_Specs::multipleValue);
+		m_Buffer = AllocateFields(m_Capacity, m_Fields);
+	}
+
+	template<typename... Ts>
+	inline BB::SoAArray<Ts...>::SoAArray(const SoAArray<Ts...>& a_Array)
+		: m_Allocator(a_Array.m_Allocator)
+	{
+		m_Capacity = a_Array.m_Capacity;
+		m_Buffer = AllocateFields(m_Capacity, m_Fields);
+		CopyFields(FieldIndices{}, a_Array);
+		m_Size = a_Array.m_Size;
+	}
+
+	template<typename... Ts>
+	inline BB::SoAArray<Ts...>::SoAArray(SoAArray<Ts...>&& a_Array) noexcept
+		: m_Allocator(a_Array.m_Allocator)
+	{
+		m_Buffer = a_Array.m_Buffer;
+		memcpy(m_Fields, a_Array.m_Fields, sizeof(m_Fields));
+		m_Size = a_Array.m_Size;
+		m_Capacity = a_Array.m_Capacity;
+
+		a_Array.m_Buffer = nullptr;
+		memset(a_Array.m_Fields, 0, sizeof(a_Array.m_Fields));
+		a_Array.m_Size = 0;
+		a_Array.m_Capacity = 0;
+	}
+
+	template<typename... Ts>
+	inline BB::SoAArray<Ts...>::~SoAArray()
+	{
+		Release();
+	}
+
+	template<typename... Ts>
+	inline SoAArray<Ts...>& BB::SoAArray<Ts...>::operator=(const SoAArray<Ts...>& a_Rhs)
+	{
+		Release();
+
+		m_Allocator = a_Rhs.m_Allocator;
+		m_Capacity = a_Rhs.m_Capacity;
+		m_Buffer = AllocateFields(m_Capacity, m_Fields);
+		CopyFields(FieldIndices{}, a_Rhs);
+		m_Size = a_Rhs.m_Size;
+
+		return *this;
+	}
+
+	template<typename... Ts>
+	inline SoAArray<Ts...>& BB::SoAArray<Ts...>::operator=(SoAArray<Ts...>&& a_Rhs) noexcept
+	{
+		Release();
+
+		m_Allocator = a_Rhs.m_Allocator;
+		m_Buffer = a_Rhs.m_Buffer;
+		memcpy(m_Fields, a_Rhs.m_Fields, sizeof(m_Fields));
+		m_Size = a_Rhs.m_Size;
+		m_Capacity = a_Rhs.m_Capacity;
+
+		a_Rhs.m_Buffer = nullptr;
+		memset(a_Rhs.m_Fields, 0, sizeof(a_Rhs.m_Fields));
+		a_Rhs.m_Size = 0;
+		a_Rhs.m_Capacity = 0;
+
+		return *this;
+	}
+
+	template<typename... Ts>
+	inline void BB::SoAArray<Ts...>::push_back(const Ts&... a_Values)
+	{
+		emplace_back(a_Values...);
+	}
+
+	template<typename... Ts>
+	template<class... Args>
+	inline void BB::SoAArray<Ts...>::emplace_back(Args&&... a_Args)
+	{
+		static_assert(sizeof...(Args) == fieldCount, "SoAArray emplace_back needs one argument per field.");
+		if (m_Size >= m_Capacity)
+			grow();
+
+		ConstructFields(FieldIndices{}, m_Size, std::forward<Args>(a_Args)...);
+		m_Size++;
+	}
+
+	template<typename... Ts>
+	inline void BB::SoAArray<Ts...>::reserve(size_t a_Size)
+	{
+		if (a_Size > m_Capacity)
+			reallocate(Math::RoundUp(a_Size, SoA_Specs::multipleValue));
+	}
+
+	template<typename... Ts>
+	inline void BB::SoAArray<Ts...>::resize(size_t a_Size)
+	{
+		reserve(a_Size);
+
+		for (size_t i = m_Size; i < a_Size; i++)
+			DefaultConstructFields(FieldIndices{}, i);
+		for (size_t i = a_Size; i < m_Size; i++)
+			DestroyFields(FieldIndices{}, i);
+
+		m_Size = a_Size;
+	}
+
+	template<typename... Ts>
+	inline void BB::SoAArray<Ts...>::pop()
+	{
+		BB_ASSERT(m_Size != 0, "SoAArray, Popping while m_Size is 0!");
+		--m_Size;
+		DestroyFields(FieldIndices{}, m_Size);
+	}
+
+	template<typename... Ts>
+	inline void BB::SoAArray<Ts...>::erase_swap(size_t a_Index)
+	{
+		BB_ASSERT(a_Index < m_Size, "SoAArray, erase_swap index is out of bounds!");
+		--m_Size;
+		DestroyFields(FieldIndices{}, a_Index);
+		//Relocate the last element into the hole, the last slot is dead after this.
+		if (a_Index != m_Size)
+			MoveElement(FieldIndices{}, a_Index, m_Size);
+	}
+
+	template<typename... Ts>
+	inline void BB::SoAArray<Ts...>::clear()
+	{
+		for (size_t i = 0; i < m_Size; i++)
+			DestroyFields(FieldIndices{}, i);
+		m_Size = 0;
+	}
+
+	template<typename... Ts>
+	inline void* BB::SoAArray<Ts...>::AllocateFields(const size_t a_Capacity, void* (&a_Fields)[fieldCount])
+	{
+		const size_t t_FieldSizes[fieldCount] = { sizeof(Ts)... };
+		size_t t_TotalSize = 0;
+		for (size_t i = 0; i < fieldCount; i++)
+			t_TotalSize += FieldBytes(t_FieldSizes[i], a_Capacity);
+
+		//Align the fields ourselves, allocators with debug headers do not keep big alignments.
+		void* t_Buffer = BBalloc(m_Allocator, t_TotalSize + SoA_Specs::fieldAlignment);
+		void* t_Field = Pointer::Add(t_Buffer, Pointer::AlignForwardAdjustment(t_Buffer, SoA_Specs::fieldAlignment));
+		for (size_t i = 0; i < fieldCount; i++)
+		{
+			a_Fields[i] = t_Field;
+			t_Field = Pointer::Add(t_Field, FieldBytes(t_FieldSizes[i], a_Capacity));
+		}
+		return t_Buffer;
+	}
+
+	template<typename... Ts>
+	template<size_t... Is>
+	inline void BB::SoAArray<Ts...>::CopyFields(std::index_sequence<Is...>, const SoAArray<Ts...>& a_Array)
+	{
+		(Memory::Copy<Field<Is>>(data<Is>(), a_Array.template data<Is>(), a_Array.m_Size), ...);
+	}
+
+	template<typename... Ts>
+	template<size_t... Is>
+	inline void BB::SoAArray<Ts...>::MoveFields(std::index_sequence<Is...>, void* (&a_NewFields)[fieldCount])
+	{
+		(Memory::Move<Field<Is>>(reinterpret_cast<Field<Is>*>(a_NewFields[Is]), data<Is>(), m_Size), ...);
+	}
+
+	template<typename... Ts>
+	template<size_t... Is, class... Args>
+	inline void BB::SoAArray<Ts...>::ConstructFields(std::index_sequence<Is...>, const size_t a_Index, Args&&... a_Args)
+	{
+		(new (&data<Is>()[a_Index]) Field<Is>(std::forward<Args>(a_Args)), ...);
+	}
+
+	template<typename... Ts>
+	template<size_t... Is>
+	inline void BB::SoAArray<Ts...>::DefaultConstructFields(std::index_sequence<Is...>, const size_t a_Index)
+	{
+		(new (&data<Is>()[a_Index]) Field<Is>(), ...);
+	}
+
+	template<typename... Ts>
+	template<size_t... Is>
+	inline void BB::SoAArray<Ts...>::DestroyFields(std::index_sequence<Is...>, const size_t a_Index)
+	{
+		(DestroyField<Is>(a_Index), ...);
+	}
+
+	template<typename... Ts>
+	template<size_t... Is>
+	inline void BB::SoAArray<Ts...>::MoveElement(std::index_sequence<Is...>, const size_t a_Destination, const size_t a_Source)
+	{
+		(Memory::Move<Field<Is>>(&data<Is>()[a_Destination], &data<Is>()[a_Source], 1), ...);
+	}
+
+	template<typename... Ts>
+	template<size_t I>
+	inline void BB::SoAArray<Ts...>::DestroyField(const size_t a_Index)
+	{
+		using FieldType = Field<I>;
+		if constexpr (!std::is_trivially_destructible_v<FieldType>)
+		{
+			data<I>()[a_Index].~FieldType();
+		}
+	}
+
+	template<typename... Ts>
+	inline void BB::SoAArray<Ts...>::grow(size_t a_MinCapacity)
+	{
+		size_t t_ModifiedCapacity = m_Capacity * 2;
+
+		if (a_MinCapacity > t_ModifiedCapacity)
+			t_ModifiedCapacity = Math::RoundUp(a_MinCapacity, SoA_Specs::multipleValue);
+
+		reallocate(t_ModifiedCapacity);
+	}
+
+	template<typename... Ts>
+	inline void BB::SoAArray<Ts...>::reallocate(size_t a_NewCapacity)
+	{
+		void* t_NewFields[fieldCount];
+		void* t_NewBuffer = AllocateFields(a_NewCapacity, t_NewFields);
+
+		MoveFields(FieldIndices{}, t_NewFields);
+		if (m_Buffer != nullptr)
+			BBfree(m_Allocator, m_Buffer);
+
+		m_Buffer = t_NewBuffer;
+		memcpy(m_Fields, t_NewFields, sizeof(m_Fields));
+		m_Capacity = a_NewCapacity;
+	}
+
+	template<typename... Ts>
+	inline void BB::SoAArray<Ts...>::Release()
+	{
+		if (m_Buffer == nullptr)
+			return;
+
+		clear();
+		BBfree(m_Allocator, m_Buffer);
+		m_Buffer = nullptr;
+		memset(m_Fields, 0, sizeof(m_Fields));
+		m_Capacity = 0;
+	}
+
+	/// <summary>
+	/// Slotmap that stores its objects as a SoAArray, every field is a dense array that stays packed on erase.
+	/// Handles work the same as the Slotmap handles.
+	/// </summary>
+	template<typename... Ts>
+	class SoASlotmap
+	{
+	public:
+		BB_TRIVIALLY_RELOCATABLE;
+
+		template<size_t I>
+		using Field = typename SoAArray<Ts...>::template Field<I>;
+
+		SoASlotmap(Allocator a_Allocator);
+		SoASlotmap(Allocator a_Allocator, const uint32_t a_Size);
+		SoASlotmap(const SoASlotmap<Ts...>& a_Map);
+		SoASlotmap(SoASlotmap<Ts...>&& a_Map) noexcept;
+		~SoASlotmap();
+
+		SoASlotmap<Ts...>& operator=(const SoASlotmap<Ts...>& a_Rhs);
+		SoASlotmap<Ts...>& operator=(SoASlotmap<Ts...>&& a_Rhs) noexcept;
+
+		SlotmapHandle insert(const Ts&... a_Values);
+		//Construct every field from its own argument, needs one argument per field.
+		template <class... Args>
+		SlotmapHandle emplace(Args&&... a_Args);
+		void erase(const SlotmapHandle a_Handle);
+
+		template<size_t I>
+		Field<I>& find(const SlotmapHandle a_Handle) const
+		{
+			CheckGen(a_Handle);
+			return m_Objects.template data<I>()[m_IdArr[a_Handle.index].index];
+		}
+		template<typename F>
+		F& find(const SlotmapHandle a_Handle) const { return find<SoAFieldIndex<F, Ts...>()>(a_Handle); }
+		//The dense index of a handle, use it to index the field slices.
+		uint32_t dense_index(const SlotmapHandle a_Handle) const
+		{
+			CheckGen(a_Handle);
+			return m_IdArr[a_Handle.index].index;
+		}
+		//The handle of the element at a_DenseIndex, for systems that iterate the fields and need to refer back to the element.
+		SlotmapHandle handle(const uint32_t a_DenseIndex) const
+		{
+			BB_ASSERT(a_DenseIndex < size(), "SoASlotmap, dense index is out of bounds.");
+			SlotmapHandle t_Handle;
+			t_Handle.index = m_EraseArr[a_DenseIndex];
+			t_Handle.generation = m_IdArr[t_Handle.index].generation;
+			return t_Handle;
+		}
+		/// <summary>
+		/// All elements of a single field as a dense Slice, the order changes on erase.
+		/// Every field has the same order, index i of every field belongs to the same element.
+		/// </summary>
+		template<size_t I>
+		Slice<Field<I>> field() const { return m_Objects.template field<I>(); }
+		template<typename F>
+		Slice<F> field() const { return m_Objects.template field<F>(); }
+
+		void reserve(const uint32_t a_Capacity);
+		void clear();
+
+		uint32_t size() const { return static_cast<uint32_t>(m_Objects.size()); }
+		uint32_t capacity() const { return m_Capacity; }
+
+	private:
+		void CheckGen(const SlotmapHandle a_Handle) const;
+		//Sets up the free list of the ids from a_Begin till m_Capacity.
+		void LinkFreeIds(const uint32_t a_Begin);
+		//This function also changes the m_Capacity value.
+		void reallocate(const uint32_t a_NewCapacity);
+
+		Allocator m_Allocator;
+
+		SoAArray<Ts...> m_Objects;
+		SlotmapHandle* m_IdArr = nullptr;
+		uint32_t* m_EraseArr = nullptr;
+
+		uint32_t m_Capacity = 0;
+		//index to m_IdArr
+		uint32_t m_NextFree = 0;
+	};
+
+	template<typename... Ts>
+	inline BB::SoASlotmap<Ts...>::SoASlotmap(Allocator a_Allocator)
+		: SoASlotmap(a_Allocator, Slotmap_Specs::standardSize)
+	{}
+
+	template<typename... Ts>
+	inline BB::SoASlotmap<Ts...>::SoASlotmap(Allocator a_Allocator, const uint32_t a_Size)
+		: m_Allocator(a_Allocator), m_Objects(a_Allocator, a_Size)
+	{
+		reallocate(a_Size);
+	}
+
+	template<typename... Ts>
+	inline BB::SoASlotmap<Ts...>::SoASlotmap(const SoASlotmap<Ts...>& a_Map)
+		: m_Allocator(a_Map.m_Allocator), m_Objects(a_Map.m_Objects)
+	{
+		m_Capacity = a_Map.m_Capacity;
+		m_NextFree = a_Map.m_NextFree;
+		m_IdArr = reinterpret_cast<SlotmapHandle*>(BBalloc(m_Allocator, (sizeof(SlotmapHandle) + sizeof(uint32_t)) * m_Capacity));
+		m_EraseArr = reinterpret_cast<uint32_t*>(Pointer::Add(m_IdArr, sizeof(SlotmapHandle) * m_Capacity));
+		memcpy(m_IdArr, a_Map.m_IdArr, (sizeof(SlotmapHandle) + sizeof(uint32_t)) * m_Capacity);
+	}
+
+	template<typename... Ts>
+	inline BB::SoASlotmap<Ts...>::SoASlotmap(SoASlotmap<Ts...>&& a_Map) noexcept
+		: m_Allocator(a_Map.m_Allocator), m_Objects(std::move(a_Map.m_Objects))
+	{
+		m_IdArr = a_Map.m_IdArr;
+		m_EraseArr = a_Map.m_EraseArr;
+		m_Capacity = a_Map.m_Capacity;
+		m_NextFree = a_Map.m_NextFree;
+
+		a_Map.m_IdArr = nullptr;
+		a_Map.m_EraseArr = nullptr;
+		a_Map.m_Capacity = 0;
+		a_Map.m_NextFree = 0;
+	}
+
+	template<typename... Ts>
+	inline BB::SoASlotmap<Ts...>::~SoASlotmap()
+	{
+		if (m_IdArr != nullptr)
+			BBfree(m_Allocator, m_IdArr);
+	}
+
+	template<typename... Ts>
+	inline SoASlotmap<Ts...>& BB::SoASlotmap<Ts...>::operator=(const SoASlotmap<Ts...>& a_Rhs)
+	{
+		if (m_IdArr != nullptr)
+			BBfree(m_Allocator, m_IdArr);
+
+		m_Allocator = a_Rhs.m_Allocator;
+		m_Objects = a_Rhs.m_Objects;
+		m_Capacity = a_Rhs.m_Capacity;
+		m_NextFree = a_Rhs.m_NextFree;
+		m_IdArr = reinterpret_cast<SlotmapHandle*>(BBalloc(m_Allocator, (sizeof(SlotmapHandle) + sizeof(uint32_t)) * m_Capacity));
+		m_EraseArr = reinterpret_cast<uint32_t*>(Pointer::Add(m_IdArr, sizeof(SlotmapHandle) * m_Capacity));
+		memcpy(m_IdArr, a_Rhs.m_IdArr, (sizeof(SlotmapHandle) + sizeof(uint32_t)) * m_Capacity);
+
+		return *this;
+	}
+
+	template<typename... Ts>
+	inline SoASlotmap<Ts...>& BB::SoASlotmap<Ts...>::operator=(SoASlotmap<Ts...>&& a_Rhs) noexcept
+	{
+		if (m_IdArr != nullptr)
+			BBfree(m_Allocator, m_IdArr);
+
+		m_Allocator = a_Rhs.m_Allocator;
+		m_Objects = std::move(a_Rhs.m_Objects);
+		m_IdArr = a_Rhs.m_IdArr;
+		m_EraseArr = a_Rhs.m_EraseArr;
+		m_Capacity = a_Rhs.m_Capacity;
+		m_NextFree = a_Rhs.m_NextFree;
+
+		a_Rhs.m_IdArr = nullptr;
+		a_Rhs.m_EraseArr = nullptr;
+		a_Rhs.m_Capacity = 0;
+		a_Rhs.m_NextFree = 0;
+
+		return *this;
+	}
+
+	template<typename... Ts>
+	inline SlotmapHandle BB::SoASlotmap<Ts...>::insert(const Ts&... a_Values)
+	{
+		return emplace(a_Values...);
+	}
+
+	template<typename... Ts>
+	template<class... Args>
+	inline SlotmapHandle BB::SoASlotmap<Ts...>::emplace(Args&&... a_Args)
+	{
+		const uint32_t t_DenseIndex = size();
+		if (t_DenseIndex >= m_Capacity)
+			reallocate(m_Capacity * 2);
+
+		SlotmapHandle t_ID = m_IdArr[m_NextFree];
+		t_ID.index = m_NextFree;
+		//Set the next free to the one that is next, an unused m_IdArr entry holds the next free one.
+		m_NextFree = m_IdArr[t_ID.index].index;
+		m_IdArr[t_ID.index].index = t_DenseIndex;
+
+		m_Objects.emplace_back(std::forward<Args>(a_Args)...);
+		m_EraseArr[t_DenseIndex] = t_ID.index;
+
+		return t_ID;
+	}
+
+	template<typename... Ts>
+	inline void BB::SoASlotmap<Ts...>::erase(const SlotmapHandle a_Handle)
+	{
+		CheckGen(a_Handle);
+		const uint32_t t_Index = m_IdArr[a_Handle.index].index;
+		const uint32_t t_Last = size() - 1;
+
+		//Every field swaps with the last element, so all fields stay packed together.
+		m_Objects.erase_swap(t_Index);
+		m_IdArr[m_EraseArr[t_Last]].index = t_Index;
+		m_EraseArr[t_Index] = m_EraseArr[t_Last];
+
+		//Increment the gen and put the id back in the free list.
+		m_IdArr[a_Handle.index].index = m_NextFree;
+		++m_IdArr[a_Handle.index].generation;
+		m_NextFree = a_Handle.index;
+	}
+
+	template<typename... Ts>
+	inline void BB::SoASlotmap<Ts...>::reserve(const uint32_t a_Capacity)
+	{
+		if (a_Capacity > m_Capacity)
+			reallocate(a_Capacity);
+	}
+
+	template<typename... Ts>
+	inline void BB::SoASlotmap<Ts...>::clear()
+	{
+		//Every live handle becomes invalid.
+		for (uint32_t i = 0; i < size(); i++)
+			++m_IdArr[m_EraseArr[i]].generation;
+
+		m_Objects.clear();
+		for (uint32_t i = 0; i < m_Capacity; ++i)
+			m_IdArr[i].index = i + 1;
+		m_NextFree = 0;
+	}
+
+	template<typename... Ts>
+	inline void BB::SoASlotmap<Ts...>::CheckGen(const SlotmapHandle a_Handle) const
+	{
+		BB_ASSERT(m_IdArr[a_Handle.index].generation == a_Handle.generation,
+			"SoASlotmap, Handle is from the wrong generation! Likely means this handle was already used to delete an element.");
+	}
+
+	template<typename... Ts>
+	inline void BB::SoASlotmap<Ts...>::LinkFreeIds(const uint32_t a_Begin)
+	{
+		for (uint32_t i = a_Begin; i < m_Capacity; ++i)
+		{
+			m_IdArr[i].index = i + 1;
+			m_IdArr[i].generation = 1;
+		}
+	}
+
+	template<typename... Ts>
+	inline void BB::SoASlotmap<Ts...>::reallocate(const uint32_t a_NewCapacity)
+	{
+		BB_ASSERT(a_NewCapacity < UINT32_MAX, "SoASlotmap's too big! SoASlotmaps cannot be bigger then UINT32_MAX");
+
+		SlotmapHandle* t_NewIdArr = reinterpret_cast<SlotmapHandle*>(BBalloc(m_Allocator, (sizeof(SlotmapHandle) + sizeof(uint32_t)) * a_NewCapacity));
+		uint32_t* t_NewEraseArr = reinterpret_cast<uint32_t*>(Pointer::Add(t_NewIdArr, sizeof(SlotmapHandle) * a_NewCapacity));
+		const uint32_t t_OldCapacity = m_Capacity;
+		if (m_IdArr != nullptr)
+		{
+			memcpy(t_NewIdArr, m_IdArr, sizeof(SlotmapHandle) * t_OldCapacity);
+			memcpy(t_NewEraseArr, m_EraseArr, sizeof(uint32_t) * size());
+			BBfree(m_Allocator, m_IdArr);
+		}
+
+		m_IdArr = t_NewIdArr;
+		m_EraseArr = t_NewEraseArr;
+		m_Capacity = a_NewCapacity;
+		//The old free list ends at t_OldCapacity, which is the first new id.
+		LinkFreeIds(t_OldCapacity);
+		m_Objects.reserve(a_NewCapacity);
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "Common.h"
+#include "BBString.h"
+
+namespace BB
+{
+	namespace StringBuilder_Specs
+	{
+		//Size of the first chunk, every next chunk is double the size of the last one.
+		constexpr const size_t standardChunkSize = 1024;
+		//Chunks stop growing at this size, bigger appends still get a chunk that fits them.
+		constexpr const size_t maxChunkSize = mbSize;
+	}
+
+	/// <summary>
+	/// Builds a big string out of a chain of chunks, text that is already written never moves.
+	/// Appending only allocates a new chunk when the last one is full, nothing is reallocated or copied.
+	/// Write the result to a file with write_to_file or copy it once at the end with flatten.
+	/// </summary>
+	class StringBuilder
+	{
+	public:
+		StringBuilder(Allocator a_Allocator);
+		StringBuilder(Allocator a_Allocator, const size_t a_ChunkSize);
+		StringBuilder(StringBuilder&& a_Builder) noexcept;
+		~StringBuilder();
+
+		StringBuilder(const StringBuilder&) = delete;
+		StringBuilder& operator=(const StringBuilder&) = delete;
+		StringBuilder& operator=(StringBuilder&& a_Rhs) noexcept;
+
+		void append(const char* a_String);
+		void append(const char* a_String, const size_t a_Size);
+		void append(const StringView a_String);
+		void push_back(const char a_Char);
+
+		//Empties the builder, the first chunk is kept for reuse.
+		void clear();
+
+		/// <summary>
+		/// Copy all the text to a_Buffer, a_Buffer must hold size() characters. No null terminator is written.
+		/// </summary>
+		void copy_to(char* a_Buffer) const;
+		/// <summary>
+		/// Append all the text to a_String, it is resized once and every chunk is copied once.
+		/// </summary>
+		void flatten(String& a_String) const;
+		/// <summary>
+		/// Write all the text to a_File in order, one write per chunk on Windows. A POSIX backend can use a single writev.
+		/// </summary>
+		void write_to_file(const OSFileHandle a_File) const;
+
+		size_t size() const { return m_Size; }
+		bool empty() const { return m_Size == 0; }
+		size_t chunk_count() const { return m_ChunkCount; }
+
+	private:
+		//The characters are stored right after the chunk.
+		struct Chunk
+		{
+			Chunk* next;
+			size_t size;
+			size_t capacity;
+
+			char* data() { return reinterpret_cast<char*>(this + 1); }
+			const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+		};
+
+		//Adds a chunk to the end of the chain that fits at least a_MinCapacity characters.
+		void AddChunk(const size_t a_MinCapacity);
+		//Takes the chunks of a_Builder and leaves it empty with no memory.
+		void MoveFrom(StringBuilder& a_Builder);
+		void Release();
+
+		Allocator m_Allocator;
+
+		Chunk* m_First = nullptr;
+		Chunk* m_Last = nullptr;
+		size_t m_ChunkCount = 0;
+		//Capacity of the next chunk.
+		size_t m_NextChunkSize;
+		size_t m_Size = 0;
+	};
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "Storage/Hashmap.h"
+
+namespace BB
+{
+	namespace StringInterner_Specs
+	{
+		constexpr const uint32_t INVALID_ID = UINT32_MAX;
+		constexpr const size_t standardMaxStrings = 1 << 16;
+		//Bytes of string memory committed at a time.
+		constexpr const size_t arenaCommitSize = 1 << 16;
+	}
+
+	/// <summary>
+	/// Handle to a string stored once in the global string interner.
+	/// Two ids are equal only if the strings are equal, so compares are a single integer compare.
+	/// The hash of the string is computed once when it is interned and stored in the id.
+	/// </summary>
+	struct StringId
+	{
+		uint32_t id = StringInterner_Specs::INVALID_ID;
+		//Lower 32 bits of Hash::MakeHash of the string.
+		uint32_t hash = 0;
+
+		bool operator==(const StringId a_Rhs) const { return id == a_Rhs.id; }
+		bool operator!=(const StringId a_Rhs) const { return id != a_Rhs.id; }
+		bool IsValid() const { return id != StringInterner_Specs::INVALID_ID; }
+	};
+
+	//Hashmaps keyed by StringId use the stored hash, the string is never touched.
+	template<>
+	struct Standard_Hasher<StringId>
+	{
+		inline Hash operator()(const StringId a_Key) const
+		{
+			return Hash(a_Key.hash);
+		}
+	};
+
+	/// <summary>
+	/// Global table that stores every unique string once, strings stay valid until Destroy.
+	/// All functions are thread safe. Looking up a string that is already interned never takes a lock,
+	/// only adding a new string does.
+	/// </summary>
+	namespace StringInterner
+	{
+		/// <summary>
+		/// Create the table, a_MaxStrings is the amount of unique strings it can hold.
+		/// </summary>
+		void Init(const size_t a_MaxStrings = StringInterner_Specs::standardMaxStrings);
+		/// <summary>
+		/// Free all the strings, every StringId and string returned before is invalid after this.
+		/// </summary>
+		void Destroy();
+
+		/// <summary>
+		/// Get the id of a string, adds the string to the table if it is not in there yet.
+		/// </summary>
+		StringId Intern(const char* a_String);
+		StringId Intern(const char* a_String, const size_t a_Length);
+		/// <summary>
+		/// Get the id of a string without adding it, returns an invalid id if it was never interned.
+		/// </summary>
+		StringId Find(const char* a_String);
+		StringId Find(const char* a_String, const size_t a_Length);
+
+		//The null terminated string of a_Id.
+		const char* GetString(const StringId a_Id);
+		size_t GetLength(const StringId a_Id);
+		//Amount of unique strings in the table.
+		size_t Count();
+	}
+}
@@ -0,0 +1,265 @@
+#pragma once
+#include "Utils/Logger.h"
+#include "Utils/Utils.h"
+
+#include <type_traits>
+
+namespace BB
+{
+	namespace StringView_Specs
+	{
+		//Returned by the find functions when nothing is found.
+		constexpr const size_t NOT_FOUND = SIZE_MAX;
+	}
+
+	//Search kernels for char strings, implemented with SIMD in StringView.cpp.
+	namespace StringOps
+	{
+		//Index of the first a_Char in a_String, a_Size if there is none.
+		size_t FindChar(const char* a_String, const size_t a_Size, const char a_Char);
+		//Index of the last a_Char in a_String, a_Size if there is none.
+		size_t FindLastChar(const char* a_String, const size_t a_Size, const char a_Char);
+		//Index of the first a_Pattern in a_String, a_Size if there is none.
+		size_t FindString(const char* a_String, const size_t a_Size, const char* a_Pattern, const size_t a_PatternSize);
+	}
+
+	/// <summary>
+	/// Non owning view of a string, the string does not need to be null terminated.
+	/// Cheap to copy, pass it by value. The viewed memory must outlive the view.
+	/// </summary>
+	template<typename CharT>
+	class Basic_StringView
+	{
+	public:
+		Basic_StringView() = default;
+		Basic_StringView(const CharT* a_String) : m_String(a_String), m_Size(Memory::StrLength(a_String)) {}
+		Basic_StringView(const CharT* a_String, const size_t a_Size) : m_String(a_String), m_Size(a_Size) {}
+
+		const CharT& operator[](const size_t a_Index) const
+		{
+			BB_ASSERT(a_Index < m_Size, "StringView, trying to get an character that is out of bounds.");
+			return m_String[a_Index];
+		}
+		bool operator==(const Basic_StringView<CharT> a_Rhs) const { return compare(a_Rhs); }
+		bool operator!=(const Basic_StringView<CharT> a_Rhs) const { return !compare(a_Rhs); }
+
+		/// <summary>
+		/// Get a view of a_Count characters from a_Pos, a_Count is clamped to the end of the view.
+		/// </summary>
+		Basic_StringView<CharT> substr(const size_t a_Pos, const size_t a_Count = StringView_Specs::NOT_FOUND) const;
+		void remove_prefix(const size_t a_Count);
+		void remove_suffix(const size_t a_Count);
+
+		/// <summary>
+		/// Index of the first match at or after a_Pos, StringView_Specs::NOT_FOUND if there is none.
+		/// </summary>
+		size_t find(const CharT a_Char, const size_t a_Pos = 0) const;
+		size_t find(const Basic_StringView<CharT> a_String, const size_t a_Pos = 0) const;
+		/// <summary>
+		/// Index of the last match that starts at or before a_Pos, StringView_Specs::NOT_FOUND if there is none.
+		/// </summary>
+		size_t rfind(const CharT a_Char, const size_t a_Pos = StringView_Specs::NOT_FOUND) const;
+		size_t rfind(const Basic_StringView<CharT> a_String, const size_t a_Pos = StringView_Specs::NOT_FOUND) const;
+
+		bool starts_with(const Basic_StringView<CharT> a_String) const;
+		bool ends_with(const Basic_StringView<CharT> a_String) const;
+		//True if both views have the same characters.
+		bool compare(const Basic_StringView<CharT> a_String) const;
+
+		/// <summary>
+		/// Split the view on a_Delimiter and write the parts to a_Out.
+		/// At most a_MaxCount parts are written, the last part then holds the rest of the view.
+		/// Returns the amount of parts written.
+		/// </summary>
+		size_t split(const CharT a_Delimiter, Basic_StringView<CharT>* a_Out, const size_t a_MaxCount) const;
+
+		const CharT* begin() const { return m_String; }
+		const CharT* end() const { return m_String + m_Size; }
+
+		size_t size() const { return m_Size; }
+		bool empty() const { return m_Size == 0; }
+		const CharT* data() const { return m_String; }
+
+	private:
+		//Dispatch to the SIMD kernels for char, wide strings use plain loops.
+		static size_t FindCharIn(const CharT* a_String, const size_t a_Size, const CharT a_Char);
+		static size_t FindLastCharIn(const CharT* a_String, const size_t a_Size, const CharT a_Char);
+		static size_t FindStringIn(const CharT* a_String, const size_t a_Size, const CharT* a_Pattern, const size_t a_PatternSize);
+
+		const CharT* m_String = nullptr;
+		size_t m_Size = 0;
+	};
+
+	using StringView = Basic_StringView<char>;
+	using WStringView = Basic_StringView<wchar_t>;
+
+	template<typename CharT>
+	inline Basic_StringView<CharT> BB::Basic_StringView<CharT>::substr(const size_t a_Pos, const size_t a_Count) const
+	{
+		BB_ASSERT(a_Pos <= m_Size, "StringView::substr, a_Pos is out of bounds.");
+		const size_t t_Rest = m_Size - a_Pos;
+		return Basic_StringView<CharT>(m_String + a_Pos, a_Count < t_Rest ? a_Count : t_Rest);
+	}
+
+	template<typename CharT>
+	inline void BB::Basic_StringView<CharT>::remove_prefix(const size_t a_Count)
+	{
+		BB_ASSERT(a_Count <= m_Size, "StringView::remove_prefix, removing more than the view has.");
+		m_String += a_Count;
+		m_Size -= a_Count;
+	}
+
+	template<typename CharT>
+	inline void BB::Basic_StringView<CharT>::remove_suffix(const size_t a_Count)
+	{
+		BB_ASSERT(a_Count <= m_Size, "StringView::remove_suffix, removing more than the view has.");
+		m_Size -= a_Count;
+	}
+
+	template<typename CharT>
+	inline size_t BB::Basic_StringView<CharT>::find(const CharT a_Char, const size_t a_Pos) const
+	{
+		if (a_Pos >= m_Size)
+			return StringView_Specs::NOT_FOUND;
+
+		const size_t t_Index = FindCharIn(m_String + a_Pos, m_Size - a_Pos, a_Char);
+		if (t_Index == m_Size - a_Pos)
+			return StringView_Specs::NOT_FOUND;
+		return a_Pos + t_Index;
+	}
+
+	template<typename CharT>
+	inline size_t BB::Basic_StringView<CharT>::find(const Basic_StringView<CharT> a_String, const size_t a_Pos) const
+	{
+		if (a_Pos > m_Size)
+			return StringView_Specs::NOT_FOUND;
+
+		const size_t t_Index = FindStringIn(m_String + a_Pos, m_Size - a_Pos, a_String.data(), a_String.size());
+		if (t_Index == m_Size - a_Pos && a_String.size() != 0)
+			return StringView_Specs::NOT_FOUND;
+		return a_Pos + t_Index;
+	}
+
+	template<typename CharT>
+	inline size_t BB::Basic_StringView<CharT>::rfind(const CharT a_Char, const size_t a_Pos) const
+	{
+		if (m_Size == 0)
+			return StringView_Specs::NOT_FOUND;
+
+		const size_t t_SearchSize = a_Pos < m_Size ? a_Pos + 1 : m_Size;
+		const size_t t_Index = FindLastCharIn(m_String, t_SearchSize, a_Char);
+		if (t_Index == t_SearchSize)
+			return StringView_Specs::NOT_FOUND;
+		return t_Index;
+	}
+
+	template<typename CharT>
+	inline size_t BB::Basic_StringView<CharT>::rfind(const Basic_StringView<CharT> a_String, const size_t a_Pos) const
+	{
+		if (a_String.size() > m_Size)
+			return StringView_Specs::NOT_FOUND;
+
+		size_t t_Start = m_Size - a_String.size();
+		if (a_Pos < t_Start)
+			t_Start = a_Pos;
+		if (a_String.empty())
+			return t_Start;
+
+		//Find the first character of the pattern from the back, then check the rest.
+		size_t t_SearchSize = t_Start + 1;
+		while (t_SearchSize != 0)
+		{
+			const size_t t_Index = FindLastCharIn(m_String, t_SearchSize, a_String[0]);
+			if (t_Index == t_SearchSize)
+				break;
+			if (Memory::Compare(m_String + t_Index, a_String.data(), a_String.size()) == 0)
+				return t_Index;
+			t_SearchSize = t_Index;
+		}
+		return StringView_Specs::NOT_FOUND;
+	}
+
+	template<typename CharT>
+	inline bool BB::Basic_StringView<CharT>::starts_with(const Basic_StringView<CharT> a_String) const
+	{
+		return a_String.size() <= m_Size && Memory::Compare(m_String, a_String.data(), a_String.size()) == 0;
+	}
+
+	template<typename CharT>
+	inline bool BB::Basic_StringView<CharT>::ends_with(const Basic_StringView<CharT> a_String) const
+	{
+		return a_String.size() <= m_Size && Memory::Compare(m_String + (m_Size - a_String.size()), a_String.data(), a_String.size()) == 0;
+	}
+
+	template<typename CharT>
+	inline bool BB::Basic_StringView<CharT>::compare(const Basic_StringView<CharT> a_String) const
+	{
+		return a_String.size() == m_Size && Memory::Compare(m_String, a_String.data(), m_Size) == 0;
+	}
+
+	template<typename CharT>
+	inline size_t BB::Basic_StringView<CharT>::split(const CharT a_Delimiter, Basic_StringView<CharT>* a_Out, const size_t a_MaxCount) const
+	{
+		if (a_MaxCount == 0)
+			return 0;
+
+		size_t t_Count = 0;
+		size_t t_Begin = 0;
+		while (t_Count + 1 < a_MaxCount)
+		{
+			const size_t t_Index = FindCharIn(m_String + t_Begin, m_Size - t_Begin, a_Delimiter);
+			if (t_Index == m_Size - t_Begin)
+				break;
+			a_Out[t_Count++] = Basic_StringView<CharT>(m_String + t_Begin, t_Index);
+			t_Begin += t_Index + 1;
+		}
+		a_Out[t_Count++] = Basic_StringView<CharT>(m_String + t_Begin, m_Size - t_Begin);
+		return t_Count;
+	}
+
+	template<typename CharT>
+	inline size_t BB::Basic_StringView<CharT>::FindCharIn(const CharT* a_String, const size_t a_Size, const CharT a_Char)
+	{
+		if constexpr (std::is_same_v<CharT, char>)
+			return StringOps::FindChar(a_String, a_Size, a_Char);
+		else
+		{
+			for (size_t i = 0; i < a_Size; i++)
+				if (a_String[i] == a_Char)
+					return i;
+			return a_Size;
+		}
+	}
+
+	template<typename CharT>
+	inline size_t BB::Basic_StringView<CharT>::FindLastCharIn(const CharT* a_String, const size_t a_Size, const CharT a_Char)
+	{
+		if constexpr (std::is_same_v<CharT, char>)
+			return StringOps::FindLastChar(a_String, a_Size, a_Char);
+		else
+		{
+			for (size_t i = a_Size; i > 0; i--)
+				if (a_String[i - 1] == a_Char)
+					return i - 1;
+			return a_Size;
+		}
+	}
+
+	template<typename CharT>
+	inline size_t BB::Basic_StringView<CharT>::FindStringIn(const CharT* a_String, const size_t a_Size, const CharT* a_Pattern, const size_t a_PatternSize)
+	{
+		if constexpr (std::is_same_v<CharT, char>)
+			return StringOps::FindString(a_String, a_Size, a_Pattern, a_PatternSize);
+		else
+		{
+			if (a_PatternSize == 0)
+				return 0;
+			if (a_PatternSize > a_Size)
+				return a_Size;
+			for (size_t i = 0; i + a_PatternSize <= a_Size; i++)
+				if (a_String[i] == a_Pattern[0] && Memory::Compare(a_String + i, a_Pattern, a_PatternSize) == 0)
+					return i;
+			return a_Size;
+		}
+	}
+}
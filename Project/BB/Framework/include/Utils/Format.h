@@ -0,0 +1,156 @@
+#pragma once
+#include "Storage/StringView.h"
+
+#include <type_traits>
+
+namespace BB
+{
+	namespace Format_Specs
+	{
+		//Most characters written by UIntToChars and IntToChars, "-9223372036854775808".
+		constexpr const size_t maxIntegerChars = 20;
+		//Most characters written by FloatToChars and DoubleToChars, "-0.00000012345678901234567".
+		constexpr const size_t maxFloatChars = 26;
+		//Most characters written by HexToChars, "0x" and 16 digits.
+		constexpr const size_t maxHexChars = 18;
+	}
+
+	//Number to text conversions, implemented in Format.cpp.
+	//They do not allocate, do not add a null terminator and return the amount of characters written.
+	namespace FormatOps
+	{
+		size_t UIntToChars(char* a_Buffer, const uint64_t a_Value);
+		size_t IntToChars(char* a_Buffer, const int64_t a_Value);
+		//Lowercase hexadecimal with a 0x prefix.
+		size_t HexToChars(char* a_Buffer, const uint64_t a_Value);
+		//Shortest text that reads back to exactly the same value.
+		//Fixed notation between 1e-7 and 1e21, scientific notation like 1.5e-8 outside of that.
+		size_t FloatToChars(char* a_Buffer, const float a_Value);
+		size_t DoubleToChars(char* a_Buffer, const double a_Value);
+
+		/// <summary>
+		/// Append a_Format to a_String up until the first {}, used by Format.
+		/// {{ and }} are written as { and }. a_Format is moved past the part that got appended.
+		/// Returns true if a {} was found.
+		/// </summary>
+		template<typename StringT>
+		bool AppendUntilArg(StringT& a_String, StringView& a_Format);
+
+		//Append a_Arg as text, used by Format.
+		template<typename StringT, typename T>
+		void AppendArg(StringT& a_String, const T& a_Arg);
+	}
+
+	/// <summary>
+	/// Append a_Format to a_String with every {} replaced by the next argument.
+	/// Works with anything that has append(const char*, size_t), like String and StackString.
+	/// Arguments can be bools, characters, integers, floats, pointers and anything that converts to a StringView.
+	/// </summary>
+	template<typename StringT, typename T, typename... Args>
+	void Format(StringT& a_String, const StringView a_Format, const T& a_Arg, const Args&... a_Args);
+	template<typename StringT>
+	void Format(StringT& a_String, const StringView a_Format);
+
+	template<typename StringT>
+	inline bool BB::FormatOps::AppendUntilArg(StringT& a_String, StringView& a_Format)
+	{
+		while (!a_Format.empty())
+		{
+			size_t t_Special = a_Format.find('{');
+			//Only a } before the { needs to be handled first.
+			const size_t t_Close = a_Format.substr(0, t_Special).find('}');
+			if (t_Close != StringView_Specs::NOT_FOUND)
+				t_Special = t_Close;
+
+			if (t_Special == StringView_Specs::NOT_FOUND)
+			{
+				a_String.append(a_Format.data(), a_Format.size());
+				a_Format.remove_prefix(a_Format.size());
+				return false;
+			}
+
+			a_String.append(a_Format.data(), t_Special);
+			const char t_Char = a_Format[t_Special];
+			const char t_Next = t_Special + 1 < a_Format.size() ? a_Format[t_Special + 1] : '\0';
+			if (t_Char == '{' && t_Next == '}')
+			{
+				a_Format.remove_prefix(t_Special + 2);
+				return true;
+			}
+
+			BB_ASSERT(t_Next == t_Char, "Format, a { or } that is not part of {}, {{ or }}.");
+			a_String.append(&t_Char, 1);
+			a_Format.remove_prefix(t_Special + (t_Next == t_Char ? 2 : 1));
+		}
+		return false;
+	}
+
+	template<typename StringT, typename T>
+	inline void BB::FormatOps::AppendArg(StringT& a_String, const T& a_Arg)
+	{
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			if (a_Arg)
+				a_String.append("true", 4);
+			else
+				a_String.append("false", 5);
+		}
+		else if constexpr (std::is_same_v<T, char>)
+			a_String.append(&a_Arg, 1);
+		else if constexpr (std::is_enum_v<T>)
+			AppendArg(a_String, static_cast<std::underlying_type_t<T>>(a_Arg));
+		else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+		{
+			char t_Buffer[Format_Specs::maxIntegerChars];
+			a_String.append(t_Buffer, IntToChars(t_Buffer, a_Arg));
+		}
+		else if constexpr (std::is_integral_v<T>)
+		{
+			char t_Buffer[Format_Specs::maxIntegerChars];
+			a_String.append(t_Buffer, UIntToChars(t_Buffer, a_Arg));
+		}
+		else if constexpr (std::is_same_v<T, float>)
+		{
+			char t_Buffer[Format_Specs::maxFloatChars];
+			a_String.append(t_Buffer, FloatToChars(t_Buffer, a_Arg));
+		}
+		else if constexpr (std::is_same_v<T, double>)
+		{
+			char t_Buffer[Format_Specs::maxFloatChars];
+			a_String.append(t_Buffer, DoubleToChars(t_Buffer, a_Arg));
+		}
+		else if constexpr (std::is_convertible_v<const T&, StringView>)
+		{
+			const StringView t_View = a_Arg;
+			a_String.append(t_View.data(), t_View.size());
+		}
+		else if constexpr (std::is_pointer_v<T>)
+		{
+			char t_Buffer[Format_Specs::maxHexChars];
+			a_String.append(t_Buffer, HexToChars(t_Buffer, reinterpret_cast<uintptr_t>(a_Arg)));
+		}
+		else
+			static_assert(!std::is_same_v<T, T>, "Format, this argument type cannot be formatted.");
+	}
+
+	template<typename StringT, typename T, typename... Args>
+	inline void BB::Format(StringT& a_String, const StringView a_Format, const T& a_Arg, const Args&... a_Args)
+	{
+		StringView t_Format = a_Format;
+		if (!FormatOps::AppendUntilArg(a_String, t_Format))
+		{
+			BB_ASSERT(false, "Format, more arguments than {} in the format string.");
+			return;
+		}
+		FormatOps::AppendArg(a_String, a_Arg);
+		Format(a_String, t_Format, a_Args...);
+	}
+
+	template<typename StringT>
+	inline void BB::Format(StringT& a_String, const StringView a_Format)
+	{
+		StringView t_Format = a_Format;
+		const bool t_HasArg = FormatOps::AppendUntilArg(a_String, t_Format);
+		BB_ASSERT(!t_HasArg, "Format, more {} in the format string than arguments.");
+	}
+}
@@ -1,16 +1,43 @@
 #pragma once
 #include "Utils/Logger.h"
+#include <cstdint>
 #include <type_traits>
+#include <cstring>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace Hash_Specs
+{
+	//wyhash secrets, used for mixing.
+	constexpr uint64_t secret0 = 0xa0761d6478bd642full;
+	constexpr uint64_t secret1 = 0xe7037ed1a0b428dbull;
+	constexpr uint64_t secret2 = 0x8ebc6af09c88c6e3ull;
+	constexpr uint64_t secret3 = 0x589965cc75374cc3ull;
+
+	//Byte ranges larger then this go through the striped bulk path, which has a SIMD implementation.
+	constexpr size_t bulkThreshold = 256;
+	constexpr size_t bulkStripeSize = 64;
+	constexpr size_t bulkLaneCount = bulkStripeSize / sizeof(uint64_t);
+	//The accumulators get scrambled after every block of stripes.
+	constexpr size_t bulkStripesPerBlock = 16;
+	constexpr uint32_t bulkPrime = 0x9E3779B1u;
+	constexpr uint64_t bulkKeys[bulkLaneCount]
+	{
+		0xbe4ba423396cfeb8ull, 0x1cad21f72c81017cull, 0xdb979083e96dd4deull, 0x1f67b3b7a4a44072ull,
+		0x78e5c0cc4ee679cbull, 0x2172ffcc7dd05a82ull, 0x8e2443f7744608b8ull, 0x4c263a81e69035e0ull
+	};
+}
 
 //will remove this, I don't like it.
 //Maybe a unified hash is cringe and I should just have some basic hashing operations in this file.
 struct Hash
 {
-	Hash() {};
-	Hash(uint64_t a_Hash) : hash(a_Hash) {};
+	constexpr Hash() {};
+	constexpr Hash(uint64_t a_Hash) : hash(a_Hash) {};
 	uint64_t hash = 0;
 
-	operator const uint64_t() const { return hash; }
+	constexpr operator const uint64_t() const { return hash; }
 	void operator=(const uint64_t a_Rhs) { hash = a_Rhs; }
 	Hash operator++(int) { return hash++; }
 	void operator*=(size_t a_Multi) { hash *= a_Multi; }
@@ -18,35 +45,232 @@ struct Hash
 	//Create with uint64_t.
 	static Hash MakeHash(size_t a_Value);
 	static Hash MakeHash(const char* a_Value);
+	//Same result as MakeHash(const char*), but the string does not need to be null terminated.
+	static Hash MakeHash(const char* a_Value, const size_t a_Size);
+	static Hash MakeHash(const void* a_Data, const size_t a_Size);
 	static Hash MakeHash(void* a_Value);
 
+	//Compile time versions, these return the same values as their MakeHash counterparts.
+	static constexpr Hash MakeHashConstexpr(const uint64_t a_Value);
+	static constexpr Hash MakeHashConstexpr(const char* a_Value, const size_t a_Size);
+	template<size_t N>
+	static constexpr Hash MakeHashConstexpr(const char(&a_String)[N]) { return MakeHashConstexpr(a_String, N - 1); }
+
 private:
+	//Runs the stripes of the bulk path, implemented with SIMD in Hash.cpp.
+	static void BulkAccumulateSIMD(const char* a_Data, const size_t a_StripeCount, uint64_t* a_Acc);
+
+	//Operations used by the hash when running at runtime.
+	struct RuntimeOps
+	{
+		static uint64_t Read64(const char* a_Data)
+		{
+			uint64_t t_Value;
+			memcpy(&t_Value, a_Data, sizeof(t_Value));
+			return t_Value;
+		}
+		static uint64_t Read32(const char* a_Data)
+		{
+			uint32_t t_Value;
+			memcpy(&t_Value, a_Data, sizeof(t_Value));
+			return t_Value;
+		}
+		static void Mum(uint64_t& a_A, uint64_t& a_B)
+		{
+#if defined(_MSC_VER) && defined(_M_X64)
+			a_A = _umul128(a_A, a_B, &a_B);
+#elif defined(__SIZEOF_INT128__)
+			const __uint128_t t_Result = static_cast<__uint128_t>(a_A) * a_B;
+			a_A = static_cast<uint64_t>(t_Result);
+			a_B = static_cast<uint64_t>(t_Result >> 64);
+#else
+			ConstexprOps::Mum(a_A, a_B);
+#endif
+		}
+		static void BulkAccumulate(const char* a_Data, const size_t a_StripeCount, uint64_t* a_Acc)
+		{
+			BulkAccumulateSIMD(a_Data, a_StripeCount, a_Acc);
+		}
+	};
+
+	//Operations that can be evaluated at compile time, little endian like the runtime reads.
+	struct ConstexprOps
+	{
+		static constexpr uint64_t Read64(const char* a_Data)
+		{
+			uint64_t t_Value = 0;
+			for (size_t i = 0; i < sizeof(uint64_t); i++)
+				t_Value |= static_cast<uint64_t>(static_cast<uint8_t>(a_Data[i])) << (i * 8);
+			return t_Value;
+		}
+		static constexpr uint64_t Read32(const char* a_Data)
+		{
+			uint64_t t_Value = 0;
+			for (size_t i = 0; i < sizeof(uint32_t); i++)
+				t_Value |= static_cast<uint64_t>(static_cast<uint8_t>(a_Data[i])) << (i * 8);
+			return t_Value;
+		}
+		//64x64 to 128 bit multiply, low half in a_A and high half in a_B.
+		static constexpr void Mum(uint64_t& a_A, uint64_t& a_B)
+		{
+			const uint64_t t_AHigh = a_A >> 32, t_ALow = static_cast<uint32_t>(a_A);
+			const uint64_t t_BHigh = a_B >> 32, t_BLow = static_cast<uint32_t>(a_B);
+			const uint64_t t_HighHigh = t_AHigh * t_BHigh, t_HighLow = t_AHigh * t_BLow;
+			const uint64_t t_LowHigh = t_ALow * t_BHigh, t_LowLow = t_ALow * t_BLow;
+			const uint64_t t_Mid = (t_LowLow >> 32) + static_cast<uint32_t>(t_HighLow) + static_cast<uint32_t>(t_LowHigh);
+			a_A = (t_Mid << 32) | static_cast<uint32_t>(t_LowLow);
+			a_B = t_HighHigh + (t_HighLow >> 32) + (t_LowHigh >> 32) + (t_Mid >> 32);
+		}
+		static constexpr void BulkAccumulate(const char* a_Data, const size_t a_StripeCount, uint64_t* a_Acc)
+		{
+			uint64_t t_StripeKey = 0;
+			for (size_t t_Stripe = 0; t_Stripe < a_StripeCount; t_Stripe++)
+			{
+				const char* t_Data = a_Data + t_Stripe * Hash_Specs::bulkStripeSize;
+				for (size_t i = 0; i < Hash_Specs::bulkLaneCount; i++)
+				{
+					const uint64_t t_DataValue = Read64(t_Data + i * sizeof(uint64_t));
+					const uint64_t t_DataKey = t_DataValue ^ (Hash_Specs::bulkKeys[i] + t_StripeKey);
+					a_Acc[i ^ 1] += t_DataValue;
+					a_Acc[i] += (t_DataKey & 0xFFFFFFFF) * (t_DataKey >> 32);
+				}
+				t_StripeKey += Hash_Specs::secret0;
+
+				if ((t_Stripe + 1) % Hash_Specs::bulkStripesPerBlock == 0)
+				{
+					for (size_t i = 0; i < Hash_Specs::bulkLaneCount; i++)
+					{
+						a_Acc[i] ^= a_Acc[i] >> 47;
+						a_Acc[i] ^= Hash_Specs::bulkKeys[i];
+						a_Acc[i] *= Hash_Specs::bulkPrime;
+					}
+				}
+			}
+		}
+	};
+
+	template<typename Ops>
+	static constexpr uint64_t Mix(uint64_t a_A, uint64_t a_B)
+	{
+		Ops::Mum(a_A, a_B);
+		return a_A ^ a_B;
+	}
+
+	template<typename Ops>
+	static constexpr uint64_t HashInteger(const uint64_t a_Value)
+	{
+		uint64_t t_A = a_Value ^ Hash_Specs::secret0;
+		uint64_t t_B = Hash_Specs::secret3 ^ Hash_Specs::secret1;
+		Ops::Mum(t_A, t_B);
+		return Mix<Ops>(t_A ^ Hash_Specs::secret0, t_B ^ Hash_Specs::secret1);
+	}
+
+	//wyhash for small inputs, big inputs go through an xxh3 style striped accumulate first.
+	template<typename Ops>
+	static constexpr uint64_t HashBytes(const char* a_Data, const size_t a_Size)
+	{
+		uint64_t t_Seed = Mix<Ops>(Hash_Specs::secret0, Hash_Specs::secret1);
+		uint64_t t_A = 0, t_B = 0;
+
+		if (a_Size <= 16)
+		{
+			if (a_Size >= 4)
+			{
+				const size_t t_Offset = (a_Size >> 3) << 2;
+				t_A = (Ops::Read32(a_Data) << 32) | Ops::Read32(a_Data + t_Offset);
+				t_B = (Ops::Read32(a_Data + a_Size - 4) << 32) | Ops::Read32(a_Data + a_Size - 4 - t_Offset);
+			}
+			else if (a_Size > 0)
+			{
+				t_A = (static_cast<uint64_t>(static_cast<uint8_t>(a_Data[0])) << 16) |
+					(static_cast<uint64_t>(static_cast<uint8_t>(a_Data[a_Size >> 1])) << 8) |
+					static_cast<uint64_t>(static_cast<uint8_t>(a_Data[a_Size - 1]));
+			}
+		}
+		else
+		{
+			const char* t_Data = a_Data;
+			size_t t_Remaining = a_Size;
+
+			if (a_Size > Hash_Specs::bulkThreshold)
+			{
+				uint64_t t_Acc[Hash_Specs::bulkLaneCount]{};
+				for (size_t i = 0; i < Hash_Specs::bulkLaneCount; i++)
+					t_Acc[i] = Hash_Specs::bulkKeys[i] ^ t_Seed;
+
+				const size_t t_StripeCount = a_Size / Hash_Specs::bulkStripeSize;
+				Ops::BulkAccumulate(t_Data, t_StripeCount, t_Acc);
+
+				for (size_t i = 0; i < Hash_Specs::bulkLaneCount; i += 2)
+					t_Seed += Mix<Ops>(t_Acc[i] ^ Hash_Specs::secret2, t_Acc[i + 1] ^ Hash_Specs::secret3);
 
+				t_Data += t_StripeCount * Hash_Specs::bulkStripeSize;
+				t_Remaining -= t_StripeCount * Hash_Specs::bulkStripeSize;
+			}
+			else if (t_Remaining > 48)
+			{
+				uint64_t t_Seed1 = t_Seed, t_Seed2 = t_Seed;
+				do
+				{
+					t_Seed = Mix<Ops>(Ops::Read64(t_Data) ^ Hash_Specs::secret1, Ops::Read64(t_Data + 8) ^ t_Seed);
+					t_Seed1 = Mix<Ops>(Ops::Read64(t_Data + 16) ^ Hash_Specs::secret2, Ops::Read64(t_Data + 24) ^ t_Seed1);
+					t_Seed2 = Mix<Ops>(Ops::Read64(t_Data + 32) ^ Hash_Specs::secret3, Ops::Read64(t_Data + 40) ^ t_Seed2);
+					t_Data += 48;
+					t_Remaining -= 48;
+				} while (t_Remaining > 48);
+				t_Seed ^= t_Seed1 ^ t_Seed2;
+			}
+
+			while (t_Remaining > 16)
+			{
+				t_Seed = Mix<Ops>(Ops::Read64(t_Data) ^ Hash_Specs::secret1, Ops::Read64(t_Data + 8) ^ t_Seed);
+				t_Data += 16;
+				t_Remaining -= 16;
+			}
+
+			//Always the last 16 bytes of the input, this can overlap with bytes that are already hashed.
+			t_A = Ops::Read64(a_Data + a_Size - 16);
+			t_B = Ops::Read64(a_Data + a_Size - 8);
+		}
+
+		t_A ^= Hash_Specs::secret1;
+		t_B ^= t_Seed;
+		Ops::Mum(t_A, t_B);
+		return Mix<Ops>(t_A ^ Hash_Specs::secret0 ^ a_Size, t_B ^ Hash_Specs::secret1);
+	}
 };
 
 inline Hash Hash::MakeHash(size_t a_Value)
 {
-	a_Value ^= a_Value << 13, a_Value ^= a_Value >> 17;
-	a_Value ^= a_Value << 5;
-	return Hash(a_Value);
+	return Hash(HashInteger<RuntimeOps>(a_Value));
 }
 
 inline Hash Hash::MakeHash(void* a_Value)
 {
-	uintptr_t t_Value = reinterpret_cast<uintptr_t>(a_Value);
-
-	t_Value ^= t_Value << 13, t_Value ^= t_Value >> 17;
-	t_Value ^= t_Value << 5;
-	return Hash(t_Value);
+	return Hash(HashInteger<RuntimeOps>(reinterpret_cast<uintptr_t>(a_Value)));
 }
 
 inline Hash Hash::MakeHash(const char* a_Value)
 {
-	uint64_t t_Hash = 5381;
-	int t_C;
+	return Hash(HashBytes<RuntimeOps>(a_Value, strlen(a_Value)));
+}
+
+inline Hash Hash::MakeHash(const char* a_Value, const size_t a_Size)
+{
+	return Hash(HashBytes<RuntimeOps>(a_Value, a_Size));
+}
 
-	while (t_C = *a_Value++)
-		t_Hash = ((t_Hash << 5) + t_Hash) + t_C;
+inline Hash Hash::MakeHash(const void* a_Data, const size_t a_Size)
+{
+	return Hash(HashBytes<RuntimeOps>(reinterpret_cast<const char*>(a_Data), a_Size));
+}
 
-	return Hash(t_Hash);
+constexpr Hash Hash::MakeHashConstexpr(const uint64_t a_Value)
+{
+	return Hash(HashInteger<ConstexprOps>(a_Value));
+}
+
+constexpr Hash Hash::MakeHashConstexpr(const char* a_Value, const size_t a_Size)
+{
+	return Hash(HashBytes<ConstexprOps>(a_Value, a_Size));
 }
\ No newline at end of file
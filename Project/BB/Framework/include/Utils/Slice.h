@@ -1,6 +1,6 @@
 #pragma once
 #include "Storage/Array.h"
-#include "Storage/Pool.h"
+#include "Storage/SmallArray.h"
 
 namespace BB
 {
@@ -47,12 +47,16 @@ namespace BB
 		Slice() : m_Ptr(nullptr), m_Size(0) {};
 		Slice(T* a_Ptr, size_t a_Size) : m_Ptr(a_Ptr), m_Size(a_Size) {};
 		Slice(T* a_Begin, T* a_End) : m_Ptr(a_Begin), m_Size(a_End - a_Begin) {};
-		Slice(Array<T>& a_Array) : m_Ptr(a_Array.data()), m_Size(a_Array.size()) {};
-		Slice(Pool<T>& a_Pool) : m_Ptr(a_Pool.data()), m_Size(a_Pool.size()) {};
+		//A Slice<const T> can be made from a non-const Slice or container.
+		Slice(const Slice<std::remove_const_t<T>>& a_Slice) : m_Ptr(a_Slice.data()), m_Size(a_Slice.size()) {};
+		Slice(Array<std::remove_const_t<T>>& a_Array) : m_Ptr(a_Array.data()), m_Size(a_Array.size()) {};
+		template<size_t N>
+		Slice(SmallArray<std::remove_const_t<T>, N>& a_Array) : m_Ptr(a_Array.data()), m_Size(a_Array.size()) {};
 
 		Slice<T>& operator=(const Slice<T>& a_Slice);
 		Slice<T>& operator=(const Array<T>& a_Rhs);
-		Slice<T>& operator=(const Pool<T>& a_Rhs);
+		template<size_t N>
+		Slice<T>& operator=(const SmallArray<T, N>& a_Rhs);
 
 		T& operator[](size_t a_Index) const
 		{
@@ -95,7 +99,8 @@ namespace BB
 	}
 
 	template<typename T>
-	inline Slice<T>& BB::Slice<T>::operator=(const Pool<T>& a_Rhs)
+	template<size_t N>
+	inline Slice<T>& BB::Slice<T>::operator=(const SmallArray<T, N>& a_Rhs)
 	{
 		m_Ptr = a_Rhs.data();
 		m_Size = a_Rhs.size();
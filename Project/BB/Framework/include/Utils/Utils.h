@@ -5,9 +5,42 @@
 #include <cstring>
 
 #include <cwchar>
+#include <type_traits>
+#include <utility>
+#include <xmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//Put inside a class to mark it trivially relocatable: moving it to a new address is a memcpy and the old memory is dropped without calling the destructor.
+//Only valid when the type does not point into itself, so not for types with inline storage like SmallArray.
+#define BB_TRIVIALLY_RELOCATABLE using TriviallyRelocatable_Tag = void
 
 namespace BB
 {
+	/// <summary>
+	/// Trait that tells containers they can relocate T with memcpy when they grow.
+	/// True for trivially copyable types and types that use BB_TRIVIALLY_RELOCATABLE, specialize it for types that you do not own.
+	/// </summary>
+	template<typename T, typename Enable = void>
+	struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+	template<typename T>
+	struct IsTriviallyRelocatable<T, std::void_t<typename T::TriviallyRelocatable_Tag>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool isTriviallyRelocatable_v = IsTriviallyRelocatable<T>::value;
+
+	//Default ordering of the sorted containers, uses operator<.
+	template<typename Key>
+	struct Standard_KeyLess
+	{
+		inline bool operator()(const Key& a_A, const Key& a_B) const
+		{
+			return a_A < a_B;
+		}
+	};
+
 	namespace Memory	
 	{
 
@@ -23,6 +56,14 @@ namespace BB
 		bool MemCmpSIMD128(const void* __restrict  a_Left, const void* __restrict  a_Right, size_t a_Size);
 		bool MemCmpSIMD256(const void* __restrict  a_Left, const void* __restrict  a_Right, size_t a_Size);
 
+		/// <summary>
+		/// Hint the CPU to load the cache line of a_Address, used to hide cache misses of random access.
+		/// </summary>
+		inline static void Prefetch(const void* a_Address)
+		{
+			_mm_prefetch(reinterpret_cast<const char*>(a_Address), _MM_HINT_T0);
+		}
+
 
 		/// <summary>
 		/// Memcpy abstraction that will call the constructor if needed.
@@ -30,7 +71,7 @@ namespace BB
 		template<typename T>
 		inline static void Copy(T* __restrict a_Destination, const T* __restrict a_Source, const size_t a_ElementCount)
 		{
-			if constexpr (std::is_trivially_constructible_v<T>)
+			if constexpr (std::is_trivially_copyable_v<T>)
 			{
 				memcpy(a_Destination, a_Source, a_ElementCount * sizeof(T));
 			}
@@ -62,69 +103,69 @@ namespace BB
 		}
 
 		/// <summary>
-		/// Memcpy abstraction that will call the constructor and/or deconstructor if needed.
+		/// Relocate elements to new memory, the source elements are no longer alive after this.
+		/// Trivially relocatable types are a single memcpy, other types are move constructed and then destructed.
 		/// Unsafe version: It will call memcpy instead of memmove
 		/// </summary>
 		template<typename T>
-		inline static void* Move(T* __restrict a_Destination, const T* __restrict a_Source, const size_t a_ElementCount)
+		inline static void* Move(T* __restrict a_Destination, T* __restrict a_Source, const size_t a_ElementCount)
 		{
-			constexpr bool trivalConstruction = std::is_trivially_constructible_v<T>;
-			constexpr bool trivalDestructible = std::is_trivially_destructible_v<T>;
-
-			if constexpr (trivalConstruction)
+			if constexpr (isTriviallyRelocatable_v<T>)
 			{
 				return memcpy(a_Destination, a_Source, a_ElementCount * sizeof(T));
 			}
-			else if constexpr (!trivalConstruction || !trivalDestructible)
+			else
 			{
 				for (size_t i = 0; i < a_ElementCount; i++)
 				{
-					if constexpr (!trivalConstruction)
-					{
-						new (&a_Destination[i]) T(a_Source[i]);
-					}
-					if constexpr (!trivalDestructible)
+					new (&a_Destination[i]) T(std::move(a_Source[i]));
+					if constexpr (!std::is_trivially_destructible_v<T>)
 					{
 						a_Source[i].~T();
 					}
 				}
 				return a_Destination;
 			}
-			BB_ASSERT(false, "Something weird happened in Utils.h, Unsafe Move.");
-			return nullptr;
 		}
 
 		/// <summary>
-		/// Memmove abstraction that will call the constructor and/or deconstructor if needed.
+		/// Relocate elements to memory that may overlap with the source, the source elements are no longer alive after this.
 		/// Safe version: It will call memmove instead of memcpy
 		/// </summary>
 		template<typename T>
-		inline static void* sMove(T* __restrict a_Destination, const T* __restrict a_Source, const size_t a_ElementCount)
+		inline static void* sMove(T* a_Destination, T* a_Source, const size_t a_ElementCount)
 		{
-			constexpr bool trivalConstruction = std::is_trivially_constructible_v<T>;
-			constexpr bool trivalDestructible = std::is_trivially_destructible_v<T>;
-
-			if constexpr (trivalConstruction)
+			if constexpr (isTriviallyRelocatable_v<T>)
 			{
 				return memmove(a_Destination, a_Source, a_ElementCount * sizeof(T));
 			}
-			else if constexpr (!trivalConstruction && !trivalDestructible)
+			else
 			{
-				for (size_t i = 0; i < a_ElementCount; i++)
+				//Go in the direction that does not overwrite source elements that still need to be moved.
+				if (a_Destination < a_Source)
 				{
-					if constexpr (!trivalConstruction)
+					for (size_t i = 0; i < a_ElementCount; i++)
 					{
-						new (&a_Destination[i]) T(a_Source[i]);
+						new (&a_Destination[i]) T(std::move(a_Source[i]));
+						if constexpr (!std::is_trivially_destructible_v<T>)
+						{
+							a_Source[i].~T();
+						}
 					}
-					if constexpr (!trivalDestructible)
+				}
+				else if (a_Destination > a_Source)
+				{
+					for (size_t i = a_ElementCount; i > 0; i--)
 					{
-						a_Source[i].~T();
+						new (&a_Destination[i - 1]) T(std::move(a_Source[i - 1]));
+						if constexpr (!std::is_trivially_destructible_v<T>)
+						{
+							a_Source[i - 1].~T();
+						}
 					}
 				}
 				return a_Destination;
 			}
-			BB_ASSERT(false, "Something weird happened in Utils.h, Unsafe Move.");
-			return nullptr;
 		}
 
 		/// <summary>
@@ -162,6 +203,56 @@ namespace BB
 		{
 			return ((a_NumToRound + a_Multiple - 1) / a_Multiple) * a_Multiple;
 		}
+
+		//Amount of bits set to 1.
+		inline static uint32_t PopCount(const uint64_t a_Value)
+		{
+#ifdef _MSC_VER
+			return static_cast<uint32_t>(__popcnt64(a_Value));
+#else
+			return static_cast<uint32_t>(__builtin_popcountll(a_Value));
+#endif
+		}
+
+		//Index of the lowest set bit, a_Value must not be 0.
+		//tzcnt with AVX2 builds on MSVC, with -mbmi the builtin is tzcnt as well. bsf otherwise.
+		inline static uint32_t CountTrailingZeros(const uint64_t a_Value)
+		{
+			BB_ASSERT(a_Value != 0, "CountTrailingZeros on 0 is undefined.");
+#if defined(_MSC_VER) && defined(__AVX2__)
+			return static_cast<uint32_t>(_tzcnt_u64(a_Value));
+#elif defined(_MSC_VER)
+			unsigned long t_Index;
+			_BitScanForward64(&t_Index, a_Value);
+			return static_cast<uint32_t>(t_Index);
+#else
+			return static_cast<uint32_t>(__builtin_ctzll(a_Value));
+#endif
+		}
+
+		//Index of the highest set bit counted from the top, a_Value must not be 0.
+		//lzcnt with AVX2 builds on MSVC, with -mlzcnt the builtin is lzcnt as well. bsr otherwise.
+		inline static uint32_t CountLeadingZeros(const uint64_t a_Value)
+		{
+			BB_ASSERT(a_Value != 0, "CountLeadingZeros on 0 is undefined.");
+#if defined(_MSC_VER) && defined(__AVX2__)
+			return static_cast<uint32_t>(_lzcnt_u64(a_Value));
+#elif defined(_MSC_VER)
+			unsigned long t_Index;
+			_BitScanReverse64(&t_Index, a_Value);
+			return 63 - static_cast<uint32_t>(t_Index);
+#else
+			return static_cast<uint32_t>(__builtin_clzll(a_Value));
+#endif
+		}
+
+		//Smallest power of 2 that is equal to or bigger than a_Value, 1 when a_Value is 0.
+		inline static size_t RoundUpPowerOfTwo(const size_t a_Value)
+		{
+			if (a_Value <= 1)
+				return 1;
+			return static_cast<size_t>(1) << (64 - CountLeadingZeros(a_Value - 1));
+		}
 	}
 
 	namespace Random
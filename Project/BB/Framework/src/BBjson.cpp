@@ -2,7 +2,8 @@
 #include "OS/Program.h"
 
 #include "Utils/Utils.h"
-#include <string>
+#include "Utils/Format.h"
+#include <cstdlib>
 
 using namespace BB;
 
@@ -56,9 +57,7 @@ Token GetToken(JsonFile& a_JsonFile)
 	if (t_C == '"') //is string
 	{
 		//get string length
-		size_t t_StrLen = 0;
-		while (a_JsonFile.data[a_JsonFile.pos + t_StrLen] != '"')
-			++t_StrLen;
+		const size_t t_StrLen = StringOps::FindChar(&a_JsonFile.data[a_JsonFile.pos], a_JsonFile.size - a_JsonFile.pos, '"');
 
 		t_Token.type = TOKEN_TYPE::STRING;
 		t_Token.strSize = static_cast<uint32_t>(t_StrLen);
@@ -71,7 +70,7 @@ Token GetToken(JsonFile& a_JsonFile)
 		//get string length which are numbers
 		size_t t_StrLen = 1;
 		char t_Num = a_JsonFile.data[a_JsonFile.pos + t_StrLen];
-		while (t_Num == '-' || (t_Num >= '0' && t_Num <= '9') || t_Num == '.')
+		while (t_Num == '-' || (t_Num >= '0' && t_Num <= '9') || t_Num == '.' || t_Num == 'e' || t_Num == 'E' || t_Num == '+')
 			t_Num = a_JsonFile.data[a_JsonFile.pos + t_StrLen++];
 
 		t_Token.type = TOKEN_TYPE::NUMBER;
@@ -135,7 +134,9 @@ Token GetToken(JsonFile& a_JsonFile)
 	return t_Token;
 }
 
-void BB::JsonNodeToString(const JsonNode* a_Node, String& a_String)
+//StringT is a String or a StringBuilder, both are written the same way.
+template<typename StringT>
+static void WriteJsonNode(const JsonNode* a_Node, StringT& a_String)
 {
 	switch (a_Node->type)
 	{
@@ -151,7 +152,7 @@ void BB::JsonNodeToString(const JsonNode* a_Node, String& a_String)
 			a_String.append(t_Pair->name);
 			a_String.append("\"");
 			a_String.append(" : ");
-			JsonNodeToString(t_Pair->node, a_String);
+			WriteJsonNode(t_Pair->node, a_String);
 
 			if (t_Pair->next != nullptr)
 				a_String.append(",\n");
@@ -168,7 +169,7 @@ void BB::JsonNodeToString(const JsonNode* a_Node, String& a_String)
 
 		for (size_t i = 0; i < a_Node->list.nodeCount; i++)
 		{
-			JsonNodeToString(a_Node->list.nodes[i], a_String);
+			WriteJsonNode(a_Node->list.nodes[i], a_String);
 			a_String.append(",\n");
 		}
 
@@ -180,10 +181,10 @@ void BB::JsonNodeToString(const JsonNode* a_Node, String& a_String)
 		a_String.append("\"");
 		break;
 	case BB::JSON_TYPE::NUMBER:
-		BB_WARNING(false, "Not supporting number to string yet.", WarningType::LOW);
-		a_String.append("\"");
-		//t_JsonString.append(t_Node->number);
-		a_String.append("\"");
+	{
+		char t_Number[Format_Specs::maxFloatChars];
+		a_String.append(t_Number, FormatOps::FloatToChars(t_Number, a_Node->number));
+	}
 		break;
 	case BB::JSON_TYPE::BOOL:
 		if (a_Node->boolean)
@@ -199,6 +200,16 @@ void BB::JsonNodeToString(const JsonNode* a_Node, String& a_String)
 	}
 }
 
+void BB::JsonNodeToString(const JsonNode* a_Node, String& a_String)
+{
+	WriteJsonNode(a_Node, a_String);
+}
+
+void BB::JsonNodeToString(const JsonNode* a_Node, StringBuilder& a_String)
+{
+	WriteJsonNode(a_Node, a_String);
+}
+
 JsonParser::JsonParser(const char* a_Path)
 	: m_Allocator(mbSize * 8, a_Path)
 {
@@ -210,8 +221,13 @@ JsonParser::JsonParser(const char* a_Path)
 JsonParser::JsonParser(const Buffer& a_Buffer)
 	: m_Allocator(mbSize * 8, "Json from memory read")
 {
-	m_JsonFile.data = reinterpret_cast<char*>(a_Buffer.data);
-	m_JsonFile.size = static_cast<uint32_t>(a_Buffer.size);
+	CopyJson(reinterpret_cast<const char*>(a_Buffer.data), a_Buffer.size);
+}
+
+JsonParser::JsonParser(const StringView a_Json)
+	: m_Allocator(mbSize * 8, "Json from memory read")
+{
+	CopyJson(a_Json.data(), a_Json.size());
 }
 
 JsonParser::~JsonParser()
@@ -219,6 +235,15 @@ JsonParser::~JsonParser()
 	m_Allocator.Clear();
 }
 
+void JsonParser::CopyJson(const char* a_Json, const size_t a_Size)
+{
+	//One copy of the whole text, names and strings then point into it.
+	m_JsonFile.data = BBnewArr(m_Allocator, a_Size + 1, char);
+	Memory::Copy(m_JsonFile.data, a_Json, a_Size);
+	m_JsonFile.data[a_Size] = '\0';
+	m_JsonFile.size = static_cast<uint32_t>(a_Size);
+}
+
 JsonNode* JsonParser::PraseSingleToken(const Token& a_Token)
 {
 	JsonNode* t_Node;
@@ -279,8 +304,8 @@ JsonNode* JsonParser::ParseObject()
 	while (t_ContinueLoop)
 	{
 		BB_WARNING(t_NextToken.type == TOKEN_TYPE::STRING, "Object does not start with a string!", WarningType::HIGH);
-		char* t_ElementName = BBnewArr(m_Allocator, t_NextToken.strSize + 1, char);
-		Memory::Copy(t_ElementName, t_NextToken.str, t_NextToken.strSize);
+		//The tokenizer is past the closing quote, so it can become the null terminator.
+		char* t_ElementName = t_NextToken.str;
 		t_ElementName[t_NextToken.strSize] = '\0';
 
 		t_NextToken = GetToken(m_JsonFile);
@@ -455,8 +480,8 @@ JsonNode* JsonParser::ParseString(const Token& a_Token)
 	JsonNode* t_Node = BBnew(m_Allocator, JsonNode);
 	t_Node->type = JSON_TYPE::STRING;
 
-	t_Node->string = BBnewArr(m_Allocator, a_Token.strSize + 1, char);
-	Memory::Copy(t_Node->string, a_Token.str, a_Token.strSize);
+	//Terminate in place like the object names.
+	t_Node->string = a_Token.str;
 	t_Node->string[a_Token.strSize] = '\0';
 
 	return t_Node;
@@ -467,7 +492,7 @@ JsonNode* JsonParser::ParseNumber(const Token& a_Token)
 	JsonNode* t_Node = BBnew(m_Allocator, JsonNode);
 	t_Node->type = JSON_TYPE::NUMBER;
 
-	t_Node->number = std::stof(a_Token.str);
+	t_Node->number = strtof(a_Token.str, nullptr);
 
 	return t_Node;
 }
@@ -4,6 +4,7 @@
 #include "Math.inl"
 #include "Utils/Logger.h"
 #include "RingAllocator.h"
+#include "RingBuffer.h"
 
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
@@ -23,21 +24,15 @@ void DefaultResize(WindowHandle a_WindowHandle, uint32_t a_X, uint32_t a_Y) {}
 static PFN_WindowCloseEvent sPFN_CloseEvent = DefaultClose;
 static PFN_WindowResizeEvent sPFN_ResizeEvent = DefaultResize;
 
-struct InputBuffer
-{
-	InputEvent inputBuff[INPUT_EVENT_BUFFER_MAX];
-	uint32_t start = 0;
-	uint16_t pos = 0;
-	uint16_t used = 0;
-};
-
 struct GlobalProgramInfo
 {
 	bool trackingMouse = true;
 };
 
 static GlobalProgramInfo s_ProgramInfo{};
-static InputBuffer s_InputBuffer{};
+//Only holds the input queue, a freelist so the queue can give its buffer back when it is destroyed at exit.
+static FreelistAllocator_t s_InputAllocator(INPUT_EVENT_BUFFER_MAX * sizeof(InputEvent) + kbSize, "Input Allocator");
+static RingBuffer<InputEvent> s_InputBuffer(s_InputAllocator, INPUT_EVENT_BUFFER_MAX, false);
 static std::mutex s_InputMutex{};
 
 static size_t s_OSRingAllocatorSize = 0; //This will be changed to the OS granulary minimum..
@@ -46,35 +41,21 @@ static LocalRingAllocator s_OSRingAllocator{ s_OSRingAllocatorSize };
 void PushInput(const InputEvent& a_Input)
 {
 	s_InputMutex.lock();
-	if (s_InputBuffer.pos + 1 > INPUT_EVENT_BUFFER_MAX)
-		s_InputBuffer.pos = 0;
-
-	s_InputBuffer.inputBuff[s_InputBuffer.pos++] = a_Input;
+	//Since when we get the input we get all of it, a full buffer drops the oldest event.
+	if (s_InputBuffer.full())
+		s_InputBuffer.pop_front();
 
-	//Since when we get the input we get all of it. 
-	if (s_InputBuffer.used < INPUT_EVENT_BUFFER_MAX)
-	{
-		++s_InputBuffer.used;
-	}
+	s_InputBuffer.push_back(a_Input);
 	s_InputMutex.unlock();
 }
 
-//Returns false if no input is left.
-void GetAllInput(InputEvent* a_InputBuffer)
+//Returns the amount of events written to a_InputBuffer.
+size_t GetAllInput(InputEvent* a_InputBuffer)
 {
 	s_InputMutex.lock();
-	int t_FirstIndex = s_InputBuffer.start;
-	for (size_t i = 0; i < s_InputBuffer.used; i++)
-	{
-		a_InputBuffer[i] = s_InputBuffer.inputBuff[t_FirstIndex];
-		//We go back to zero the read the data.
-		if (++t_FirstIndex > INPUT_EVENT_BUFFER_MAX)
-			t_FirstIndex = 0;
-	}
-
-	s_InputBuffer.start = s_InputBuffer.pos;
-	s_InputBuffer.used = 0;
+	const size_t t_EventCount = s_InputBuffer.pop_front(a_InputBuffer, s_InputBuffer.size());
 	s_InputMutex.unlock();
+	return t_EventCount;
 }
 
 void BB::InitProgram()
@@ -470,6 +451,13 @@ void BB::WriteToOSFile(const OSFileHandle a_file_handle, const void* a_data, con
 	}
 }
 
+//WriteFileGather only works on unbuffered files with page sized buffers, so the buffers are written one after another.
+void BB::WriteToOSFile(const OSFileHandle a_FileHandle, const Buffer* a_Buffers, const size_t a_BufferCount)
+{
+	for (size_t i = 0; i < a_BufferCount; i++)
+		WriteToOSFile(a_FileHandle, a_Buffers[i].data, a_Buffers[i].size);
+}
+
 //Get a file's size in bytes.
 uint64_t BB::GetOSFileSize(const OSFileHandle a_FileHandle)
 {
@@ -736,10 +724,14 @@ bool BB::ProcessMessages(const WindowHandle a_WindowHandle)
 
 void BB::PollInputEvents(InputEvent* a_EventBuffers, size_t& a_InputEventAmount)
 {
-	a_InputEventAmount = s_InputBuffer.used;
 	if (a_EventBuffers == nullptr)
+	{
+		s_InputMutex.lock();
+		a_InputEventAmount = s_InputBuffer.size();
+		s_InputMutex.unlock();
 		return;
+	}
 	
 	//Overwrite could happen! But this is user's responsibility.
-	GetAllInput(a_EventBuffers);
+	a_InputEventAmount = GetAllInput(a_EventBuffers);
 }
\ No newline at end of file
@@ -0,0 +1,311 @@
+#include "BitArray.h"
+
+#include <immintrin.h>
+
+using namespace BB;
+
+#ifdef __AVX2__
+constexpr const size_t AVX_WORDS = sizeof(__m256i) / sizeof(uint64_t);
+#endif //__AVX2__
+
+void BB::BitOps::And(uint64_t* __restrict a_Destination, const uint64_t* __restrict a_Source, const size_t a_WordCount)
+{
+	size_t i = 0;
+#ifdef __AVX2__
+	for (; i + AVX_WORDS <= a_WordCount; i += AVX_WORDS)
+	{
+		const __m256i t_Destination = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_Destination + i));
+		const __m256i t_Source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_Source + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(a_Destination + i), _mm256_and_si256(t_Destination, t_Source));
+	}
+#endif //__AVX2__
+	for (; i < a_WordCount; i++)
+		a_Destination[i] &= a_Source[i];
+}
+
+void BB::BitOps::Or(uint64_t* __restrict a_Destination, const uint64_t* __restrict a_Source, const size_t a_WordCount)
+{
+	size_t i = 0;
+#ifdef __AVX2__
+	for (; i + AVX_WORDS <= a_WordCount; i += AVX_WORDS)
+	{
+		const __m256i t_Destination = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_Destination + i));
+		const __m256i t_Source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_Source + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(a_Destination + i), _mm256_or_si256(t_Destination, t_Source));
+	}
+#endif //__AVX2__
+	for (; i < a_WordCount; i++)
+		a_Destination[i] |= a_Source[i];
+}
+
+void BB::BitOps::Xor(uint64_t* __restrict a_Destination, const uint64_t* __restrict a_Source, const size_t a_WordCount)
+{
+	size_t i = 0;
+#ifdef __AVX2__
+	for (; i + AVX_WORDS <= a_WordCount; i += AVX_WORDS)
+	{
+		const __m256i t_Destination = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_Destination + i));
+		const __m256i t_Source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_Source + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(a_Destination + i), _mm256_xor_si256(t_Destination, t_Source));
+	}
+#endif //__AVX2__
+	for (; i < a_WordCount; i++)
+		a_Destination[i] ^= a_Source[i];
+}
+
+void BB::BitOps::AndNot(uint64_t* __restrict a_Destination, const uint64_t* __restrict a_Source, const size_t a_WordCount)
+{
+	size_t i = 0;
+#ifdef __AVX2__
+	for (; i + AVX_WORDS <= a_WordCount; i += AVX_WORDS)
+	{
+		const __m256i t_Destination = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_Destination + i));
+		const __m256i t_Source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_Source + i));
+		//andnot inverts the first operand.
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(a_Destination + i), _mm256_andnot_si256(t_Source, t_Destination));
+	}
+#endif //__AVX2__
+	for (; i < a_WordCount; i++)
+		a_Destination[i] &= ~a_Source[i];
+}
+
+size_t BB::BitOps::PopCount(const uint64_t* a_Words, const size_t a_WordCount)
+{
+	//4 counters so the popcnt instructions do not wait on each other.
+	size_t t_Count0 = 0, t_Count1 = 0, t_Count2 = 0, t_Count3 = 0;
+	size_t i = 0;
+	for (; i + 4 <= a_WordCount; i += 4)
+	{
+		t_Count0 += Math::PopCount(a_Words[i]);
+		t_Count1 += Math::PopCount(a_Words[i + 1]);
+		t_Count2 += Math::PopCount(a_Words[i + 2]);
+		t_Count3 += Math::PopCount(a_Words[i + 3]);
+	}
+	for (; i < a_WordCount; i++)
+		t_Count0 += Math::PopCount(a_Words[i]);
+
+	return t_Count0 + t_Count1 + t_Count2 + t_Count3;
+}
+
+bool BB::BitOps::Any(const uint64_t* a_Words, const size_t a_WordCount)
+{
+	size_t i = 0;
+#ifdef __AVX2__
+	for (; i + AVX_WORDS <= a_WordCount; i += AVX_WORDS)
+	{
+		const __m256i t_Words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_Words + i));
+		if (!_mm256_testz_si256(t_Words, t_Words))
+			return true;
+	}
+#endif //__AVX2__
+	for (; i < a_WordCount; i++)
+	{
+		if (a_Words[i] != 0)
+			return true;
+	}
+	return false;
+}
+
+size_t BB::BitOps::FindFirstUnset(const uint64_t* a_Words, const size_t a_Begin, const size_t a_End)
+{
+	size_t i = a_Begin;
+	while (i < a_End)
+	{
+		const size_t t_WordIndex = i >> BitArray_Specs::wordShift;
+		//Ignore the bits before i in the first word.
+		const uint64_t t_Unset = ~a_Words[t_WordIndex] & (~0ull << (i & BitArray_Specs::wordMask));
+		if (t_Unset != 0)
+		{
+			const size_t t_Index = (t_WordIndex << BitArray_Specs::wordShift) + Math::CountTrailingZeros(t_Unset);
+			return t_Index < a_End ? t_Index : a_End;
+		}
+		i = (t_WordIndex + 1) << BitArray_Specs::wordShift;
+	}
+	return a_End;
+}
+
+size_t BB::BitOps::FindLastSet(const uint64_t* a_Words, const size_t a_Begin, const size_t a_End)
+{
+	if (a_End <= a_Begin)
+		return a_End;
+
+	const size_t t_FirstWord = a_Begin >> BitArray_Specs::wordShift;
+	size_t i = a_End - 1;
+	while (true)
+	{
+		const size_t t_WordIndex = i >> BitArray_Specs::wordShift;
+		//Ignore the bits after i in the last word.
+		const uint64_t t_Set = a_Words[t_WordIndex] & (~0ull >> (BitArray_Specs::wordMask - (i & BitArray_Specs::wordMask)));
+		if (t_Set != 0)
+		{
+			const size_t t_Index = (t_WordIndex << BitArray_Specs::wordShift) + BitArray_Specs::wordMask - Math::CountLeadingZeros(t_Set);
+			return t_Index >= a_Begin ? t_Index : a_End;
+		}
+		if (t_WordIndex == t_FirstWord)
+			return a_End;
+		i = (t_WordIndex << BitArray_Specs::wordShift) - 1;
+	}
+}
+
+BitArray::BitArray(Allocator a_Allocator)
+	: m_Allocator(a_Allocator)
+{}
+
+BitArray::BitArray(Allocator a_Allocator, const size_t a_BitCount)
+	: m_Allocator(a_Allocator)
+{
+	resize(a_BitCount);
+}
+
+BitArray::BitArray(const BitArray& a_BitArray)
+	: m_Allocator(a_BitArray.m_Allocator)
+{
+	if (a_BitArray.m_WordCapacity != 0)
+	{
+		reallocate(a_BitArray.m_WordCapacity);
+		memcpy(m_Words, a_BitArray.m_Words, a_BitArray.m_WordCapacity * sizeof(uint64_t));
+	}
+	m_BitCount = a_BitArray.m_BitCount;
+}
+
+BitArray::BitArray(BitArray&& a_BitArray) noexcept
+	: m_Allocator(a_BitArray.m_Allocator)
+{
+	m_Words = a_BitArray.m_Words;
+	m_BitCount = a_BitArray.m_BitCount;
+	m_WordCapacity = a_BitArray.m_WordCapacity;
+
+	a_BitArray.m_Words = nullptr;
+	a_BitArray.m_BitCount = 0;
+	a_BitArray.m_WordCapacity = 0;
+}
+
+BitArray::~BitArray()
+{
+	if (m_Words != nullptr)
+		BBfree(m_Allocator, m_Words);
+}
+
+BitArray& BitArray::operator=(const BitArray& a_Rhs)
+{
+	if (m_Words != nullptr)
+		BBfree(m_Allocator, m_Words);
+	m_Words = nullptr;
+	m_WordCapacity = 0;
+
+	m_Allocator = a_Rhs.m_Allocator;
+	if (a_Rhs.m_WordCapacity != 0)
+	{
+		reallocate(a_Rhs.m_WordCapacity);
+		memcpy(m_Words, a_Rhs.m_Words, a_Rhs.m_WordCapacity * sizeof(uint64_t));
+	}
+	m_BitCount = a_Rhs.m_BitCount;
+
+	return *this;
+}
+
+BitArray& BitArray::operator=(BitArray&& a_Rhs) noexcept
+{
+	if (m_Words != nullptr)
+		BBfree(m_Allocator, m_Words);
+
+	m_Allocator = a_Rhs.m_Allocator;
+	m_Words = a_Rhs.m_Words;
+	m_BitCount = a_Rhs.m_BitCount;
+	m_WordCapacity = a_Rhs.m_WordCapacity;
+
+	a_Rhs.m_Words = nullptr;
+	a_Rhs.m_BitCount = 0;
+	a_Rhs.m_WordCapacity = 0;
+
+	return *this;
+}
+
+void BitArray::push_back(const bool a_Value)
+{
+	if (m_BitCount == capacity())
+		reallocate(m_WordCapacity == 0 ? 1 : m_WordCapacity * 2);
+
+	const size_t t_Index = m_BitCount++;
+	if (a_Value)
+		set(t_Index);
+}
+
+void BitArray::resize(const size_t a_BitCount)
+{
+	reserve(a_BitCount);
+	if (a_BitCount < m_BitCount)
+	{
+		//Keep the bits outside of the size at 0.
+		const size_t t_WordCount = BitArray_Specs::WordCount(a_BitCount);
+		if (t_WordCount != 0)
+			m_Words[t_WordCount - 1] &= BitArray_Specs::LastWordMask(a_BitCount);
+		memset(m_Words + t_WordCount, 0, (word_count() - t_WordCount) * sizeof(uint64_t));
+	}
+	m_BitCount = a_BitCount;
+}
+
+void BitArray::reserve(const size_t a_BitCount)
+{
+	const size_t t_WordCount = BitArray_Specs::WordCount(a_BitCount);
+	if (t_WordCount > m_WordCapacity)
+		reallocate(t_WordCount);
+}
+
+void BitArray::set_all()
+{
+	const size_t t_WordCount = word_count();
+	if (t_WordCount == 0)
+		return;
+	memset(m_Words, 0xFF, t_WordCount * sizeof(uint64_t));
+	m_Words[t_WordCount - 1] &= BitArray_Specs::LastWordMask(m_BitCount);
+}
+
+void BitArray::clear()
+{
+	if (m_Words != nullptr)
+		memset(m_Words, 0, word_count() * sizeof(uint64_t));
+}
+
+BitArray& BitArray::operator&=(const BitArray& a_Rhs)
+{
+	BB_ASSERT(m_BitCount == a_Rhs.m_BitCount, "BitArray, bulk operation on BitArrays of a different size.");
+	BitOps::And(m_Words, a_Rhs.m_Words, word_count());
+	return *this;
+}
+
+BitArray& BitArray::operator|=(const BitArray& a_Rhs)
+{
+	BB_ASSERT(m_BitCount == a_Rhs.m_BitCount, "BitArray, bulk operation on BitArrays of a different size.");
+	BitOps::Or(m_Words, a_Rhs.m_Words, word_count());
+	return *this;
+}
+
+BitArray& BitArray::operator^=(const BitArray& a_Rhs)
+{
+	BB_ASSERT(m_BitCount == a_Rhs.m_BitCount, "BitArray, bulk operation on BitArrays of a different size.");
+	BitOps::Xor(m_Words, a_Rhs.m_Words, word_count());
+	return *this;
+}
+
+BitArray& BitArray::and_not(const BitArray& a_Rhs)
+{
+	BB_ASSERT(m_BitCount == a_Rhs.m_BitCount, "BitArray, bulk operation on BitArrays of a different size.");
+	BitOps::AndNot(m_Words, a_Rhs.m_Words, word_count());
+	return *this;
+}
+
+void BitArray::reallocate(const size_t a_NewWordCapacity)
+{
+	uint64_t* t_NewWords = reinterpret_cast<uint64_t*>(BBalloc(m_Allocator, a_NewWordCapacity * sizeof(uint64_t)));
+	//New words start at 0 so growing never needs to clear bits.
+	memset(t_NewWords, 0, a_NewWordCapacity * sizeof(uint64_t));
+	if (m_Words != nullptr)
+	{
+		memcpy(t_NewWords, m_Words, m_WordCapacity * sizeof(uint64_t));
+		BBfree(m_Allocator, m_Words);
+	}
+
+	m_Words = t_NewWords;
+	m_WordCapacity = a_NewWordCapacity;
+}
@@ -0,0 +1,180 @@
+#include "StringBuilder.h"
+#include "OS/Program.h"
+#include "Math.inl"
+
+using namespace BB;
+
+StringBuilder::StringBuilder(Allocator a_Allocator)
+	: StringBuilder(a_Allocator, StringBuilder_Specs::standardChunkSize)
+{}
+
+StringBuilder::StringBuilder(Allocator a_Allocator, const size_t a_ChunkSize)
+	: m_Allocator(a_Allocator), m_NextChunkSize(a_ChunkSize)
+{
+	BB_ASSERT(a_ChunkSize != 0, "StringBuilder, chunk size cannot be 0.");
+}
+
+StringBuilder::StringBuilder(StringBuilder&& a_Builder) noexcept
+	: m_Allocator(a_Builder.m_Allocator)
+{
+	MoveFrom(a_Builder);
+}
+
+StringBuilder::~StringBuilder()
+{
+	Release();
+}
+
+StringBuilder& StringBuilder::operator=(StringBuilder&& a_Rhs) noexcept
+{
+	Release();
+	m_Allocator = a_Rhs.m_Allocator;
+	MoveFrom(a_Rhs);
+	return *this;
+}
+
+void StringBuilder::append(const char* a_String)
+{
+	append(a_String, strlen(a_String));
+}
+
+void StringBuilder::append(const char* a_String, const size_t a_Size)
+{
+	size_t t_Written = 0;
+	if (m_Last != nullptr)
+	{
+		t_Written = Min(a_Size, m_Last->capacity - m_Last->size);
+		Memory::Copy(m_Last->data() + m_Last->size, a_String, t_Written);
+		m_Last->size += t_Written;
+	}
+
+	//The rest goes to one new chunk.
+	if (t_Written != a_Size)
+	{
+		const size_t t_Rest = a_Size - t_Written;
+		AddChunk(t_Rest);
+		Memory::Copy(m_Last->data(), a_String + t_Written, t_Rest);
+		m_Last->size = t_Rest;
+	}
+	m_Size += a_Size;
+}
+
+void StringBuilder::append(const StringView a_String)
+{
+	append(a_String.data(), a_String.size());
+}
+
+void StringBuilder::push_back(const char a_Char)
+{
+	if (m_Last == nullptr || m_Last->size == m_Last->capacity)
+		AddChunk(1);
+	m_Last->data()[m_Last->size++] = a_Char;
+	m_Size++;
+}
+
+void StringBuilder::clear()
+{
+	if (m_First == nullptr)
+		return;
+
+	Chunk* t_Chunk = m_First->next;
+	while (t_Chunk != nullptr)
+	{
+		Chunk* t_Next = t_Chunk->next;
+		BBfree(m_Allocator, t_Chunk);
+		t_Chunk = t_Next;
+	}
+
+	m_First->next = nullptr;
+	m_First->size = 0;
+	m_Last = m_First;
+	m_ChunkCount = 1;
+	m_Size = 0;
+}
+
+void StringBuilder::copy_to(char* a_Buffer) const
+{
+	for (const Chunk* t_Chunk = m_First; t_Chunk != nullptr; t_Chunk = t_Chunk->next)
+	{
+		Memory::Copy(a_Buffer, t_Chunk->data(), t_Chunk->size);
+		a_Buffer += t_Chunk->size;
+	}
+}
+
+void StringBuilder::flatten(String& a_String) const
+{
+	a_String.reserve(a_String.size() + m_Size);
+	for (const Chunk* t_Chunk = m_First; t_Chunk != nullptr; t_Chunk = t_Chunk->next)
+		a_String.append(t_Chunk->data(), t_Chunk->size);
+}
+
+void StringBuilder::write_to_file(const OSFileHandle a_File) const
+{
+	//Chunks double in size so even very big strings only have a few, more than this is written in batches.
+	constexpr const size_t batchSize = 64;
+	Buffer t_Buffers[batchSize];
+
+	const Chunk* t_Chunk = m_First;
+	while (t_Chunk != nullptr)
+	{
+		size_t t_Count = 0;
+		for (; t_Chunk != nullptr && t_Count < batchSize; t_Chunk = t_Chunk->next)
+		{
+			if (t_Chunk->size == 0)
+				continue;
+			t_Buffers[t_Count].data = const_cast<char*>(t_Chunk->data());
+			t_Buffers[t_Count].size = t_Chunk->size;
+			t_Count++;
+		}
+		if (t_Count != 0)
+			WriteToOSFile(a_File, t_Buffers, t_Count);
+	}
+}
+
+void StringBuilder::AddChunk(const size_t a_MinCapacity)
+{
+	const size_t t_Capacity = Max(m_NextChunkSize, a_MinCapacity);
+	Chunk* t_Chunk = reinterpret_cast<Chunk*>(BBalloc(m_Allocator, sizeof(Chunk) + t_Capacity));
+	t_Chunk->next = nullptr;
+	t_Chunk->size = 0;
+	t_Chunk->capacity = t_Capacity;
+
+	if (m_Last != nullptr)
+		m_Last->next = t_Chunk;
+	else
+		m_First = t_Chunk;
+	m_Last = t_Chunk;
+	m_ChunkCount++;
+
+	m_NextChunkSize = Min(m_NextChunkSize * 2, StringBuilder_Specs::maxChunkSize);
+}
+
+void StringBuilder::MoveFrom(StringBuilder& a_Builder)
+{
+	m_First = a_Builder.m_First;
+	m_Last = a_Builder.m_Last;
+	m_ChunkCount = a_Builder.m_ChunkCount;
+	m_NextChunkSize = a_Builder.m_NextChunkSize;
+	m_Size = a_Builder.m_Size;
+
+	a_Builder.m_First = nullptr;
+	a_Builder.m_Last = nullptr;
+	a_Builder.m_ChunkCount = 0;
+	a_Builder.m_Size = 0;
+}
+
+void StringBuilder::Release()
+{
+	Chunk* t_Chunk = m_First;
+	while (t_Chunk != nullptr)
+	{
+		Chunk* t_Next = t_Chunk->next;
+		BBfree(m_Allocator, t_Chunk);
+		t_Chunk = t_Next;
+	}
+
+	m_First = nullptr;
+	m_Last = nullptr;
+	m_ChunkCount = 0;
+	m_Size = 0;
+}
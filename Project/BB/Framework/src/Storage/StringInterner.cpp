@@ -0,0 +1,208 @@
+#include "StringInterner.h"
+#include "Allocators/BackingAllocator.h"
+#include "Math.inl"
+
+#include <atomic>
+#include <thread>
+#include <new>
+
+using namespace BB;
+
+struct InternedString
+{
+	const char* string;
+	uint32_t length;
+	uint32_t hash;
+};
+
+struct StringInternerTable
+{
+	//Open addressing table, a slot is the hash in the upper 32 bits and the id + 1 in the lower 32 bits. 0 is empty.
+	//It never grows so lookups can run while a string is added.
+	std::atomic<uint64_t>* slots = nullptr;
+	size_t slotMask = 0;
+
+	//Indexed by id.
+	InternedString* strings = nullptr;
+	size_t maxStrings = 0;
+	std::atomic<uint32_t> count{ 0 };
+
+	//The string memory, committed as it is needed so strings never move.
+	char* arenaStart = nullptr;
+	char* arenaBump = nullptr;
+	char* arenaEnd = nullptr;
+
+	//Only taken when a new string is added.
+	std::atomic<bool> insertLock{ false };
+};
+
+static StringInternerTable s_Table;
+
+static uint64_t PackSlot(const uint32_t a_Hash, const uint32_t a_Id)
+{
+	return (static_cast<uint64_t>(a_Hash) << 32) | (static_cast<uint64_t>(a_Id) + 1);
+}
+
+//Returns the id of the string or INVALID_ID, a_EmptySlot gets the slot where the string would be added.
+static uint32_t LookupString(const char* a_String, const size_t a_Length, const uint32_t a_Hash, size_t& a_EmptySlot)
+{
+	size_t t_Index = a_Hash & s_Table.slotMask;
+	while (true)
+	{
+		const uint64_t t_Slot = s_Table.slots[t_Index].load(std::memory_order_acquire);
+		if (t_Slot == 0)
+		{
+			a_EmptySlot = t_Index;
+			return StringInterner_Specs::INVALID_ID;
+		}
+
+		if (static_cast<uint32_t>(t_Slot >> 32) == a_Hash)
+		{
+			const uint32_t t_Id = static_cast<uint32_t>(t_Slot) - 1;
+			const InternedString& t_String = s_Table.strings[t_Id];
+			if (t_String.length == a_Length && memcmp(t_String.string, a_String, a_Length) == 0)
+				return t_Id;
+		}
+		t_Index = (t_Index + 1) & s_Table.slotMask;
+	}
+}
+
+//Copies the string and a null terminator to the arena, only called while holding the insert lock.
+static const char* CopyToArena(const char* a_String, const size_t a_Length)
+{
+	while (s_Table.arenaBump + a_Length + 1 > s_Table.arenaEnd)
+	{
+		size_t t_CommitSize = Max(StringInterner_Specs::arenaCommitSize, a_Length + 1);
+		mallocVirtual(s_Table.arenaStart, t_CommitSize);
+		s_Table.arenaEnd += t_CommitSize;
+	}
+
+	char* t_String = s_Table.arenaBump;
+	memcpy(t_String, a_String, a_Length);
+	t_String[a_Length] = '\0';
+	s_Table.arenaBump += a_Length + 1;
+	return t_String;
+}
+
+static StringId MakeId(const uint32_t a_Id, const uint32_t a_Hash)
+{
+	StringId t_Id;
+	t_Id.id = a_Id;
+	t_Id.hash = a_Hash;
+	return t_Id;
+}
+
+void BB::StringInterner::Init(const size_t a_MaxStrings)
+{
+	BB_ASSERT(s_Table.slots == nullptr, "StringInterner::Init, the string interner already exists!");
+	BB_ASSERT(a_MaxStrings < StringInterner_Specs::INVALID_ID, "StringInterner::Init, too many strings.");
+
+	//At most half of the slots are used, that keeps the probes short.
+	const size_t t_SlotCount = Math::RoundUpPowerOfTwo(a_MaxStrings * 2);
+	size_t t_SlotBytes = t_SlotCount * sizeof(std::atomic<uint64_t>);
+	s_Table.slots = reinterpret_cast<std::atomic<uint64_t>*>(mallocVirtual(nullptr, t_SlotBytes, VIRTUAL_RESERVE_NONE));
+	for (size_t i = 0; i < t_SlotCount; i++)
+		new (&s_Table.slots[i]) std::atomic<uint64_t>(0);
+	s_Table.slotMask = t_SlotCount - 1;
+
+	size_t t_StringsBytes = a_MaxStrings * sizeof(InternedString);
+	s_Table.strings = reinterpret_cast<InternedString*>(mallocVirtual(nullptr, t_StringsBytes, VIRTUAL_RESERVE_NONE));
+	s_Table.maxStrings = a_MaxStrings;
+	s_Table.count.store(0, std::memory_order_relaxed);
+
+	size_t t_ArenaBytes = StringInterner_Specs::arenaCommitSize;
+	s_Table.arenaStart = reinterpret_cast<char*>(mallocVirtual(nullptr, t_ArenaBytes, VIRTUAL_RESERVE_EXTRA));
+	s_Table.arenaBump = s_Table.arenaStart;
+	s_Table.arenaEnd = s_Table.arenaStart + t_ArenaBytes;
+}
+
+void BB::StringInterner::Destroy()
+{
+	BB_ASSERT(s_Table.slots != nullptr, "StringInterner::Destroy, the string interner does not exist!");
+	freeVirtual(s_Table.slots);
+	freeVirtual(s_Table.strings);
+	freeVirtual(s_Table.arenaStart);
+
+	s_Table.slots = nullptr;
+	s_Table.slotMask = 0;
+	s_Table.strings = nullptr;
+	s_Table.maxStrings = 0;
+	s_Table.count.store(0, std::memory_order_relaxed);
+	s_Table.arenaStart = nullptr;
+	s_Table.arenaBump = nullptr;
+	s_Table.arenaEnd = nullptr;
+}
+
+StringId BB::StringInterner::Intern(const char* a_String)
+{
+	return Intern(a_String, strlen(a_String));
+}
+
+StringId BB::StringInterner::Intern(const char* a_String, const size_t a_Length)
+{
+	const uint32_t t_Hash = static_cast<uint32_t>(Hash::MakeHash(a_String, a_Length));
+	size_t t_EmptySlot;
+	uint32_t t_Id = LookupString(a_String, a_Length, t_Hash, t_EmptySlot);
+	if (t_Id != StringInterner_Specs::INVALID_ID)
+		return MakeId(t_Id, t_Hash);
+
+	if (s_Table.insertLock.exchange(true, std::memory_order_acquire))
+	{
+		do
+		{
+			std::this_thread::yield();
+		} while (s_Table.insertLock.exchange(true, std::memory_order_acquire));
+	}
+
+	//Another thread might have added the same string while we waited.
+	t_Id = LookupString(a_String, a_Length, t_Hash, t_EmptySlot);
+	if (t_Id == StringInterner_Specs::INVALID_ID)
+	{
+		t_Id = s_Table.count.load(std::memory_order_relaxed);
+		BB_ASSERT(t_Id < s_Table.maxStrings, "StringInterner::Intern, the string interner is full.");
+
+		InternedString& t_String = s_Table.strings[t_Id];
+		t_String.string = CopyToArena(a_String, a_Length);
+		t_String.length = static_cast<uint32_t>(a_Length);
+		t_String.hash = t_Hash;
+
+		//Publish the string, lookups that see the slot also see the string.
+		s_Table.slots[t_EmptySlot].store(PackSlot(t_Hash, t_Id), std::memory_order_release);
+		s_Table.count.store(t_Id + 1, std::memory_order_release);
+	}
+
+	s_Table.insertLock.store(false, std::memory_order_release);
+	return MakeId(t_Id, t_Hash);
+}
+
+StringId BB::StringInterner::Find(const char* a_String)
+{
+	return Find(a_String, strlen(a_String));
+}
+
+StringId BB::StringInterner::Find(const char* a_String, const size_t a_Length)
+{
+	const uint32_t t_Hash = static_cast<uint32_t>(Hash::MakeHash(a_String, a_Length));
+	size_t t_EmptySlot;
+	const uint32_t t_Id = LookupString(a_String, a_Length, t_Hash, t_EmptySlot);
+	if (t_Id == StringInterner_Specs::INVALID_ID)
+		return StringId();
+	return MakeId(t_Id, t_Hash);
+}
+
+const char* BB::StringInterner::GetString(const StringId a_Id)
+{
+	BB_ASSERT(a_Id.IsValid(), "StringInterner::GetString, invalid StringId.");
+	return s_Table.strings[a_Id.id].string;
+}
+
+size_t BB::StringInterner::GetLength(const StringId a_Id)
+{
+	BB_ASSERT(a_Id.IsValid(), "StringInterner::GetLength, invalid StringId.");
+	return s_Table.strings[a_Id.id].length;
+}
+
+size_t BB::StringInterner::Count()
+{
+	return s_Table.count.load(std::memory_order_acquire);
+}
@@ -0,0 +1,132 @@
+#include "StringView.h"
+
+#include <immintrin.h>
+
+using namespace BB;
+
+//Bit i is set when byte i of a_Block is a_Char.
+#ifdef __AVX2__
+static uint32_t MatchMask(const __m256i a_Block, const __m256i a_Char)
+{
+	return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a_Block, a_Char)));
+}
+#endif //__AVX2__
+
+static uint32_t MatchMask(const __m128i a_Block, const __m128i a_Char)
+{
+	return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a_Block, a_Char)));
+}
+
+size_t BB::StringOps::FindChar(const char* a_String, const size_t a_Size, const char a_Char)
+{
+	size_t i = 0;
+#ifdef __AVX2__
+	const __m256i t_Char256 = _mm256_set1_epi8(a_Char);
+	for (; i + sizeof(__m256i) <= a_Size; i += sizeof(__m256i))
+	{
+		const uint32_t t_Mask = MatchMask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_String + i)), t_Char256);
+		if (t_Mask != 0)
+			return i + Math::CountTrailingZeros(t_Mask);
+	}
+#endif //__AVX2__
+	const __m128i t_Char = _mm_set1_epi8(a_Char);
+	for (; i + sizeof(__m128i) <= a_Size; i += sizeof(__m128i))
+	{
+		const uint32_t t_Mask = MatchMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a_String + i)), t_Char);
+		if (t_Mask != 0)
+			return i + Math::CountTrailingZeros(t_Mask);
+	}
+
+	for (; i < a_Size; i++)
+		if (a_String[i] == a_Char)
+			return i;
+	return a_Size;
+}
+
+size_t BB::StringOps::FindLastChar(const char* a_String, const size_t a_Size, const char a_Char)
+{
+	//i is the end of the part that is not searched yet.
+	size_t i = a_Size;
+#ifdef __AVX2__
+	const __m256i t_Char256 = _mm256_set1_epi8(a_Char);
+	for (; i >= sizeof(__m256i); i -= sizeof(__m256i))
+	{
+		const size_t t_Begin = i - sizeof(__m256i);
+		const uint32_t t_Mask = MatchMask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_String + t_Begin)), t_Char256);
+		if (t_Mask != 0)
+			return t_Begin + 63 - Math::CountLeadingZeros(t_Mask);
+	}
+#endif //__AVX2__
+	const __m128i t_Char = _mm_set1_epi8(a_Char);
+	for (; i >= sizeof(__m128i); i -= sizeof(__m128i))
+	{
+		const size_t t_Begin = i - sizeof(__m128i);
+		const uint32_t t_Mask = MatchMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a_String + t_Begin)), t_Char);
+		if (t_Mask != 0)
+			return t_Begin + 63 - Math::CountLeadingZeros(t_Mask);
+	}
+
+	for (; i > 0; i--)
+		if (a_String[i - 1] == a_Char)
+			return i - 1;
+	return a_Size;
+}
+
+//Every candidate position must have the first and the last character of the pattern,
+//both get checked for a whole block of positions at once and only the positions with both get a full compare.
+size_t BB::StringOps::FindString(const char* a_String, const size_t a_Size, const char* a_Pattern, const size_t a_PatternSize)
+{
+	if (a_PatternSize == 0)
+		return 0;
+	if (a_PatternSize > a_Size)
+		return a_Size;
+	if (a_PatternSize == 1)
+		return FindChar(a_String, a_Size, a_Pattern[0]);
+
+	const size_t t_Last = a_PatternSize - 1;
+	//Amount of positions the pattern can start at.
+	const size_t t_Positions = a_Size - t_Last;
+	//The first and the last character are already checked.
+	const size_t t_MiddleSize = a_PatternSize - 2;
+
+	size_t i = 0;
+#ifdef __AVX2__
+	const __m256i t_First256 = _mm256_set1_epi8(a_Pattern[0]);
+	const __m256i t_Last256 = _mm256_set1_epi8(a_Pattern[t_Last]);
+	for (; i + sizeof(__m256i) <= t_Positions; i += sizeof(__m256i))
+	{
+		const __m256i t_FirstBlock = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_String + i));
+		const __m256i t_LastBlock = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_String + i + t_Last));
+		uint32_t t_Mask = MatchMask(t_FirstBlock, t_First256) & MatchMask(t_LastBlock, t_Last256);
+		while (t_Mask != 0)
+		{
+			const size_t t_Index = i + Math::CountTrailingZeros(t_Mask);
+			if (memcmp(a_String + t_Index + 1, a_Pattern + 1, t_MiddleSize) == 0)
+				return t_Index;
+			//Clear the lowest set bit.
+			t_Mask &= t_Mask - 1;
+		}
+	}
+#endif //__AVX2__
+	const __m128i t_First = _mm_set1_epi8(a_Pattern[0]);
+	const __m128i t_LastChar = _mm_set1_epi8(a_Pattern[t_Last]);
+	for (; i + sizeof(__m128i) <= t_Positions; i += sizeof(__m128i))
+	{
+		const __m128i t_FirstBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a_String + i));
+		const __m128i t_LastBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a_String + i + t_Last));
+		uint32_t t_Mask = MatchMask(t_FirstBlock, t_First) & MatchMask(t_LastBlock, t_LastChar);
+		while (t_Mask != 0)
+		{
+			const size_t t_Index = i + Math::CountTrailingZeros(t_Mask);
+			if (memcmp(a_String + t_Index + 1, a_Pattern + 1, t_MiddleSize) == 0)
+				return t_Index;
+			t_Mask &= t_Mask - 1;
+		}
+	}
+
+	for (; i < t_Positions; i++)
+		if (a_String[i] == a_Pattern[0] && a_String[i + t_Last] == a_Pattern[t_Last] &&
+			memcmp(a_String + i + 1, a_Pattern + 1, t_MiddleSize) == 0)
+			return i;
+	return a_Size;
+}
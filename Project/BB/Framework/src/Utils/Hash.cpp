@@ -0,0 +1,93 @@
+#include "Hash.h"
+
+#include <immintrin.h>
+
+//Must give the exact same result as Hash::ConstexprOps::BulkAccumulate.
+void Hash::BulkAccumulateSIMD(const char* a_Data, const size_t a_StripeCount, uint64_t* a_Acc)
+{
+#ifdef __AVX2__
+	__m256i t_Acc0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_Acc));
+	__m256i t_Acc1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_Acc + 4));
+	const __m256i t_BaseKey0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Hash_Specs::bulkKeys));
+	const __m256i t_BaseKey1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Hash_Specs::bulkKeys + 4));
+	const __m256i t_KeyStep = _mm256_set1_epi64x(static_cast<long long>(Hash_Specs::secret0));
+	const __m256i t_Prime = _mm256_set1_epi32(static_cast<int>(Hash_Specs::bulkPrime));
+	__m256i t_Key0 = t_BaseKey0;
+	__m256i t_Key1 = t_BaseKey1;
+
+	for (size_t t_Stripe = 0; t_Stripe < a_StripeCount; t_Stripe++)
+	{
+		const char* t_Data = a_Data + t_Stripe * Hash_Specs::bulkStripeSize;
+		const __m256i t_DataValue0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(t_Data));
+		const __m256i t_DataValue1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(t_Data + 32));
+		const __m256i t_DataKey0 = _mm256_xor_si256(t_DataValue0, t_Key0);
+		const __m256i t_DataKey1 = _mm256_xor_si256(t_DataValue1, t_Key1);
+
+		//Low 32 bits times high 32 bits of every lane.
+		const __m256i t_Product0 = _mm256_mul_epu32(t_DataKey0, _mm256_srli_epi64(t_DataKey0, 32));
+		const __m256i t_Product1 = _mm256_mul_epu32(t_DataKey1, _mm256_srli_epi64(t_DataKey1, 32));
+		//Lane i gets the data of lane i ^ 1.
+		const __m256i t_Swapped0 = _mm256_shuffle_epi32(t_DataValue0, _MM_SHUFFLE(1, 0, 3, 2));
+		const __m256i t_Swapped1 = _mm256_shuffle_epi32(t_DataValue1, _MM_SHUFFLE(1, 0, 3, 2));
+
+		t_Acc0 = _mm256_add_epi64(t_Acc0, _mm256_add_epi64(t_Product0, t_Swapped0));
+		t_Acc1 = _mm256_add_epi64(t_Acc1, _mm256_add_epi64(t_Product1, t_Swapped1));
+		t_Key0 = _mm256_add_epi64(t_Key0, t_KeyStep);
+		t_Key1 = _mm256_add_epi64(t_Key1, t_KeyStep);
+
+		if ((t_Stripe + 1) % Hash_Specs::bulkStripesPerBlock == 0)
+		{
+			t_Acc0 = _mm256_xor_si256(_mm256_xor_si256(t_Acc0, _mm256_srli_epi64(t_Acc0, 47)), t_BaseKey0);
+			t_Acc1 = _mm256_xor_si256(_mm256_xor_si256(t_Acc1, _mm256_srli_epi64(t_Acc1, 47)), t_BaseKey1);
+			//64 bit times 32 bit multiply.
+			t_Acc0 = _mm256_add_epi64(_mm256_mul_epu32(t_Acc0, t_Prime),
+				_mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(t_Acc0, 32), t_Prime), 32));
+			t_Acc1 = _mm256_add_epi64(_mm256_mul_epu32(t_Acc1, t_Prime),
+				_mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(t_Acc1, 32), t_Prime), 32));
+		}
+	}
+
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(a_Acc), t_Acc0);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(a_Acc + 4), t_Acc1);
+#else
+	constexpr size_t t_VectorCount = Hash_Specs::bulkLaneCount / 2;
+	__m128i t_Acc[t_VectorCount];
+	__m128i t_BaseKey[t_VectorCount];
+	__m128i t_Key[t_VectorCount];
+	for (size_t i = 0; i < t_VectorCount; i++)
+	{
+		t_Acc[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a_Acc + i * 2));
+		t_BaseKey[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Hash_Specs::bulkKeys + i * 2));
+		t_Key[i] = t_BaseKey[i];
+	}
+	const __m128i t_KeyStep = _mm_set1_epi64x(static_cast<long long>(Hash_Specs::secret0));
+	const __m128i t_Prime = _mm_set1_epi32(static_cast<int>(Hash_Specs::bulkPrime));
+
+	for (size_t t_Stripe = 0; t_Stripe < a_StripeCount; t_Stripe++)
+	{
+		const char* t_Data = a_Data + t_Stripe * Hash_Specs::bulkStripeSize;
+		for (size_t i = 0; i < t_VectorCount; i++)
+		{
+			const __m128i t_DataValue = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t_Data + i * sizeof(__m128i)));
+			const __m128i t_DataKey = _mm_xor_si128(t_DataValue, t_Key[i]);
+			const __m128i t_Product = _mm_mul_epu32(t_DataKey, _mm_srli_epi64(t_DataKey, 32));
+			const __m128i t_Swapped = _mm_shuffle_epi32(t_DataValue, _MM_SHUFFLE(1, 0, 3, 2));
+			t_Acc[i] = _mm_add_epi64(t_Acc[i], _mm_add_epi64(t_Product, t_Swapped));
+			t_Key[i] = _mm_add_epi64(t_Key[i], t_KeyStep);
+		}
+
+		if ((t_Stripe + 1) % Hash_Specs::bulkStripesPerBlock == 0)
+		{
+			for (size_t i = 0; i < t_VectorCount; i++)
+			{
+				t_Acc[i] = _mm_xor_si128(_mm_xor_si128(t_Acc[i], _mm_srli_epi64(t_Acc[i], 47)), t_BaseKey[i]);
+				t_Acc[i] = _mm_add_epi64(_mm_mul_epu32(t_Acc[i], t_Prime),
+					_mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(t_Acc[i], 32), t_Prime), 32));
+			}
+		}
+	}
+
+	for (size_t i = 0; i < t_VectorCount; i++)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(a_Acc + i * 2), t_Acc[i]);
+#endif
+}
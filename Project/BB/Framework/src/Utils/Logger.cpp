@@ -5,6 +5,8 @@
 #include "BBThreadScheduler.hpp"
 #include "Allocators.h"
 #include "BBString.h"
+#include "Format.h"
+#include "RingBuffer.h"
 #include <stdarg.h>
 
 using namespace BB;
@@ -19,8 +21,8 @@ class LoggerSingleton
 private:
 	uint32_t m_MaxLoggerBufferSize;
 	WarningTypeFlags m_EnabledWarningFlags = 0;
-	//create a fixed string class for this.
-	String m_CacheString;
+	//Fixed size, never grows. Emptied into m_UploadString when the next message does not fit.
+	RingBuffer<char> m_CacheBuffer;
 	//create a fixed string class for this.
 	String m_UploadString;
 	ThreadTask m_LastThreadTask = 0;
@@ -31,8 +33,8 @@ private:
 public:
 
 	LoggerSingleton()
-		: m_MaxLoggerBufferSize(2024),
-		  m_CacheString(s_Allocator, m_MaxLoggerBufferSize),
+		: m_MaxLoggerBufferSize(2048),
+		  m_CacheBuffer(s_Allocator, m_MaxLoggerBufferSize, false),
 		  m_UploadString(s_Allocator, m_MaxLoggerBufferSize),
 		  m_LogFile(CreateOSFile(L"logger.txt")),
 		  m_WriteToFileMutex(OSCreateMutex())
@@ -63,18 +65,22 @@ public:
 		OSWaitAndLockMutex(m_WriteToFileMutex);
 		WriteToConsole(a_Msg, static_cast<uint32_t>(a_Size));
 
-		if (m_CacheString.size() + a_Size > m_MaxLoggerBufferSize)
+		if (m_CacheBuffer.size() + a_Size > m_CacheBuffer.capacity())
 		{
-			m_UploadString.clear();
-			m_UploadString.append(m_CacheString);
-			//async upload to file.
+			//async upload to file, wait first so the upload string is no longer being read.
 			Threads::WaitForTask(m_LastThreadTask);
+			m_UploadString.clear();
+			//The cached text is at most 2 contiguous parts.
+			while (!m_CacheBuffer.empty())
+			{
+				const Slice<char> t_Span = m_CacheBuffer.read_span();
+				m_UploadString.append(t_Span.data(), t_Span.size());
+				m_CacheBuffer.pop_front(t_Span.size());
+			}
 			m_LastThreadTask = Threads::StartTaskThread(WriteLoggerToFile, nullptr);
-			//clear the cache string for new logging infos
-			m_CacheString.clear();
 		}
 
-		m_CacheString.append(a_Msg, a_Size);
+		m_CacheBuffer.push_back(a_Msg, a_Size);
 
 		OSUnlockMutex(m_WriteToFileMutex);
 	}
@@ -124,11 +130,11 @@ static void Log_to_Console(const char* a_FileName, int a_Line, const char* a_War
 		t_String.append(a_FileName);
 	}
 	{ //Get the line number into the buffer
-		char lineNumString[8]{};
-		sprintf_s(lineNumString, 8, "%u", a_Line);
+		char t_LineNumber[Format_Specs::maxIntegerChars];
+		const size_t t_LineNumberSize = FormatOps::IntToChars(t_LineNumber, a_Line);
 
 		t_String.append(LOG_MESSAGE_LINE_NUMBER_1, sizeof(LOG_MESSAGE_LINE_NUMBER_1) - 1);
-		t_String.append(lineNumString);
+		t_String.append(t_LineNumber, t_LineNumberSize);
 	}
 	{ //Get the message(s).
 		t_String.append(LOG_MESSAGE_MESSAGE_TXT_2, sizeof(LOG_MESSAGE_MESSAGE_TXT_2) - 1);
@@ -150,6 +156,18 @@ static void Log_to_Console(const char* a_FileName, int a_Line, const char* a_War
 				t_String.append(t_Char);
 			}
 				break;
+			case 'd':
+			{
+				char t_Number[Format_Specs::maxIntegerChars];
+				t_String.append(t_Number, FormatOps::IntToChars(t_Number, va_arg(a_Args, int)));
+			}
+				break;
+			case 'f': //floats are passed as doubles.
+			{
+				char t_Number[Format_Specs::maxFloatChars];
+				t_String.append(t_Number, FormatOps::DoubleToChars(t_Number, va_arg(a_Args, double)));
+			}
+				break;
 			default:
 				BB_ASSERT(false, "va arg format not yet supported");
 				break;
@@ -1,6 +1,7 @@
 #pragma once
 #include "../TestValues.h"
 #include "Storage/Array.h"
+#include "Utils/Slice.h"
 
 TEST(ArrayDataStructure, push_reserve)
 {
@@ -104,10 +105,11 @@ TEST(ArrayDataStructure, Array_push)
 
 	BB::Array<size2593bytes> t_Array(t_Allocator, initialSize);
 
-	size_t t_RandomValues[pushSize]{};
+	//One extra value for the single push at the end.
+	size_t t_RandomValues[pushSize + 1]{};
 	size2593bytes t_SizeArray[initialSize]{};
 
-	for (size_t i = 0; i < pushSize; i++)
+	for (size_t i = 0; i < pushSize + 1; i++)
 	{
 		t_RandomValues[i] = static_cast<size_t>(BB::Random::Random());
 	}
@@ -426,4 +428,297 @@ TEST(ArrayDataStructure, Array_Assignment)
 	{
 		EXPECT_EQ(t_AssignmentOperatorArray[i].value, t_RandomValues[i]) << "Array, assignment operator array test has wrong values.";
 	}
-}
\ No newline at end of file
+}
+TEST(ArrayDataStructure, Array_Append_Resize_Erase_Swap)
+{
+	constexpr const size_t samples = 256;
+
+	//2 MB alloactor.
+	BB::FreelistAllocator_t t_Allocator(1024 * 1024 * 2);
+
+	size_t t_RandomValues[samples]{};
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_RandomValues[i] = static_cast<size_t>(BB::Random::Random());
+	}
+
+	BB::Array<size_t> t_Array(t_Allocator);
+	t_Array.push_back(t_RandomValues, 3);
+	//Append after existing elements, from a const slice made from a stack array.
+	t_Array.append(BB::Slice<const size_t>(t_RandomValues + 3, samples - 3));
+	ASSERT_EQ(t_Array.size(), samples);
+	for (size_t i = 0; i < samples; i++)
+	{
+		EXPECT_EQ(t_Array[i], t_RandomValues[i]) << "Array, append has wrong values.";
+	}
+
+	//Append an array to another array.
+	BB::Array<size_t> t_AppendedArray(t_Allocator);
+	t_AppendedArray.append(t_Array);
+	t_AppendedArray.append(BB::Slice<size_t>(t_Array).SubSlice(0, 8));
+	ASSERT_EQ(t_AppendedArray.size(), samples + 8);
+	for (size_t i = 0; i < samples + 8; i++)
+	{
+		EXPECT_EQ(t_AppendedArray[i], t_RandomValues[i % samples]) << "Array, appending an array has wrong values.";
+	}
+
+	//resize value initializes, resize_uninitialized only changes the size.
+	BB::Array<size_t> t_ResizeArray(t_Allocator);
+	t_ResizeArray.resize(samples);
+	for (size_t i = 0; i < samples; i++)
+	{
+		EXPECT_EQ(t_ResizeArray[i], 0) << "Array, resize did not value initialize.";
+	}
+	t_ResizeArray.resize_uninitialized(samples * 2);
+	ASSERT_EQ(t_ResizeArray.size(), samples * 2);
+	memcpy(t_ResizeArray.data() + samples, t_RandomValues, sizeof(t_RandomValues));
+	for (size_t i = 0; i < samples; i++)
+	{
+		EXPECT_EQ(t_ResizeArray[samples + i], t_RandomValues[i]) << "Array, resize_uninitialized lost values.";
+	}
+
+	//erase_swap moves the last element in the removed slot.
+	const size_t t_Last = t_Array[samples - 1];
+	t_Array.erase_swap(4);
+	ASSERT_EQ(t_Array.size(), samples - 1);
+	EXPECT_EQ(t_Array[4], t_Last);
+	t_Array.erase_swap(t_Array.size() - 1);
+	ASSERT_EQ(t_Array.size(), samples - 2);
+	EXPECT_EQ(t_Array[t_Array.size() - 1], t_RandomValues[samples - 3]);
+
+	size_t t_Count = 0;
+	for (size_t t_Value : t_Array)
+	{
+		EXPECT_EQ(t_Value, t_Array[t_Count]);
+		t_Count++;
+	}
+	EXPECT_EQ(t_Count, t_Array.size()) << "Array, range loop visits the wrong amount of elements.";
+}
+
+TEST(ArrayDataStructure, Array_Object_Erase_Swap_Growth_Factor)
+{
+	constexpr const size_t samples = 64;
+
+	//2 MB alloactor.
+	BB::FreelistAllocator_t t_Allocator(1024 * 1024 * 2);
+
+	BB::Array<std::string> t_Array(t_Allocator);
+	t_Array.set_growth_factor(1.5f);
+	size_t t_LastCapacity = t_Array.capacity();
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Array.emplace_back(std::to_string(i) + " a string long enough to not fit in the small string buffer");
+		EXPECT_GE(t_Array.capacity(), t_Array.size());
+		if (t_Array.capacity() != t_LastCapacity)
+		{
+			//1.5 growth rounded up to the multiple value instead of doubling.
+			EXPECT_LE(t_Array.capacity(), t_LastCapacity * 2);
+			t_LastCapacity = t_Array.capacity();
+		}
+	}
+
+	t_Array.erase_swap(0);
+	EXPECT_EQ(t_Array[0], std::to_string(samples - 1) + " a string long enough to not fit in the small string buffer");
+	EXPECT_EQ(t_Array.size(), samples - 1);
+
+	BB::Array<std::string> t_Appended(t_Allocator);
+	t_Appended.append(t_Array);
+	ASSERT_EQ(t_Appended.size(), t_Array.size());
+	for (size_t i = 0; i < t_Array.size(); i++)
+	{
+		EXPECT_EQ(t_Appended[i], t_Array[i]);
+	}
+}
+
+//Counts the constructor and destructor calls so the relocation tests can check that growing does not call them.
+template<bool Relocatable>
+struct RelocationCounter
+{
+	static size_t copies;
+	static size_t moves;
+	static size_t destructs;
+	static void Reset() { copies = 0; moves = 0; destructs = 0; }
+
+	RelocationCounter(size_t a_Value) : value(new size_t(a_Value)) {}
+	RelocationCounter(const RelocationCounter& a_Other) : value(new size_t(*a_Other.value)) { ++copies; }
+	RelocationCounter(RelocationCounter&& a_Other) noexcept : value(a_Other.value) { a_Other.value = nullptr; ++moves; }
+	RelocationCounter& operator=(const RelocationCounter& a_Rhs) { *value = *a_Rhs.value; ++copies; return *this; }
+	~RelocationCounter() { delete value; ++destructs; }
+
+	size_t* value;
+};
+template<bool Relocatable> size_t RelocationCounter<Relocatable>::copies = 0;
+template<bool Relocatable> size_t RelocationCounter<Relocatable>::moves = 0;
+template<bool Relocatable> size_t RelocationCounter<Relocatable>::destructs = 0;
+
+template<>
+struct BB::IsTriviallyRelocatable<RelocationCounter<true>> : std::true_type {};
+
+static_assert(BB::isTriviallyRelocatable_v<size_t>, "Trivially copyable types must be trivially relocatable.");
+static_assert(BB::isTriviallyRelocatable_v<BB::Array<std::string>>, "Array must be trivially relocatable.");
+static_assert(!BB::isTriviallyRelocatable_v<RelocationCounter<false>>, "Types with a custom copy should not be trivially relocatable by default.");
+
+TEST(ArrayDataStructure, Array_Trivially_Relocatable_Growth)
+{
+	constexpr const size_t samples = 512;
+
+	//2 MB alloactor.
+	BB::FreelistAllocator_t t_Allocator(1024 * 1024 * 2);
+
+	{
+		RelocationCounter<true>::Reset();
+		BB::Array<RelocationCounter<true>> t_Array(t_Allocator);
+		for (size_t i = 0; i < samples; i++)
+			t_Array.emplace_back(i);
+		t_Array.emplace(0, samples);
+		t_Array.erase_swap(1);
+
+		EXPECT_EQ(RelocationCounter<true>::copies, 0);
+		EXPECT_EQ(RelocationCounter<true>::moves, 0) << "Growing an array of relocatable types should be a memcpy.";
+		EXPECT_EQ(RelocationCounter<true>::destructs, 1) << "Only the erased element should be destructed.";
+		EXPECT_EQ(*t_Array[0].value, samples);
+		EXPECT_EQ(*t_Array[1].value, samples - 1);
+		for (size_t i = 2; i < t_Array.size(); i++)
+			EXPECT_EQ(*t_Array[i].value, i - 1);
+	}
+
+	{
+		RelocationCounter<false>::Reset();
+		BB::Array<RelocationCounter<false>> t_Array(t_Allocator);
+		for (size_t i = 0; i < samples; i++)
+			t_Array.emplace_back(i);
+
+		EXPECT_EQ(RelocationCounter<false>::copies, 0) << "Growing should move and not copy.";
+		EXPECT_NE(RelocationCounter<false>::moves, 0);
+		EXPECT_EQ(RelocationCounter<false>::moves, RelocationCounter<false>::destructs);
+		for (size_t i = 0; i < t_Array.size(); i++)
+			EXPECT_EQ(*t_Array[i].value, i);
+	}
+
+	//Arrays in an array, the inner buffers must survive the outer growth.
+	{
+		BB::Array<BB::Array<size_t>> t_Arrays(t_Allocator);
+		for (size_t i = 0; i < 64; i++)
+		{
+			t_Arrays.emplace_back(t_Allocator);
+			t_Arrays[i].emplace_back(i);
+		}
+		for (size_t i = 0; i < 64; i++)
+			EXPECT_EQ(t_Arrays[i][0], i);
+	}
+}
+
+#include <chrono>
+#include <vector>
+
+TEST(ArrayDataStructure, Array_Speedtest)
+{
+	typedef std::chrono::duration<float, std::milli> ms;
+	constexpr const float MILLITIMEDIVIDE = 1 / 1000.f;
+
+	constexpr const size_t samples = 1 << 20;
+	constexpr const size_t bulkSize = 1024;
+
+	const size_t allocatorSize = BB::mbSize * 64;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	size_t* t_Values = reinterpret_cast<size_t*>(BBalloc(t_Allocator, bulkSize * sizeof(size_t)));
+	for (size_t i = 0; i < bulkSize; i++)
+		t_Values[i] = static_cast<size_t>(BB::Random::Random());
+
+	//Unused result so the compiler does not remove the work.
+	size_t t_Result = 0;
+
+	std::cout << "Array speed test comparison with std::vector, " << samples << " elements." << "\n";
+
+	std::cout << "/-----------------------------------------/" << "\n" << "push_back:" << "\n";
+	{
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		std::vector<size_t> t_Vector;
+		for (size_t i = 0; i < samples; i++)
+			t_Vector.push_back(i);
+		t_Result += t_Vector.back();
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "std::vector speed with time in MS " << t_Speed << "\n";
+	}
+	{
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		BB::Array<size_t> t_Array(t_Allocator);
+		for (size_t i = 0; i < samples; i++)
+			t_Array.emplace_back(i);
+		t_Result += t_Array[samples - 1];
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::Array speed with time in MS " << t_Speed << "\n";
+	}
+
+	std::cout << "/-----------------------------------------/" << "\n" << "bulk append of " << bulkSize << " elements:" << "\n";
+	{
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		std::vector<size_t> t_Vector;
+		for (size_t i = 0; i < samples; i += bulkSize)
+			t_Vector.insert(t_Vector.end(), t_Values, t_Values + bulkSize);
+		t_Result += t_Vector.back();
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "std::vector speed with time in MS " << t_Speed << "\n";
+	}
+	{
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		BB::Array<size_t> t_Array(t_Allocator);
+		for (size_t i = 0; i < samples; i += bulkSize)
+			t_Array.append(BB::Slice<const size_t>(t_Values, bulkSize));
+		t_Result += t_Array[samples - 1];
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::Array speed with time in MS " << t_Speed << "\n";
+	}
+
+	std::cout << "/-----------------------------------------/" << "\n" << "resize then fill:" << "\n";
+	{
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		std::vector<size_t> t_Vector;
+		t_Vector.resize(samples);
+		for (size_t i = 0; i < samples; i += bulkSize)
+			memcpy(&t_Vector[i], t_Values, bulkSize * sizeof(size_t));
+		t_Result += t_Vector.back();
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "std::vector resize speed with time in MS " << t_Speed << "\n";
+	}
+	{
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		BB::Array<size_t> t_Array(t_Allocator);
+		t_Array.resize_uninitialized(samples);
+		for (size_t i = 0; i < samples; i += bulkSize)
+			memcpy(&t_Array[i], t_Values, bulkSize * sizeof(size_t));
+		t_Result += t_Array[samples - 1];
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::Array resize_uninitialized speed with time in MS " << t_Speed << "\n";
+	}
+
+	std::cout << "/-----------------------------------------/" << "\n" << "unordered remove of every element from the front:" << "\n";
+	{
+		std::vector<size_t> t_Vector(samples, 1);
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		while (!t_Vector.empty())
+		{
+			t_Result += t_Vector[0];
+			t_Vector[0] = t_Vector.back();
+			t_Vector.pop_back();
+		}
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "std::vector swap and pop speed with time in MS " << t_Speed << "\n";
+	}
+	{
+		BB::Array<size_t> t_Array(t_Allocator);
+		t_Array.resize(samples);
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		while (t_Array.size() != 0)
+		{
+			t_Result += t_Array[0];
+			t_Array.erase_swap(0);
+		}
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::Array erase_swap speed with time in MS " << t_Speed << "\n";
+	}
+	std::cout << "/-----------------------------------------/" << "\n" << t_Result << "\n";
+
+	BB::BBfree(t_Allocator, t_Values);
+}
@@ -73,4 +73,72 @@ TEST(BBjson, Big_Disk_JSON)
 	//call the destructor as I want to clear the allocator.
 	t_JsonString.~Basic_String();
 	t_Allocator.Clear();
-}
\ No newline at end of file
+}
+
+TEST(BBjson, Lookup_By_View)
+{
+	const char t_JsonFile[] = R"({ "fruit": "Apple", "size": "Large", "color": "Red" })";
+
+	BB::JsonParser t_Parser(BB::StringView(t_JsonFile, sizeof(t_JsonFile) - 1));
+	t_Parser.Parse();
+	const BB::JsonObject* t_Object = t_Parser.GetRootNode()->GetObject();
+
+	//The name does not need to be null terminated.
+	const BB::StringView t_Name("size_and_more", 4);
+	const BB::JsonNode* t_Node = t_Object->Find(t_Name);
+	ASSERT_NE(t_Node, nullptr);
+	EXPECT_EQ(strcmp(t_Node->GetString(), "Large"), 0);
+	EXPECT_EQ(t_Object->Find("weight"), nullptr);
+
+	//The parser works on its own copy of the text.
+	EXPECT_EQ(strcmp(t_JsonFile, R"({ "fruit": "Apple", "size": "Large", "color": "Red" })"), 0);
+}
+
+TEST(BBjson, Numbers_Round_Trip)
+{
+	const char t_JsonFile[] = R"({ "a": 1.5, "b": -20, "c": 0.000000015, "d": 3e+25 })";
+
+	BB::FreelistAllocator_t t_Allocator{ BB::kbSize * 16 };
+	BB::String t_JsonString{ t_Allocator };
+	{
+		BB::JsonParser t_Parser(BB::StringView(t_JsonFile, sizeof(t_JsonFile) - 1));
+		t_Parser.Parse();
+		JsonNodeToString(t_Parser.GetRootNode(), t_JsonString);
+	}
+
+	//Numbers are written with the least digits that read back the same.
+	const BB::StringView t_Text = t_JsonString;
+	EXPECT_NE(t_Text.find(": 1.5"), BB::StringView_Specs::NOT_FOUND);
+	EXPECT_NE(t_Text.find(": -20"), BB::StringView_Specs::NOT_FOUND);
+	EXPECT_NE(t_Text.find(": 1.5e-8"), BB::StringView_Specs::NOT_FOUND);
+	EXPECT_NE(t_Text.find(": 3e25"), BB::StringView_Specs::NOT_FOUND);
+
+	BB::JsonParser t_Parser(t_Text);
+	t_Parser.Parse();
+	const BB::JsonObject* t_Object = t_Parser.GetRootNode()->GetObject();
+	EXPECT_EQ(t_Object->Find("a")->GetNumber(), 1.5f);
+	EXPECT_EQ(t_Object->Find("b")->GetNumber(), -20.f);
+	EXPECT_EQ(t_Object->Find("c")->GetNumber(), 0.000000015f);
+	EXPECT_EQ(t_Object->Find("d")->GetNumber(), 3e25f);
+}
+
+TEST(BBjson, To_StringBuilder)
+{
+	const char t_JsonFile[] = R"({ "name": "lamp", "color": [0.25, 1, 0.5], "owner": null, "light": { "range": 12.5 } })";
+
+	BB::FreelistAllocator_t t_Allocator{ BB::kbSize * 64 };
+	BB::JsonParser t_Parser(BB::StringView(t_JsonFile, sizeof(t_JsonFile) - 1));
+	t_Parser.Parse();
+
+	BB::String t_String{ t_Allocator };
+	JsonNodeToString(t_Parser.GetRootNode(), t_String);
+
+	//Small chunks so the text is spread over many of them.
+	BB::StringBuilder t_Builder{ t_Allocator, 16 };
+	JsonNodeToString(t_Parser.GetRootNode(), t_Builder);
+	EXPECT_GT(t_Builder.chunk_count(), 1);
+
+	BB::String t_Flat{ t_Allocator };
+	t_Builder.flatten(t_Flat);
+	EXPECT_EQ(strcmp(t_Flat.c_str(), t_String.c_str()), 0);
+}
@@ -0,0 +1,201 @@
+#pragma once
+#include "../TestValues.h"
+#include "Storage/BitArray.h"
+#include "Storage/Array.h"
+#include <vector>
+
+TEST(BitArrayDataStructure, BitArray_Set_Count_Iterate)
+{
+	//Not a multiple of 64 and enough words for the AVX2 path.
+	constexpr const size_t bitCount = 64 * 13 + 17;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::BitArray t_Bits(t_Allocator, bitCount);
+	std::vector<bool> t_Reference(bitCount);
+	EXPECT_TRUE(t_Bits.none());
+	EXPECT_EQ(t_Bits.count(), 0);
+
+	for (size_t i = 0; i < bitCount; i++)
+	{
+		if (BB::Random::Random() % 3 == 0)
+		{
+			t_Bits.set(i);
+			t_Reference[i] = true;
+		}
+	}
+	t_Bits.flip(5);
+	t_Reference[5] = !t_Reference[5];
+	t_Bits.reset(bitCount - 1);
+	t_Reference[bitCount - 1] = false;
+
+	size_t t_ReferenceCount = 0;
+	for (size_t i = 0; i < bitCount; i++)
+	{
+		ASSERT_EQ(t_Bits[i], t_Reference[i]);
+		t_ReferenceCount += t_Reference[i];
+	}
+	EXPECT_EQ(t_Bits.count(), t_ReferenceCount);
+	EXPECT_TRUE(t_Bits.any());
+
+	//Iteration gives the set bits in order.
+	size_t t_Previous = 0;
+	size_t t_Visited = 0;
+	for (size_t t_Index : t_Bits.set_bits())
+	{
+		ASSERT_TRUE(t_Reference[t_Index]);
+		if (t_Visited != 0)
+			ASSERT_GT(t_Index, t_Previous);
+		t_Previous = t_Index;
+		++t_Visited;
+	}
+	EXPECT_EQ(t_Visited, t_ReferenceCount);
+
+	//set_all keeps the bits past the size at 0.
+	t_Bits.set_all();
+	EXPECT_EQ(t_Bits.count(), bitCount);
+	t_Bits.clear();
+	EXPECT_TRUE(t_Bits.none());
+	EXPECT_EQ(t_Bits.set_bits().begin(), t_Bits.set_bits().end());
+
+	//Growing with push_back.
+	BB::BitArray t_Grow(t_Allocator);
+	for (size_t i = 0; i < bitCount; i++)
+		t_Grow.push_back(t_Reference[i]);
+	ASSERT_EQ(t_Grow.size(), bitCount);
+	EXPECT_EQ(t_Grow.count(), t_ReferenceCount);
+
+	//Shrinking clears the bits outside of the size.
+	t_Grow.resize(10);
+	size_t t_SmallCount = 0;
+	for (size_t i = 0; i < 10; i++)
+		t_SmallCount += t_Reference[i];
+	EXPECT_EQ(t_Grow.count(), t_SmallCount);
+	t_Grow.resize(bitCount);
+	EXPECT_EQ(t_Grow.count(), t_SmallCount);
+
+	BB::BitArray t_Copy(t_Grow);
+	EXPECT_EQ(t_Copy.count(), t_SmallCount);
+	BB::BitArray t_Moved(std::move(t_Copy));
+	EXPECT_EQ(t_Moved.count(), t_SmallCount);
+	EXPECT_EQ(t_Copy.size(), 0);
+}
+
+TEST(BitArrayDataStructure, BitArray_Bulk_Operations)
+{
+	constexpr const size_t bitCount = 64 * 9 + 3;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::BitArray t_A(t_Allocator, bitCount);
+	BB::BitArray t_B(t_Allocator, bitCount);
+	BB::FixedBitArray<bitCount> t_FixedA;
+	BB::FixedBitArray<bitCount> t_FixedB;
+	std::vector<bool> t_RefA(bitCount), t_RefB(bitCount);
+	for (size_t i = 0; i < bitCount; i++)
+	{
+		if (BB::Random::Random() & 1)
+		{
+			t_A.set(i);
+			t_FixedA.set(i);
+			t_RefA[i] = true;
+		}
+		if (BB::Random::Random() & 1)
+		{
+			t_B.set(i);
+			t_FixedB.set(i);
+			t_RefB[i] = true;
+		}
+	}
+
+	BB::BitArray t_And(t_A);
+	t_And &= t_B;
+	BB::BitArray t_Or(t_A);
+	t_Or |= t_B;
+	BB::BitArray t_Xor(t_A);
+	t_Xor ^= t_B;
+	BB::BitArray t_AndNot(t_A);
+	t_AndNot.and_not(t_B);
+
+	BB::FixedBitArray<bitCount> t_FixedAnd = t_FixedA;
+	t_FixedAnd &= t_FixedB;
+	BB::FixedBitArray<bitCount> t_FixedOr = t_FixedA;
+	t_FixedOr |= t_FixedB;
+	BB::FixedBitArray<bitCount> t_FixedXor = t_FixedA;
+	t_FixedXor ^= t_FixedB;
+	BB::FixedBitArray<bitCount> t_FixedAndNot = t_FixedA;
+	t_FixedAndNot.and_not(t_FixedB);
+
+	for (size_t i = 0; i < bitCount; i++)
+	{
+		ASSERT_EQ(t_And[i], t_RefA[i] && t_RefB[i]);
+		ASSERT_EQ(t_Or[i], t_RefA[i] || t_RefB[i]);
+		ASSERT_EQ(t_Xor[i], t_RefA[i] != t_RefB[i]);
+		ASSERT_EQ(t_AndNot[i], t_RefA[i] && !t_RefB[i]);
+
+		ASSERT_EQ(t_FixedAnd[i], t_And[i]);
+		ASSERT_EQ(t_FixedOr[i], t_Or[i]);
+		ASSERT_EQ(t_FixedXor[i], t_Xor[i]);
+		ASSERT_EQ(t_FixedAndNot[i], t_AndNot[i]);
+	}
+	EXPECT_EQ(t_FixedOr.count(), t_Or.count());
+
+	size_t t_Visited = 0;
+	for (size_t t_Index : t_FixedXor.set_bits())
+	{
+		ASSERT_TRUE(t_Xor[t_Index]);
+		++t_Visited;
+	}
+	EXPECT_EQ(t_Visited, t_Xor.count());
+
+	t_FixedA.set_all();
+	EXPECT_EQ(t_FixedA.count(), bitCount);
+}
+
+#include <chrono>
+
+TEST(BitArrayDataStructure, BitArray_Speedtest)
+{
+	typedef std::chrono::duration<float, std::milli> ms;
+	constexpr const float MILLITIMEDIVIDE = 1 / 1000.f;
+
+	constexpr const size_t bitCount = 1 << 20;
+
+	const size_t allocatorSize = BB::mbSize * 8;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::Array<bool> t_Bools(t_Allocator, bitCount);
+	t_Bools.resize(bitCount);
+	BB::BitArray t_Bits(t_Allocator, bitCount);
+	//Sparse like a dirty flag list.
+	for (size_t i = 0; i < bitCount; i += 1 + BB::Random::Random() % 64)
+	{
+		t_Bools[i] = true;
+		t_Bits.set(i);
+	}
+
+	size_t t_Result = 0;
+	std::cout << "BitArray speed test, visiting the set flags out of " << bitCount << "." << "\n";
+	{
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < bitCount; i++)
+		{
+			if (t_Bools[i])
+				t_Result += i;
+		}
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::Array<bool> speed with time in MS " << t_Speed << "\n";
+	}
+	{
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		for (size_t t_Index : t_Bits.set_bits())
+			t_Result -= t_Index;
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::BitArray speed with time in MS " << t_Speed << "\n";
+	}
+	EXPECT_EQ(t_Result, 0);
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include "../TestValues.h"
+#include "Storage/BucketArray.h"
+
+TEST(BucketArrayDataStructure, BucketArray_Stable_Addresses)
+{
+	constexpr const size_t bucketSize = 16;
+	constexpr const size_t samples = bucketSize * 20 + 3;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::BucketArray<size_t, bucketSize> t_Array(t_Allocator);
+	EXPECT_EQ(t_Array.capacity(), 0);
+
+	size_t* t_Pointers[samples]{};
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Pointers[i] = &t_Array.emplace_back(i * 3);
+	}
+	ASSERT_EQ(t_Array.size(), samples);
+	EXPECT_EQ(t_Array.bucket_count(), samples / bucketSize + 1);
+
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_EQ(t_Pointers[i], &t_Array[i]) << "BucketArray element moved while growing.";
+		ASSERT_EQ(*t_Pointers[i], i * 3);
+	}
+
+	size_t t_Count = 0;
+	for (size_t& t_Value : t_Array)
+	{
+		ASSERT_EQ(t_Value, t_Count * 3);
+		++t_Count;
+	}
+	ASSERT_EQ(t_Count, samples) << "Iterator did not visit every element.";
+
+	//Bucket wise iteration, the last bucket is partially filled.
+	t_Count = 0;
+	for (size_t i = 0; i < t_Array.bucket_count(); i++)
+	{
+		BB::Slice<size_t> t_Bucket = t_Array.bucket(i);
+		EXPECT_EQ(t_Bucket.size(), i + 1 == t_Array.bucket_count() ? samples % bucketSize : bucketSize);
+		for (size_t j = 0; j < t_Bucket.size(); j++)
+		{
+			ASSERT_EQ(t_Bucket[j], t_Count * 3);
+			++t_Count;
+		}
+	}
+	ASSERT_EQ(t_Count, samples);
+
+	//Pop and push reuse the same slot.
+	t_Array.pop();
+	size_t* t_Reused = &t_Array.emplace_back(static_cast<size_t>(7));
+	EXPECT_EQ(t_Reused, t_Pointers[samples - 1]);
+
+	//Clear keeps the buckets.
+	const size_t t_OldCapacity = t_Array.capacity();
+	t_Array.clear();
+	EXPECT_EQ(t_Array.size(), 0);
+	EXPECT_EQ(t_Array.capacity(), t_OldCapacity);
+	EXPECT_EQ(&t_Array.emplace_back(static_cast<size_t>(1)), t_Pointers[0]);
+}
+
+TEST(BucketArrayDataStructure, BucketArray_Copy_Move_Objects)
+{
+	constexpr const size_t bucketSize = 8;
+	constexpr const size_t samples = 100;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	//std::string to check that constructors and destructors are called.
+	BB::BucketArray<std::string, bucketSize> t_Array(t_Allocator, samples);
+	EXPECT_GE(t_Array.capacity(), samples);
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Array.push_back(std::to_string(i) + " a string long enough to not fit in the small string buffer");
+	}
+
+	BB::BucketArray<std::string, bucketSize> t_Copy(t_Array);
+	ASSERT_EQ(t_Copy.size(), samples);
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_EQ(t_Copy[i], t_Array[i]);
+		ASSERT_NE(&t_Copy[i], &t_Array[i]);
+	}
+
+	std::string* t_First = &t_Array[0];
+	BB::BucketArray<std::string, bucketSize> t_Moved(std::move(t_Array));
+	EXPECT_EQ(t_Array.size(), 0);
+	EXPECT_EQ(&t_Moved[0], t_First) << "Moving a BucketArray should not move the elements.";
+
+	BB::BucketArray<std::string, bucketSize> t_Assigned(t_Allocator);
+	t_Assigned.emplace_back("overwritten");
+	t_Assigned = t_Copy;
+	ASSERT_EQ(t_Assigned.size(), samples);
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_EQ(t_Assigned[i], t_Moved[i]);
+	}
+
+	t_Assigned = std::move(t_Moved);
+	ASSERT_EQ(t_Assigned.size(), samples);
+	EXPECT_EQ(&t_Assigned[0], t_First);
+}
@@ -0,0 +1,214 @@
+#pragma once
+#include "../TestValues.h"
+#include "Storage/DaryHeap.h"
+#include <algorithm>
+#include <vector>
+
+struct DaryHeapTask
+{
+	float priority;
+	uint32_t id;
+	char payload[24];
+
+	bool operator<(const DaryHeapTask& a_Rhs) const { return priority < a_Rhs.priority; }
+};
+
+struct DaryHeapGreater
+{
+	bool operator()(const size_t a_A, const size_t a_B) const { return a_A > a_B; }
+};
+
+template<size_t Arity>
+static void DaryHeapOrderTest(BB::Allocator a_Allocator)
+{
+	constexpr const size_t samples = 1000;
+
+	BB::DaryHeap<size_t, Arity> t_Heap(a_Allocator);
+	std::vector<size_t> t_Reference;
+	for (size_t i = 0; i < samples; i++)
+	{
+		const size_t t_Value = BB::Random::Random() % (samples / 2);
+		t_Heap.push(t_Value);
+		t_Reference.push_back(t_Value);
+	}
+	ASSERT_EQ(t_Heap.size(), samples);
+	std::sort(t_Reference.begin(), t_Reference.end());
+
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_EQ(t_Heap.top(), t_Reference[i]);
+		t_Heap.pop();
+	}
+	ASSERT_TRUE(t_Heap.empty());
+}
+
+TEST(DaryHeapDataStructure, DaryHeap_Push_Pop)
+{
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	DaryHeapOrderTest<2>(t_Allocator);
+	DaryHeapOrderTest<3>(t_Allocator);
+	DaryHeapOrderTest<4>(t_Allocator);
+	DaryHeapOrderTest<8>(t_Allocator);
+
+	//A max heap through the compare functor.
+	BB::DaryHeap<size_t, 4, DaryHeapGreater> t_MaxHeap(t_Allocator);
+	for (size_t i = 0; i < 100; i++)
+		t_MaxHeap.push(i);
+	for (size_t i = 100; i > 0; i--)
+	{
+		ASSERT_EQ(t_MaxHeap.top(), i - 1);
+		t_MaxHeap.pop();
+	}
+}
+
+TEST(DaryHeapDataStructure, DaryHeap_Heapify_PopMany)
+{
+	constexpr const size_t samples = 1024;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	size_t t_Values[samples];
+	for (size_t i = 0; i < samples; i++)
+		t_Values[i] = (i * 7919) % samples;
+
+	BB::DaryHeap<size_t> t_Heap(t_Allocator);
+	t_Heap.push(samples * 2);
+	//heapify replaces what was in the heap.
+	t_Heap.heapify(BB::Slice<const size_t>(t_Values, samples));
+	ASSERT_EQ(t_Heap.size(), samples);
+
+	size_t t_Popped[samples];
+	ASSERT_EQ(t_Heap.pop_many(t_Popped, samples / 2), samples / 2);
+	ASSERT_EQ(t_Heap.size(), samples / 2);
+	//Asking for more than what is left only gives what is left.
+	ASSERT_EQ(t_Heap.pop_many(t_Popped + samples / 2, samples), samples / 2);
+	ASSERT_TRUE(t_Heap.empty());
+	for (size_t i = 0; i < samples; i++)
+		ASSERT_EQ(t_Popped[i], i);
+
+	EXPECT_EQ(t_Heap.pop_many(t_Popped, samples), 0);
+}
+
+TEST(DaryHeapDataStructure, IndexedDaryHeap_Decrease_Update_Erase)
+{
+	constexpr const size_t samples = 512;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::IndexedDaryHeap<size_t> t_Heap(t_Allocator);
+	BB::HeapHandle t_Handles[samples];
+	size_t t_Reference[samples];
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Reference[i] = samples + (BB::Random::Random() % samples);
+		t_Handles[i] = t_Heap.push(t_Reference[i]);
+	}
+
+	//Lower every third element, raise every fifth and erase every seventh.
+	for (size_t i = 0; i < samples; i += 3)
+	{
+		t_Reference[i] -= samples / 2;
+		t_Heap.decrease_key(t_Handles[i], t_Reference[i]);
+	}
+	for (size_t i = 0; i < samples; i += 5)
+	{
+		t_Reference[i] += samples;
+		t_Heap.update(t_Handles[i], t_Reference[i]);
+	}
+	for (size_t i = 0; i < samples; i += 7)
+	{
+		t_Heap.erase(t_Handles[i]);
+		ASSERT_FALSE(t_Heap.contains(t_Handles[i]));
+	}
+
+	std::vector<size_t> t_Sorted;
+	for (size_t i = 0; i < samples; i++)
+	{
+		if (i % 7 == 0)
+			continue;
+		ASSERT_EQ(t_Heap.get(t_Handles[i]), t_Reference[i]);
+		t_Sorted.push_back(t_Reference[i]);
+	}
+	std::sort(t_Sorted.begin(), t_Sorted.end());
+	ASSERT_EQ(t_Heap.size(), t_Sorted.size());
+
+	for (size_t i = 0; i < t_Sorted.size(); i++)
+	{
+		const BB::HeapHandle t_Top = t_Heap.top_handle();
+		ASSERT_EQ(t_Heap.top(), t_Sorted[i]);
+		ASSERT_EQ(t_Reference[t_Top], t_Sorted[i]);
+		t_Heap.pop();
+		ASSERT_FALSE(t_Heap.contains(t_Top));
+	}
+	ASSERT_TRUE(t_Heap.empty());
+
+	//Handles get reused.
+	const BB::HeapHandle t_Reused = t_Heap.push(1);
+	EXPECT_LT(t_Reused, samples);
+	EXPECT_EQ(t_Heap.get(t_Reused), 1);
+
+	//After heapify element i has handle i.
+	for (size_t i = 0; i < samples; i++)
+		t_Reference[i] = samples - i;
+	t_Heap.heapify(BB::Slice<const size_t>(t_Reference, samples));
+	ASSERT_EQ(t_Heap.size(), samples);
+	for (size_t i = 0; i < samples; i++)
+		ASSERT_EQ(t_Heap.get(static_cast<BB::HeapHandle>(i)), samples - i);
+	t_Heap.decrease_key(0, 0);
+	EXPECT_EQ(t_Heap.top_handle(), 0);
+
+	size_t t_Popped[samples];
+	ASSERT_EQ(t_Heap.pop_many(t_Popped, samples), samples);
+	EXPECT_EQ(t_Popped[0], 0);
+	for (size_t i = 1; i < samples; i++)
+		ASSERT_EQ(t_Popped[i], i);
+}
+
+#include <chrono>
+
+template<typename T, size_t Arity>
+static float DaryHeapSpeed(BB::Allocator a_Allocator, const T* a_Values, const size_t a_Count)
+{
+	typedef std::chrono::duration<float, std::milli> ms;
+	constexpr const float MILLITIMEDIVIDE = 1 / 1000.f;
+
+	BB::DaryHeap<T, Arity> t_Heap(a_Allocator, a_Count);
+	auto t_Timer = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < a_Count; i++)
+		t_Heap.push(a_Values[i]);
+	while (!t_Heap.empty())
+		t_Heap.pop();
+	return std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+}
+
+TEST(DaryHeapDataStructure, DaryHeap_Speedtest)
+{
+	constexpr const size_t samples = 1 << 17;
+
+	const size_t allocatorSize = BB::mbSize * 64;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	std::vector<uint32_t> t_Ints(samples);
+	std::vector<DaryHeapTask> t_Tasks(samples);
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Ints[i] = static_cast<uint32_t>(BB::Random::Random());
+		t_Tasks[i].priority = static_cast<float>(t_Ints[i] % 100000);
+		t_Tasks[i].id = static_cast<uint32_t>(i);
+	}
+
+	std::cout << "DaryHeap speed test, " << samples << " pushes followed by as many pops." << "\n";
+	std::cout << "uint32_t binary heap speed with time in MS " << DaryHeapSpeed<uint32_t, 2>(t_Allocator, t_Ints.data(), samples) << "\n";
+	std::cout << "uint32_t 4-ary heap speed with time in MS " << DaryHeapSpeed<uint32_t, 4>(t_Allocator, t_Ints.data(), samples) << "\n";
+	std::cout << "uint32_t 8-ary heap speed with time in MS " << DaryHeapSpeed<uint32_t, 8>(t_Allocator, t_Ints.data(), samples) << "\n";
+	std::cout << "32 byte struct binary heap speed with time in MS " << DaryHeapSpeed<DaryHeapTask, 2>(t_Allocator, t_Tasks.data(), samples) << "\n";
+	std::cout << "32 byte struct 4-ary heap speed with time in MS " << DaryHeapSpeed<DaryHeapTask, 4>(t_Allocator, t_Tasks.data(), samples) << "\n";
+	std::cout << "32 byte struct 8-ary heap speed with time in MS " << DaryHeapSpeed<DaryHeapTask, 8>(t_Allocator, t_Tasks.data(), samples) << "\n";
+}
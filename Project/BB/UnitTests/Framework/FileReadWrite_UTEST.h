@@ -1,6 +1,7 @@
 #pragma once
 #include "../TestValues.h"
 #include "OS/Program.h"
+#include "Storage/StringBuilder.h"
 
 TEST(Program_IO, Read_Write_Files)
 {
@@ -81,4 +82,36 @@ TEST(Program_IO, Read_Write_Files_Same_File)
 	ASSERT_STREQ(t_TestText, DOC_DATA);
 
 	t_Allocator.Clear();
-}
\ No newline at end of file
+}
+
+TEST(Program_IO, Read_Write_Files_StringBuilder)
+{
+	BB::LinearAllocator_t t_Allocator(1024);
+	BB::FreelistAllocator_t t_BuilderAllocator(BB::kbSize * 16);
+
+	constexpr wchar* DOC_NAME = L"READWRITETEST_BUILDER.txt";
+	constexpr char* DOC_DATA = "HELLO WORLD! I'm a BB engine unit test for file read and writing.";
+
+	//Small chunks so the text is written from multiple buffers.
+	BB::StringBuilder t_Builder(t_BuilderAllocator, 8);
+	t_Builder.append("HELLO WORLD!");
+	t_Builder.append(" I'm a BB engine unit");
+	t_Builder.append(" test for file read and writing.");
+
+	BB::OSFileHandle t_TestFile = BB::CreateOSFile(DOC_NAME);
+
+	t_Builder.write_to_file(t_TestFile);
+
+	BB::CloseOSFile(t_TestFile);
+
+	BB::Buffer t_ReadBuffer = BB::ReadOSFile(t_Allocator, DOC_NAME);
+
+	char* t_TestText = BBnewArr(t_Allocator, t_ReadBuffer.size + 1, char);
+	memcpy(t_TestText, t_ReadBuffer.data, t_ReadBuffer.size);
+	t_TestText[t_ReadBuffer.size] = '\0';
+
+	//Should be equal, or else the gather write is broken.
+	ASSERT_STREQ(t_TestText, DOC_DATA);
+
+	t_Allocator.Clear();
+}
@@ -0,0 +1,191 @@
+#pragma once
+#include "../TestValues.h"
+#include "Storage/FlatMap.h"
+#include "Storage/Hashmap.h"
+#include <map>
+#include <vector>
+
+TEST(FlatMapDataStructure, FlatMap_Insert_Find_Erase)
+{
+	constexpr const size_t samples = 1000;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::FlatMap<uint32_t, std::string> t_Map(t_Allocator);
+	std::map<uint32_t, std::string> t_Reference;
+	for (size_t i = 0; i < samples; i++)
+	{
+		const uint32_t t_Key = BB::Random::Random() % (samples * 4);
+		const std::string t_Value = std::to_string(t_Key) + " a string long enough to not fit in the small string buffer";
+		t_Map.insert(t_Key, t_Value);
+		t_Reference[t_Key] = t_Value;
+	}
+	ASSERT_EQ(t_Map.size(), t_Reference.size());
+
+	//Both layouts find the same elements.
+	for (size_t t_Layout = 0; t_Layout < 2; t_Layout++)
+	{
+		t_Map.set_eytzinger(t_Layout == 1);
+		for (uint32_t t_Key = 0; t_Key < samples * 4 + 1; t_Key++)
+		{
+			const std::string* t_Found = t_Map.find(t_Key);
+			auto t_RefIt = t_Reference.find(t_Key);
+			if (t_RefIt == t_Reference.end())
+			{
+				ASSERT_EQ(t_Found, nullptr);
+			}
+			else
+			{
+				ASSERT_NE(t_Found, nullptr);
+				ASSERT_EQ(*t_Found, t_RefIt->second);
+			}
+			ASSERT_EQ(t_Map.lower_bound(t_Key), static_cast<size_t>(std::distance(t_Reference.begin(), t_Reference.lower_bound(t_Key))));
+		}
+	}
+
+	//Iteration goes in key order.
+	auto t_RefIt = t_Reference.begin();
+	for (BB::FlatMap<uint32_t, std::string>::Pair t_Pair : t_Map)
+	{
+		ASSERT_EQ(*t_Pair.key, t_RefIt->first);
+		ASSERT_EQ(*t_Pair.value, t_RefIt->second);
+		++t_RefIt;
+	}
+
+	//Erase half while the eytzinger index is on, it gets rebuilt.
+	for (uint32_t t_Key = 0; t_Key < samples * 4; t_Key += 2)
+	{
+		t_Map.erase(t_Key);
+		t_Reference.erase(t_Key);
+	}
+	ASSERT_EQ(t_Map.size(), t_Reference.size());
+	for (auto& t_Pair : t_Reference)
+	{
+		ASSERT_NE(t_Map.find(t_Pair.first), nullptr);
+		ASSERT_EQ(*t_Map.find(t_Pair.first), t_Pair.second);
+	}
+	EXPECT_EQ(t_Map.find(0), nullptr);
+
+	BB::FlatMap<uint32_t, std::string> t_Copy(t_Map);
+	BB::FlatMap<uint32_t, std::string> t_Moved(std::move(t_Map));
+	EXPECT_EQ(t_Map.size(), 0);
+	ASSERT_EQ(t_Copy.size(), t_Moved.size());
+	for (auto& t_Pair : t_Reference)
+	{
+		ASSERT_EQ(*t_Copy.find(t_Pair.first), t_Pair.second);
+		ASSERT_EQ(*t_Moved.find(t_Pair.first), t_Pair.second);
+	}
+	t_Copy.clear();
+	EXPECT_EQ(t_Copy.find(t_Reference.begin()->first), nullptr);
+}
+
+TEST(FlatMapDataStructure, FlatMap_Build_Range)
+{
+	constexpr const size_t samples = 2048;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::FlatMap<size_t, size_t> t_Map(t_Allocator);
+	t_Map.insert(5, 0);
+
+	//Unsorted with duplicates, the last value of a key wins.
+	size_t t_Keys[samples];
+	size_t t_Values[samples];
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Keys[i] = (i * 7919) % (samples / 2);
+		t_Values[i] = i;
+	}
+	t_Map.build(t_Keys, t_Values, samples);
+	ASSERT_EQ(t_Map.size(), samples / 2);
+	for (size_t i = 0; i < samples / 2; i++)
+	{
+		ASSERT_EQ(t_Map.key(i), i);
+		//Every key is given twice, the second time with a value of at least samples / 2.
+		ASSERT_GE(t_Map.value(i), samples / 2);
+		ASSERT_EQ((t_Map.value(i) * 7919) % (samples / 2), i);
+	}
+
+	//Range queries are a slice of the sorted arrays.
+	t_Map.set_eytzinger(true);
+	BB::FlatMap<size_t, size_t>::Range t_Range = t_Map.range(100, 200);
+	ASSERT_EQ(t_Range.keys.size(), 100);
+	ASSERT_EQ(t_Range.values.size(), 100);
+	for (size_t i = 0; i < t_Range.keys.size(); i++)
+	{
+		ASSERT_EQ(t_Range.keys[i], 100 + i);
+		ASSERT_EQ(t_Range.values[i], *t_Map.find(100 + i));
+	}
+	EXPECT_EQ(t_Map.range(200, 100).keys.size(), 0);
+	EXPECT_EQ(t_Map.range(samples, samples * 2).keys.size(), 0);
+	EXPECT_EQ(t_Map.range(0, samples).keys.size(), samples / 2);
+}
+
+#include <chrono>
+
+TEST(FlatMapDataStructure, FlatMap_Speedtest)
+{
+	typedef std::chrono::duration<float, std::milli> ms;
+	constexpr const float MILLITIMEDIVIDE = 1 / 1000.f;
+
+	constexpr const size_t samples = 1 << 16;
+	constexpr const size_t lookups = 1 << 20;
+
+	const size_t allocatorSize = BB::mbSize * 32;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	std::vector<uint32_t> t_Keys(samples);
+	std::vector<uint32_t> t_Values(samples);
+	std::vector<uint32_t> t_Lookups(lookups);
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Keys[i] = static_cast<uint32_t>(i * 3);
+		t_Values[i] = static_cast<uint32_t>(i);
+	}
+	for (size_t i = 0; i < lookups; i++)
+		t_Lookups[i] = t_Keys[BB::Random::Random() % samples];
+
+	BB::UM_HashMap<uint32_t, uint32_t> t_UMMap(t_Allocator, samples);
+	BB::OL_HashMap<uint32_t, uint32_t> t_OLMap(t_Allocator, samples);
+	BB::FlatMap<uint32_t, uint32_t> t_FlatMap(t_Allocator);
+	t_UMMap.build(t_Keys.data(), t_Values.data(), samples);
+	t_OLMap.build(t_Keys.data(), t_Values.data(), samples);
+	t_FlatMap.build(t_Keys.data(), t_Values.data(), samples);
+
+	uint32_t t_Result = 0;
+	std::cout << "FlatMap speed test, " << lookups << " random finds in a map of " << samples << " elements." << "\n";
+	{
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < lookups; i++)
+			t_Result += *t_UMMap.find(t_Lookups[i]);
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::UM_HashMap speed with time in MS " << t_Speed << "\n";
+	}
+	{
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < lookups; i++)
+			t_Result -= *t_OLMap.find(t_Lookups[i]);
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::OL_HashMap speed with time in MS " << t_Speed << "\n";
+	}
+	{
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < lookups; i++)
+			t_Result += *t_FlatMap.find(t_Lookups[i]);
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::FlatMap sorted layout speed with time in MS " << t_Speed << "\n";
+	}
+	t_FlatMap.set_eytzinger(true);
+	{
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < lookups; i++)
+			t_Result -= *t_FlatMap.find(t_Lookups[i]);
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::FlatMap eytzinger layout speed with time in MS " << t_Speed << "\n";
+	}
+	EXPECT_EQ(t_Result, 0);
+}
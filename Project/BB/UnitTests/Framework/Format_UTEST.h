@@ -0,0 +1,208 @@
+#pragma once
+#include "../TestValues.h"
+#include "Storage/BBString.h"
+#include "Utils/Format.h"
+#include <limits>
+#include <string>
+
+static std::string FormatIntString(const int64_t a_Value)
+{
+	char t_Buffer[BB::Format_Specs::maxIntegerChars];
+	return std::string(t_Buffer, BB::FormatOps::IntToChars(t_Buffer, a_Value));
+}
+
+static std::string FormatDoubleString(const double a_Value)
+{
+	char t_Buffer[BB::Format_Specs::maxFloatChars];
+	return std::string(t_Buffer, BB::FormatOps::DoubleToChars(t_Buffer, a_Value));
+}
+
+static std::string FormatFloatString(const float a_Value)
+{
+	char t_Buffer[BB::Format_Specs::maxFloatChars];
+	return std::string(t_Buffer, BB::FormatOps::FloatToChars(t_Buffer, a_Value));
+}
+
+//Amount of significant digits in the text, leading and trailing zeros and the exponent do not count.
+static int FormatSignificantDigits(const std::string& a_Text)
+{
+	std::string t_Digits;
+	for (const char t_Char : a_Text)
+	{
+		if (t_Char == 'e')
+			break;
+		if (t_Char >= '0' && t_Char <= '9' && (t_Char != '0' || !t_Digits.empty()))
+			t_Digits.push_back(t_Char);
+	}
+	while (!t_Digits.empty() && t_Digits.back() == '0')
+		t_Digits.pop_back();
+	return static_cast<int>(t_Digits.size());
+}
+
+TEST(Format, Integer_To_Chars)
+{
+	const int64_t t_Values[] = { 0, 1, -1, 9, 10, 99, 100, -100, 12345, 1000000007, INT32_MIN, INT32_MAX, INT64_MIN, INT64_MAX };
+	char t_Expected[32];
+	for (const int64_t t_Value : t_Values)
+	{
+		snprintf(t_Expected, sizeof(t_Expected), "%lld", static_cast<long long>(t_Value));
+		EXPECT_EQ(FormatIntString(t_Value), t_Expected);
+	}
+	EXPECT_EQ(FormatIntString(INT64_MIN).size(), BB::Format_Specs::maxIntegerChars);
+
+	char t_Buffer[BB::Format_Specs::maxIntegerChars];
+	EXPECT_EQ(std::string(t_Buffer, BB::FormatOps::UIntToChars(t_Buffer, UINT64_MAX)), "18446744073709551615");
+	//Every power of 10 and the values around it.
+	for (uint64_t t_Power = 1; t_Power <= 10000000000000000000ull; t_Power *= 10)
+	{
+		for (uint64_t t_Value = t_Power - 1; t_Value <= t_Power + 1; t_Value++)
+		{
+			snprintf(t_Expected, sizeof(t_Expected), "%llu", static_cast<unsigned long long>(t_Value));
+			ASSERT_EQ(std::string(t_Buffer, BB::FormatOps::UIntToChars(t_Buffer, t_Value)), t_Expected);
+		}
+		if (t_Power == 10000000000000000000ull)
+			break;
+	}
+
+	char t_Hex[BB::Format_Specs::maxHexChars];
+	EXPECT_EQ(std::string(t_Hex, BB::FormatOps::HexToChars(t_Hex, 0)), "0x0");
+	EXPECT_EQ(std::string(t_Hex, BB::FormatOps::HexToChars(t_Hex, 0xdeadbeef)), "0xdeadbeef");
+	EXPECT_EQ(std::string(t_Hex, BB::FormatOps::HexToChars(t_Hex, UINT64_MAX)), "0xffffffffffffffff");
+}
+
+TEST(Format, Float_To_Chars_Notation)
+{
+	EXPECT_EQ(FormatDoubleString(0.0), "0");
+	EXPECT_EQ(FormatDoubleString(-0.0), "-0");
+	EXPECT_EQ(FormatDoubleString(1.0), "1");
+	EXPECT_EQ(FormatDoubleString(-1.5), "-1.5");
+	EXPECT_EQ(FormatDoubleString(0.1), "0.1");
+	EXPECT_EQ(FormatDoubleString(0.3), "0.3");
+	EXPECT_EQ(FormatDoubleString(123456.789), "123456.789");
+	EXPECT_EQ(FormatDoubleString(1e20), "100000000000000000000");
+	EXPECT_EQ(FormatDoubleString(1e21), "1e21");
+	EXPECT_EQ(FormatDoubleString(1e-7), "0.0000001");
+	EXPECT_EQ(FormatDoubleString(1.5e-8), "1.5e-8");
+	EXPECT_EQ(FormatDoubleString(5e-324), "5e-324");
+	EXPECT_EQ(FormatDoubleString(1.7976931348623157e308), "1.7976931348623157e308");
+	EXPECT_EQ(FormatDoubleString(std::numeric_limits<double>::infinity()), "inf");
+	EXPECT_EQ(FormatDoubleString(-std::numeric_limits<double>::infinity()), "-inf");
+	EXPECT_EQ(FormatDoubleString(std::numeric_limits<double>::quiet_NaN()), "nan");
+
+	EXPECT_EQ(FormatFloatString(3.14159f), "3.14159");
+	EXPECT_EQ(FormatFloatString(0.1f), "0.1");
+	EXPECT_EQ(FormatFloatString(16777216.f), "16777216");
+	EXPECT_EQ(FormatFloatString(3.4028235e38f), "3.4028235e38");
+	EXPECT_EQ(FormatFloatString(1e-45f), "1e-45");
+}
+
+//Random bit patterns must read back to the same value with the least amount of digits.
+TEST(Format, Float_To_Chars_Round_Trip)
+{
+	constexpr const size_t samples = 1 << 16;
+	char t_Shorter[64];
+
+	for (size_t i = 0; i < samples; i++)
+	{
+		const uint64_t t_Bits = (static_cast<uint64_t>(BB::Random::Random()) << 32) ^ BB::Random::Random();
+		double t_Double;
+		memcpy(&t_Double, &t_Bits, sizeof(t_Double));
+		if (std::isfinite(t_Double))
+		{
+			const std::string t_Text = FormatDoubleString(t_Double);
+			ASSERT_LE(t_Text.size(), BB::Format_Specs::maxFloatChars);
+			const double t_Back = strtod(t_Text.c_str(), nullptr);
+			ASSERT_EQ(memcmp(&t_Back, &t_Double, sizeof(t_Double)), 0) << t_Text;
+
+			const int t_Digits = FormatSignificantDigits(t_Text);
+			if (t_Digits > 1)
+			{
+				snprintf(t_Shorter, sizeof(t_Shorter), "%.*g", t_Digits - 1, t_Double);
+				ASSERT_NE(strtod(t_Shorter, nullptr), t_Double) << t_Text;
+			}
+		}
+
+		const uint32_t t_FloatBits = static_cast<uint32_t>(t_Bits);
+		float t_Float;
+		memcpy(&t_Float, &t_FloatBits, sizeof(t_Float));
+		if (std::isfinite(t_Float))
+		{
+			const std::string t_Text = FormatFloatString(t_Float);
+			ASSERT_LE(t_Text.size(), BB::Format_Specs::maxFloatChars);
+			const float t_Back = strtof(t_Text.c_str(), nullptr);
+			ASSERT_EQ(memcmp(&t_Back, &t_Float, sizeof(t_Float)), 0) << t_Text;
+
+			const int t_Digits = FormatSignificantDigits(t_Text);
+			if (t_Digits > 1)
+			{
+				snprintf(t_Shorter, sizeof(t_Shorter), "%.*g", t_Digits - 1, static_cast<double>(t_Float));
+				ASSERT_NE(strtof(t_Shorter, nullptr), t_Float) << t_Text;
+			}
+		}
+	}
+}
+
+enum class FormatTestEnum : uint32_t
+{
+	VALUE = 7
+};
+
+TEST(Format, Format_Arguments)
+{
+	const size_t allocatorSize = BB::kbSize * 16;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::String t_String(t_Allocator);
+	BB::Format(t_String, "{} has {} items at {} for {}{}", "inventory", 42u, 0.5f, -1.25, '!');
+	EXPECT_EQ(strcmp(t_String.c_str(), "inventory has 42 items at 0.5 for -1.25!"), 0);
+
+	//Format appends, escapes are written once.
+	const BB::String t_Name(t_Allocator, "player");
+	BB::Format(t_String, " {{{}}} {} {}}}", t_Name, true, FormatTestEnum::VALUE);
+	EXPECT_EQ(strcmp(t_String.c_str(), "inventory has 42 items at 0.5 for -1.25! {player} true 7}"), 0);
+
+	t_String.clear();
+	BB::Format(t_String, "no arguments");
+	EXPECT_EQ(strcmp(t_String.c_str(), "no arguments"), 0);
+
+	t_String.clear();
+	BB::Format(t_String, "{}", static_cast<const void*>(nullptr));
+	EXPECT_EQ(strcmp(t_String.c_str(), "0x0"), 0);
+
+	//Stack strings work the same without allocating.
+	BB::StackString<64> t_StackString;
+	BB::Format(t_StackString, "{}/{}", INT64_MIN, UINT64_MAX);
+	EXPECT_EQ(strcmp(t_StackString.c_str(), "-9223372036854775808/18446744073709551615"), 0);
+}
+
+#include <chrono>
+
+TEST(Format, Format_Speedtest)
+{
+	typedef std::chrono::duration<float, std::milli> ms;
+	constexpr const float MILLITIMEDIVIDE = 1 / 1000.f;
+	constexpr const size_t samples = 1 << 18;
+
+	double* t_Values = new double[samples];
+	for (size_t i = 0; i < samples; i++)
+		t_Values[i] = static_cast<double>(BB::Random::Random()) / static_cast<double>(BB::Random::Random() | 1);
+
+	char t_Buffer[64];
+	size_t t_Written = 0;
+	auto t_Timer = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < samples; i++)
+		t_Written += static_cast<size_t>(snprintf(t_Buffer, sizeof(t_Buffer), "%.17g", t_Values[i]));
+	const float t_SnprintfTime = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+
+	t_Timer = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < samples; i++)
+		t_Written += BB::FormatOps::DoubleToChars(t_Buffer, t_Values[i]);
+	const float t_FormatTime = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+	EXPECT_NE(t_Written, 0);
+
+	std::cout << "Double to text speed test, " << samples << " doubles." << "\n";
+	std::cout << "snprintf %.17g speed with time in MS " << t_SnprintfTime << "\n";
+	std::cout << "FormatOps::DoubleToChars speed with time in MS " << t_FormatTime << "\n";
+
+	delete[] t_Values;
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include "../TestValues.h"
+#include "Utils/Hash.h"
+#include "BBMemory.h"
+#include <bitset>
+
+//The compile time hash must be usable as a constant.
+static_assert(Hash::MakeHashConstexpr("BB") != Hash::MakeHashConstexpr("BC"), "constexpr hash is not usable at compile time.");
+
+TEST(Hash, Runtime_Matches_Constexpr)
+{
+	//Covers the small, medium and the SIMD bulk path including a couple of scramble blocks.
+	constexpr const size_t maxSize = 2500;
+	char t_Buffer[maxSize]{};
+	for (size_t i = 0; i < maxSize; i++)
+	{
+		t_Buffer[i] = static_cast<char>(BB::Random::Random());
+	}
+
+	for (size_t i = 0; i < maxSize; i++)
+	{
+		ASSERT_EQ(Hash::MakeHash(t_Buffer, i).hash, Hash::MakeHashConstexpr(t_Buffer, i).hash) << "Runtime and constexpr hash differ at size " << i;
+		ASSERT_EQ(Hash::MakeHash(static_cast<const void*>(t_Buffer), i).hash, Hash::MakeHash(t_Buffer, i).hash);
+	}
+
+	for (size_t i = 0; i < 1024; i++)
+	{
+		const size_t t_Value = static_cast<size_t>(BB::Random::Random());
+		ASSERT_EQ(Hash::MakeHash(t_Value).hash, Hash::MakeHashConstexpr(t_Value).hash) << "Runtime and constexpr integer hash differ.";
+	}
+
+	const char* t_String = "Framework string key";
+	ASSERT_EQ(Hash::MakeHash(t_String).hash, Hash::MakeHash(t_String, strlen(t_String)).hash);
+	ASSERT_EQ(Hash::MakeHash(t_String).hash, Hash::MakeHashConstexpr("Framework string key").hash);
+}
+
+TEST(Hash, Avalanche)
+{
+	//Flipping a single input bit should flip close to half of the output bits.
+	constexpr const size_t samples = 256;
+	size_t t_FlippedBits = 0;
+	size_t t_Tests = 0;
+
+	char t_Buffer[512]{};
+	for (size_t i = 0; i < samples; i++)
+	{
+		const size_t t_Value = static_cast<size_t>(BB::Random::Random());
+		const uint64_t t_Hash = Hash::MakeHash(t_Value);
+		for (size_t t_Bit = 0; t_Bit < 64; t_Bit++)
+		{
+			t_FlippedBits += std::bitset<64>(t_Hash ^ Hash::MakeHash(t_Value ^ (1ull << t_Bit))).count();
+			t_Tests++;
+		}
+	}
+
+	//The byte path, flip a bit in both a small and a bulk sized input.
+	for (size_t i = 0; i < sizeof(t_Buffer); i++)
+		t_Buffer[i] = static_cast<char>(BB::Random::Random());
+	const size_t t_Sizes[] = { 3, 12, 40, 200, sizeof(t_Buffer) };
+	for (size_t t_SizeIndex = 0; t_SizeIndex < _countof(t_Sizes); t_SizeIndex++)
+	{
+		const size_t t_Size = t_Sizes[t_SizeIndex];
+		const uint64_t t_Hash = Hash::MakeHash(t_Buffer, t_Size);
+		for (size_t t_Bit = 0; t_Bit < t_Size * 8; t_Bit++)
+		{
+			t_Buffer[t_Bit / 8] ^= static_cast<char>(1 << (t_Bit % 8));
+			t_FlippedBits += std::bitset<64>(t_Hash ^ Hash::MakeHash(t_Buffer, t_Size)).count();
+			t_Buffer[t_Bit / 8] ^= static_cast<char>(1 << (t_Bit % 8));
+			t_Tests++;
+		}
+	}
+
+	const double t_Average = static_cast<double>(t_FlippedBits) / static_cast<double>(t_Tests);
+	EXPECT_GT(t_Average, 30.0) << "Bad avalanche, average flipped bits: " << t_Average;
+	EXPECT_LT(t_Average, 34.0) << "Bad avalanche, average flipped bits: " << t_Average;
+}
+
+#include <chrono>
+#include <string_view>
+
+TEST(Hash, Hash_Speedtest)
+{
+	typedef std::chrono::duration<float, std::milli> ms;
+	constexpr const float MILLITIMEDIVIDE = 1 / 1000.f;
+
+	constexpr const size_t samples = 8192;
+	constexpr const size_t bufferSize = BB::kbSize * 64;
+
+	const size_t allocatorSize = BB::mbSize;
+	BB::LinearAllocator_t t_Allocator(allocatorSize);
+	char* t_Buffer = reinterpret_cast<char*>(BBalloc(t_Allocator, bufferSize));
+	for (size_t i = 0; i < bufferSize; i++)
+		t_Buffer[i] = static_cast<char>(BB::Random::Random());
+
+	//Unused result so the compiler does not remove the hashing.
+	uint64_t t_Result = 0;
+
+	std::cout << "Hash speed test comparison with std::hash<std::string_view>" << "\n";
+	const size_t t_Sizes[] = { 8, 24, 100, 1024, bufferSize };
+	for (size_t t_SizeIndex = 0; t_SizeIndex < _countof(t_Sizes); t_SizeIndex++)
+	{
+		const size_t t_Size = t_Sizes[t_SizeIndex];
+		const size_t t_Iterations = samples * 64 / (t_Size / 8 + 1);
+		std::cout << "/-----------------------------------------/" << "\n" << "Size " << t_Size << " bytes, iterations " << t_Iterations << ":" << "\n";
+
+		{
+			auto t_Timer = std::chrono::high_resolution_clock::now();
+			for (size_t i = 0; i < t_Iterations; i++)
+			{
+				t_Result += std::hash<std::string_view>()(std::string_view(t_Buffer + (i & 7), t_Size - 8));
+			}
+			auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+			std::cout << "std::hash speed with time in MS " << t_Speed << "\n";
+		}
+
+		{
+			auto t_Timer = std::chrono::high_resolution_clock::now();
+			for (size_t i = 0; i < t_Iterations; i++)
+			{
+				t_Result += Hash::MakeHash(t_Buffer + (i & 7), t_Size - 8);
+			}
+			auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+			std::cout << "BB::Hash speed with time in MS " << t_Speed << "\n";
+		}
+	}
+	std::cout << "/-----------------------------------------/" << "\n" << t_Result << "\n";
+}
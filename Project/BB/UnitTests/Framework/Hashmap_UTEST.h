@@ -2,6 +2,9 @@
 #include "../TestValues.h"
 #include "Storage/Hashmap.h"
 
+static_assert(BB::isTriviallyRelocatable_v<BB::UM_HashMap<size_t, size_t>> && BB::isTriviallyRelocatable_v<BB::OL_HashMap<size_t, size_t>>,
+	"Hashmaps must be trivially relocatable.");
+
 TEST(Hashmap_Datastructure, UM_Hashmap_Insert_Copy_Assignment)
 {
 	constexpr const size_t samples = 256;
@@ -119,11 +122,13 @@ TEST(Hashmap_Datastructure, UM_Hashmap_Range_Based_Loop)
 		ASSERT_EQ(t_Map.find(t_Key)->value, t_Value.value) << "Wrong element was likely grabbed.";
 	}
 
-	//Not supporting range based loops.
-	//for (auto& t_It : t_Map)
-	//{
-	//	ASSERT_EQ(t_Map.find(*t_It.key)->value, t_It.value->value) << "Iterator found an pair that the hashmap couldn't find.";
-	//}
+	size_t t_IteratedCount = 0;
+	for (auto& t_It : t_Map)
+	{
+		ASSERT_EQ(t_Map.find(*t_It.key)->value, t_It.value->value) << "Iterator found an pair that the hashmap couldn't find.";
+		++t_IteratedCount;
+	}
+	ASSERT_EQ(t_IteratedCount, t_Map.size()) << "Iterator did not visit every element.";
 }
 
 TEST(Hashmap_Datastructure, OL_Hashmap_Insert_Copy_Assignment)
@@ -261,11 +266,355 @@ TEST(Hashmap_Datastructure, OL_Hashmap_Range_Based_Loop)
 		ASSERT_EQ(t_Map.find(t_Key)->value, t_Value.value) << "Wrong element was likely grabbed.";
 	}
 
-	//Not supporting range based loops.
-	//for (auto& t_It : t_Map)
-	//{
-	//	ASSERT_EQ(t_Map.find(*t_It.key)->value, t_It.value->value) << "Iterator found an pair that the hashmap couldn't find.";
-	//}
+	size_t t_IteratedCount = 0;
+	for (auto& t_It : t_Map)
+	{
+		ASSERT_EQ(t_Map.find(*t_It.key)->value, t_It.value->value) << "Iterator found an pair that the hashmap couldn't find.";
+		++t_IteratedCount;
+	}
+	ASSERT_EQ(t_IteratedCount, t_Map.size()) << "Iterator did not visit every element.";
+}
+
+TEST(Hashmap_Datastructure, UM_Hashmap_Incremental_Resize)
+{
+	constexpr const size_t samples = 4096;
+
+	//32 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 32;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	//Start small so that the map needs to resize multiple times.
+	BB::UM_HashMap<size_t, size2593bytesObj> t_Map(t_Allocator, 16);
+	t_Map.set_incremental_resize(true);
+
+	bool t_HasResized = false;
+	size_t t_ResizeIterations = 0;
+	for (size_t i = 0; i < samples; i++)
+	{
+		size2593bytesObj t_Value{};
+		t_Value.value = i + 2;
+		t_Map.insert(i, t_Value);
+		t_HasResized |= t_Map.is_resizing();
+
+		//Iteration also visits the elements that are still in the old table.
+		if (t_Map.is_resizing() && t_ResizeIterations < 16)
+		{
+			++t_ResizeIterations;
+			size_t t_IteratedCount = 0;
+			for (auto& t_It : t_Map)
+			{
+				ASSERT_EQ(t_Map.find(*t_It.key)->value, t_It.value->value) << "Iterator found an pair that the hashmap couldn't find.";
+				++t_IteratedCount;
+			}
+			ASSERT_EQ(t_IteratedCount, t_Map.size()) << "Iterator did not visit every element during a resize.";
+		}
+
+		//The element needs to be findable while the old table is still being moved.
+		ASSERT_NE(t_Map.find(i), nullptr) << "Cannot find the element while it was added!";
+		ASSERT_EQ(t_Map.find(i)->value, t_Value.value) << "Wrong element was likely grabbed.";
+	}
+	EXPECT_TRUE(t_HasResized) << "The map never did an incremental resize, this might indicate an unaccurate test.";
+	EXPECT_GT(t_ResizeIterations, 0u);
+	ASSERT_EQ(t_Map.size(), samples);
+
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_NE(t_Map.find(i), nullptr) << "Element got lost during an incremental resize.";
+		ASSERT_EQ(t_Map.find(i)->value, i + 2) << "Wrong element was likely grabbed.";
+	}
+
+	//Erase half of the elements.
+	for (size_t i = 0; i < samples; i += 2)
+	{
+		t_Map.erase(i);
+	}
+	ASSERT_EQ(t_Map.size(), samples / 2);
+
+	for (size_t i = 0; i < samples; i++)
+	{
+		if (i % 2 == 0)
+			ASSERT_EQ(t_Map.find(i), nullptr) << "Element was found while it should've been deleted.";
+		else
+			ASSERT_EQ(t_Map.find(i)->value, i + 2) << "Wrong element was likely grabbed.";
+	}
+
+	//Turning it off finishes the resize.
+	t_Map.set_incremental_resize(false);
+	EXPECT_FALSE(t_Map.is_resizing());
+}
+
+//Counts the living objects, a value that leaks or gets destroyed twice shows up in the count.
+static size_t s_HashmapCountedAlive = 0;
+struct HashmapCountedObj
+{
+	//Empty buckets hold a default constructed value that owns nothing and is not counted.
+	HashmapCountedObj() : value(nullptr) {}
+	HashmapCountedObj(const size_t a_Value) : value(new size_t(a_Value)) { ++s_HashmapCountedAlive; }
+	HashmapCountedObj(const HashmapCountedObj& a_Obj) : value(new size_t(*a_Obj.value)) { ++s_HashmapCountedAlive; }
+	HashmapCountedObj(HashmapCountedObj&& a_Obj) noexcept : value(a_Obj.value) { a_Obj.value = nullptr; ++s_HashmapCountedAlive; }
+	~HashmapCountedObj() { delete value; --s_HashmapCountedAlive; }
+	HashmapCountedObj& operator=(const HashmapCountedObj&) = delete;
+
+	size_t* value;
+};
+
+//Every 4 keys share a hash, so every bucket has a collision chain.
+struct HashmapCollisionHasher
+{
+	inline Hash operator()(const size_t a_Key) const
+	{
+		return Hash(a_Key / 4);
+	}
+};
+
+TEST(Hashmap_Datastructure, UM_Hashmap_Non_Trivial_Values)
+{
+	constexpr const size_t samples = 1024;
+
+	//32 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 32;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	{
+		BB::UM_HashMap<size_t, HashmapCountedObj, BB::Standard_KeyComp<size_t>, HashmapCollisionHasher> t_Map(t_Allocator, 16);
+		t_Map.set_incremental_resize(true);
+
+		bool t_HasResized = false;
+		for (size_t i = 0; i < samples; i++)
+		{
+			t_Map.emplace(i, i);
+			t_HasResized |= t_Map.is_resizing();
+			ASSERT_EQ(s_HashmapCountedAlive, t_Map.size()) << "A value leaked or was destroyed twice while growing.";
+		}
+		EXPECT_TRUE(t_HasResized) << "The map never did an incremental resize, this might indicate an unaccurate test.";
+
+		{
+			BB::UM_HashMap<size_t, HashmapCountedObj, BB::Standard_KeyComp<size_t>, HashmapCollisionHasher> t_CopyMap(t_Map);
+			ASSERT_EQ(s_HashmapCountedAlive, t_Map.size() * 2);
+		}
+		ASSERT_EQ(s_HashmapCountedAlive, t_Map.size());
+
+		//Erases the first entry of a bucket and entries in the middle of a chain.
+		for (size_t i = 0; i < samples; i += 2)
+		{
+			t_Map.erase(i);
+			ASSERT_EQ(s_HashmapCountedAlive, t_Map.size()) << "A value leaked or was destroyed twice on erase.";
+		}
+		for (size_t i = 1; i < samples; i += 2)
+		{
+			ASSERT_NE(t_Map.find(i), nullptr) << "Element got lost after an erase.";
+			ASSERT_EQ(*t_Map.find(i)->value, i) << "Wrong element was likely grabbed.";
+		}
+
+		t_Map.clear();
+		ASSERT_EQ(s_HashmapCountedAlive, 0u) << "A value leaked on clear.";
+
+		//The destructor cleans up the chains as well.
+		for (size_t i = 0; i < samples; i++)
+			t_Map.emplace(i, i);
+	}
+	ASSERT_EQ(s_HashmapCountedAlive, 0u) << "A value leaked in the destructor.";
+}
+
+TEST(Hashmap_Datastructure, OL_Hashmap_Incremental_Resize)
+{
+	constexpr const size_t samples = 4096;
+
+	//32 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 32;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	//Start small so that the map needs to resize multiple times.
+	BB::OL_HashMap<size_t, size2593bytesObj> t_Map(t_Allocator, 16);
+	t_Map.set_incremental_resize(true);
+
+	bool t_HasResized = false;
+	size_t t_ResizeIterations = 0;
+	for (size_t i = 0; i < samples; i++)
+	{
+		size2593bytesObj t_Value{};
+		t_Value.value = i + 2;
+		t_Map.insert(i, t_Value);
+		t_HasResized |= t_Map.is_resizing();
+
+		//Iteration also visits the elements that are still in the old table.
+		if (t_Map.is_resizing() && t_ResizeIterations < 16)
+		{
+			++t_ResizeIterations;
+			size_t t_IteratedCount = 0;
+			for (auto& t_It : t_Map)
+			{
+				ASSERT_EQ(t_Map.find(*t_It.key)->value, t_It.value->value) << "Iterator found an pair that the hashmap couldn't find.";
+				++t_IteratedCount;
+			}
+			ASSERT_EQ(t_IteratedCount, t_Map.size()) << "Iterator did not visit every element during a resize.";
+		}
+
+		//The element needs to be findable while the old table is still being moved.
+		ASSERT_NE(t_Map.find(i), nullptr) << "Cannot find the element while it was added!";
+		ASSERT_EQ(t_Map.find(i)->value, t_Value.value) << "Wrong element was likely grabbed.";
+	}
+	EXPECT_TRUE(t_HasResized) << "The map never did an incremental resize, this might indicate an unaccurate test.";
+	EXPECT_GT(t_ResizeIterations, 0u);
+	ASSERT_EQ(t_Map.size(), samples);
+
+	//Copy while a resize might still be going on.
+	BB::OL_HashMap<size_t, size2593bytesObj> t_CopyMap(t_Map);
+
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_NE(t_Map.find(i), nullptr) << "Element got lost during an incremental resize.";
+		ASSERT_EQ(t_Map.find(i)->value, i + 2) << "Wrong element was likely grabbed.";
+		ASSERT_EQ(t_CopyMap.find(i)->value, i + 2) << "Wrong element was grabbed from the copy of the map.";
+	}
+
+	//Erase half of the elements.
+	for (size_t i = 0; i < samples; i += 2)
+	{
+		t_Map.erase(i);
+	}
+	ASSERT_EQ(t_Map.size(), samples / 2);
+
+	for (size_t i = 0; i < samples; i++)
+	{
+		if (i % 2 == 0)
+			ASSERT_EQ(t_Map.find(i), nullptr) << "Element was found while it should've been deleted.";
+		else
+			ASSERT_EQ(t_Map.find(i)->value, i + 2) << "Wrong element was likely grabbed.";
+	}
+
+	//Turning it off finishes the resize.
+	t_Map.set_incremental_resize(false);
+	EXPECT_FALSE(t_Map.is_resizing());
+}
+
+TEST(Hashmap_Datastructure, Hashmap_Prehashed_And_String_Lookup)
+{
+	constexpr const size_t samples = 512;
+
+	//8 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 8;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::UM_HashMap<char*, size_t, BB::String_KeyComp> t_UMMap(t_Allocator);
+	BB::OL_HashMap<char*, size_t, BB::String_KeyComp> t_OLMap(t_Allocator);
+
+	//All the keys live in one buffer, every key is followed by a suffix that is not part of the lookup.
+	char t_Keys[samples][32]{};
+	for (size_t i = 0; i < samples; i++)
+	{
+		snprintf(t_Keys[i], sizeof(t_Keys[i]), "key_%04zu", i);
+		const Hash t_Hash = Hash::MakeHash(t_Keys[i]);
+		ASSERT_EQ(t_Hash.hash, Hash::MakeHash(t_Keys[i], strlen(t_Keys[i])).hash) << "Sized string hash differs from the null terminated one.";
+
+		t_UMMap.emplace_hashed(t_Keys[i], t_Hash, i);
+		t_OLMap.emplace_hashed(t_Keys[i], t_Hash, i);
+	}
+	ASSERT_EQ(t_UMMap.size(), samples);
+	ASSERT_EQ(t_OLMap.size(), samples);
+
+	char t_View[64]{};
+	for (size_t i = 0; i < samples; i++)
+	{
+		const size_t t_Length = strlen(t_Keys[i]);
+		const Hash t_Hash = Hash::MakeHash(t_Keys[i]);
+
+		ASSERT_EQ(*t_UMMap.find_hashed(t_Keys[i], t_Hash), i);
+		ASSERT_EQ(*t_OLMap.find_hashed(t_Keys[i], t_Hash), i);
+		ASSERT_EQ(*t_UMMap.find(t_Keys[i]), i);
+		ASSERT_EQ(*t_OLMap.find(t_Keys[i]), i);
+
+		//Lookup with a string that is not null terminated after the key.
+		snprintf(t_View, sizeof(t_View), "%s_suffix", t_Keys[i]);
+		ASSERT_NE(t_UMMap.find(t_View, t_Length), nullptr) << "Cannot find the element with a string view.";
+		ASSERT_EQ(*t_UMMap.find(t_View, t_Length), i);
+		ASSERT_NE(t_OLMap.find(t_View, t_Length), nullptr) << "Cannot find the element with a string view.";
+		ASSERT_EQ(*t_OLMap.find(t_View, t_Length), i);
+
+		//A prefix of a key is not the key.
+		ASSERT_EQ(t_UMMap.find(t_View, t_Length - 1), nullptr) << "Found an element with a prefix of the key.";
+		ASSERT_EQ(t_OLMap.find(t_View, t_Length - 1), nullptr) << "Found an element with a prefix of the key.";
+		ASSERT_EQ(t_OLMap.find(t_View), nullptr) << "Found an element with a longer key.";
+	}
+
+	//Copies keep the stored hashes and key lengths.
+	BB::OL_HashMap<char*, size_t, BB::String_KeyComp> t_OLCopy(t_OLMap);
+	for (size_t i = 0; i < samples; i += 2)
+	{
+		t_UMMap.erase(t_Keys[i]);
+		t_OLMap.erase(t_Keys[i]);
+	}
+	for (size_t i = 0; i < samples; i++)
+	{
+		const size_t t_Length = strlen(t_Keys[i]);
+		ASSERT_NE(t_OLCopy.find(t_Keys[i], t_Length), nullptr) << "Copied map lost an element.";
+		if (i % 2 == 0)
+		{
+			ASSERT_EQ(t_UMMap.find(t_Keys[i], t_Length), nullptr) << "Element was found while it should've been deleted.";
+			ASSERT_EQ(t_OLMap.find(t_Keys[i], t_Length), nullptr) << "Element was found while it should've been deleted.";
+		}
+		else
+		{
+			ASSERT_EQ(*t_UMMap.find(t_Keys[i], t_Length), i);
+			ASSERT_EQ(*t_OLMap.find(t_Keys[i], t_Length), i);
+		}
+	}
+}
+
+TEST(Hashmap_Datastructure, Hashmap_Build_Find_Many)
+{
+	constexpr const size_t samples = 2048;
+
+	//8 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 8;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::UM_HashMap<size_t, size_t> t_UMMap(t_Allocator);
+	BB::OL_HashMap<size_t, size_t> t_OLMap(t_Allocator);
+
+	size_t t_Keys[samples]{};
+	size_t t_Values[samples]{};
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Keys[i] = i * 3 + 1;
+		t_Values[i] = i;
+	}
+
+	t_UMMap.build(t_Keys, t_Values, samples);
+	t_OLMap.build(t_Keys, t_Values, samples);
+	ASSERT_EQ(t_UMMap.size(), samples);
+	ASSERT_EQ(t_OLMap.size(), samples);
+
+	//Half the lookups exist, half do not.
+	size_t t_Lookups[samples]{};
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Lookups[i] = (i % 2 == 0) ? t_Keys[i] : t_Keys[i] + 1;
+	}
+
+	size_t* t_UMResults[samples]{};
+	size_t* t_OLResults[samples]{};
+	t_UMMap.find_many(t_Lookups, samples, t_UMResults);
+	t_OLMap.find_many(t_Lookups, samples, t_OLResults);
+	for (size_t i = 0; i < samples; i++)
+	{
+		if (i % 2 == 0)
+		{
+			ASSERT_NE(t_UMResults[i], nullptr) << "find_many did not find a key that was build.";
+			ASSERT_NE(t_OLResults[i], nullptr) << "find_many did not find a key that was build.";
+			ASSERT_EQ(*t_UMResults[i], i);
+			ASSERT_EQ(*t_OLResults[i], i);
+		}
+		else
+		{
+			ASSERT_EQ(t_UMResults[i], nullptr) << "find_many found a key that was never added.";
+			ASSERT_EQ(t_OLResults[i], nullptr) << "find_many found a key that was never added.";
+		}
+	}
+
+	//A normal insert after a build still works.
+	t_OLMap.insert(2, t_Values[5]);
+	ASSERT_EQ(*t_OLMap.find(2), 5);
 }
 
 #include <chrono>
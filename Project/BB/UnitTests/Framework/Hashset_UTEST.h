@@ -0,0 +1,81 @@
+#pragma once
+#include "../TestValues.h"
+#include "Storage/Hashset.h"
+
+TEST(Hashset_Datastructure, OL_Hashset_Insert_Erase_Copy)
+{
+	constexpr const size_t samples = 4096;
+
+	//8 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 8;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	//Start small so the set has to grow a couple of times.
+	BB::OL_HashSet<size_t> t_Set(t_Allocator, 16);
+
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_TRUE(t_Set.insert(i * 7)) << "Insert failed on a key that is not in the set.";
+		ASSERT_TRUE(t_Set.contains(i * 7)) << "Cannot find the key while it was added!";
+	}
+	ASSERT_FALSE(t_Set.insert(7)) << "Inserted a duplicate key.";
+	ASSERT_EQ(t_Set.size(), samples);
+
+	BB::OL_HashSet<size_t> t_Copy(t_Set);
+
+	for (size_t i = 0; i < samples; i += 2)
+	{
+		ASSERT_TRUE(t_Set.erase(i * 7));
+	}
+	ASSERT_FALSE(t_Set.erase(1)) << "Erased a key that was never added.";
+	ASSERT_EQ(t_Set.size(), samples / 2);
+
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_EQ(t_Set.contains(i * 7), i % 2 == 1);
+		ASSERT_TRUE(t_Copy.contains(i * 7)) << "Copied set lost a key.";
+	}
+
+	size_t t_IteratedCount = 0;
+	for (const size_t t_Key : t_Set)
+	{
+		ASSERT_TRUE(t_Set.contains(t_Key)) << "Iterator found a key that the set couldn't find.";
+		ASSERT_EQ(t_Key % 14, 7) << "Iterator found an erased key.";
+		++t_IteratedCount;
+	}
+	ASSERT_EQ(t_IteratedCount, t_Set.size());
+
+	t_Set.clear();
+	ASSERT_EQ(t_Set.size(), 0);
+	ASSERT_EQ(t_Set.begin(), t_Set.end()) << "Iterating over an empty set.";
+}
+
+TEST(Hashset_Datastructure, OL_Hashset_Build_Contains_Many)
+{
+	constexpr const size_t samples = 2048;
+
+	//8 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 8;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::OL_HashSet<char*, BB::String_KeyComp> t_Set(t_Allocator);
+
+	char t_Keys[samples][16]{};
+	char* t_KeyPtrs[samples]{};
+	for (size_t i = 0; i < samples; i++)
+	{
+		snprintf(t_Keys[i], sizeof(t_Keys[i]), "set_%zu", i);
+		t_KeyPtrs[i] = t_Keys[i];
+	}
+
+	//Only build with the first half.
+	t_Set.build(t_KeyPtrs, samples / 2);
+	ASSERT_EQ(t_Set.size(), samples / 2);
+
+	bool t_Results[samples]{};
+	t_Set.contains_many(t_KeyPtrs, samples, t_Results);
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_EQ(t_Results[i], i < samples / 2) << "contains_many gave the wrong result for key " << t_Keys[i];
+	}
+}
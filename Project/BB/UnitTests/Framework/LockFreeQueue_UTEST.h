@@ -0,0 +1,324 @@
+#pragma once
+#include "../TestValues.h"
+#include "Storage/LockFreeQueue.h"
+#include <thread>
+
+TEST(LockFreeQueueDataStructure, SPSCQueue_Single_Thread)
+{
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::SPSCQueue<std::string> t_Queue(t_Allocator, 12);
+	EXPECT_EQ(t_Queue.capacity(), 16);
+
+	//Go around the buffer a few times.
+	std::string t_Out;
+	for (size_t t_Lap = 0; t_Lap < 4; t_Lap++)
+	{
+		for (size_t i = 0; i < 16; i++)
+		{
+			ASSERT_TRUE(t_Queue.try_emplace(std::to_string(i) + " a string long enough to not fit in the small string buffer"));
+		}
+		EXPECT_FALSE(t_Queue.try_push("full"));
+		for (size_t i = 0; i < 11; i++)
+		{
+			ASSERT_TRUE(t_Queue.try_pop(t_Out));
+			ASSERT_EQ(t_Out, std::to_string(i) + " a string long enough to not fit in the small string buffer");
+		}
+		std::string t_Rest[16];
+		EXPECT_EQ(t_Queue.pop_many(t_Rest, 16), 5);
+		EXPECT_EQ(t_Rest[4], "15 a string long enough to not fit in the small string buffer");
+		EXPECT_FALSE(t_Queue.try_pop(t_Out));
+	}
+
+	const std::string t_Batch[20]{ "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12", "13", "14", "15", "16", "17", "18", "19" };
+	EXPECT_EQ(t_Queue.push_many(t_Batch, 20), 16);
+	EXPECT_EQ(t_Queue.size_approx(), 16);
+	//The destructor destroys the elements that are left.
+}
+
+constexpr const size_t QUEUE_TEST_SAMPLES = 1 << 16;
+
+//Pushes 0 to QUEUE_TEST_SAMPLES - 1, alternating single and batch pushes.
+static void SPSCProducer(BB::SPSCQueue<size_t>* a_Queue)
+{
+	size_t t_Batch[8];
+	size_t i = 0;
+	while (i < QUEUE_TEST_SAMPLES)
+	{
+		size_t t_Pushed;
+		if (i & 1)
+		{
+			t_Pushed = a_Queue->try_push(i) ? 1 : 0;
+		}
+		else
+		{
+			const size_t t_Left = QUEUE_TEST_SAMPLES - i;
+			const size_t t_Count = t_Left < 8 ? t_Left : 8;
+			for (size_t j = 0; j < t_Count; j++)
+				t_Batch[j] = i + j;
+			t_Pushed = a_Queue->push_many(t_Batch, t_Count);
+		}
+
+		//Give the consumer time when the queue is full, matters when both threads share a core.
+		if (t_Pushed == 0)
+			std::this_thread::yield();
+		i += t_Pushed;
+	}
+}
+
+TEST(LockFreeQueueDataStructure, SPSCQueue_Producer_Consumer)
+{
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	//Small so both threads hit full and empty often.
+	BB::SPSCQueue<size_t> t_Queue(t_Allocator, 64);
+	std::thread t_Producer(SPSCProducer, &t_Queue);
+
+	//Elements come out in order.
+	size_t t_Expected = 0;
+	size_t t_Batch[16];
+	while (t_Expected < QUEUE_TEST_SAMPLES)
+	{
+		const size_t t_Count = t_Queue.pop_many(t_Batch, 16);
+		if (t_Count == 0)
+			std::this_thread::yield();
+		for (size_t i = 0; i < t_Count; i++)
+		{
+			ASSERT_EQ(t_Batch[i], t_Expected);
+			++t_Expected;
+		}
+	}
+	t_Producer.join();
+	EXPECT_EQ(t_Queue.size_approx(), 0);
+}
+
+struct MPMCTestInfo
+{
+	BB::MPMCQueue<size_t>* queue;
+	size_t total;
+	std::atomic<size_t> sum{ 0 };
+	std::atomic<size_t> popped{ 0 };
+};
+
+//Pushes a_Begin to a_Begin + QUEUE_TEST_SAMPLES - 1, alternating single and batch pushes.
+static void MPMCProducer(MPMCTestInfo* a_Info, const size_t a_Begin)
+{
+	size_t t_Batch[4];
+	size_t i = 0;
+	while (i < QUEUE_TEST_SAMPLES)
+	{
+		size_t t_Pushed;
+		if (i & 1)
+		{
+			t_Pushed = a_Info->queue->try_push(a_Begin + i) ? 1 : 0;
+		}
+		else
+		{
+			const size_t t_Left = QUEUE_TEST_SAMPLES - i;
+			const size_t t_Count = t_Left < 4 ? t_Left : 4;
+			for (size_t j = 0; j < t_Count; j++)
+				t_Batch[j] = a_Begin + i + j;
+			t_Pushed = a_Info->queue->push_many(t_Batch, t_Count);
+		}
+
+		if (t_Pushed == 0)
+			std::this_thread::yield();
+		i += t_Pushed;
+	}
+}
+
+//Adds up everything it pops until all elements are popped.
+static void MPMCConsumer(MPMCTestInfo* a_Info)
+{
+	size_t t_LocalSum = 0;
+	size_t t_Batch[8];
+	while (a_Info->popped.load() < a_Info->total)
+	{
+		const size_t t_Count = a_Info->queue->pop_many(t_Batch, 8);
+		if (t_Count == 0)
+			std::this_thread::yield();
+		for (size_t j = 0; j < t_Count; j++)
+			t_LocalSum += t_Batch[j];
+		a_Info->popped += t_Count;
+	}
+	a_Info->sum += t_LocalSum;
+}
+
+TEST(LockFreeQueueDataStructure, MPMCQueue_Producers_Consumers)
+{
+	constexpr const size_t threadCount = 4;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::MPMCQueue<size_t> t_Queue(t_Allocator, 128);
+
+	//Single threaded first, full and empty are reported.
+	for (size_t i = 0; i < 128; i++)
+		ASSERT_TRUE(t_Queue.try_push(i));
+	EXPECT_FALSE(t_Queue.try_push(128));
+	size_t t_Single[128];
+	EXPECT_EQ(t_Queue.pop_many(t_Single, 200), 128);
+	EXPECT_EQ(t_Single[127], 127);
+	size_t t_Out;
+	EXPECT_FALSE(t_Queue.try_pop(t_Out));
+
+	//Every value is pushed once, the consumers add up what they pop.
+	MPMCTestInfo t_Info;
+	t_Info.queue = &t_Queue;
+	t_Info.total = threadCount * QUEUE_TEST_SAMPLES;
+
+	std::thread t_Producers[threadCount];
+	std::thread t_Consumers[threadCount];
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		t_Producers[i] = std::thread(MPMCProducer, &t_Info, i * QUEUE_TEST_SAMPLES);
+		t_Consumers[i] = std::thread(MPMCConsumer, &t_Info);
+	}
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		t_Producers[i].join();
+		t_Consumers[i].join();
+	}
+
+	EXPECT_EQ(t_Info.popped.load(), t_Info.total);
+	EXPECT_EQ(t_Info.sum.load(), t_Info.total * (t_Info.total - 1) / 2);
+	EXPECT_EQ(t_Queue.size_approx(), 0);
+}
+
+#include <chrono>
+#include <mutex>
+#include <queue>
+
+struct MutexQueue
+{
+	std::queue<size_t> queue;
+	std::mutex mutex;
+};
+
+template<typename Queue>
+static void SpeedtestProducer(Queue* a_Queue, const size_t a_Count)
+{
+	for (size_t i = 0; i < a_Count; i++)
+	{
+		while (!a_Queue->try_push(i))
+			std::this_thread::yield();
+	}
+}
+
+static void SpeedtestMutexProducer(MutexQueue* a_Queue, const size_t a_Count)
+{
+	for (size_t i = 0; i < a_Count; i++)
+	{
+		a_Queue->mutex.lock();
+		a_Queue->queue.push(i);
+		a_Queue->mutex.unlock();
+	}
+}
+
+//Sends every value it gets back on a_Pong.
+static void SpeedtestEcho(BB::SPSCQueue<size_t>* a_Ping, BB::SPSCQueue<size_t>* a_Pong, const size_t a_Count)
+{
+	size_t t_Value;
+	for (size_t i = 0; i < a_Count; i++)
+	{
+		while (!a_Ping->try_pop(t_Value))
+			std::this_thread::yield();
+		while (!a_Pong->try_push(t_Value))
+			std::this_thread::yield();
+	}
+}
+
+TEST(LockFreeQueueDataStructure, LockFreeQueue_Speedtest)
+{
+	typedef std::chrono::duration<float, std::milli> ms;
+	constexpr const float MILLITIMEDIVIDE = 1 / 1000.f;
+
+	constexpr const size_t samples = 1 << 18;
+	constexpr const size_t pingPongs = 1 << 12;
+	constexpr const size_t queueSize = 1024;
+
+	const size_t allocatorSize = BB::mbSize * 4;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	std::cout << "Lock free queue speed test, 1 producer and 1 consumer moving " << samples << " elements." << "\n";
+	{
+		MutexQueue t_Queue;
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		std::thread t_Producer(SpeedtestMutexProducer, &t_Queue, samples);
+		size_t t_Received = 0;
+		while (t_Received < samples)
+		{
+			t_Queue.mutex.lock();
+			while (!t_Queue.queue.empty())
+			{
+				t_Queue.queue.pop();
+				++t_Received;
+			}
+			t_Queue.mutex.unlock();
+		}
+		t_Producer.join();
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "std::queue with std::mutex throughput with time in MS " << t_Speed << "\n";
+	}
+	{
+		BB::SPSCQueue<size_t> t_Queue(t_Allocator, queueSize);
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		std::thread t_Producer(SpeedtestProducer<BB::SPSCQueue<size_t>>, &t_Queue, samples);
+		size_t t_Received = 0;
+		size_t t_Batch[64];
+		while (t_Received < samples)
+		{
+			const size_t t_Count = t_Queue.pop_many(t_Batch, 64);
+			if (t_Count == 0)
+				std::this_thread::yield();
+			t_Received += t_Count;
+		}
+		t_Producer.join();
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::SPSCQueue throughput with time in MS " << t_Speed << "\n";
+	}
+	{
+		BB::MPMCQueue<size_t> t_Queue(t_Allocator, queueSize);
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		std::thread t_Producer(SpeedtestProducer<BB::MPMCQueue<size_t>>, &t_Queue, samples);
+		size_t t_Received = 0;
+		size_t t_Batch[64];
+		while (t_Received < samples)
+		{
+			const size_t t_Count = t_Queue.pop_many(t_Batch, 64);
+			if (t_Count == 0)
+				std::this_thread::yield();
+			t_Received += t_Count;
+		}
+		t_Producer.join();
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::MPMCQueue throughput with time in MS " << t_Speed << "\n";
+	}
+
+	//Latency, a value goes to the other thread and comes back.
+	std::cout << "Lock free queue latency test, " << pingPongs << " round trips between 2 threads." << "\n";
+	{
+		BB::SPSCQueue<size_t> t_Ping(t_Allocator, 2);
+		BB::SPSCQueue<size_t> t_Pong(t_Allocator, 2);
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		std::thread t_Echo(SpeedtestEcho, &t_Ping, &t_Pong, pingPongs);
+		size_t t_Value;
+		for (size_t i = 0; i < pingPongs; i++)
+		{
+			while (!t_Ping.try_push(i))
+				std::this_thread::yield();
+			while (!t_Pong.try_pop(t_Value))
+				std::this_thread::yield();
+			EXPECT_EQ(t_Value, i);
+		}
+		t_Echo.join();
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::SPSCQueue round trips with time in MS " << t_Speed << "\n";
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "../TestValues.h"
+#include "Storage/PerfectHashmap.h"
+
+namespace PerfectHashmap_Test
+{
+	constexpr auto jsonFields = BB::MakePerfectHashMap<const char*, int>({
+		{ "name", 0 }, { "width", 1 }, { "height", 2 }, { "format", 3 },
+		{ "mipLevels", 4 }, { "arrayLayers", 5 }, { "samples", 6 }, { "usage", 7 },
+		{ "tiling", 8 }, { "sharingMode", 9 }, { "initialLayout", 10 }, { "flags", 11 } });
+
+	//The lookup can also be done by the compiler.
+	static_assert(*jsonFields.find_hashed("tiling", Hash::MakeHashConstexpr("tiling")) == 8, "constexpr PerfectHashMap lookup failed.");
+	static_assert(jsonFields.find_hashed("depth", Hash::MakeHashConstexpr("depth")) == nullptr, "constexpr PerfectHashMap found a key that does not exist.");
+
+	//A duplicate key is refused, a constexpr build of these entries does not compile.
+	constexpr BB::PerfectHashEntry<const char*, int> duplicateFields[] = { { "name", 0 }, { "width", 1 }, { "name", 2 } };
+	static_assert(!BB::PerfectHashMap<const char*, int, _countof(duplicateFields)>::UniqueKeys(duplicateFields), "PerfectHashMap accepted a duplicate key.");
+	static_assert(BB::PerfectHashMap<const char*, int, 2>::UniqueKeys({ { "name", 0 }, { "width", 1 } }), "PerfectHashMap refused unique keys.");
+}
+
+TEST(PerfectHashmap_Datastructure, PerfectHashmap_String_Keys)
+{
+	using namespace PerfectHashmap_Test;
+	const char* t_Keys[] = { "name", "width", "height", "format", "mipLevels", "arrayLayers",
+		"samples", "usage", "tiling", "sharingMode", "initialLayout", "flags" };
+
+	ASSERT_EQ(jsonFields.size(), _countof(t_Keys));
+	for (size_t i = 0; i < _countof(t_Keys); i++)
+	{
+		ASSERT_NE(jsonFields.find(t_Keys[i]), nullptr) << "Cannot find key " << t_Keys[i];
+		ASSERT_EQ(*jsonFields.find(t_Keys[i]), static_cast<int>(i)) << "Wrong element was likely grabbed.";
+	}
+
+	ASSERT_EQ(jsonFields.find("depth"), nullptr) << "Found a key that does not exist.";
+	ASSERT_EQ(jsonFields.find(""), nullptr) << "Found the empty key.";
+	ASSERT_EQ(jsonFields.find("widt"), nullptr) << "Found a prefix of a key.";
+
+	//Lookup with a string that is not null terminated, like a token inside a json file.
+	const char* t_Json = "\"mipLevels\": 4";
+	ASSERT_NE(jsonFields.find(t_Json + 1, 9), nullptr) << "Cannot find the key with a string view.";
+	ASSERT_EQ(*jsonFields.find(t_Json + 1, 9), 4);
+	ASSERT_EQ(jsonFields.find(t_Json + 1, 8), nullptr) << "Found a prefix of a key with a string view.";
+}
+
+TEST(PerfectHashmap_Datastructure, PerfectHashmap_Integer_Keys)
+{
+	constexpr const size_t samples = 1024;
+
+	//The builder also works at runtime, this is a lot of keys for a constexpr build.
+	static BB::PerfectHashEntry<uint32_t, size_t> t_Entries[samples]{};
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Entries[i].key = static_cast<uint32_t>(i * 2654435761u);
+		t_Entries[i].value = i;
+	}
+
+	static const BB::PerfectHashMap<uint32_t, size_t, samples> t_Map(t_Entries);
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_NE(t_Map.find(t_Entries[i].key), nullptr) << "Cannot find a key.";
+		ASSERT_EQ(*t_Map.find(t_Entries[i].key), i) << "Wrong element was likely grabbed.";
+	}
+
+	size_t t_FalseHits = 0;
+	for (uint32_t i = 0; i < samples; i++)
+	{
+		if (t_Map.find(i * 2654435761u + 1) != nullptr)
+			++t_FalseHits;
+	}
+	ASSERT_EQ(t_FalseHits, 0) << "Found keys that were never added.";
+
+	constexpr auto t_Small = BB::MakePerfectHashMap<int, int>({ { 7, 70 }, { -3, 30 }, { 1000, 1 } });
+	static_assert(*t_Small.find_hashed(-3, Hash::MakeHashConstexpr(static_cast<uint64_t>(-3))) == 30, "constexpr integer lookup failed.");
+	ASSERT_EQ(*t_Small.find(7), 70);
+	ASSERT_EQ(*t_Small.find(-3), 30);
+	ASSERT_EQ(*t_Small.find(1000), 1);
+	ASSERT_EQ(t_Small.find(8), nullptr);
+}
@@ -2,6 +2,9 @@
 #include "../TestValues.h"
 #include "Storage/Pool.h"
 #include "Storage/GrowPool.h"
+#include "Storage/ConcurrentPool.h"
+#include <thread>
+#include <vector>
 
 TEST(PoolDataStructure, Pool_Create_Get_Free)
 {
@@ -119,4 +122,325 @@ TEST(GrowPoolDataStructure, GrowPool_Create_Get_Free)
 	EXPECT_NE(t_Pool.Get(), nullptr);
 
 	t_Pool.DestroyPool();
-}
\ No newline at end of file
+}
+
+TEST(PoolDataStructure, Pool_GetMany_FreeMany)
+{
+	constexpr const size_t samples = 256;
+	struct PoolObj { size_t value; size_t pad; };
+
+	//2 MB alloactor.
+	BB::FreelistAllocator_t t_Allocator(1024 * 1024 * 2);
+
+	BB::Pool<PoolObj> t_Pool;
+	t_Pool.CreatePool(t_Allocator, samples);
+
+	//Untouched slots come out in memory order.
+	PoolObj* t_Array[samples]{};
+	ASSERT_EQ(t_Pool.GetMany(t_Array, samples / 2), samples / 2);
+	for (size_t i = 0; i < samples / 2; i++)
+	{
+		EXPECT_EQ(t_Array[i], t_Pool.data() + i);
+		t_Array[i]->value = i;
+	}
+
+	//Return a quarter, the next GetMany first takes those and then bumps.
+	t_Pool.FreeMany(t_Array, samples / 4);
+	ASSERT_EQ(t_Pool.GetMany(t_Array, samples / 2), samples / 2);
+	for (size_t i = 0; i < samples / 2; i++)
+	{
+		if (i < samples / 4)
+		{
+			EXPECT_LT(t_Array[i], t_Pool.data() + samples / 4);
+		}
+		else
+		{
+			EXPECT_EQ(t_Array[i], t_Pool.data() + samples / 2 + (i - samples / 4));
+		}
+	}
+
+	//Only a quarter is left.
+	PoolObj* t_Rest[samples]{};
+	EXPECT_EQ(t_Pool.GetMany(t_Rest, samples), samples / 4);
+	EXPECT_EQ(t_Pool.Get(), nullptr);
+
+	t_Pool.FreeMany(t_Rest, samples / 4);
+	t_Pool.Free(t_Array[0]);
+	EXPECT_EQ(t_Pool.Get(), t_Array[0]);
+	EXPECT_EQ(t_Pool.GetMany(t_Rest, samples), samples / 4);
+
+	t_Pool.DestroyPool(t_Allocator);
+}
+
+TEST(GrowPoolDataStructure, GrowPool_GetMany_FreeMany)
+{
+	constexpr const size_t samples = 1 << 14;
+	struct PoolObj { size_t value; size_t pad[7]; };
+
+	//Starts small, GetMany has to grow a few times.
+	BB::GrowPool<PoolObj> t_Pool;
+	t_Pool.CreatePool(16);
+
+	PoolObj** t_Array = new PoolObj*[samples];
+	t_Pool.GetMany(t_Array, samples);
+	for (size_t i = 0; i < samples; i++)
+	{
+		//No free list yet, so every object is the next one in memory.
+		if (i != 0)
+			ASSERT_EQ(t_Array[i], t_Array[i - 1] + 1);
+		t_Array[i]->value = i;
+	}
+
+	t_Pool.FreeMany(t_Array, samples / 2);
+	PoolObj* t_Get = t_Pool.Get();
+	EXPECT_EQ(t_Get, t_Array[0]);
+	t_Pool.Free(t_Get);
+
+	t_Pool.GetMany(t_Array, samples);
+	for (size_t i = 0; i < samples; i++)
+		t_Array[i]->value = i;
+	for (size_t i = 0; i < samples; i++)
+		ASSERT_EQ(t_Array[i]->value, i);
+
+	delete[] t_Array;
+	t_Pool.DestroyPool();
+}
+
+template<typename Pool>
+static void PoolIterateCompactTest(Pool& a_Pool, const size_t a_Samples)
+{
+	std::vector<size_t*> t_Objects(a_Samples);
+	for (size_t i = 0; i < a_Samples; i++)
+	{
+		t_Objects[i] = reinterpret_cast<size_t*>(a_Pool.Get());
+		*t_Objects[i] = i;
+	}
+
+	//Free every object that is not a multiple of 3, iteration only sees the live ones in address order.
+	for (size_t i = 0; i < a_Samples; i++)
+	{
+		if (i % 3 != 0)
+			a_Pool.Free(reinterpret_cast<decltype(a_Pool.Get())>(t_Objects[i]));
+	}
+	size_t t_Expected = 0;
+	for (auto& t_Object : a_Pool)
+	{
+		ASSERT_EQ(*reinterpret_cast<size_t*>(&t_Object), t_Expected);
+		t_Expected += 3;
+	}
+	ASSERT_EQ(t_Expected, ((a_Samples - 1) / 3 + 1) * 3);
+
+	//Compact in small steps, every relocation moves a live object down.
+	std::vector<BB::PoolRelocation<std::remove_pointer_t<decltype(a_Pool.Get())>>> t_Relocations(a_Samples);
+	size_t t_TotalMoved = 0;
+	while (true)
+	{
+		const size_t t_Moved = a_Pool.Compact(t_Relocations.data(), 8);
+		for (size_t i = 0; i < t_Moved; i++)
+		{
+			EXPECT_LT(t_Relocations[i].to, t_Relocations[i].from);
+			EXPECT_TRUE(a_Pool.IsLive(t_Relocations[i].to));
+			EXPECT_FALSE(a_Pool.IsLive(t_Relocations[i].from));
+			const size_t t_Value = *reinterpret_cast<size_t*>(t_Relocations[i].to);
+			t_Objects[t_Value] = reinterpret_cast<size_t*>(t_Relocations[i].to);
+		}
+		t_TotalMoved += t_Moved;
+		if (t_Moved == 0)
+			break;
+	}
+	EXPECT_NE(t_TotalMoved, 0);
+
+	//All live objects are now packed at the start.
+	const size_t t_LiveCount = (a_Samples - 1) / 3 + 1;
+	size_t t_Count = 0;
+	for (auto& t_Object : a_Pool)
+	{
+		ASSERT_EQ(&t_Object, a_Pool.data() + t_Count);
+		ASSERT_EQ(t_Objects[*reinterpret_cast<size_t*>(&t_Object)], reinterpret_cast<size_t*>(&t_Object));
+		++t_Count;
+	}
+	ASSERT_EQ(t_Count, t_LiveCount);
+
+	//New objects fill up right after the packed ones.
+	auto t_New = a_Pool.Get();
+	EXPECT_EQ(t_New, a_Pool.data() + t_LiveCount);
+	a_Pool.Free(t_New);
+	for (size_t i = 0; i < a_Samples; i += 3)
+		a_Pool.Free(reinterpret_cast<decltype(a_Pool.Get())>(t_Objects[i]));
+	EXPECT_TRUE(a_Pool.begin() == a_Pool.end());
+}
+
+TEST(PoolDataStructure, Pool_Iterate_Compact)
+{
+	constexpr const size_t samples = 300;
+	struct PoolObj { size_t value; size_t pad; };
+
+	//2 MB alloactor.
+	BB::FreelistAllocator_t t_Allocator(1024 * 1024 * 2);
+
+	BB::Pool<PoolObj> t_Pool;
+	t_Pool.CreatePool(t_Allocator, samples);
+	PoolIterateCompactTest(t_Pool, samples);
+	t_Pool.DestroyPool(t_Allocator);
+}
+
+TEST(GrowPoolDataStructure, GrowPool_Iterate_Compact)
+{
+	constexpr const size_t samples = 10000;
+	struct PoolObj { size_t value; size_t pad[3]; };
+
+	BB::GrowPool<PoolObj> t_Pool;
+	t_Pool.CreatePool(16);
+	PoolIterateCompactTest(t_Pool, samples);
+	t_Pool.DestroyPool();
+}
+
+struct ConcurrentPoolTestObj
+{
+	size_t owner;
+	size_t value;
+};
+
+constexpr const size_t CONCURRENT_POOL_ITERATIONS = 2000;
+constexpr const size_t CONCURRENT_POOL_HELD = 16;
+
+//Every thread takes a few objects, writes its own id in them and checks that no other thread got the same object.
+template<typename Pool>
+static void ConcurrentPoolWorker(Pool* a_Pool, const size_t a_Owner, bool* a_Failed)
+{
+	ConcurrentPoolTestObj* t_Held[CONCURRENT_POOL_HELD];
+	for (size_t t_Iteration = 0; t_Iteration < CONCURRENT_POOL_ITERATIONS; t_Iteration++)
+	{
+		for (size_t i = 0; i < CONCURRENT_POOL_HELD; i++)
+		{
+			t_Held[i] = a_Pool->Get();
+			if (t_Held[i] == nullptr)
+			{
+				*a_Failed = true;
+				return;
+			}
+			t_Held[i]->owner = a_Owner;
+			t_Held[i]->value = t_Iteration * CONCURRENT_POOL_HELD + i;
+		}
+		std::this_thread::yield();
+		for (size_t i = 0; i < CONCURRENT_POOL_HELD; i++)
+		{
+			if (t_Held[i]->owner != a_Owner || t_Held[i]->value != t_Iteration * CONCURRENT_POOL_HELD + i)
+				*a_Failed = true;
+			a_Pool->Free(t_Held[i]);
+		}
+	}
+}
+
+TEST(PoolDataStructure, ConcurrentPool_Threads_Get_Free)
+{
+	constexpr const size_t threadCount = 4;
+	constexpr const size_t samples = threadCount * CONCURRENT_POOL_HELD;
+
+	//2 MB alloactor.
+	BB::FreelistAllocator_t t_Allocator(1024 * 1024 * 2);
+
+	BB::ConcurrentPool<ConcurrentPoolTestObj> t_Pool;
+	t_Pool.CreatePool(t_Allocator, samples);
+
+	//Single threaded it works like Pool.
+	ConcurrentPoolTestObj* t_Array[samples]{};
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Array[i] = t_Pool.Get();
+		ASSERT_NE(t_Array[i], nullptr);
+		t_Array[i]->value = i;
+	}
+	EXPECT_EQ(t_Pool.Get(), nullptr);
+	for (size_t i = 0; i < samples; i++)
+	{
+		EXPECT_EQ(t_Array[i]->value, i);
+		t_Pool.Free(t_Array[i]);
+	}
+
+	//The pool is exactly big enough for all threads, a lost or double object shows up as a nullptr or a wrong owner.
+	bool t_Failed[threadCount]{};
+	std::thread t_Threads[threadCount];
+	for (size_t i = 0; i < threadCount; i++)
+		t_Threads[i] = std::thread(ConcurrentPoolWorker<BB::ConcurrentPool<ConcurrentPoolTestObj>>, &t_Pool, i, &t_Failed[i]);
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		t_Threads[i].join();
+		EXPECT_FALSE(t_Failed[i]);
+	}
+
+	for (size_t i = 0; i < samples; i++)
+		ASSERT_NE(t_Pool.Get(), nullptr);
+	EXPECT_EQ(t_Pool.Get(), nullptr);
+
+	t_Pool.DestroyPool(t_Allocator);
+}
+
+TEST(PoolDataStructure, ConcurrentPool_Odd_Sized_Objects)
+{
+	//3 bytes per object, the free list links behind them must still be aligned.
+	struct OddObj
+	{
+		char value[3];
+	};
+	constexpr const size_t samples = 10;
+
+	BB::FreelistAllocator_t t_Allocator(BB::kbSize * 4);
+
+	BB::ConcurrentPool<OddObj> t_Pool;
+	t_Pool.CreatePool(t_Allocator, samples);
+
+	OddObj* t_Array[samples]{};
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Array[i] = t_Pool.Get();
+		ASSERT_NE(t_Array[i], nullptr);
+		memset(t_Array[i]->value, static_cast<int>(i), sizeof(t_Array[i]->value));
+	}
+	EXPECT_EQ(t_Pool.Get(), nullptr);
+	for (size_t i = 0; i < samples; i++)
+	{
+		EXPECT_EQ(t_Array[i]->value[2], static_cast<char>(i));
+		t_Pool.Free(t_Array[i]);
+	}
+	for (size_t i = 0; i < samples; i++)
+		ASSERT_NE(t_Pool.Get(), nullptr);
+
+	t_Pool.DestroyPool(t_Allocator);
+}
+
+TEST(GrowPoolDataStructure, ConcurrentGrowPool_Threads_Get_Free)
+{
+	constexpr const size_t threadCount = 4;
+
+	//Start small so the threads have to grow the pool together.
+	BB::ConcurrentGrowPool<ConcurrentPoolTestObj> t_Pool;
+	t_Pool.CreatePool(4);
+
+	bool t_Failed[threadCount]{};
+	std::thread t_Threads[threadCount];
+	for (size_t i = 0; i < threadCount; i++)
+		t_Threads[i] = std::thread(ConcurrentPoolWorker<BB::ConcurrentGrowPool<ConcurrentPoolTestObj>>, &t_Pool, i, &t_Failed[i]);
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		t_Threads[i].join();
+		EXPECT_FALSE(t_Failed[i]);
+	}
+
+	//Grow a lot from a single thread, every object is unique.
+	constexpr const size_t samples = 1 << 14;
+	ConcurrentPoolTestObj** t_Array = new ConcurrentPoolTestObj*[samples];
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Array[i] = t_Pool.Get();
+		t_Array[i]->value = i;
+	}
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_EQ(t_Array[i]->value, i);
+		t_Pool.Free(t_Array[i]);
+	}
+	delete[] t_Array;
+
+	t_Pool.DestroyPool();
+}
@@ -0,0 +1,176 @@
+#pragma once
+#include "../TestValues.h"
+#include "Storage/RingBuffer.h"
+#include <deque>
+
+TEST(RingBufferDataStructure, RingBuffer_Push_Pop_Both_Ends)
+{
+	constexpr const size_t samples = 1000;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	//Capacity is rounded up to a power of 2.
+	BB::RingBuffer<size_t> t_Ring(t_Allocator, 20);
+	EXPECT_EQ(t_Ring.capacity(), 32);
+
+	//Random pushes and pops from both ends, checked against std::deque.
+	std::deque<size_t> t_Reference;
+	for (size_t i = 0; i < samples; i++)
+	{
+		switch (BB::Random::Random() % 5)
+		{
+		case 0:
+			t_Ring.push_front(i);
+			t_Reference.push_front(i);
+			break;
+		case 1:
+			if (!t_Reference.empty())
+			{
+				ASSERT_EQ(t_Ring.front(), t_Reference.front());
+				t_Ring.pop_front();
+				t_Reference.pop_front();
+			}
+			break;
+		case 2:
+			if (!t_Reference.empty())
+			{
+				ASSERT_EQ(t_Ring.back(), t_Reference.back());
+				t_Ring.pop_back();
+				t_Reference.pop_back();
+			}
+			break;
+		default:
+			t_Ring.push_back(i);
+			t_Reference.push_back(i);
+			break;
+		}
+		ASSERT_EQ(t_Ring.size(), t_Reference.size());
+	}
+	EXPECT_EQ(t_Ring.capacity() & (t_Ring.capacity() - 1), 0) << "RingBuffer capacity is not a power of 2 after growing.";
+	for (size_t i = 0; i < t_Reference.size(); i++)
+	{
+		ASSERT_EQ(t_Ring[i], t_Reference[i]);
+	}
+
+	//Objects get constructed and destructed while wrapping around.
+	BB::RingBuffer<std::string> t_Strings(t_Allocator, 4);
+	for (size_t i = 0; i < 3; i++)
+		t_Strings.emplace_back(std::to_string(i) + " a string long enough to not fit in the small string buffer");
+	t_Strings.pop_front();
+	t_Strings.pop_front();
+	for (size_t i = 3; i < 10; i++)
+		t_Strings.emplace_back(std::to_string(i) + " a string long enough to not fit in the small string buffer");
+	ASSERT_EQ(t_Strings.size(), 8);
+	EXPECT_EQ(t_Strings.front(), "2 a string long enough to not fit in the small string buffer");
+	EXPECT_EQ(t_Strings.back(), "9 a string long enough to not fit in the small string buffer");
+
+	BB::RingBuffer<std::string> t_Copy(t_Strings);
+	BB::RingBuffer<std::string> t_Moved(std::move(t_Strings));
+	EXPECT_EQ(t_Strings.size(), 0);
+	for (size_t i = 0; i < t_Copy.size(); i++)
+	{
+		ASSERT_EQ(t_Copy[i], t_Moved[i]);
+	}
+	t_Strings.emplace_back("usable after a move");
+	EXPECT_EQ(t_Strings.size(), 1);
+}
+
+TEST(RingBufferDataStructure, RingBuffer_Bulk_Spans_No_Growth)
+{
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::RingBuffer<uint32_t> t_Ring(t_Allocator, 16, false);
+	for (uint32_t i = 0; i < 16; i++)
+	{
+		EXPECT_TRUE(t_Ring.try_push_back(i));
+	}
+	EXPECT_TRUE(t_Ring.full());
+	EXPECT_FALSE(t_Ring.try_push_back(16));
+	EXPECT_EQ(t_Ring.capacity(), 16);
+
+	//Move the front to the middle so the next writes wrap around.
+	t_Ring.pop_front(10);
+	const uint32_t t_Values[12]{ 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111 };
+	t_Ring.push_back(t_Values, 10);
+	ASSERT_EQ(t_Ring.size(), 16);
+	EXPECT_EQ(t_Ring[5], 15);
+	EXPECT_EQ(t_Ring[6], 100);
+	EXPECT_EQ(t_Ring.back(), 109);
+
+	//The elements are split in 2 contiguous parts.
+	BB::Slice<uint32_t> t_Read = t_Ring.read_span();
+	ASSERT_EQ(t_Read.size(), 6);
+	EXPECT_EQ(t_Read[0], 10);
+
+	uint32_t t_Out[16]{};
+	EXPECT_EQ(t_Ring.pop_front(t_Out, 8), 8);
+	EXPECT_EQ(t_Out[5], 15);
+	EXPECT_EQ(t_Out[7], 101);
+	EXPECT_EQ(t_Ring.size(), 8);
+
+	//Write straight into the buffer.
+	BB::Slice<uint32_t> t_Write = t_Ring.write_span();
+	ASSERT_NE(t_Write.size(), 0);
+	for (size_t i = 0; i < t_Write.size(); i++)
+		t_Write[i] = 200 + static_cast<uint32_t>(i);
+	t_Ring.commit_write(t_Write.size());
+	EXPECT_EQ(t_Ring[8], 200);
+
+	const size_t t_Remaining = t_Ring.size();
+	EXPECT_EQ(t_Ring.pop_front(t_Out, 16), t_Remaining);
+	EXPECT_TRUE(t_Ring.empty());
+	EXPECT_EQ(t_Out[0], 102);
+	EXPECT_EQ(t_Out[8], 200);
+}
+
+#include <chrono>
+
+TEST(RingBufferDataStructure, RingBuffer_Speedtest)
+{
+	typedef std::chrono::duration<float, std::milli> ms;
+	constexpr const float MILLITIMEDIVIDE = 1 / 1000.f;
+
+	constexpr const size_t samples = 1 << 20;
+	constexpr const size_t queueSize = 64;
+
+	const size_t allocatorSize = BB::mbSize * 4;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	size_t t_Result = 0;
+	std::cout << "RingBuffer speed test, pushing and popping " << samples << " elements through a queue of " << queueSize << "." << "\n";
+	{
+		std::deque<size_t> t_Deque;
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < samples; i++)
+		{
+			t_Deque.push_back(i);
+			if (t_Deque.size() == queueSize)
+			{
+				t_Result += t_Deque.front();
+				t_Deque.pop_front();
+			}
+		}
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "std::deque speed with time in MS " << t_Speed << "\n";
+	}
+	{
+		BB::RingBuffer<size_t> t_Ring(t_Allocator, queueSize, false);
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < samples; i++)
+		{
+			t_Ring.push_back(i);
+			if (t_Ring.full())
+			{
+				t_Result -= t_Ring.front();
+				t_Ring.pop_front();
+			}
+		}
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::RingBuffer speed with time in MS " << t_Speed << "\n";
+	}
+	EXPECT_EQ(t_Result, 0);
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include "../TestValues.h"
 #include "Storage/Slotmap.h"
+#include "Storage/ConcurrentSlotmap.h"
+#include <thread>
 
 TEST(Slotmap_Datastructure, Slotmap_Insert_Remove)
 {
@@ -208,4 +210,129 @@ TEST(Slotmap_Datastructure, Slotmap_Reserve_Grow)
 		ASSERT_EQ(t_It->value, t_RandomKeys[t_Count++].value) << "Wrong element was likely grabbed after a grow event.";
 	}
 	ASSERT_EQ(samples, t_Count) << "Iterator went over the sample after a grow event amount.";
-}
\ No newline at end of file
+}
+
+TEST(Slotmap_Datastructure, ConcurrentSlotmap_Sync)
+{
+	constexpr const uint32_t samples = 128;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::ConcurrentSlotmap<std::string> t_Map(t_Allocator, samples);
+	BB::SlotmapHandle t_Handles[samples];
+	for (uint32_t i = 0; i < samples; i++)
+		t_Handles[i] = t_Map.emplace(std::to_string(i));
+
+	//Staged objects are not visible until the sync.
+	EXPECT_EQ(t_Map.size(), 0);
+	EXPECT_FALSE(t_Map.contains(t_Handles[0]));
+	t_Map.sync();
+	ASSERT_EQ(t_Map.size(), samples);
+	for (uint32_t i = 0; i < samples; i++)
+		ASSERT_EQ(t_Map.find(t_Handles[i]), std::to_string(i));
+
+	for (uint32_t i = 0; i < samples; i += 2)
+		t_Map.erase(t_Handles[i]);
+	//Erases are applied at the sync, the objects are still there.
+	EXPECT_EQ(t_Map.size(), samples);
+	EXPECT_TRUE(t_Map.contains(t_Handles[0]));
+	t_Map.sync();
+	ASSERT_EQ(t_Map.size(), samples / 2);
+	for (uint32_t i = 0; i < samples; i++)
+	{
+		if (i % 2 == 0)
+		{
+			ASSERT_FALSE(t_Map.contains(t_Handles[i]));
+		}
+		else
+		{
+			ASSERT_EQ(t_Map.find(t_Handles[i]), std::to_string(i));
+		}
+	}
+
+	//The erased ids are reused with a new generation.
+	const BB::SlotmapHandle t_Reused = t_Map.insert("reused");
+	t_Map.sync();
+	EXPECT_EQ(t_Reused.index % 2, 0);
+	EXPECT_NE(t_Reused.generation, 1);
+	EXPECT_EQ(t_Map[t_Reused], "reused");
+
+	//Grow between phases, the old handles stay valid.
+	t_Map.reserve(samples * 2);
+	for (uint32_t i = 0; i < samples + samples / 2 - 1; i++)
+		t_Map.emplace("new");
+	t_Map.sync();
+	ASSERT_EQ(t_Map.size(), samples * 2);
+	for (uint32_t i = 1; i < samples; i += 2)
+		ASSERT_EQ(t_Map.find(t_Handles[i]), std::to_string(i));
+
+	t_Map.clear();
+	EXPECT_EQ(t_Map.size(), 0);
+	EXPECT_FALSE(t_Map.contains(t_Reused));
+}
+
+constexpr const uint32_t CONCURRENT_SLOTMAP_PER_THREAD = 512;
+
+static void ConcurrentSlotmapSpawner(BB::ConcurrentSlotmap<uint64_t>* a_Map, BB::SlotmapHandle* a_Handles, const uint32_t a_Begin)
+{
+	for (uint32_t i = 0; i < CONCURRENT_SLOTMAP_PER_THREAD; i++)
+	{
+		a_Handles[a_Begin + i] = a_Map->emplace(static_cast<uint64_t>(a_Begin + i));
+		if ((i & 31) == 0)
+			std::this_thread::yield();
+	}
+}
+
+static void ConcurrentSlotmapDespawner(BB::ConcurrentSlotmap<uint64_t>* a_Map, const BB::SlotmapHandle* a_Handles, const uint32_t a_Begin)
+{
+	for (uint32_t i = 0; i < CONCURRENT_SLOTMAP_PER_THREAD; i += 2)
+	{
+		a_Map->erase(a_Handles[a_Begin + i]);
+		if ((i & 31) == 0)
+			std::this_thread::yield();
+	}
+}
+
+TEST(Slotmap_Datastructure, ConcurrentSlotmap_Parallel_Spawn_Despawn)
+{
+	constexpr const uint32_t threadCount = 4;
+	constexpr const uint32_t samples = threadCount * CONCURRENT_SLOTMAP_PER_THREAD;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::ConcurrentSlotmap<uint64_t> t_Map(t_Allocator, samples);
+	BB::SlotmapHandle t_Handles[samples];
+
+	std::thread t_Threads[threadCount];
+	for (uint32_t i = 0; i < threadCount; i++)
+		t_Threads[i] = std::thread(ConcurrentSlotmapSpawner, &t_Map, t_Handles, i * CONCURRENT_SLOTMAP_PER_THREAD);
+	for (uint32_t i = 0; i < threadCount; i++)
+		t_Threads[i].join();
+	t_Map.sync();
+
+	ASSERT_EQ(t_Map.size(), samples);
+	for (uint32_t i = 0; i < samples; i++)
+		ASSERT_EQ(t_Map.find(t_Handles[i]), i);
+
+	//Every thread despawns every other object it spawned.
+	for (uint32_t i = 0; i < threadCount; i++)
+		t_Threads[i] = std::thread(ConcurrentSlotmapDespawner, &t_Map, t_Handles, i * CONCURRENT_SLOTMAP_PER_THREAD);
+	for (uint32_t i = 0; i < threadCount; i++)
+		t_Threads[i].join();
+	t_Map.sync();
+
+	ASSERT_EQ(t_Map.size(), samples / 2);
+	uint64_t t_Sum = 0;
+	for (uint64_t t_Value : t_Map)
+	{
+		ASSERT_EQ(t_Value % 2, 1);
+		t_Sum += t_Value;
+	}
+	EXPECT_EQ(t_Sum, static_cast<uint64_t>(samples / 2) * (samples / 2));
+	for (uint32_t i = 0; i < samples; i++)
+		ASSERT_EQ(t_Map.contains(t_Handles[i]), i % 2 == 1);
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include "../TestValues.h"
+#include "Storage/SmallArray.h"
+#include "Utils/Slice.h"
+
+TEST(SmallArrayDataStructure, SmallArray_Inline_Then_Spill)
+{
+	constexpr const size_t inlineCount = 16;
+	constexpr const size_t samples = inlineCount * 8;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::SmallArray<size_t, inlineCount> t_Array(t_Allocator);
+	EXPECT_EQ(t_Array.capacity(), inlineCount);
+	EXPECT_TRUE(t_Array.is_inline());
+
+	for (size_t i = 0; i < inlineCount; i++)
+	{
+		t_Array.emplace_back(i * 3);
+	}
+	EXPECT_TRUE(t_Array.is_inline()) << "SmallArray spilled to the allocator before going over N elements.";
+	EXPECT_EQ(t_Array.capacity(), inlineCount);
+
+	for (size_t i = inlineCount; i < samples; i++)
+	{
+		size_t t_Value = i * 3;
+		t_Array.push_back(t_Value);
+	}
+	EXPECT_FALSE(t_Array.is_inline()) << "SmallArray did not spill to the allocator after going over N elements.";
+	ASSERT_EQ(t_Array.size(), samples);
+
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_EQ(t_Array[i], i * 3) << "Value got lost when spilling to the allocator.";
+	}
+
+	//Bulk push appends after the current elements.
+	const size_t t_Extra[4] = { 1, 2, 3, 4 };
+	t_Array.push_back(t_Extra, 4);
+	ASSERT_EQ(t_Array.size(), samples + 4);
+	for (size_t i = 0; i < 4; i++)
+	{
+		ASSERT_EQ(t_Array[samples + i], t_Extra[i]);
+	}
+
+	size_t t_Count = 0;
+	for (size_t& t_Value : t_Array)
+	{
+		ASSERT_EQ(t_Value, t_Array[t_Count]);
+		++t_Count;
+	}
+	ASSERT_EQ(t_Count, t_Array.size()) << "Iterator did not visit every element.";
+}
+
+TEST(SmallArrayDataStructure, SmallArray_Insert_Copy_Move)
+{
+	constexpr const size_t inlineCount = 4;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::SmallArray<size2593bytesObj, inlineCount> t_Array(t_Allocator);
+	t_Array.emplace_back(1);
+	t_Array.emplace_back(3);
+	t_Array.insert(1, size2593bytesObj(2));
+	t_Array.emplace(0, 0);
+	ASSERT_EQ(t_Array.size(), 4);
+	ASSERT_TRUE(t_Array.is_inline());
+	for (size_t i = 0; i < t_Array.size(); i++)
+	{
+		ASSERT_EQ(t_Array[i].value, i) << "insert put the element in the wrong place.";
+	}
+
+	//Copy and move while inline.
+	BB::SmallArray<size2593bytesObj, inlineCount> t_InlineCopy(t_Array);
+	ASSERT_TRUE(t_InlineCopy.is_inline());
+	BB::SmallArray<size2593bytesObj, inlineCount> t_InlineMove(std::move(t_InlineCopy));
+	ASSERT_TRUE(t_InlineMove.is_inline());
+	ASSERT_EQ(t_InlineCopy.size(), 0);
+	for (size_t i = 0; i < t_InlineMove.size(); i++)
+	{
+		ASSERT_EQ(t_InlineMove[i].value, i) << "Moving an inline SmallArray lost an element.";
+	}
+
+	//Copy and move after spilling.
+	for (size_t i = 4; i < 32; i++)
+	{
+		t_Array.emplace_back(i);
+	}
+	ASSERT_FALSE(t_Array.is_inline());
+
+	BB::SmallArray<size2593bytesObj, inlineCount> t_HeapCopy(t_Allocator);
+	t_HeapCopy = t_Array;
+	const size2593bytesObj* t_HeapData = t_HeapCopy.data();
+	BB::SmallArray<size2593bytesObj, inlineCount> t_HeapMove(t_Allocator);
+	t_HeapMove = std::move(t_HeapCopy);
+	ASSERT_EQ(t_HeapMove.data(), t_HeapData) << "Moving a spilled SmallArray should take over the heap buffer.";
+	ASSERT_TRUE(t_HeapCopy.is_inline());
+
+	for (size_t i = 0; i < 32; i++)
+	{
+		ASSERT_EQ(t_HeapMove[i].value, i);
+	}
+
+	//Slice conversion.
+	BB::Slice<size2593bytesObj> t_Slice = t_HeapMove;
+	ASSERT_EQ(t_Slice.size(), t_HeapMove.size());
+	ASSERT_EQ(t_Slice.data(), t_HeapMove.data());
+	t_Slice = t_InlineMove;
+	ASSERT_EQ(t_Slice.size(), t_InlineMove.size());
+	ASSERT_EQ(t_Slice[3].value, 3);
+
+	t_HeapMove.clear();
+	ASSERT_EQ(t_HeapMove.size(), 0);
+}
@@ -0,0 +1,263 @@
+#pragma once
+#include "../TestValues.h"
+#include "Storage/SoAArray.h"
+
+TEST(SoAArrayDataStructure, SoAArray_Push_Erase_Fields)
+{
+	constexpr const size_t samples = 300;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::SoAArray<float, uint32_t, size2593bytes> t_Array(t_Allocator);
+	for (size_t i = 0; i < samples; i++)
+	{
+		size2593bytes t_Big{};
+		t_Big.value = i * 7;
+		t_Array.push_back(static_cast<float>(i), static_cast<uint32_t>(i * 2), t_Big);
+	}
+	ASSERT_EQ(t_Array.size(), samples);
+
+	//Every field is dense and aligned so loops over it can use aligned SIMD loads.
+	BB::Slice<float> t_Floats = t_Array.field<0>();
+	BB::Slice<uint32_t> t_Ints = t_Array.field<1>();
+	BB::Slice<size2593bytes> t_Bigs = t_Array.field<2>();
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(t_Floats.data()) % BB::SoA_Specs::fieldAlignment, 0);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(t_Ints.data()) % BB::SoA_Specs::fieldAlignment, 0);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(t_Bigs.data()) % BB::SoA_Specs::fieldAlignment, 0);
+	ASSERT_EQ(t_Floats.size(), samples);
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_EQ(t_Floats[i], static_cast<float>(i));
+		ASSERT_EQ(t_Ints[i], i * 2);
+		ASSERT_EQ(t_Bigs[i].value, i * 7);
+	}
+
+	//erase_swap moves every field of the last element.
+	t_Array.erase_swap(10);
+	ASSERT_EQ(t_Array.size(), samples - 1);
+	EXPECT_EQ(t_Array.get<0>(10), static_cast<float>(samples - 1));
+	EXPECT_EQ(t_Array.get<1>(10), (samples - 1) * 2);
+	EXPECT_EQ(t_Array.get<2>(10).value, (samples - 1) * 7);
+
+	t_Array.pop();
+	EXPECT_EQ(t_Array.size(), samples - 2);
+
+	t_Array.resize(samples);
+	EXPECT_EQ(t_Array.get<1>(samples - 1), 0);
+
+	t_Array.clear();
+	EXPECT_EQ(t_Array.size(), 0);
+}
+
+TEST(SoAArrayDataStructure, SoAArray_Copy_Move_Objects)
+{
+	constexpr const size_t samples = 100;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	//std::string to check that constructors and destructors are called.
+	BB::SoAArray<std::string, size_t> t_Array(t_Allocator);
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Array.emplace_back(std::to_string(i) + " a string long enough to not fit in the small string buffer", i);
+	}
+
+	BB::SoAArray<std::string, size_t> t_Copy(t_Array);
+	ASSERT_EQ(t_Copy.size(), samples);
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_EQ(t_Copy.get<0>(i), t_Array.get<0>(i));
+		ASSERT_EQ(t_Copy.get<1>(i), i);
+	}
+
+	t_Copy.erase_swap(0);
+	EXPECT_EQ(t_Copy.get<0>(0), t_Array.get<0>(samples - 1));
+
+	BB::SoAArray<std::string, size_t> t_Moved(std::move(t_Array));
+	EXPECT_EQ(t_Array.size(), 0);
+	ASSERT_EQ(t_Moved.size(), samples);
+
+	BB::SoAArray<std::string, size_t> t_Assigned(t_Allocator);
+	t_Assigned = t_Copy;
+	EXPECT_EQ(t_Assigned.size(), samples - 1);
+	t_Assigned = std::move(t_Moved);
+	ASSERT_EQ(t_Assigned.size(), samples);
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_EQ(t_Assigned.get<1>(i), i);
+	}
+}
+
+TEST(SoAArrayDataStructure, SoASlotmap_Insert_Erase)
+{
+	constexpr const size_t samples = 256;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::SoASlotmap<float, std::string> t_Map(t_Allocator);
+	BB::SlotmapHandle t_Handles[samples];
+	for (size_t i = 0; i < samples; i++)
+	{
+		t_Handles[i] = t_Map.emplace(static_cast<float>(i), std::to_string(i));
+	}
+	ASSERT_EQ(t_Map.size(), samples);
+
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_EQ(t_Map.find<0>(t_Handles[i]), static_cast<float>(i));
+		ASSERT_EQ(t_Map.find<1>(t_Handles[i]), std::to_string(i));
+	}
+
+	//Erase every even element, the fields stay packed and the other handles stay valid.
+	for (size_t i = 0; i < samples; i += 2)
+	{
+		t_Map.erase(t_Handles[i]);
+	}
+	ASSERT_EQ(t_Map.size(), samples / 2);
+	ASSERT_EQ(t_Map.field<0>().size(), samples / 2);
+	for (size_t i = 1; i < samples; i += 2)
+	{
+		ASSERT_EQ(t_Map.find<0>(t_Handles[i]), static_cast<float>(i));
+		ASSERT_EQ(t_Map.find<1>(t_Handles[i]), std::to_string(i));
+		ASSERT_EQ(t_Map.field<1>()[t_Map.dense_index(t_Handles[i])], std::to_string(i));
+	}
+
+	float t_Sum = 0;
+	for (float t_Value : t_Map.field<0>())
+		t_Sum += t_Value;
+	EXPECT_EQ(t_Sum, static_cast<float>(samples / 2 * samples / 2));
+
+	//Reuse the erased ids, the new handles have a new generation.
+	for (size_t i = 0; i < samples; i += 2)
+	{
+		BB::SlotmapHandle t_Handle = t_Map.insert(static_cast<float>(i), std::to_string(i));
+		EXPECT_NE(t_Handle.handle, t_Handles[i].handle);
+		t_Handles[i] = t_Handle;
+	}
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_EQ(t_Map.find<1>(t_Handles[i]), std::to_string(i));
+	}
+
+	BB::SoASlotmap<float, std::string> t_Copy(t_Map);
+	t_Map.clear();
+	EXPECT_EQ(t_Map.size(), 0);
+	for (size_t i = 0; i < samples; i++)
+	{
+		ASSERT_EQ(t_Copy.find<1>(t_Handles[i]), std::to_string(i));
+	}
+}
+
+struct SoATestTransform
+{
+	float position[3];
+};
+
+struct SoATestVelocity
+{
+	float velocity[3];
+};
+
+struct SoATestRender
+{
+	uint32_t meshId;
+	uint32_t materialId;
+};
+
+TEST(SoAArrayDataStructure, SoASlotmap_Columns_By_Type)
+{
+	constexpr const size_t samples = 128;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::SoASlotmap<SoATestTransform, SoATestVelocity, SoATestRender> t_Map(t_Allocator);
+	BB::SlotmapHandle t_Handles[samples];
+	for (uint32_t i = 0; i < samples; i++)
+	{
+		const SoATestTransform t_Transform{ { static_cast<float>(i), 0.f, 0.f } };
+		const SoATestVelocity t_Velocity{ { 1.f, 0.f, 0.f } };
+		const SoATestRender t_Render{ i, i * 2 };
+		t_Handles[i] = t_Map.insert(t_Transform, t_Velocity, t_Render);
+	}
+	for (uint32_t i = 0; i < samples; i += 3)
+		t_Map.erase(t_Handles[i]);
+
+	//A movement system only touches the transform and velocity columns.
+	BB::Slice<SoATestTransform> t_Transforms = t_Map.field<SoATestTransform>();
+	const BB::Slice<SoATestVelocity> t_Velocities = t_Map.field<SoATestVelocity>();
+	ASSERT_EQ(t_Transforms.size(), t_Map.size());
+	ASSERT_EQ(t_Velocities.size(), t_Map.size());
+	for (size_t i = 0; i < t_Transforms.size(); i++)
+		t_Transforms[i].position[0] += t_Velocities[i].velocity[0];
+
+	//The dense index maps back to the handle, all columns agree on the element.
+	for (uint32_t i = 0; i < t_Map.size(); i++)
+	{
+		const BB::SlotmapHandle t_Handle = t_Map.handle(i);
+		ASSERT_EQ(t_Map.dense_index(t_Handle), i);
+		const uint32_t t_Original = t_Map.find<SoATestRender>(t_Handle).meshId;
+		ASSERT_EQ(t_Handles[t_Original].handle, t_Handle.handle);
+		ASSERT_EQ(t_Map.field<2>()[i].materialId, t_Original * 2);
+		ASSERT_EQ(t_Map.find<SoATestTransform>(t_Handle).position[0], static_cast<float>(t_Original + 1));
+	}
+}
+
+#include <chrono>
+
+TEST(SoAArrayDataStructure, SoAArray_Speedtest)
+{
+	typedef std::chrono::duration<float, std::milli> ms;
+	constexpr const float MILLITIMEDIVIDE = 1 / 1000.f;
+
+	constexpr const size_t samples = 1 << 18;
+
+	struct Particle
+	{
+		float position[3];
+		float velocity[3];
+		float color[4];
+		float lifetime;
+	};
+
+	const size_t allocatorSize = BB::mbSize * 64;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::Array<Particle> t_AoS(t_Allocator, samples);
+	BB::SoAArray<float, float, Particle> t_SoA(t_Allocator, samples);
+	for (size_t i = 0; i < samples; i++)
+	{
+		Particle t_Particle{};
+		t_Particle.position[1] = static_cast<float>(i);
+		t_Particle.velocity[1] = 1.f;
+		t_Particle.lifetime = static_cast<float>(i & 255);
+		t_AoS.push_back(t_Particle);
+		t_SoA.push_back(t_Particle.position[1], t_Particle.velocity[1], t_Particle);
+	}
+
+	std::cout << "SoAArray speed test, updating 1 field of " << samples << " particles." << "\n";
+	{
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < samples; i++)
+			t_AoS[i].position[1] += t_AoS[i].velocity[1] * 0.016f;
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::Array of structs speed with time in MS " << t_Speed << "\n";
+	}
+	{
+		auto t_Timer = std::chrono::high_resolution_clock::now();
+		float* t_Positions = t_SoA.data<0>();
+		const float* t_Velocities = t_SoA.data<1>();
+		for (size_t i = 0; i < samples; i++)
+			t_Positions[i] += t_Velocities[i] * 0.016f;
+		auto t_Speed = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+		std::cout << "BB::SoAArray speed with time in MS " << t_Speed << "\n";
+	}
+	EXPECT_EQ(t_AoS[samples - 1].position[1], t_SoA.get<0>(samples - 1));
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include "../TestValues.h"
+#include "Storage/StringBuilder.h"
+#include "Utils/Format.h"
+#include <string>
+
+TEST(StringBuilder_DataStructure, append_and_flatten)
+{
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	//Small chunks so that appends are split over chunks.
+	BB::StringBuilder t_Builder(t_Allocator, 16);
+	std::string t_Expected;
+	for (size_t i = 0; i < 512; i++)
+	{
+		const char* t_Word = i % 3 == 0 ? "alpha " : i % 3 == 1 ? "be" : "gamma_delta_epsilon ";
+		t_Builder.append(t_Word);
+		t_Expected += t_Word;
+		t_Builder.push_back('|');
+		t_Expected += '|';
+	}
+	//Bigger than any chunk.
+	const std::string t_Big(BB::StringBuilder_Specs::maxChunkSize + 100, 'x');
+	t_Builder.append(BB::StringView(t_Big.data(), t_Big.size()));
+	t_Expected += t_Big;
+	t_Builder.append("end", 3);
+	t_Expected += "end";
+
+	ASSERT_EQ(t_Builder.size(), t_Expected.size());
+	//Chunks double in size, so there are only a few.
+	EXPECT_LT(t_Builder.chunk_count(), 16);
+
+	char* t_Copy = new char[t_Builder.size()];
+	t_Builder.copy_to(t_Copy);
+	EXPECT_EQ(memcmp(t_Copy, t_Expected.data(), t_Expected.size()), 0);
+	delete[] t_Copy;
+
+	BB::String t_String(t_Allocator, "start:");
+	t_Builder.flatten(t_String);
+	ASSERT_EQ(t_String.size(), t_Expected.size() + 6);
+	EXPECT_EQ(memcmp(t_String.data() + 6, t_Expected.data(), t_Expected.size()), 0);
+	EXPECT_EQ(t_String.c_str()[t_String.size()], '\0');
+
+	//Clear keeps the first chunk.
+	t_Builder.clear();
+	EXPECT_TRUE(t_Builder.empty());
+	EXPECT_EQ(t_Builder.chunk_count(), 1);
+	t_Builder.append("again");
+	char t_Again[5];
+	t_Builder.copy_to(t_Again);
+	EXPECT_EQ(memcmp(t_Again, "again", 5), 0);
+
+	//Moving takes the chunks.
+	BB::StringBuilder t_Moved(std::move(t_Builder));
+	EXPECT_EQ(t_Moved.size(), 5);
+	EXPECT_EQ(t_Builder.size(), 0);
+	EXPECT_EQ(t_Builder.chunk_count(), 0);
+	t_Builder.append("reuse");
+	EXPECT_EQ(t_Builder.size(), 5);
+}
+
+TEST(StringBuilder_DataStructure, format_into_builder)
+{
+	const size_t allocatorSize = BB::kbSize * 64;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::StringBuilder t_Builder(t_Allocator, 8);
+	for (int i = 0; i < 100; i++)
+		BB::Format(t_Builder, "{}:{};", i, i * 0.5f);
+
+	BB::String t_String(t_Allocator);
+	t_Builder.flatten(t_String);
+
+	std::string t_Expected;
+	char t_Entry[32];
+	for (int i = 0; i < 100; i++)
+	{
+		snprintf(t_Entry, sizeof(t_Entry), "%d:%g;", i, i * 0.5f);
+		t_Expected += t_Entry;
+	}
+	EXPECT_EQ(strcmp(t_String.c_str(), t_Expected.c_str()), 0);
+}
+
+#include <chrono>
+
+TEST(StringBuilder_DataStructure, StringBuilder_Speedtest)
+{
+	typedef std::chrono::duration<float, std::milli> ms;
+	constexpr const float MILLITIMEDIVIDE = 1 / 1000.f;
+	constexpr const size_t appends = 1 << 18;
+	const char* t_Line = "\"name\" : \"some_value\",\n";
+	const size_t t_LineSize = strlen(t_Line);
+
+	//64 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 64;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	auto t_Timer = std::chrono::high_resolution_clock::now();
+	{
+		BB::String t_String(t_Allocator);
+		for (size_t i = 0; i < appends; i++)
+			t_String.append(t_Line, t_LineSize);
+		EXPECT_EQ(t_String.size(), appends * t_LineSize);
+	}
+	const float t_StringTime = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+
+	t_Timer = std::chrono::high_resolution_clock::now();
+	{
+		BB::StringBuilder t_Builder(t_Allocator);
+		for (size_t i = 0; i < appends; i++)
+			t_Builder.append(t_Line, t_LineSize);
+		BB::String t_String(t_Allocator);
+		t_Builder.flatten(t_String);
+		EXPECT_EQ(t_String.size(), appends * t_LineSize);
+	}
+	const float t_BuilderTime = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+
+	std::cout << "String building speed test, " << appends << " appends of " << t_LineSize << " characters." << "\n";
+	std::cout << "BB::String::append speed with time in MS " << t_StringTime << "\n";
+	std::cout << "BB::StringBuilder::append and flatten speed with time in MS " << t_BuilderTime << "\n";
+}
@@ -0,0 +1,147 @@
+#pragma once
+#include "../TestValues.h"
+#include "Storage/StringInterner.h"
+#include <thread>
+
+TEST(StringInterner, Intern_Find_Lookup)
+{
+	constexpr const size_t samples = 1024;
+
+	//2 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 2;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::StringInterner::Init(samples);
+
+	char t_Keys[samples][32]{};
+	BB::StringId t_Ids[samples];
+	for (size_t i = 0; i < samples; i++)
+	{
+		snprintf(t_Keys[i], sizeof(t_Keys[i]), "field_name_%04zu", i);
+		t_Ids[i] = BB::StringInterner::Intern(t_Keys[i]);
+		ASSERT_TRUE(t_Ids[i].IsValid());
+	}
+	ASSERT_EQ(BB::StringInterner::Count(), samples);
+
+	for (size_t i = 0; i < samples; i++)
+	{
+		//Interning again gives the same id and does not add a string.
+		const BB::StringId t_Again = BB::StringInterner::Intern(t_Keys[i], strlen(t_Keys[i]));
+		ASSERT_EQ(t_Again, t_Ids[i]);
+		ASSERT_EQ(t_Again.hash, t_Ids[i].hash);
+		ASSERT_EQ(t_Ids[i].hash, static_cast<uint32_t>(Hash::MakeHash(t_Keys[i])));
+		ASSERT_EQ(BB::StringInterner::Find(t_Keys[i]), t_Ids[i]);
+
+		//The stored string is a copy.
+		ASSERT_NE(BB::StringInterner::GetString(t_Ids[i]), t_Keys[i]);
+		ASSERT_EQ(strcmp(BB::StringInterner::GetString(t_Ids[i]), t_Keys[i]), 0);
+		ASSERT_EQ(BB::StringInterner::GetLength(t_Ids[i]), strlen(t_Keys[i]));
+		if (i != 0)
+			ASSERT_NE(t_Ids[i], t_Ids[i - 1]);
+	}
+	ASSERT_EQ(BB::StringInterner::Count(), samples);
+
+	//Strings that were never interned, a prefix of an interned string included.
+	EXPECT_FALSE(BB::StringInterner::Find("not_interned").IsValid());
+	EXPECT_FALSE(BB::StringInterner::Find(t_Keys[0], strlen(t_Keys[0]) - 1).IsValid());
+
+	//Hashmaps keyed by the id use the hash stored in the id.
+	BB::OL_HashMap<BB::StringId, size_t> t_Map(t_Allocator);
+	for (size_t i = 0; i < samples; i++)
+		t_Map.insert(t_Ids[i], i);
+	for (size_t i = 0; i < samples; i++)
+		ASSERT_EQ(*t_Map.find(BB::StringInterner::Find(t_Keys[i])), i);
+
+	BB::StringInterner::Destroy();
+}
+
+constexpr const size_t STRING_INTERNER_PER_THREAD = 512;
+
+static void StringInternerWorker(BB::StringId* a_Ids, const size_t a_Offset)
+{
+	char t_Key[32];
+	//Every thread interns the same strings, only the first one to get there adds them.
+	for (size_t i = 0; i < STRING_INTERNER_PER_THREAD * 2; i++)
+	{
+		snprintf(t_Key, sizeof(t_Key), "shared_%zu", i);
+		a_Ids[a_Offset + i] = BB::StringInterner::Intern(t_Key);
+		if (i % 32 == 0)
+			std::this_thread::yield();
+	}
+}
+
+TEST(StringInterner, Parallel_Intern)
+{
+	constexpr const size_t threadCount = 4;
+	constexpr const size_t stringCount = STRING_INTERNER_PER_THREAD * 2;
+
+	BB::StringInterner::Init(stringCount);
+
+	BB::StringId* t_Ids = new BB::StringId[stringCount * threadCount];
+	std::thread t_Threads[threadCount];
+	for (size_t i = 0; i < threadCount; i++)
+		t_Threads[i] = std::thread(StringInternerWorker, t_Ids, i * stringCount);
+	for (size_t i = 0; i < threadCount; i++)
+		t_Threads[i].join();
+
+	ASSERT_EQ(BB::StringInterner::Count(), stringCount);
+	char t_Key[32];
+	for (size_t i = 0; i < stringCount; i++)
+	{
+		snprintf(t_Key, sizeof(t_Key), "shared_%zu", i);
+		ASSERT_EQ(strcmp(BB::StringInterner::GetString(t_Ids[i]), t_Key), 0);
+		for (size_t t_Thread = 1; t_Thread < threadCount; t_Thread++)
+			ASSERT_EQ(t_Ids[t_Thread * stringCount + i], t_Ids[i]);
+	}
+
+	delete[] t_Ids;
+	BB::StringInterner::Destroy();
+}
+
+#include <chrono>
+
+TEST(StringInterner, StringId_Speedtest)
+{
+	typedef std::chrono::duration<float, std::milli> ms;
+	constexpr const float MILLITIMEDIVIDE = 1 / 1000.f;
+	constexpr const size_t samples = 4096;
+	constexpr const size_t lookups = samples * 64;
+
+	//16 MB alloactor.
+	const size_t allocatorSize = BB::mbSize * 16;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	BB::StringInterner::Init(samples);
+
+	char(*t_Keys)[48] = new char[samples][48];
+	BB::StringId* t_Ids = new BB::StringId[samples];
+	BB::OL_HashMap<char*, size_t, BB::String_KeyComp> t_StringMap(t_Allocator);
+	BB::OL_HashMap<BB::StringId, size_t> t_IdMap(t_Allocator);
+	for (size_t i = 0; i < samples; i++)
+	{
+		snprintf(t_Keys[i], sizeof(t_Keys[i]), "assets/textures/environment/rock_%04zu", i);
+		t_Ids[i] = BB::StringInterner::Intern(t_Keys[i]);
+		t_StringMap.insert(t_Keys[i], i);
+		t_IdMap.insert(t_Ids[i], i);
+	}
+
+	size_t t_Sum = 0;
+	auto t_Timer = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < lookups; i++)
+		t_Sum += *t_StringMap.find(t_Keys[(i * 7919) % samples]);
+	const float t_StringTime = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+
+	t_Timer = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < lookups; i++)
+		t_Sum -= *t_IdMap.find(t_Ids[(i * 7919) % samples]);
+	const float t_IdTime = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+	EXPECT_EQ(t_Sum, 0);
+
+	std::cout << "Hashmap lookup speed test, " << lookups << " lookups of " << samples << " string keys." << "\n";
+	std::cout << "OL_HashMap<char*> with String_KeyComp speed with time in MS " << t_StringTime << "\n";
+	std::cout << "OL_HashMap<StringId> speed with time in MS " << t_IdTime << "\n";
+
+	delete[] t_Ids;
+	delete[] t_Keys;
+	BB::StringInterner::Destroy();
+}
@@ -0,0 +1,154 @@
+#pragma once
+#include "../TestValues.h"
+#include "Storage/BBString.h"
+#include <string>
+#include <string_view>
+
+TEST(StringView_DataStructure, find_rfind_compare)
+{
+	const BB::StringView t_View("assets/textures/environment/rock_diffuse.png");
+
+	EXPECT_EQ(t_View.find('/'), 6);
+	EXPECT_EQ(t_View.find('/', 7), 15);
+	EXPECT_EQ(t_View.find('#'), BB::StringView_Specs::NOT_FOUND);
+	EXPECT_EQ(t_View.rfind('/'), 27);
+	EXPECT_EQ(t_View.rfind('/', 26), 15);
+	EXPECT_EQ(t_View.rfind('a'), 0);
+	EXPECT_EQ(t_View.rfind('#'), BB::StringView_Specs::NOT_FOUND);
+
+	EXPECT_EQ(t_View.find("rock"), 28);
+	EXPECT_EQ(t_View.find("en"), 16);
+	EXPECT_EQ(t_View.find("en", 17), 24);
+	EXPECT_EQ(t_View.find("rocks"), BB::StringView_Specs::NOT_FOUND);
+	EXPECT_EQ(t_View.find(""), 0);
+	EXPECT_EQ(t_View.rfind("en"), 24);
+	EXPECT_EQ(t_View.rfind("en", 23), 16);
+	EXPECT_EQ(t_View.rfind(".png"), t_View.size() - 4);
+	EXPECT_EQ(t_View.rfind("assets/textures/environment/rock_diffuse.png!"), BB::StringView_Specs::NOT_FOUND);
+
+	EXPECT_TRUE(t_View.starts_with("assets/"));
+	EXPECT_FALSE(t_View.starts_with("textures/"));
+	EXPECT_TRUE(t_View.ends_with(".png"));
+	EXPECT_FALSE(t_View.ends_with(".jpg"));
+
+	const BB::StringView t_Name = t_View.substr(28, 4);
+	EXPECT_TRUE(t_Name.compare("rock"));
+	EXPECT_TRUE(t_Name == BB::StringView("rock_", 4));
+	EXPECT_TRUE(t_Name != BB::StringView("rocks"));
+	EXPECT_EQ(t_View.substr(40).size(), t_View.size() - 40);
+
+	//Wide strings use the same interface.
+	const BB::WStringView t_WView(L"key=value=other");
+	EXPECT_EQ(t_WView.find(L'='), 3);
+	EXPECT_EQ(t_WView.rfind(L'='), 9);
+	EXPECT_EQ(t_WView.find(L"value"), 4);
+	EXPECT_EQ(t_WView.rfind(L"e="), 8);
+	EXPECT_TRUE(t_WView.starts_with(L"key"));
+}
+
+TEST(StringView_DataStructure, split)
+{
+	const BB::StringView t_View("x,y,,z");
+	BB::StringView t_Parts[8];
+
+	ASSERT_EQ(t_View.split(',', t_Parts, 8), 4);
+	EXPECT_TRUE(t_Parts[0].compare("x"));
+	EXPECT_TRUE(t_Parts[1].compare("y"));
+	EXPECT_TRUE(t_Parts[2].empty());
+	EXPECT_TRUE(t_Parts[3].compare("z"));
+
+	//The last part gets the rest.
+	ASSERT_EQ(t_View.split(',', t_Parts, 2), 2);
+	EXPECT_TRUE(t_Parts[0].compare("x"));
+	EXPECT_TRUE(t_Parts[1].compare("y,,z"));
+
+	ASSERT_EQ(BB::StringView("").split(',', t_Parts, 8), 1);
+	EXPECT_TRUE(t_Parts[0].empty());
+}
+
+//Compares the SIMD kernels with std::string_view on every alignment and length around the vector sizes.
+TEST(StringView_DataStructure, simd_search_matches_std)
+{
+	constexpr const size_t maxLength = 130;
+	char t_Buffer[maxLength + 64];
+	for (size_t i = 0; i < sizeof(t_Buffer); i++)
+		t_Buffer[i] = static_cast<char>('a' + BB::Random::Random() % 3);
+
+	const char* t_Patterns[] = { "a", "ab", "cab", "abca", "bbbbbbbb", "abcabcabcabcabcabc" };
+	for (size_t t_Offset = 0; t_Offset < 33; t_Offset++)
+	{
+		for (size_t t_Length = 0; t_Length < maxLength; t_Length++)
+		{
+			const BB::StringView t_View(t_Buffer + t_Offset, t_Length);
+			const std::string_view t_StdView(t_Buffer + t_Offset, t_Length);
+
+			for (const char* t_Pattern : t_Patterns)
+			{
+				const size_t t_Expected = t_StdView.find(t_Pattern);
+				ASSERT_EQ(t_View.find(t_Pattern), t_Expected == std::string_view::npos ? BB::StringView_Specs::NOT_FOUND : t_Expected);
+				const size_t t_ExpectedLast = t_StdView.rfind(t_Pattern);
+				ASSERT_EQ(t_View.rfind(t_Pattern), t_ExpectedLast == std::string_view::npos ? BB::StringView_Specs::NOT_FOUND : t_ExpectedLast);
+			}
+			const size_t t_ExpectedChar = t_StdView.rfind('c');
+			ASSERT_EQ(t_View.rfind('c'), t_ExpectedChar == std::string_view::npos ? BB::StringView_Specs::NOT_FOUND : t_ExpectedChar);
+		}
+	}
+}
+
+TEST(StringView_DataStructure, string_accepts_views)
+{
+	const size_t allocatorSize = BB::kbSize * 16;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	const BB::StringView t_Path("shaders/lit.hlsl");
+	BB::StringView t_Parts[2];
+	ASSERT_EQ(t_Path.split('/', t_Parts, 2), 2);
+
+	BB::String t_String(t_Allocator, t_Parts[1]);
+	EXPECT_EQ(strcmp(t_String.c_str(), "lit.hlsl"), 0);
+	t_String.insert(0, t_Parts[0]);
+	t_String.insert(t_Parts[0].size(), BB::StringView("/"));
+	t_String.append(BB::StringView(".bin_extra", 4));
+	EXPECT_EQ(strcmp(t_String.c_str(), "shaders/lit.hlsl.bin"), 0);
+
+	//A string converts to a view without copying.
+	const BB::StringView t_View = t_String;
+	EXPECT_EQ(t_View.data(), t_String.data());
+	EXPECT_EQ(t_View.size(), t_String.size());
+	EXPECT_TRUE(t_View.ends_with(".bin"));
+}
+
+#include <chrono>
+
+TEST(StringView_DataStructure, StringView_Speedtest)
+{
+	typedef std::chrono::duration<float, std::milli> ms;
+	constexpr const float MILLITIMEDIVIDE = 1 / 1000.f;
+	constexpr const size_t textSize = BB::mbSize;
+	constexpr const size_t iterations = 16;
+
+	std::string t_Text(textSize, 'a');
+	for (size_t i = 0; i < textSize; i++)
+		t_Text[i] = static_cast<char>('a' + BB::Random::Random() % 26);
+	const char* t_Pattern = "needle_in_the_haystack";
+	t_Text.replace(textSize - 64, strlen(t_Pattern), t_Pattern);
+
+	const std::string_view t_StdView(t_Text);
+	const BB::StringView t_View(t_Text.data(), t_Text.size());
+
+	size_t t_Found = 0;
+	auto t_Timer = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < iterations; i++)
+		t_Found += t_StdView.find(t_Pattern);
+	const float t_StdTime = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+
+	t_Timer = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < iterations; i++)
+		t_Found -= t_View.find(t_Pattern);
+	const float t_BBTime = std::chrono::duration_cast<ms>(std::chrono::high_resolution_clock::now() - t_Timer).count() * MILLITIMEDIVIDE;
+	EXPECT_EQ(t_Found, 0);
+
+	std::cout << "String search speed test, " << iterations << " searches through " << textSize << " characters." << "\n";
+	std::cout << "std::string_view::find speed with time in MS " << t_StdTime << "\n";
+	std::cout << "BB::StringView::find speed with time in MS " << t_BBTime << "\n";
+}
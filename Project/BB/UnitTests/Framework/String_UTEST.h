@@ -2,6 +2,9 @@
 #include "../TestValues.h"
 #include "Storage/BBString.h"
 
+//Containers of strings grow with a memcpy.
+static_assert(BB::isTriviallyRelocatable_v<BB::String> && BB::isTriviallyRelocatable_v<BB::WString>, "Basic_String must be trivially relocatable.");
+
 #pragma region WString
 TEST(String_DataStructure, append_insert_push_pop_copy_assignment)
 {
@@ -159,6 +162,75 @@ TEST(String_DataStructure, reserve_shrink)
 
 	EXPECT_EQ(t_String.capacity(), t_ModifiedC_StringSize) << "String did not shrink down to the correct size";
 }
+TEST(String_DataStructure, small_string)
+{
+	const size_t allocatorSize = BB::kbSize * 16;
+	BB::FreelistAllocator_t t_Allocator(allocatorSize);
+
+	//23 characters and the terminator fit inside the string object.
+	constexpr const char* t_SmallString = "Twenty three characters";
+	constexpr const char* t_BigString = "Twenty three characters and then some more.";
+
+	BB::String t_String(t_Allocator, t_SmallString);
+	EXPECT_TRUE(t_String.is_local()) << "A 23 character string should not allocate.";
+	EXPECT_EQ(t_String.size(), strlen(t_SmallString));
+	EXPECT_EQ(t_String.c_str()[t_String.size()], '\0');
+	EXPECT_EQ(strcmp(t_String.c_str(), t_SmallString), 0);
+
+	t_String.pop_back();
+	EXPECT_EQ(t_String.size(), strlen(t_SmallString) - 1);
+	EXPECT_TRUE(t_String.compare("Twenty three character"));
+	EXPECT_EQ(t_String.c_str()[t_String.size()], '\0');
+	t_String.push_back('s');
+
+	//Growing past the local storage moves the string to the heap.
+	t_String.append(t_BigString + strlen(t_SmallString));
+	EXPECT_FALSE(t_String.is_local());
+	EXPECT_EQ(strcmp(t_String.c_str(), t_BigString), 0);
+
+	//Copies of a small heap string are local again.
+	BB::String t_SmallHeapString(t_Allocator, 64);
+	t_SmallHeapString.append("small");
+	EXPECT_FALSE(t_SmallHeapString.is_local());
+	BB::String t_CopyString(t_SmallHeapString);
+	EXPECT_TRUE(t_CopyString.is_local());
+	EXPECT_TRUE(t_CopyString.compare("small"));
+	t_SmallHeapString.shrink_to_fit();
+	EXPECT_TRUE(t_SmallHeapString.is_local());
+	EXPECT_EQ(strcmp(t_SmallHeapString.c_str(), "small"), 0);
+
+	//Move both kinds, the moved from string is left without data.
+	BB::String t_MovedLocal(std::move(t_CopyString));
+	EXPECT_TRUE(t_MovedLocal.is_local());
+	EXPECT_EQ(strcmp(t_MovedLocal.c_str(), "small"), 0);
+	EXPECT_EQ(t_CopyString.data(), nullptr);
+	EXPECT_EQ(t_CopyString.size(), 0);
+
+	BB::String t_MovedHeap(std::move(t_String));
+	EXPECT_FALSE(t_MovedHeap.is_local());
+	EXPECT_EQ(strcmp(t_MovedHeap.c_str(), t_BigString), 0);
+	EXPECT_EQ(t_String.data(), nullptr);
+
+	t_MovedLocal = t_MovedHeap;
+	EXPECT_FALSE(t_MovedLocal.is_local());
+	EXPECT_EQ(strcmp(t_MovedLocal.c_str(), t_BigString), 0);
+	t_MovedHeap = std::move(t_SmallHeapString);
+	EXPECT_TRUE(t_MovedHeap.is_local());
+	EXPECT_EQ(strcmp(t_MovedHeap.c_str(), "small"), 0);
+
+	//Wide strings get less characters in the same space.
+	constexpr const size_t t_WideLocal = 24 / sizeof(wchar_t) - 1;
+	BB::WString t_WString(t_Allocator);
+	for (size_t i = 0; i < t_WideLocal; i++)
+		t_WString.push_back(L'a');
+	EXPECT_TRUE(t_WString.is_local());
+	EXPECT_EQ(t_WString.c_str()[t_WideLocal], L'\0');
+	t_WString.push_back(L'b');
+	EXPECT_FALSE(t_WString.is_local());
+	EXPECT_EQ(t_WString.size(), t_WideLocal + 1);
+	EXPECT_EQ(t_WString.c_str()[t_WideLocal], L'b');
+	EXPECT_EQ(t_WString.c_str()[t_WideLocal + 1], L'\0');
+}
 #pragma endregion //String
 
 #pragma region WString
@@ -12,14 +12,29 @@
 #pragma warning(disable:6262)
 #include "Framework/Allocators_UTEST.h"
 #include "Framework/Array_UTEST.h"
+#include "Framework/SmallArray_UTEST.h"
+#include "Framework/BucketArray_UTEST.h"
+#include "Framework/SoAArray_UTEST.h"
+#include "Framework/BitArray_UTEST.h"
+#include "Framework/RingBuffer_UTEST.h"
+#include "Framework/LockFreeQueue_UTEST.h"
+#include "Framework/DaryHeap_UTEST.h"
 #include "Framework/Pool_UTEST.h"
 #include "Framework/Hashmap_UTEST.h"
+#include "Framework/Hash_UTEST.h"
+#include "Framework/FlatMap_UTEST.h"
+#include "Framework/Hashset_UTEST.h"
+#include "Framework/PerfectHashmap_UTEST.h"
 #include "Framework/MemoryArena_UTEST.h"
 #include "Framework/BBjson_UTEST.hpp"
 #include "Framework/MemoryOperations_UTEST.h"
 #include "Framework/Slice_UTEST.h"
 #include "Framework/Slotmap_UTEST.h"
 #include "Framework/String_UTEST.h"
+#include "Framework/StringInterner_UTEST.h"
+#include "Framework/StringView_UTEST.h"
+#include "Framework/StringBuilder_UTEST.h"
+#include "Framework/Format_UTEST.h"
 #include "Framework/FileReadWrite_UTEST.h"
 #pragma warning(default:6262)
 